@@ -0,0 +1,67 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <benchmark/benchmark.h>
+#include "boost/mysql/detail/protocol/channel.hpp"
+#include "test_stream.hpp"
+
+using boost::mysql::detail::channel;
+using boost::mysql::detail::bytestring;
+using boost::mysql::test::test_stream;
+using boost::mysql::test::make_packet;
+using boost::mysql::error_code;
+
+namespace
+{
+
+// Messages loaded in the stream. When all of them have been read, the stream is rewound
+constexpr std::size_t num_messages = 1024;
+
+// Arguments are the message size and the read-ahead size (0 disables read-ahead)
+void BM_ChannelRead(benchmark::State& state)
+{
+    auto message_size = static_cast<std::size_t>(state.range(0));
+    boost::asio::io_context ctx;
+    test_stream stream (ctx);
+    std::string payload (message_size, 'a');
+    for (std::size_t i = 0; i < num_messages; ++i)
+        stream.add_bytes_to_read(make_packet(0, payload));
+
+    channel<test_stream> chan (stream);
+    chan.set_read_ahead_size(static_cast<std::size_t>(state.range(1)));
+    bytestring buffer;
+    error_code err;
+    std::size_t remaining = num_messages;
+    for (auto _ : state)
+    {
+        if (remaining == 0)
+        {
+            stream.rewind();
+            remaining = num_messages;
+        }
+        chan.reset_sequence_number();
+        chan.read(buffer, err);
+        if (err)
+        {
+            state.SkipWithError(err.message().c_str());
+            break;
+        }
+        --remaining;
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    state.SetItemsProcessed(state.iterations()); // messages
+    state.SetBytesProcessed(state.iterations() * (message_size + 4));
+}
+BENCHMARK(BM_ChannelRead)
+    ->Args({16, 0})
+    ->Args({16, 16384})
+    ->Args({256, 0})
+    ->Args({256, 16384})
+    ->Args({4096, 0})
+    ->Args({4096, 16384});
+
+} // anon namespace
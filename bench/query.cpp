@@ -0,0 +1,129 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <benchmark/benchmark.h>
+#include "boost/mysql/connection.hpp"
+#include "fake_server.hpp"
+#include "test_common.hpp"
+#include "test_stream.hpp"
+#include <string>
+#ifdef BOOST_ASIO_HAS_LOCAL_SOCKETS
+#include <unistd.h>
+#endif
+
+using namespace boost::mysql::test;
+using boost::mysql::value;
+using boost::mysql::connection_params;
+using boost::mysql::ssl_options;
+using boost::mysql::ssl_mode;
+
+namespace
+{
+
+constexpr const char* sql = "SELECT id, name, salary, hired FROM employee";
+
+fake_server make_server(std::size_t num_rows)
+{
+    std::vector<fake_server::row_type> rows;
+    for (std::size_t i = 0; i < num_rows; ++i)
+        rows.push_back(makevalues(static_cast<std::int64_t>(i), "John Doe", 48000.5, makedate(2020, 1, 1)));
+    fake_server res;
+    res.add_resultset(sql, {"id", "name", "salary", "hired"}, rows);
+    return res;
+}
+
+template <typename Connection>
+void query_and_fetch(benchmark::State& state, Connection& conn)
+{
+    auto result = conn.query(sql);
+    while (const auto* row = result.fetch_one())
+        benchmark::DoNotOptimize(row);
+    if (!result.complete())
+        state.SkipWithError("resultset not complete");
+}
+
+// Runs a query and reads its rows one by one, over an in-memory stream.
+// Arguments are the number of rows and the read-ahead size
+void BM_QueryInMemory(benchmark::State& state)
+{
+    auto num_rows = static_cast<std::size_t>(state.range(0));
+    auto server = make_server(num_rows);
+    const auto& response = server.query_response(sql);
+
+    boost::asio::io_context ctx;
+    boost::mysql::connection<test_stream> conn (ctx);
+    conn.set_read_ahead_size(static_cast<std::size_t>(state.range(1)));
+    conn.next_layer().add_bytes_to_read(response);
+    for (auto _ : state)
+    {
+        conn.next_layer().rewind();
+        conn.next_layer().clear_bytes_written();
+        query_and_fetch(state, conn);
+    }
+    state.SetItemsProcessed(state.iterations() * num_rows); // rows
+    state.SetBytesProcessed(state.iterations() * response.size());
+}
+BENCHMARK(BM_QueryInMemory)
+    ->Args({1, 0})
+    ->Args({1000, 0})
+    ->Args({1000, 16384});
+
+// Same, but over loopback TCP, against a fake_tcp_server
+void BM_QueryTcp(benchmark::State& state)
+{
+    auto num_rows = static_cast<std::size_t>(state.range(0));
+    auto server = make_server(num_rows);
+    fake_tcp_server tcp_server (server, {boost::asio::ip::address_v4::loopback(), 0});
+
+    boost::asio::io_context ctx;
+    boost::mysql::tcp_connection conn (ctx);
+    conn.set_read_ahead_size(static_cast<std::size_t>(state.range(1)));
+    conn.connect(tcp_server.endpoint(), connection_params("user", "password", "",
+        boost::mysql::collation::utf8_general_ci, ssl_options(ssl_mode::disable)));
+    for (auto _ : state)
+        query_and_fetch(state, conn);
+    conn.close();
+    state.SetItemsProcessed(state.iterations() * num_rows); // rows
+    state.SetBytesProcessed(state.iterations() * server.query_response(sql).size());
+}
+BENCHMARK(BM_QueryTcp)
+    ->Args({1, 0})
+    ->Args({1000, 0})
+    ->Args({1000, 16384});
+
+#ifdef BOOST_ASIO_HAS_LOCAL_SOCKETS
+// Same, but over a UNIX socket, against a fake_unix_server. Together with
+// BM_QueryTcp, measures the cost of the Asio I/O backend: build with and
+// without BOOST_MYSQL_IO_URING to compare io_uring and epoll
+// (see ci/compare_io_backends.sh)
+void BM_QueryUnix(benchmark::State& state)
+{
+    auto num_rows = static_cast<std::size_t>(state.range(0));
+    auto server = make_server(num_rows);
+    // A path per process, so concurrent runs don't steal each other's socket.
+    // fake_unix_server removes any stale file before binding
+    std::string path = "/tmp/boost_mysql_bench_" + std::to_string(::getpid()) + ".sock";
+    fake_unix_server unix_server (server, {path});
+
+    boost::asio::io_context ctx;
+    boost::mysql::unix_connection conn (ctx);
+    conn.set_read_ahead_size(static_cast<std::size_t>(state.range(1)));
+    conn.connect(unix_server.endpoint(), connection_params("user", "password", "",
+        boost::mysql::collation::utf8_general_ci, ssl_options(ssl_mode::disable)));
+    for (auto _ : state)
+        query_and_fetch(state, conn);
+    conn.close();
+    state.SetItemsProcessed(state.iterations() * num_rows); // rows
+    state.SetBytesProcessed(state.iterations() * server.query_response(sql).size());
+}
+BENCHMARK(BM_QueryUnix)
+    ->Args({1, 0})
+    ->Args({1000, 0})
+    ->Args({1000, 16384});
+#endif
+
+} // anon namespace
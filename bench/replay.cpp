@@ -0,0 +1,65 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Replays a protocol capture, recorded with boost::mysql::capture_writer,
+// against the client, without a server. Usage:
+//    mysql_replay <capture-file> [benchmark options]
+// Use it to compare client performance between versions with the traffic
+// of a real deployment.
+
+#include <benchmark/benchmark.h>
+#include "capture_replay.hpp"
+#include <functional>
+#include <iostream>
+#include <memory>
+
+using boost::mysql::test::capture_replayer;
+
+namespace
+{
+
+void replay(benchmark::State& state, capture_replayer& replayer)
+{
+    replayer.get_connection().set_read_ahead_size(static_cast<std::size_t>(state.range(0)));
+    std::size_t num_rows = 0;
+    for (auto _ : state)
+        num_rows += replayer.run().num_rows;
+    state.SetItemsProcessed(static_cast<std::int64_t>(num_rows));
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(replayer.server_bytes_size()));
+    state.counters["commands"] = static_cast<double>(replayer.num_commands());
+}
+
+} // anon namespace
+
+int main(int argc, char** argv)
+{
+    benchmark::Initialize(&argc, argv);
+    if (argc != 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <capture-file> [benchmark options]\n";
+        return 1;
+    }
+
+    std::unique_ptr<capture_replayer> replayer;
+    try
+    {
+        replayer = std::make_unique<capture_replayer>(capture_replayer::read_file(argv[1]));
+        replayer->run(); // validate the capture before measuring
+    }
+    catch (const std::exception& err)
+    {
+        std::cerr << "Error replaying " << argv[1] << ": " << err.what() << '\n';
+        return 1;
+    }
+
+    benchmark::RegisterBenchmark("Replay", replay, std::ref(*replayer))
+        ->Arg(0)
+        ->Arg(16384);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
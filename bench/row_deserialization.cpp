@@ -0,0 +1,97 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <benchmark/benchmark.h>
+#include "boost/mysql/detail/protocol/text_deserialization.hpp"
+#include "boost/mysql/detail/protocol/binary_deserialization.hpp"
+#include "fake_server.hpp"
+#include "test_common.hpp"
+
+using namespace boost::mysql::detail;
+using namespace boost::mysql::test;
+using boost::mysql::value;
+using boost::mysql::field_metadata;
+
+namespace
+{
+
+// Rows have this many fields, all of the same type
+constexpr std::size_t num_fields = 10;
+
+const std::string long_text (1024, 'a');
+
+struct column_type
+{
+    protocol_field_type type;
+    std::uint16_t flags;
+    std::uint8_t decimals;
+    value sample;
+};
+
+const column_type bigint_col { protocol_field_type::longlong, 0, 0, value(std::int64_t(-1234567890123)) };
+const column_type bigint_unsigned_col { protocol_field_type::longlong, column_flags::unsigned_, 0, value(std::uint64_t(1234567890123)) };
+const column_type float_col { protocol_field_type::float_, 0, 31, value(3.14f) };
+const column_type double_col { protocol_field_type::double_, 0, 31, value(-2.718281828459045) };
+const column_type varchar_col { protocol_field_type::var_string, 0, 0, value("a short string") };
+const column_type text_col { protocol_field_type::blob, 0, 0, value(long_text) };
+const column_type date_col { protocol_field_type::date, 0, 0, value(makedate(2020, 10, 4)) };
+const column_type datetime_col { protocol_field_type::datetime, 0, 6, value(makedt(2020, 10, 4, 23, 59, 1, 123456)) };
+const column_type time_col { protocol_field_type::time, 0, 6, value(maket(838, 59, 58, 999999)) };
+const column_type null_col { protocol_field_type::var_string, 0, 0, value(nullptr) };
+
+// Deserializes a row of num_fields values of the given type, using the text or binary protocol
+void BM_DeserializeRow(benchmark::State& state, const column_type& col, bool binary)
+{
+    column_definition_packet coldef {};
+    coldef.type = col.type;
+    coldef.flags.value = col.flags;
+    coldef.decimals.value = col.decimals;
+    std::vector<field_metadata> meta (num_fields, field_metadata(coldef));
+
+    fake_server::row_type row (num_fields, col.sample);
+    auto payload = binary ? fake_server::make_binary_row(row) : fake_server::make_text_row(row);
+    auto deserializer = binary ? &deserialize_binary_row : &deserialize_text_row;
+
+    std::vector<value> output;
+    for (auto _ : state)
+    {
+        deserialization_context ctx (boost::asio::buffer(payload), capabilities(0));
+        auto err = deserializer(ctx, meta, output);
+        if (err)
+        {
+            state.SkipWithError(err.message().c_str());
+            break;
+        }
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetItemsProcessed(state.iterations()); // rows
+    state.SetBytesProcessed(state.iterations() * payload.size());
+}
+
+BENCHMARK_CAPTURE(BM_DeserializeRow, text_bigint, bigint_col, false);
+BENCHMARK_CAPTURE(BM_DeserializeRow, text_bigint_unsigned, bigint_unsigned_col, false);
+BENCHMARK_CAPTURE(BM_DeserializeRow, text_float, float_col, false);
+BENCHMARK_CAPTURE(BM_DeserializeRow, text_double, double_col, false);
+BENCHMARK_CAPTURE(BM_DeserializeRow, text_varchar, varchar_col, false);
+BENCHMARK_CAPTURE(BM_DeserializeRow, text_text_1kb, text_col, false);
+BENCHMARK_CAPTURE(BM_DeserializeRow, text_date, date_col, false);
+BENCHMARK_CAPTURE(BM_DeserializeRow, text_datetime, datetime_col, false);
+BENCHMARK_CAPTURE(BM_DeserializeRow, text_time, time_col, false);
+BENCHMARK_CAPTURE(BM_DeserializeRow, text_null, null_col, false);
+
+BENCHMARK_CAPTURE(BM_DeserializeRow, binary_bigint, bigint_col, true);
+BENCHMARK_CAPTURE(BM_DeserializeRow, binary_bigint_unsigned, bigint_unsigned_col, true);
+BENCHMARK_CAPTURE(BM_DeserializeRow, binary_float, float_col, true);
+BENCHMARK_CAPTURE(BM_DeserializeRow, binary_double, double_col, true);
+BENCHMARK_CAPTURE(BM_DeserializeRow, binary_varchar, varchar_col, true);
+BENCHMARK_CAPTURE(BM_DeserializeRow, binary_text_1kb, text_col, true);
+BENCHMARK_CAPTURE(BM_DeserializeRow, binary_date, date_col, true);
+BENCHMARK_CAPTURE(BM_DeserializeRow, binary_datetime, datetime_col, true);
+BENCHMARK_CAPTURE(BM_DeserializeRow, binary_time, time_col, true);
+BENCHMARK_CAPTURE(BM_DeserializeRow, binary_null, null_col, true);
+
+} // anon namespace
@@ -0,0 +1,127 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <benchmark/benchmark.h>
+#include "boost/mysql/detail/protocol/serialization.hpp"
+#include "boost/mysql/detail/protocol/prepared_statement_messages.hpp"
+#include "boost/mysql/detail/protocol/null_bitmap_traits.hpp"
+#include "boost/mysql/detail/auxiliar/bytestring.hpp"
+#include "test_common.hpp"
+
+using namespace boost::mysql::detail;
+using boost::mysql::value;
+using boost::mysql::test::makedate;
+
+namespace
+{
+
+// Number of values (de)serialized per iteration
+constexpr std::size_t batch_size = 1024;
+
+template <typename T>
+std::vector<std::uint8_t> serialize_batch(const T& input)
+{
+    serialization_context ctx (capabilities(0));
+    std::vector<std::uint8_t> res (get_size(ctx, input) * batch_size);
+    ctx.set_first(res.data());
+    for (std::size_t i = 0; i < batch_size; ++i)
+        serialize(ctx, input);
+    return res;
+}
+
+template <typename T>
+void deserialize_batch(benchmark::State& state, const std::vector<std::uint8_t>& buff)
+{
+    T output;
+    for (auto _ : state)
+    {
+        deserialization_context ctx (boost::asio::buffer(buff), capabilities(0));
+        for (std::size_t i = 0; i < batch_size; ++i)
+        {
+            auto err = deserialize(ctx, output);
+            benchmark::DoNotOptimize(err);
+            benchmark::DoNotOptimize(output);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * batch_size);
+    state.SetBytesProcessed(state.iterations() * buff.size());
+}
+
+// The argument is the value to deserialize. It determines
+// the length of the encoding: 1, 3, 4 or 9 bytes
+void BM_DeserializeIntLenenc(benchmark::State& state)
+{
+    auto buff = serialize_batch(int_lenenc(static_cast<std::uint64_t>(state.range(0))));
+    deserialize_batch<int_lenenc>(state, buff);
+}
+BENCHMARK(BM_DeserializeIntLenenc)->Arg(0xfa)->Arg(0xffff)->Arg(0xffffff)->Arg(0x1000000);
+
+// The argument is the string length
+void BM_DeserializeStringLenenc(benchmark::State& state)
+{
+    std::string contents (static_cast<std::size_t>(state.range(0)), 'a');
+    auto buff = serialize_batch(string_lenenc(contents));
+    deserialize_batch<string_lenenc>(state, buff);
+}
+BENCHMARK(BM_DeserializeStringLenenc)->Arg(8)->Arg(256)->Arg(16384);
+
+// The argument is the number of parameters, of mixed types
+void BM_SerializeStmtExecute(benchmark::State& state)
+{
+    const std::string long_string (64, 'a');
+    const value samples [] {
+        value(std::int64_t(-42)),
+        value(3.14),
+        value("short string"),
+        value(long_string),
+        value(makedate(2020, 10, 4)),
+        value(nullptr)
+    };
+    std::vector<value> params;
+    for (std::int64_t i = 0; i < state.range(0); ++i)
+        params.push_back(samples[i % std::size(samples)]);
+
+    com_stmt_execute_packet<std::vector<value>::const_iterator> packet {
+        int4(1), // statement ID
+        int1(0), // flags
+        int4(1), // iteration count
+        int1(1), // new params flag
+        params.begin(),
+        params.end()
+    };
+    bytestring buffer;
+    for (auto _ : state)
+    {
+        serialize_message(packet, capabilities(0), buffer);
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    state.SetItemsProcessed(state.iterations() * params.size());
+    state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+BENCHMARK(BM_SerializeStmtExecute)->Arg(1)->Arg(8)->Arg(64);
+
+// The argument is the number of fields. Half of them are NULL
+void BM_NullBitmap(benchmark::State& state)
+{
+    auto num_fields = static_cast<std::size_t>(state.range(0));
+    null_bitmap_traits traits (binary_row_null_bitmap_offset, num_fields);
+    std::vector<std::uint8_t> bitmap (traits.byte_count());
+    for (auto _ : state)
+    {
+        std::fill(bitmap.begin(), bitmap.end(), std::uint8_t(0));
+        for (std::size_t i = 0; i < num_fields; i += 2)
+            traits.set_null(bitmap.data(), i);
+        std::size_t num_nulls = 0;
+        for (std::size_t i = 0; i < num_fields; ++i)
+            num_nulls += traits.is_null(bitmap.data(), i);
+        benchmark::DoNotOptimize(num_nulls);
+    }
+    state.SetItemsProcessed(state.iterations() * num_fields);
+}
+BENCHMARK(BM_NullBitmap)->Arg(8)->Arg(64)->Arg(1024);
+
+} // anon namespace
@@ -0,0 +1,40 @@
+#!/bin/bash
+#
+# Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+#
+# Distributed under the Boost Software License, Version 1.0. (See accompanying
+# file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#
+
+# Compares the performance of Boost.Asio's epoll and io_uring backends.
+# Builds mysql_benchmarks twice, with and without BOOST_MYSQL_IO_URING, and runs
+# the benchmarks that perform socket I/O (queries against a fake server over
+# loopback TCP and UNIX sockets). No MySQL server is required.
+#
+# Usage (from the repository root): ci/compare_io_backends.sh [extra CMake options]
+# Results are written to build-epoll/epoll.json and build-io_uring/io_uring.json,
+# and compared using Google Benchmark's compare.py, if BENCHMARK_COMPARE points to it.
+
+set -e
+
+FILTER='BM_Query(Tcp|Unix)'
+
+for BACKEND in epoll io_uring; do
+    mkdir -p build-$BACKEND
+    cmake -S . -B build-$BACKEND \
+        -DCMAKE_BUILD_TYPE=Release \
+        -DBOOST_MYSQL_BENCHMARKS=ON \
+        $(if [ $BACKEND == "io_uring" ]; then echo -DBOOST_MYSQL_IO_URING=ON; fi) \
+        "$@"
+    cmake --build build-$BACKEND --target mysql_benchmarks -j6
+    build-$BACKEND/bench/mysql_benchmarks \
+        --benchmark_filter="$FILTER" \
+        --benchmark_repetitions=5 \
+        --benchmark_report_aggregates_only=true \
+        --benchmark_out=build-$BACKEND/$BACKEND.json \
+        --benchmark_out_format=json
+done
+
+if [ -n "$BENCHMARK_COMPARE" ]; then
+    python3 "$BENCHMARK_COMPARE" benchmarks build-epoll/epoll.json build-io_uring/io_uring.json
+fi
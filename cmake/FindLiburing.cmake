@@ -0,0 +1,29 @@
+#
+# Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+#
+# Distributed under the Boost Software License, Version 1.0. (See accompanying
+# file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#
+
+# Perform the search
+find_path(Liburing_INCLUDE_DIR "liburing.h")
+find_library(Liburing_LIBRARY uring)
+
+# Inform CMake of the results
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(
+    Liburing
+    DEFAULT_MSG
+    Liburing_LIBRARY
+    Liburing_INCLUDE_DIR
+)
+
+if(Liburing_FOUND AND NOT TARGET Liburing::Liburing)
+    add_library(Liburing::Liburing UNKNOWN IMPORTED)
+    set_target_properties(
+        Liburing::Liburing
+        PROPERTIES
+        IMPORTED_LOCATION ${Liburing_LIBRARY}
+        INTERFACE_INCLUDE_DIRECTORIES ${Liburing_INCLUDE_DIR}
+    )
+endif()
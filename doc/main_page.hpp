@@ -18,7 +18,7 @@
  *   go asyncrhonous using callbacks, futures or coroutines.
  * - It is written in modern C++ (C++17) and takes advantage of the latest language
  *   features and standard library additions.
- * - It is header only.
+ * - It is header only, with optional separate compilation.
  *
  * \section building Building
  *
@@ -32,9 +32,17 @@
  *
  * Finally, link your target against the **Boost_mysql** interface library, and you will be done!
  *
+ * To reduce build times and code size, set the BOOST_MYSQL_SEPARATE_COMPILATION CMake
+ * option and link against **Boost_mysql_compiled** instead. This static library contains
+ * the library's non-template code and the connection, resultset and statement templates
+ * for TCP and UNIX sockets, which are then not instantiated by your translation units.
+ * Without CMake, define BOOST_MYSQL_SEPARATE_COMPILATION for your whole program and
+ * include `boost/mysql/src.hpp` in exactly one of its source files.
+ *
  * \section Requirements
  *
  * - C++17 capable compiler (tested with gcc 7.4, clang 7.0, Apple clang 11.0, MSVC 19.25).
+ *   The standard library must provide <memory_resource> (gcc 9, clang 9 with libc++ or MSVC 19.13 and higher).
  * - Boost 1.70 or higher. The following Boost libraries are used:
  *    - Boost.Asio (and in consequence, Boost.System).
  *    - Boost.Beast (implementation dependency, we are working in removing it).
@@ -56,7 +64,50 @@
  * - Authentication methods (authentication plugins): mysql_native_password and
  *   caching_sha2_password. These are the default methods in MySQL 5 and MySQL 8,
  *   respectively.
- * - Encrypted connections (TLS).
+ * - Encrypted connections (TLS), optionally sharing a TLS context between
+ *   connections and resuming TLS sessions (boost::mysql::ssl_session_cache).
+ * - Client-side SQL formatting (boost::mysql::format_sql), which safely escapes
+ *   strings according to the connection's character set and SQL mode.
+ * - Bulk inserts (boost::mysql::batch_inserter), which compose multi-row INSERT
+ *   statements up to a configurable size and send them without extra copies.
+ * - Custom memory allocation: a connection can be given a std::pmr::memory_resource,
+ *   from which network buffers, metadata and row strings are allocated.
+ * - Compact rows (boost::mysql::compact_row), storing each value in 16 bytes,
+ *   to keep large amounts of rows in memory.
+ * - Exact fixed-point arithmetic on DECIMAL values (boost::mysql::decimal),
+ *   with up to 38 digits of precision.
+ * - Constant-time access to row values by field name (boost::mysql::resultset::at),
+ *   with optional compile-time hashed keys (boost::mysql::field_name_key).
+ * - Executing queries and statements into an existing boost::mysql::resultset,
+ *   reusing its memory, so steady-state workloads don't allocate.
+ * - Reading rows in batches (boost::mysql::row_batch_reader), fetching the next
+ *   batch in the background while the current one is processed. Works well with
+ *   C++20 coroutines.
+ * - Opt-in read-ahead (connection::set_read_ahead_size), which reads many
+ *   small rows from the network in a single call, within a memory limit.
+ * - Session state tracking (connection::session): the current schema, changed
+ *   system variables and transaction state, as reported by the server, with no
+ *   extra round trips.
+ * - Metrics and tracing hooks (connection::set_observer): packets, handshake phases,
+ *   and per-command latency split into network and row decoding time, with
+ *   ready-made lock-free histograms (boost::mysql::histogram_observer) and
+ *   OpenTelemetry-style spans (boost::mysql::span_observer).
+ * - Protocol capture (connection::set_capture): records the messages exchanged
+ *   with the server to a compact binary file (boost::mysql::capture_writer),
+ *   which can be replayed offline for performance regression testing.
+ * - Always-on connection counters (connection::stats): bytes, packets, queries,
+ *   statements, decoded rows and time blocked in reads and writes, readable from
+ *   any thread and easy to aggregate across connections (boost::mysql::connection_stats).
+ * - Opt-in resilient connections (boost::mysql::resilient_connection), which
+ *   reconnect with jittered exponential backoff, prepare statements again after
+ *   reconnecting, and retry idempotent operations (boost::mysql::retry_policy).
+ * - Connection pools (boost::mysql::connection_pool) and read/write splitting across
+ *   a primary and its replicas (boost::mysql::replica_router), with round-robin or
+ *   least-outstanding balancing, replica lag checks and optional read-your-writes
+ *   consistency based on GTIDs.
+ * - Thread-per-core support: sharded pools (boost::mysql::sharded_pool) with a
+ *   connection pool per io_context and work stealing between them, and connections
+ *   running in a strand (boost::mysql::tcp_strand_connection).
  *
  * \section tutorial Tutorial
  * This tutorial shows an example of how to use the Boost.MySQL library.
@@ -100,8 +151,15 @@
  * \subsection unix_socket UNIX domain sockets
  * This example demonstrates connecting to a MySQL server over
  * a UNIX domain socket. It employs synchronous functions with
- * exceptions.
+ * exceptions. UNIX sockets are considered secure, as the server does:
+ * TLS is not negotiated unless ssl_mode::require is used.
  * \include unix_socket.cpp
+ *
+ * \subsection multithreading Multi-threaded programs
+ * This example demonstrates running a sharded_pool across an io_context
+ * per thread, and sharing a connection between handlers running in
+ * several threads by means of a strand (tcp_strand_connection).
+ * \include multithreading.cpp
  */
 
 
@@ -0,0 +1,202 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "boost/mysql/mysql.hpp"
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/system/system_error.hpp>
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using boost::mysql::error_code;
+
+/**
+ * For this example, we will be using the 'boost_mysql_examples' database.
+ * You can get this database by running db_setup.sql.
+ * This example assumes you are connecting to a localhost MySQL server.
+ *
+ * Connections are not thread-safe: an operation must complete before
+ * the next one starts, and a connection must not be accessed
+ * concurrently from several threads. This example shows two ways
+ * of using the library from multi-threaded programs:
+ *   - Thread-per-core: each thread runs its own io_context. A sharded_pool
+ *     keeps a connection_pool per io_context (shard), and runs each query in the
+ *     shard of the thread that issued it. Saturated shards hand work to less loaded ones.
+ *   - A single io_context run by several threads: a tcp_strand_connection
+ *     runs all its handlers in a strand, so handlers running in different threads
+ *     never access it concurrently.
+ */
+
+/**
+ * An io_context per thread. Work guards keep the io_contexts running
+ * until join() is called, which waits for the outstanding work.
+ */
+class thread_per_core
+{
+    using guard_type = boost::asio::executor_work_guard<boost::asio::io_context::executor_type>;
+    std::vector<std::unique_ptr<boost::asio::io_context>> contexts_;
+    std::vector<guard_type> guards_;
+    std::vector<std::thread> threads_;
+public:
+    explicit thread_per_core(std::size_t num_threads)
+    {
+        for (std::size_t i = 0; i < num_threads; ++i)
+        {
+            // Concurrency hint of 1: each io_context is only run by one thread
+            contexts_.push_back(std::make_unique<boost::asio::io_context>(1));
+            guards_.push_back(boost::asio::make_work_guard(*contexts_.back()));
+        }
+        for (auto& ctx: contexts_)
+            threads_.emplace_back([&ctx] { ctx->run(); });
+    }
+    thread_per_core(const thread_per_core&) = delete;
+    thread_per_core& operator=(const thread_per_core&) = delete;
+    ~thread_per_core() { join(); }
+
+    std::size_t size() const noexcept { return contexts_.size(); }
+    boost::asio::io_context& context(std::size_t i) { return *contexts_[i]; }
+
+    void join()
+    {
+        guards_.clear();
+        for (auto& t: threads_)
+        {
+            if (t.joinable())
+                t.join();
+        }
+    }
+};
+
+void run_sharded_pool(const boost::asio::ip::tcp::endpoint& ep, const boost::mysql::connection_params& params)
+{
+    thread_per_core threads (std::max(2u, std::thread::hardware_concurrency()));
+
+    // One shard per io_context, with up to 4 connections each
+    std::vector<boost::mysql::tcp_sharded_pool::executor_type> executors;
+    for (std::size_t i = 0; i < threads.size(); ++i)
+        executors.push_back(threads.context(i).get_executor());
+    boost::mysql::pool_options opts;
+    opts.max_size = 4;
+    boost::mysql::tcp_sharded_pool pool (executors, ep, params, opts);
+
+    // Each thread issues some queries. They are served by its own shard,
+    // unless it runs out of connections. Completion handlers run in the
+    // thread that issued the query.
+    std::atomic<int> remaining {static_cast<int>(threads.size()) * 10};
+    std::atomic<int> failed {0};
+    std::promise<void> done;
+    for (std::size_t i = 0; i < threads.size(); ++i)
+    {
+        boost::asio::post(threads.context(i), [&] {
+            for (int j = 0; j < 10; ++j)
+            {
+                pool.async_query("SELECT COUNT(*) FROM employee", [&](error_code err, std::vector<boost::mysql::owning_row>) {
+                    if (err)
+                        ++failed;
+                    if (--remaining == 0)
+                        done.set_value();
+                });
+            }
+        });
+    }
+    done.get_future().wait();
+    threads.join(); // the pool is safe to inspect once no thread runs its shards
+
+    std::cout << "Sharded pool: " << threads.size() << " shards, "
+              << pool.num_stolen() << " queries ran in a non-local shard, "
+              << failed << " queries failed\n";
+    for (std::size_t i = 0; i < pool.num_shards(); ++i)
+        std::cout << "  Shard " << i << ": " << pool.shard(i).size() << " connections\n";
+    if (failed)
+        throw std::runtime_error("Some queries failed");
+}
+
+void run_strand_connection(const boost::asio::ip::tcp::endpoint& ep, const boost::mysql::connection_params& params)
+{
+    boost::asio::io_context ctx;
+    boost::mysql::tcp_strand_connection conn (boost::asio::make_strand(ctx));
+    boost::mysql::resultset<boost::mysql::tcp_strand_socket> result;
+    std::promise<error_code> done;
+
+    // Operations are started from within the strand. Handlers will run
+    // in the strand, too, no matter which thread executes them
+    boost::asio::dispatch(conn.get_executor(), [&] {
+        conn.async_connect(ep, params, [&](error_code err) {
+            if (err)
+                return done.set_value(err);
+            conn.async_query("SELECT first_name FROM employee", [&](error_code err, auto res) {
+                if (err)
+                    return done.set_value(err);
+                result = std::move(res);
+                result.async_fetch_all([&](error_code err, std::vector<boost::mysql::owning_row> rows) {
+                    if (!err)
+                        std::cout << "Strand connection: read " << rows.size() << " employees\n";
+                    conn.async_close([&done, err](error_code close_err) {
+                        done.set_value(err ? err : close_err);
+                    });
+                });
+            });
+        });
+    });
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i)
+        threads.emplace_back([&ctx] { ctx.run(); });
+    for (auto& t: threads)
+        t.join();
+
+    auto err = done.get_future().get();
+    if (err)
+        throw boost::system::system_error(err);
+}
+
+void main_impl(int argc, char** argv)
+{
+    if (argc != 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " <username> <password>\n";
+        exit(1);
+    }
+
+    boost::asio::ip::tcp::endpoint ep (
+        boost::asio::ip::address_v4::loopback(), // host
+        boost::mysql::default_port                 // port
+    );
+    boost::mysql::connection_params params (
+        argv[1],               // username
+        argv[2],               // password
+        "boost_mysql_examples" // database to use; leave empty or omit the parameter for no database
+    );
+
+    run_sharded_pool(ep, params);
+    run_strand_connection(ep, params);
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        main_impl(argc, argv);
+    }
+    catch (const boost::system::system_error& err)
+    {
+        std::cerr << "Error: " << err.what() << ", error code: " << err.code() << std::endl;
+        return 1;
+    }
+    catch (const std::exception& err)
+    {
+        std::cerr << "Error: " << err.what() << std::endl;
+        return 1;
+    }
+}
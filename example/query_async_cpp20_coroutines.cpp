@@ -0,0 +1,148 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "boost/mysql/mysql.hpp"
+#include <boost/asio/io_context.hpp>
+#include <boost/system/system_error.hpp>
+#include <iostream>
+
+/**
+ * For this example, we will be using the 'boost_mysql_examples' database.
+ * You can get this database by running db_setup.sql.
+ * This example assumes you are connecting to a localhost MySQL server.
+ *
+ * This example uses asynchronous functions with C++20 coroutines
+ * (boost::asio::co_spawn and boost::asio::use_awaitable). It requires
+ * a compiler supporting them.
+ *
+ * This example assumes you are already familiar with the basic concepts
+ * of mysql-asio (tcp_connection, resultset, rows, values). If you are not,
+ * please have a look to the query_sync.cpp example.
+ *
+ * Rows are read in batches using boost::mysql::row_batch_reader. Every time
+ * we get a batch, the reader starts fetching the next one in the background,
+ * so reading rows from the network overlaps with processing them.
+ */
+
+#ifdef BOOST_ASIO_HAS_CO_AWAIT
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+using boost::asio::use_awaitable;
+
+void print_employee(const boost::mysql::row& employee)
+{
+    std::cout << "Employee '"
+              << employee.values()[0] << " "                   // first_name (type std::string_view)
+              << employee.values()[1] << "' earns "            // last_name  (type std::string_view)
+              << employee.values()[2] << " dollars yearly\n";  // salary     (type double)
+}
+
+/**
+ * Our coroutine. It must have a return type of boost::asio::awaitable<T>.
+ * Our coroutine does not communicate any result back, so T=void.
+ * Errors are reported by throwing exceptions of type boost::system::system_error.
+ * Additional diagnostics sent by the server, if any, are lost.
+ */
+boost::asio::awaitable<void> coro_main(
+    boost::mysql::tcp_connection& conn,
+    const boost::asio::ip::tcp::endpoint& ep,
+    const boost::mysql::connection_params& params
+)
+{
+    // Connect to server
+    co_await conn.async_connect(ep, params, use_awaitable);
+
+    // Issue the query to the server
+    const char* sql = "SELECT first_name, last_name, salary FROM employee";
+    boost::mysql::tcp_resultset result = co_await conn.async_query(sql, use_awaitable);
+
+    /**
+     * Read the rows in batches of at most 2 rows (use bigger batches in real code).
+     * An empty batch means that there are no more rows. The rows in a batch remain
+     * valid as long as the resultset is alive.
+     */
+    boost::mysql::row_batch_reader<boost::asio::ip::tcp::socket> reader (result, 2);
+    while (true)
+    {
+        std::vector<boost::mysql::owning_row> batch = co_await reader.async_read_batch(use_awaitable);
+        if (batch.empty()) break; // No more rows available
+        for (const auto& employee: batch)
+            print_employee(employee);
+    }
+
+    // Notify the MySQL server we want to quit, then close the underlying connection.
+    co_await conn.async_close(use_awaitable);
+}
+
+void main_impl(int argc, char** argv)
+{
+    if (argc != 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " <username> <password>\n";
+        exit(1);
+    }
+
+    // Context and connections
+    boost::asio::io_context ctx;
+    boost::mysql::tcp_connection conn (ctx);
+
+    boost::asio::ip::tcp::endpoint ep (
+        boost::asio::ip::address_v4::loopback(), // host
+        boost::mysql::default_port                 // port
+    );
+    boost::mysql::connection_params params (
+        argv[1],               // username
+        argv[2],               // password
+        "boost_mysql_examples" // database to use; leave empty or omit the parameter for no database
+    );
+
+    /**
+     * The entry point. We spawn the coroutine using boost::asio::co_spawn.
+     * It will actually start running when we call io_context::run().
+     * Exceptions thrown by the coroutine are rethrown by io_context::run(),
+     * as we pass a completion handler that rethrows them.
+     */
+    boost::asio::co_spawn(ctx.get_executor(), coro_main(conn, ep, params), [](std::exception_ptr ptr) {
+        if (ptr)
+        {
+            std::rethrow_exception(ptr);
+        }
+    });
+
+    // Don't forget to call run()! Otherwise, your program
+    // will not spawn the coroutine and will do nothing.
+    ctx.run();
+}
+
+#else
+
+void main_impl(int, char**)
+{
+    std::cout << "Sorry, your compiler does not support C++20 coroutines" << std::endl;
+}
+
+#endif
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        main_impl(argc, argv);
+    }
+    catch (const boost::system::system_error& err)
+    {
+        std::cerr << "Error: " << err.what() << ", error code: " << err.code() << std::endl;
+        return 1;
+    }
+    catch (const std::exception& err)
+    {
+        std::cerr << "Error: " << err.what() << std::endl;
+        return 1;
+    }
+}
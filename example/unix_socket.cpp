@@ -60,10 +60,10 @@ void main_impl(int argc, char** argv)
         argv[2],               // password
         "boost_mysql_examples" // database to use; leave empty or omit the parameter for no database
     );
-    // Note: by default, SSL will be used if the server supports it.
-    // connection_params accepts an optional ssl_options argument
-    // determining whether to use SSL or not. See ssl_options and ssl_mode
-    // documentation for further details on SSL.
+    // Note: UNIX sockets are considered secure, so SSL is not used
+    // by default (ssl_mode::enable), even if the server supports it.
+    // Use ssl_mode::require in an ssl_options argument to force it.
+    // See ssl_options and ssl_mode documentation for further details on SSL.
 
     boost::asio::io_context ctx;
 
@@ -0,0 +1,195 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_BATCH_INSERTER_HPP
+#define BOOST_MYSQL_BATCH_INSERTER_HPP
+
+#include "boost/mysql/format_sql.hpp"
+#include "boost/mysql/resultset.hpp"
+#include "boost/mysql/detail/protocol/channel.hpp"
+#include "boost/mysql/detail/auxiliar/async_result_macro.hpp"
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <string>
+
+namespace boost {
+namespace mysql {
+
+/**
+ * \ingroup format
+ * \brief Default maximum size of the statements composed by a batch_inserter.
+ * \details Matches the default value of the server's max_allowed_packet variable
+ * in MySQL 5.7. MySQL 8.0 defaults to 64MB.
+ */
+constexpr std::size_t default_batch_max_size = 4 * 1024 * 1024;
+
+/**
+ * \ingroup format
+ * \brief Composes and executes multi-row INSERT statements.
+ * \details A batch_inserter accumulates rows into a single
+ * `INSERT ... VALUES (...),(...),...` statement, and sends it to the
+ * server whenever adding a new row would make the statement bigger
+ * than max_size(). Use connection::make_batch_inserter to create one.
+ *
+ * Rows are composed as SQL text, using the same rules as format_sql,
+ * directly into the buffer that is sent to the server as a COM_QUERY
+ * command. This buffer is kept between flushes, so no allocations happen
+ * once it reaches its maximum size.
+ *
+ * max_size() should not exceed the server's max_allowed_packet variable
+ * (minus some bytes for the protocol overhead). A single row bigger
+ * than max_size() is sent alone in its own statement.
+ *
+ * Adding a row may involve communicating with the server, so the same
+ * considerations as for connection::query apply: no other operation
+ * may be in progress on the connection when calling add_row or flush.
+ * Remember to call flush once all rows have been added.
+ *
+ * Batch inserters are default-constructible. A default-constructed batch inserter
+ * has valid() == false. It is undefined to call any member function on an invalid
+ * batch inserter, other than assignment.
+ */
+template <typename Stream>
+class batch_inserter
+{
+    detail::channel<Stream>* channel_ {};
+    format_options opts_;
+    std::size_t max_size_ {};
+    std::size_t prefix_size_ {};
+    std::size_t num_rows_ {};
+    std::uint64_t affected_rows_ {};
+    std::string buffer_; // COM_QUERY payload: command byte, INSERT prefix and rows
+
+    template <typename ForwardIterator>
+    std::size_t append_row(ForwardIterator first, ForwardIterator last, error_code& err, error_info& info);
+
+    void on_flushed(std::size_t sent_size, const resultset<Stream>& result);
+    void flush_impl(std::size_t size_to_send, error_code& err, error_info& info);
+
+    template <typename CompletionToken>
+    auto async_flush_impl(std::size_t size_to_send, error_code err,
+            CompletionToken&& token, error_info* info);
+
+    struct flush_op;
+public:
+    /// Default constructor.
+    batch_inserter() = default;
+
+    // Private. Do not use.
+    batch_inserter(
+        detail::channel<Stream>& chan,
+        std::string_view insert_prefix,
+        const format_options& opts,
+        std::size_t max_size
+    );
+
+    /// Returns true if the object is not default-constructed.
+    bool valid() const noexcept { return channel_ != nullptr; }
+
+    /// The maximum size, in bytes, of the statements sent to the server.
+    std::size_t max_size() const noexcept { return max_size_; }
+
+    /// The number of rows that have been added but not sent to the server yet.
+    std::size_t pending_rows() const noexcept { return num_rows_; }
+
+    /// The number of rows affected by all the statements sent to the server.
+    std::uint64_t affected_rows() const noexcept { return affected_rows_; }
+
+    /**
+     * \brief Adds a row to the batch (iterator, sync with error code version).
+     * \details The range [first, last) should contain the values for the row's
+     * fields, as boost::mysql::value's or types convertible to them.
+     * If the row does not fit in the current statement, the rows added
+     * previously are sent to the server before returning.
+     */
+    template <typename ForwardIterator>
+    void add_row(ForwardIterator first, ForwardIterator last, error_code& err, error_info& info);
+
+    /// Adds a row to the batch (iterator, sync with exceptions version).
+    template <typename ForwardIterator>
+    void add_row(ForwardIterator first, ForwardIterator last);
+
+    /// Adds a row to the batch (collection, sync with error code version).
+    template <typename Collection>
+    void add_row(const Collection& values, error_code& err, error_info& info)
+    {
+        add_row(std::begin(values), std::end(values), err, info);
+    }
+
+    /// Adds a row to the batch (collection, sync with exceptions version).
+    template <typename Collection>
+    void add_row(const Collection& values)
+    {
+        add_row(std::begin(values), std::end(values));
+    }
+
+    /// Handler signature for batch_inserter::async_add_row.
+    using add_row_signature = void(error_code);
+
+    /**
+     * \brief Adds a row to the batch (iterator, async version).
+     * \details It is **not** necessary to keep the values alive
+     * until the operation completes. The batch_inserter must be kept alive.
+     */
+    template <typename ForwardIterator, typename CompletionToken>
+    BOOST_MYSQL_INITFN_RESULT_TYPE(CompletionToken, add_row_signature)
+    async_add_row(ForwardIterator first, ForwardIterator last,
+            CompletionToken&& token, error_info* info=nullptr);
+
+    /// Adds a row to the batch (collection, async version).
+    template <typename Collection, typename CompletionToken>
+    BOOST_MYSQL_INITFN_RESULT_TYPE(CompletionToken, add_row_signature)
+    async_add_row(const Collection& values, CompletionToken&& token, error_info* info=nullptr)
+    {
+        return async_add_row(
+            std::begin(values),
+            std::end(values),
+            std::forward<CompletionToken>(token),
+            info
+        );
+    }
+
+    /**
+     * \brief Sends any pending rows to the server (sync with error code version).
+     * \details Does nothing if there are no pending rows.
+     */
+    void flush(error_code& err, error_info& info);
+
+    /// Sends any pending rows to the server (sync with exceptions version).
+    void flush();
+
+    /// Handler signature for batch_inserter::async_flush.
+    using flush_signature = void(error_code);
+
+    /// Sends any pending rows to the server (async version).
+    template <typename CompletionToken>
+    BOOST_MYSQL_INITFN_RESULT_TYPE(CompletionToken, flush_signature)
+    async_flush(CompletionToken&& token, error_info* info=nullptr);
+};
+
+/**
+ * \ingroup format
+ * \brief Specialization of a batch_inserter associated with a boost::mysql::tcp_connection.
+ */
+using tcp_batch_inserter = batch_inserter<boost::asio::ip::tcp::socket>;
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS) || defined(BOOST_MYSQL_DOXYGEN)
+
+/**
+ * \ingroup format
+ * \brief Specialization of a batch_inserter associated with a boost::mysql::unix_connection.
+ */
+using unix_batch_inserter = batch_inserter<boost::asio::local::stream_protocol::socket>;
+
+#endif
+
+} // mysql
+} // boost
+
+#include "boost/mysql/impl/batch_inserter.hpp"
+
+#endif
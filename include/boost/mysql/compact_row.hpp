@@ -0,0 +1,125 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_COMPACT_ROW_HPP
+#define BOOST_MYSQL_COMPACT_ROW_HPP
+
+#include "boost/mysql/compact_value.hpp"
+#include "boost/mysql/row.hpp"
+#include "boost/mysql/detail/auxiliar/bytestring.hpp"
+#include "boost/mysql/detail/auxiliar/resource_allocator.hpp"
+#include <vector>
+
+namespace boost {
+namespace mysql {
+
+/**
+ * \ingroup resultsets
+ * \brief An owning row that stores its values as compact_value's.
+ * \details Holds the same information as an owning_row, using less
+ * memory: each value takes 16 bytes instead of 24. Use it to keep
+ * large amounts of rows in memory. Values are converted back to
+ * boost::mysql::value when accessed, which is cheap.
+ *
+ * A compact_row is created by moving an owning_row into it.
+ * Memory is taken over from the owning_row, so no allocations are
+ * performed unless the owning_row has string values pointing to memory
+ * it doesn't own. In this case, these strings are copied into
+ * the compact_row. To compact a whole resultset:
+ * \code
+ * auto rows = result.fetch_all();
+ * std::vector<compact_row> compacted (
+ *     std::make_move_iterator(rows.begin()),
+ *     std::make_move_iterator(rows.end())
+ * );
+ * \endcode
+ *
+ * Default constructible and movable, but not copyable.
+ */
+class compact_row
+{
+    detail::resource_bytestring buffer_;
+    std::vector<compact_value, detail::resource_allocator<compact_value>> values_;
+public:
+    /// Constructs an empty row.
+    compact_row() = default;
+
+    /// Constructs a compact_row by taking ownership of the memory of r.
+    explicit compact_row(owning_row&& r);
+
+    compact_row(const compact_row&) = delete;
+    compact_row(compact_row&&) = default;
+    compact_row& operator=(const compact_row&) = delete;
+    compact_row& operator=(compact_row&&) = default;
+    ~compact_row() = default;
+
+    /// The number of values in the row.
+    std::size_t size() const noexcept { return values_.size(); }
+
+    /// Returns true if the row has no values.
+    bool empty() const noexcept { return values_.empty(); }
+
+    /**
+     * \brief Returns the i-th value in the row.
+     * \details String values point into memory owned by *this.
+     * Precondition: i < size().
+     */
+    value operator[](std::size_t i) const noexcept { return values_[i].to_value(buffer_.data()); }
+
+    /// Returns the i-th value in the row, or throws std::out_of_range if i >= size().
+    value at(std::size_t i) const { return values_.at(i).to_value(buffer_.data()); }
+
+    /// Returns the compact representation of the values.
+    const std::vector<compact_value, detail::resource_allocator<compact_value>>&
+    compact_values() const noexcept { return values_; }
+
+    /**
+     * \brief Converts the row to a (non-owning) boost::mysql::row.
+     * \details String values in the returned row point into memory owned by *this.
+     */
+    row to_row() const;
+};
+
+/**
+ * \relates compact_row
+ * \brief Compares two rows.
+ */
+inline bool operator==(const compact_row& lhs, const compact_row& rhs);
+
+/**
+ * \relates compact_row
+ * \brief Compares two rows.
+ */
+inline bool operator!=(const compact_row& lhs, const compact_row& rhs) { return !(lhs == rhs); }
+
+/**
+ * \relates compact_row
+ * \brief Compares a compact_row with a row.
+ */
+inline bool operator==(const compact_row& lhs, const row& rhs);
+
+/**
+ * \relates compact_row
+ * \brief Compares a compact_row with a row.
+ */
+inline bool operator!=(const compact_row& lhs, const row& rhs) { return !(lhs == rhs); }
+
+/**
+ * \relates compact_row
+ * \brief Streams a compact_row.
+ */
+inline std::ostream& operator<<(std::ostream& os, const compact_row& value)
+{
+    return os << value.to_row();
+}
+
+} // mysql
+} // boost
+
+#include "boost/mysql/impl/compact_row.hpp"
+
+#endif
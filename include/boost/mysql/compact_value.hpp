@@ -0,0 +1,81 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_COMPACT_VALUE_HPP
+#define BOOST_MYSQL_COMPACT_VALUE_HPP
+
+#include "boost/mysql/value.hpp"
+#include <cstdint>
+
+namespace boost {
+namespace mysql {
+
+/**
+ * \ingroup values
+ * \brief A 16 byte representation of a boost::mysql::value.
+ * \details A compact_value holds a type tag and a 64-bit payload.
+ * Contrary to value, strings are not represented as pointers, but as
+ * a 32-bit offset and a 32-bit length, relative to a base pointer
+ * supplied by the user (typically, the beginning of the buffer owned
+ * by a compact_row). This makes it smaller than value (16 vs 24 bytes
+ * in 64-bit systems) and trivially relocatable together with its buffer.
+ *
+ * Conversions from and to value are cheap (no allocations or visitation).
+ * You will usually not use this class directly, but through compact_row.
+ */
+class compact_value
+{
+public:
+    /// The type of the stored value. Alternatives match value::variant_type.
+    enum class kind : std::uint8_t
+    {
+        null,     ///< std::nullptr_t
+        int64,    ///< std::int64_t
+        uint64,   ///< std::uint64_t
+        string,   ///< std::string_view
+        float_,   ///< float
+        double_,  ///< double
+        date,     ///< boost::mysql::date
+        datetime, ///< boost::mysql::datetime
+        time      ///< boost::mysql::time
+    };
+
+    /// Constructs a NULL value.
+    constexpr compact_value() noexcept = default;
+
+    /**
+     * \brief Creates a compact_value from a value.
+     * \details If v is a string, it must be contained in the 4GB range starting
+     * at base, and the same base must be passed to to_value.
+     */
+    static compact_value from_value(const value& v, const std::uint8_t* base) noexcept;
+
+    /// Returns the type of the stored value.
+    constexpr kind type() const noexcept { return kind_; }
+
+    /// Checks if the value is NULL.
+    constexpr bool is_null() const noexcept { return kind_ == kind::null; }
+
+    /**
+     * \brief Converts *this to a value.
+     * \details base should be the same pointer that was passed to from_value,
+     * or point to a copy of the same buffer.
+     */
+    value to_value(const std::uint8_t* base) const noexcept;
+private:
+    std::uint64_t payload_ {};
+    kind kind_ {kind::null};
+
+    constexpr compact_value(kind k, std::uint64_t payload) noexcept: payload_(payload), kind_(k) {}
+};
+
+} // mysql
+} // boost
+
+#include "boost/mysql/impl/compact_value.hpp"
+
+#endif
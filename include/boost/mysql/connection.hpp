@@ -12,12 +12,25 @@
 #include "boost/mysql/detail/protocol/protocol_types.hpp"
 #include "boost/mysql/detail/network_algorithms/handshake.hpp"
 #include "boost/mysql/detail/auxiliar/async_result_macro.hpp"
+#include "boost/mysql/detail/auxiliar/tmp.hpp"
 #include "boost/mysql/error.hpp"
 #include "boost/mysql/resultset.hpp"
 #include "boost/mysql/prepared_statement.hpp"
 #include "boost/mysql/connection_params.hpp"
+#include "boost/mysql/session_state.hpp"
+#include "boost/mysql/connection_observer.hpp"
+#include "boost/mysql/protocol_capture.hpp"
+#include "boost/mysql/connection_stats.hpp"
+#include "boost/mysql/format_sql.hpp"
+#include "boost/mysql/batch_inserter.hpp"
+#include <boost/asio/io_context.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/version.hpp>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
 
 /**
  * \defgroup connection Connection
@@ -75,19 +88,58 @@ public:
      * \brief Initializing constructor.
      * \details Creates a Stream object by forwarding any passed in arguments to its constructor.
      */
-    template <typename... Args>
+    template <
+        typename... Args,
+        typename=std::enable_if_t<!detail::starts_with_allocator_arg<Args...>::value>
+    >
     connection(Args&&... args) :
         next_layer_(std::forward<Args>(args)...),
         channel_(next_layer_)
     {
     }
 
+    /// The type of the allocator used for the memory allocated by the connection.
+    using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+    /**
+     * \brief Initializing constructor, with a custom memory resource.
+     * \details Creates a Stream object by forwarding args to its constructor.
+     * Buffers allocated by the connection, the resultsets and the rows it
+     * produces (network buffers, metadata and the strings in rows) will
+     * obtain their memory from alloc's memory resource, which must
+     * outlive the connection and all these objects.
+     *
+     * The containers exposed by the public API still use std::allocator:
+     * the std::vector<value> in each row (row::values()) and the
+     * std::vector<owning_row> returned by resultset::fetch_many and
+     * resultset::fetch_all. Use compact_row to keep rows whose values are
+     * allocated from the memory resource, too.
+     *
+     * As any std::pmr::memory_resource* is convertible to allocator_type,
+     * you can write `connection(std::allocator_arg, &pool, ctx)`.
+     */
+    template <typename... Args>
+    connection(std::allocator_arg_t, const allocator_type& alloc, Args&&... args) :
+        next_layer_(std::forward<Args>(args)...),
+        channel_(next_layer_, alloc.resource())
+    {
+    }
+
+    /// Returns an allocator using the memory resource passed to the constructor (or the default one).
+    allocator_type get_allocator() const noexcept { return allocator_type(channel_.memory_resource()); }
+
     /// Retrieves the underlying Stream object.
     Stream& next_layer() { return next_layer_; }
 
     /// Retrieves the underlying Stream object.
     const Stream& next_layer() const { return next_layer_; }
 
+    /// The executor type associated to this connection.
+    using executor_type = typename Stream::executor_type;
+
+    /// Retrieves the executor associated to this connection (the one of the underlying Stream).
+    executor_type get_executor() { return next_layer_.get_executor(); }
+
     /**
      * \brief Returns whether the connection uses SSL or not.
      * \details Will always return false for connections that haven't been
@@ -100,6 +152,87 @@ public:
      */
     bool uses_ssl() const noexcept { return channel_.ssl_active(); }
 
+    /**
+     * \brief Enables reading ahead from the stream, requesting up to max_bytes per read.
+     * \details Messages are read in two steps (header and body). By default,
+     * each step reads exactly the bytes it needs from the stream, which takes
+     * two read calls (two system calls for sockets) per row in a resultset.
+     * With read-ahead enabled, steps smaller than max_bytes read as many
+     * bytes as are available, up to max_bytes, into a buffer owned by the connection.
+     * Subsequent steps are served from this buffer, without touching the stream,
+     * so many small rows can be obtained in a single read call. This benefits
+     * resultset::fetch_one and resultset::async_fetch_one the most.
+     *
+     * At most max_bytes are kept in memory, allocated from the connection's memory resource.
+     * Messages bigger than max_bytes bypass the buffer. Passing 0 (the default)
+     * disables read-ahead. A value of 16KB or 64KB is usually a good choice.
+     *
+     * A new value takes effect the next time the buffer is found empty,
+     * so this function can be called at any time, e.g. before handshake
+     * or before reading a big resultset.
+     */
+    void set_read_ahead_size(std::size_t max_bytes) noexcept { channel_.set_read_ahead_size(max_bytes); }
+
+    /// Returns the maximum number of bytes requested per read (see set_read_ahead_size).
+    std::size_t read_ahead_size() const noexcept { return channel_.read_ahead_size(); }
+
+    /**
+     * \brief Sets an object to be notified of the operations performed by this connection.
+     * \details Pass nullptr (the default) to stop notifications. The connection
+     * doesn't take ownership of the observer, which must be kept alive until it is
+     * replaced or the connection is destroyed. Call this function only when no
+     * operation is outstanding. See connection_observer for the notifications.
+     */
+    void set_observer(connection_observer* observer) noexcept { channel_.set_observer(observer); }
+
+    /// Returns the object set by set_observer, or nullptr.
+    connection_observer* observer() const noexcept { return channel_.observer(); }
+
+    /**
+     * \brief Sets an object to record the messages exchanged by this connection.
+     * \details Pass nullptr (the default) to stop recording. The connection doesn't
+     * take ownership of the writer, which must be kept alive until it is replaced
+     * or the connection is destroyed. Call this function only when no operation is
+     * outstanding, and before the handshake if the capture is to be replayed.
+     * See capture_writer for more info.
+     */
+    void set_capture(capture_writer* writer) noexcept { channel_.set_capture(writer); }
+
+    /// Returns the object set by set_capture, or nullptr.
+    capture_writer* capture() const noexcept { return channel_.capture(); }
+
+    /**
+     * \brief Returns a snapshot of the counters kept by this connection.
+     * \details Counters are always kept, and updated using relaxed atomic operations,
+     * so this function can be called from any thread, even while an operation
+     * is outstanding (e.g. by a pool aggregating the stats of its connections).
+     * Counters updated concurrently with the call may or may not be reflected,
+     * so the returned values are not necessarily consistent with each other.
+     * See connection_stats for what gets counted.
+     */
+    connection_stats stats() const noexcept { return channel_.stats(); }
+
+    /**
+     * \brief Returns the session state, as reported by the server.
+     * \details The state is reset on handshake and updated every time the server
+     * sends an OK packet (i.e. when an operation completes), so it reflects the
+     * effect of the last completed statement. This allows skipping statements like
+     * `USE db` or `SET autocommit=1` when the session is already in the desired state.
+     * See session_state for what gets tracked.
+     */
+    const session_state& session() const noexcept { return channel_.current_session(); }
+
+    /**
+     * \brief Returns the options to pass to format_sql to compose queries for this connection.
+     * \details The returned object reflects the connection's character set and whether
+     * the server has the NO_BACKSLASH_ESCAPES SQL mode enabled, as reported by the
+     * last OK packet received from the server. Call this function again after any
+     * statement that may modify sql_mode, rather than caching its result.
+     *
+     * Only valid for connections that have already been established.
+     */
+    format_options format_opts() const noexcept;
+
     /// Performs the MySQL-level handshake (synchronous with error code version).
     void handshake(const connection_params& params, error_code& ec, error_info& info);
 
@@ -145,6 +278,35 @@ public:
     BOOST_MYSQL_INITFN_RESULT_TYPE(CompletionToken, query_signature)
     async_query(std::string_view query_string, CompletionToken&& token, error_info* info=nullptr);
 
+    /**
+     * \brief Executes a SQL text query into an existing resultset (sync with error code version).
+     * \details Like the other overloads, but output is overwritten instead of
+     * returning a new resultset. The memory output owns (network buffers,
+     * metadata and the row returned by resultset::fetch_one) is reused, so
+     * running many queries into the same resultset stops allocating memory
+     * once its buffers are big enough.
+     *
+     * output may be a default-constructed resultset or one that has been completely read.
+     * Rows previously returned by output.fetch_one() are invalidated. If the operation
+     * fails, output is left invalid (see resultset::valid).
+     */
+    void query(std::string_view query_string, resultset<Stream>& output, error_code&, error_info&);
+
+    /// Executes a SQL text query into an existing resultset (sync with exceptions version).
+    void query(std::string_view query_string, resultset<Stream>& output);
+
+    /// Handler signature for connection::async_query with an output resultset.
+    using query_into_signature = void(error_code);
+
+    /**
+     * \brief Executes a SQL text query into an existing resultset (async version).
+     * \details output must be kept alive until the operation completes.
+     */
+    template <typename CompletionToken>
+    BOOST_MYSQL_INITFN_RESULT_TYPE(CompletionToken, query_into_signature)
+    async_query(std::string_view query_string, resultset<Stream>& output,
+            CompletionToken&& token, error_info* info=nullptr);
+
     /**
      * \brief Prepares a statement in the server (sync with error code version).
      * \details Instructs the server to create a prepared statement. The passed
@@ -169,6 +331,23 @@ public:
     BOOST_MYSQL_INITFN_RESULT_TYPE(CompletionToken, prepare_statement_signature)
     async_prepare_statement(std::string_view statement, CompletionToken&& token, error_info* info=nullptr);
 
+    /**
+     * \brief Creates a batch_inserter to execute multi-row INSERT statements over this connection.
+     * \details insert_prefix should be the statement up to the VALUES keyword, included
+     * (e.g. "INSERT INTO my_table (id, name) VALUES"). Rows will be appended to it.
+     * Values are formatted using the options returned by connection::format_opts at the
+     * time of this call. This function does not involve any communication with the server.
+     *
+     * The returned object is only valid while this connection is alive and open.
+     */
+    batch_inserter<Stream> make_batch_inserter(
+        std::string_view insert_prefix,
+        std::size_t max_size = default_batch_max_size
+    )
+    {
+        return batch_inserter<Stream>(channel_, insert_prefix, format_opts(), max_size);
+    }
+
     /**
      * \brief Notifies the MySQL server that we want to end the session and quit the connection
      * (sync with error code version).
@@ -281,11 +460,44 @@ public:
  */
 using tcp_connection = socket_connection<boost::asio::ip::tcp::socket>;
 
+/**
+ * \ingroup connection
+ * \brief A TCP socket whose executor is a strand.
+ * \details The strand wraps a boost::asio::any_io_executor. Before Boost 1.74, which
+ * lacks it, it wraps a boost::asio::io_context::executor_type.
+ */
+#if BOOST_VERSION >= 107400
+using tcp_strand_socket = boost::asio::basic_stream_socket<
+    boost::asio::ip::tcp,
+    boost::asio::strand<boost::asio::any_io_executor>
+>;
+#else
+using tcp_strand_socket = boost::asio::basic_stream_socket<
+    boost::asio::ip::tcp,
+    boost::asio::strand<boost::asio::io_context::executor_type>
+>;
+#endif
+
+/**
+ * \ingroup connection
+ * \brief A connection to MySQL over a TCP socket, whose operations run in a strand.
+ * \details Construct it from a strand, e.g. `tcp_strand_connection conn (boost::asio::make_strand(ctx))`.
+ * Connections are not thread-safe, but the intermediate handlers of this one, and
+ * completion handlers without an associated executor, run in the strand. This allows sharing
+ * a connection between handlers running in several threads of an io_context, as long as
+ * operations are started from within the strand (e.g. using boost::asio::dispatch
+ * on get_executor()) and one at a time, as with any other connection.
+ */
+using tcp_strand_connection = socket_connection<tcp_strand_socket>;
+
 #if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS) || defined(BOOST_MYSQL_DOXYGEN)
 
 /**
  * \ingroup connection
  * \brief A connection to MySQL over a UNIX domain socket.
+ * \details UNIX sockets are considered secure, as the server does.
+ * ssl_mode::enable does not negotiate TLS over them (only ssl_mode::require does),
+ * and caching_sha2_password can perform full authentication without TLS.
  */
 using unix_connection = socket_connection<boost::asio::local::stream_protocol::socket>;
 
@@ -302,4 +514,24 @@ constexpr unsigned short default_port = 3306;
 
 #include "boost/mysql/impl/connection.hpp"
 
+#ifdef BOOST_MYSQL_SEPARATE_COMPILATION
+
+// Instantiated once, by boost/mysql/src.hpp
+#define BOOST_MYSQL_EXTERN_STREAM(Stream) \
+    extern template class boost::mysql::detail::channel<Stream>; \
+    extern template class boost::mysql::connection<Stream>; \
+    extern template class boost::mysql::socket_connection<Stream>; \
+    extern template class boost::mysql::resultset<Stream>; \
+    extern template class boost::mysql::prepared_statement<Stream>; \
+    extern template class boost::mysql::batch_inserter<Stream>;
+
+BOOST_MYSQL_EXTERN_STREAM(boost::asio::ip::tcp::socket)
+#ifdef BOOST_ASIO_HAS_LOCAL_SOCKETS
+BOOST_MYSQL_EXTERN_STREAM(boost::asio::local::stream_protocol::socket)
+#endif
+
+#undef BOOST_MYSQL_EXTERN_STREAM
+
+#endif
+
 #endif
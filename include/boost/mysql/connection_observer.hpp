@@ -0,0 +1,174 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_CONNECTION_OBSERVER_HPP
+#define BOOST_MYSQL_CONNECTION_OBSERVER_HPP
+
+#include "boost/mysql/error.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * \defgroup observability Metrics and tracing
+ * \brief Classes and functions to observe the operations performed
+ * by a connection, for metrics and tracing purposes.
+ */
+
+namespace boost {
+namespace mysql {
+
+/**
+ * \ingroup observability
+ * \brief The commands a connection sends to the server.
+ * \details The enumerator values are the command bytes used by the protocol.
+ */
+enum class command_type : std::uint8_t
+{
+    quit = 0x01,            ///< Ending the session (connection::quit).
+    query = 0x03,           ///< A text query (connection::query).
+    prepare = 0x16,         ///< Preparing a statement (connection::prepare_statement).
+    execute = 0x17,         ///< Executing a prepared statement (prepared_statement::execute).
+    close_statement = 0x19  ///< Deallocating a prepared statement (prepared_statement::close).
+};
+
+/**
+ * \ingroup observability
+ * \brief The steps of the handshake with the server, in the order they happen.
+ * \details Steps that don't apply to a given connection (like TLS for unencrypted
+ * connections) are not reported.
+ */
+enum class handshake_phase
+{
+    greeting_received, ///< The server greeting has been read and processed.
+    tls_established,   ///< The TLS handshake has completed.
+    auth_round_trip,   ///< The server requested more authentication data, which has been sent.
+    authenticated      ///< The server accepted the credentials. The handshake is complete.
+};
+
+/**
+ * \ingroup observability
+ * \brief Measurements for a single command, reported when it completes.
+ * \details A command is complete when its entire response has been read. For
+ * queries and statements returning rows, this is when the last row is read
+ * (or discarded), so elapsed includes any time the application spends between
+ * fetches. Byte counts include packet headers, but not any TLS overhead.
+ */
+struct command_stats
+{
+    /// The command.
+    command_type type {command_type::query};
+
+    /// The normalized SQL text (see sql_digest). Empty for commands without SQL text, like execute.
+    std::string_view sql_digest;
+
+    /// The number of rows read. Rows discarded by resultset::discard_remaining are not counted.
+    std::size_t num_rows {0};
+
+    /// The number of bytes sent to the server.
+    std::size_t bytes_written {0};
+
+    /// The number of bytes received from the server.
+    std::size_t bytes_read {0};
+
+    /// Time since the command started until its response was complete.
+    std::chrono::nanoseconds elapsed {0};
+
+    /// Time spent deserializing rows.
+    std::chrono::nanoseconds decode_time {0};
+
+    /**
+     * \brief Time not spent deserializing rows.
+     * \details That is, time spent serializing the request, waiting for the
+     * server and the network, and processing metadata, plus the time the
+     * application spends between fetches.
+     */
+    std::chrono::nanoseconds network_time() const noexcept { return elapsed - decode_time; }
+};
+
+/**
+ * \ingroup observability
+ * \brief Receives notifications about the operations performed by a connection.
+ * \details Derive from this class, override the functions for the events
+ * you are interested in, and pass a pointer to your object to
+ * connection::set_observer. All functions do nothing by default.
+ *
+ * Functions are called synchronously, from within the connection operations,
+ * so they should be fast and must not throw. Connections without an observer
+ * (the default) don't compute any of these measurements.
+ *
+ * A command is reported by on_command_start and, once its response is complete
+ * or an error happens, on_command_end. If an operation is started before the
+ * response to the previous one is complete (which is a usage error), the
+ * previous command is not reported as complete.
+ *
+ * An observer may be shared by several connections, as long as its functions
+ * are safe to call concurrently if the connections are used from several threads.
+ * histogram_observer and span_observer are ready-made implementations.
+ */
+class connection_observer
+{
+public:
+    virtual ~connection_observer() = default;
+
+    /// Called after reading a message. bytes includes packet headers.
+    virtual void on_packet_read(std::size_t /* bytes */) {}
+
+    /// Called after writing a message. bytes includes packet headers.
+    virtual void on_packet_written(std::size_t /* bytes */) {}
+
+    /// Called as the handshake advances.
+    virtual void on_handshake_phase(handshake_phase /* phase */) {}
+
+    /// Called before sending a command to the server. sql_digest is only valid during the call.
+    virtual void on_command_start(command_type /* type */, std::string_view /* sql_digest */) {}
+
+    /// Called after a row has been read and deserialized, with the time spent deserializing it.
+    virtual void on_row_decoded(std::chrono::nanoseconds /* decode_time */) {}
+
+    /**
+     * \brief Called when a command completes, successfully or not.
+     * \details err contains the error that made the command fail, if any.
+     * stats is only valid during the call.
+     */
+    virtual void on_command_end(const command_stats& /* stats */, error_code /* err */) {}
+};
+
+/**
+ * \ingroup observability
+ * \brief Computes a normalized form of a SQL statement, to name spans and group metrics.
+ * \details String, numeric, hexadecimal and bit literals are replaced by `?`,
+ * comments are removed and runs of whitespace are collapsed into a single space.
+ * Identifiers (including backtick-quoted ones) and keywords are kept as they are.
+ * For example, `SELECT *  FROM t WHERE id = 42 AND name = 'x'` becomes
+ * `SELECT * FROM t WHERE id = ? AND name = ?`.
+ *
+ * Double-quoted text is considered a string literal, as is the case unless the
+ * server has the ANSI_QUOTES SQL mode enabled. The digest is not meant to be valid
+ * SQL, just to not contain any of the values in the original statement.
+ */
+template <typename Allocator>
+void sql_digest(
+    std::string_view sql,
+    std::basic_string<char, std::char_traits<char>, Allocator>& output
+);
+
+/**
+ * \ingroup observability
+ * \brief Computes a normalized form of a SQL statement, to name spans and group metrics.
+ * \details See the other overload.
+ */
+inline std::string sql_digest(std::string_view sql);
+
+} // mysql
+} // boost
+
+#include "boost/mysql/impl/connection_observer.hpp"
+
+#endif
@@ -9,7 +9,9 @@
 #define BOOST_MYSQL_CONNECTION_PARAMS_HPP
 
 #include <string_view>
+#include <boost/asio/ssl/context.hpp>
 #include "boost/mysql/collation.hpp"
+#include "boost/mysql/ssl_session_cache.hpp"
 
 /**
  * \defgroup connparams Connection parameters
@@ -27,30 +29,55 @@ namespace mysql {
 enum class ssl_mode
 {
     disable, ///< Never use TLS
-    enable,  ///< Use TLS if the server supports it, fall back to non-encrypted connection if it does not.
+    enable,  ///< Use TLS if the server supports it, fall back to non-encrypted connection if it does not. Never uses TLS over UNIX sockets.
     require  ///< Always use TLS; abort the connection if the server does not support it.
 };
 
 /**
  * \ingroup connparams
  * \brief Connection options regarding TLS.
- * \details At the moment, contains only the ssl_mode, which
- * indicates whether to use TLS on the connection or not.
+ * \details Contains the ssl_mode, which indicates whether to use TLS on
+ * the connection or not, and optionally a TLS context and a session
+ * cache to be shared between connections.
+ *
+ * By default, each connection creates its own boost::asio::ssl::context
+ * when performing the TLS handshake, and every handshake is a full one.
+ * Creating contexts is expensive, so applications opening many connections
+ * should create a single context and pass it here. The context must be
+ * kept alive as long as any connection using it is.
+ *
+ * Passing a boost::mysql::ssl_session_cache makes connections resume
+ * previous TLS sessions, avoiding full handshakes when reconnecting
+ * to the same server.
  */
 class ssl_options
 {
     ssl_mode mode_;
+    boost::asio::ssl::context* context_;
+    ssl_session_cache* session_cache_;
 public:
     /**
      * \brief Default and initialization constructor.
      * \details By default, SSL is enabled for the connection
-     * if the server supports is (ssl_mode::enable).
+     * if the server supports is (ssl_mode::enable). If context is nullptr,
+     * each connection creates its own context. If session_cache is nullptr,
+     * TLS sessions are not resumed.
      */
-    explicit ssl_options(ssl_mode mode=ssl_mode::enable) noexcept:
-        mode_(mode) {}
+    explicit ssl_options(
+        ssl_mode mode=ssl_mode::enable,
+        boost::asio::ssl::context* context=nullptr,
+        ssl_session_cache* session_cache=nullptr
+    ) noexcept:
+        mode_(mode), context_(context), session_cache_(session_cache) {}
 
     /// Retrieves the TLS mode to be used for the connection.
     ssl_mode mode() const noexcept { return mode_; }
+
+    /// Retrieves the TLS context to be used for the connection, or nullptr to use a new one.
+    boost::asio::ssl::context* context() const noexcept { return context_; }
+
+    /// Retrieves the cache used to resume TLS sessions, or nullptr if sessions are not resumed.
+    ssl_session_cache* session_cache() const noexcept { return session_cache_; }
 };
 
 
@@ -0,0 +1,194 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_CONNECTION_POOL_HPP
+#define BOOST_MYSQL_CONNECTION_POOL_HPP
+
+#include "boost/mysql/resilient_connection.hpp"
+#include "boost/mysql/detail/auxiliar/owned_connection_params.hpp"
+#include "boost/mysql/detail/auxiliar/async_result_macro.hpp"
+#include <boost/asio/steady_timer.hpp>
+#include <cassert>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace boost {
+namespace mysql {
+
+/**
+ * \ingroup connection
+ * \brief Configuration for a connection_pool.
+ */
+struct pool_options
+{
+    /// The maximum number of connections the pool opens.
+    std::size_t max_size {16};
+
+    /// The retry policy for the pool's connections.
+    retry_policy retry;
+};
+
+template <typename Stream> class connection_pool;
+
+/**
+ * \ingroup connection
+ * \brief A connection borrowed from a connection_pool.
+ * \details Returns the connection to the pool when destroyed, or when release() is called.
+ * It should be returned in a clean state: with any resultset read and no transaction active.
+ * Pooled connections are movable but not copyable. A default-constructed
+ * or moved-from object has valid() == false.
+ */
+template <typename Stream>
+class pooled_connection
+{
+    connection_pool<Stream>* pool_ {};
+    resilient_connection<Stream>* conn_ {};
+
+    pooled_connection(connection_pool<Stream>& pool, resilient_connection<Stream>& conn) noexcept:
+        pool_(&pool), conn_(&conn) {}
+    friend class connection_pool<Stream>;
+public:
+    /// Default constructor.
+    pooled_connection() = default;
+
+    /// Move constructor.
+    pooled_connection(pooled_connection&& rhs) noexcept:
+        pool_(std::exchange(rhs.pool_, nullptr)), conn_(std::exchange(rhs.conn_, nullptr)) {}
+
+    /// Move assignment. Releases the connection held by this object, if any.
+    pooled_connection& operator=(pooled_connection&& rhs) noexcept
+    {
+        release();
+        pool_ = std::exchange(rhs.pool_, nullptr);
+        conn_ = std::exchange(rhs.conn_, nullptr);
+        return *this;
+    }
+
+    pooled_connection(const pooled_connection&) = delete;
+    pooled_connection& operator=(const pooled_connection&) = delete;
+
+    /// Destructor. Releases the connection, if any.
+    ~pooled_connection() { release(); }
+
+    /// Returns true if the object holds a connection.
+    bool valid() const noexcept { return conn_ != nullptr; }
+
+    /// The pool the connection belongs to.
+    connection_pool<Stream>& pool() const noexcept { assert(valid()); return *pool_; }
+
+    /// Retrieves the connection.
+    resilient_connection<Stream>& get() const noexcept { assert(valid()); return *conn_; }
+
+    /// Retrieves the connection.
+    resilient_connection<Stream>& operator*() const noexcept { return get(); }
+
+    /// Retrieves the connection.
+    resilient_connection<Stream>* operator->() const noexcept { return &get(); }
+
+    /// Returns the connection to the pool. Does nothing if valid() == false.
+    void release() noexcept;
+};
+
+/**
+ * \ingroup connection
+ * \brief A pool of connections to a single MySQL server.
+ * \details Connections are resilient_connection objects, which reconnect on their own,
+ * so a connection is never discarded. Connections are created on demand, up to
+ * pool_options::max_size. When all of them are in use, async_acquire waits
+ * until one is released. Released connections are reused in LIFO order,
+ * so a small working set of connections is kept busy. Connections left idle for
+ * long may be closed by the server, and are reconnected when used again.
+ *
+ * The pool is not thread-safe: acquiring and releasing connections must happen
+ * in the pool's executor (or in a strand). The pool must outlive the connections
+ * it hands out, and any outstanding async_acquire.
+ */
+template <
+    typename Stream ///< The underlying socket type, e.g. boost::asio::ip::tcp::socket.
+>
+class connection_pool
+{
+public:
+    /// The endpoint type associated to this pool.
+    using endpoint_type = typename Stream::endpoint_type;
+
+    /// The executor type associated to this pool.
+    using executor_type = typename Stream::executor_type;
+private:
+    struct acquire_op;
+
+    executor_type executor_;
+    endpoint_type endpoint_;
+    detail::owned_connection_params params_;
+    pool_options opts_;
+    std::vector<std::unique_ptr<resilient_connection<Stream>>> connections_;
+    std::vector<resilient_connection<Stream>*> idle_;
+    boost::asio::steady_timer wait_timer_; // never expires; waiters are woken by cancel_one
+
+    resilient_connection<Stream>& create_connection();
+    void destroy_connection(resilient_connection<Stream>& conn);
+    void release(resilient_connection<Stream>& conn) noexcept;
+    pooled_connection<Stream> make_handle(resilient_connection<Stream>& conn) noexcept { return {*this, conn}; }
+    friend class pooled_connection<Stream>;
+public:
+    /**
+     * \brief Constructor.
+     * \details No connection is opened until one is acquired. endpoint and params are copied.
+     */
+    connection_pool(const executor_type& ex, const endpoint_type& endpoint,
+            const connection_params& params, pool_options opts = {});
+
+    connection_pool(const connection_pool&) = delete;
+    connection_pool& operator=(const connection_pool&) = delete;
+
+    /// Retrieves the executor associated to this pool.
+    executor_type get_executor() const { return executor_; }
+
+    /// The endpoint the pool's connections connect to.
+    const endpoint_type& endpoint() const noexcept { return endpoint_; }
+
+    /// The number of connections, including the ones being connected.
+    std::size_t size() const noexcept { return connections_.size(); }
+
+    /// The number of connections waiting to be acquired.
+    std::size_t num_idle() const noexcept { return idle_.size(); }
+
+    /// The number of connections acquired and not yet released, or being connected.
+    std::size_t num_in_use() const noexcept { return size() - num_idle(); }
+
+    /**
+     * \brief Acquires a connection (sync with error code version).
+     * \details Returns an idle connection if there is any, and connects a new one
+     * otherwise. As waiting for a connection to be released would block forever
+     * in single-threaded code, this function fails with boost::asio::error::would_block
+     * if all pool_options::max_size connections are in use.
+     */
+    pooled_connection<Stream> acquire(error_code& err, error_info& info);
+
+    /// Acquires a connection (sync with exceptions version).
+    pooled_connection<Stream> acquire();
+
+    /// Handler signature for connection_pool::async_acquire.
+    using acquire_signature = void(error_code, pooled_connection<Stream>);
+
+    /**
+     * \brief Acquires a connection (async version).
+     * \details Returns an idle connection if there is any, connects a new one if the
+     * pool is not full, or waits for a connection to be released otherwise.
+     */
+    template <typename CompletionToken>
+    BOOST_MYSQL_INITFN_RESULT_TYPE(CompletionToken, acquire_signature)
+    async_acquire(CompletionToken&& token, error_info* info=nullptr);
+};
+
+} // mysql
+} // boost
+
+#include "boost/mysql/impl/connection_pool.hpp"
+
+#endif
@@ -0,0 +1,122 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_CONNECTION_STATS_HPP
+#define BOOST_MYSQL_CONNECTION_STATS_HPP
+
+#include <chrono>
+#include <cstdint>
+
+namespace boost {
+namespace mysql {
+
+/**
+ * \ingroup observability
+ * \brief A snapshot of the counters kept by a connection (see connection::stats).
+ * \details Counters start at zero when the connection is created and are never reset.
+ * They can be aggregated across connections with `operator+`, and the activity
+ * between two snapshots of the same connection can be obtained with `operator-`.
+ *
+ * Bytes and packets are counted once a message has been completely written or read,
+ * and include packet headers, but not TLS overhead.
+ */
+struct connection_stats
+{
+    /// Bytes read from the server.
+    std::uint64_t bytes_read {0};
+
+    /// Bytes written to the server.
+    std::uint64_t bytes_written {0};
+
+    /// Packets read from the server.
+    std::uint64_t packets_read {0};
+
+    /// Packets written to the server.
+    std::uint64_t packets_written {0};
+
+    /// Text queries issued, including those issued by batch_inserter.
+    std::uint64_t queries {0};
+
+    /// Statements prepared.
+    std::uint64_t statements_prepared {0};
+
+    /// Statement executions.
+    std::uint64_t statements_executed {0};
+
+    /// Statements closed.
+    std::uint64_t statements_closed {0};
+
+    /// Rows read and deserialized (rows discarded by resultset::discard_remaining are not counted).
+    std::uint64_t rows_decoded {0};
+
+    /// Rows that couldn't be deserialized because they were malformed.
+    std::uint64_t decode_errors {0};
+
+    /**
+     * \brief Time spent waiting for the stream to complete reads.
+     * \details Only reads that actually reach the stream are timed: messages
+     * served from the read-ahead buffer are not. For async operations, this
+     * includes the time the completion waits to be run by the executor.
+     */
+    std::chrono::nanoseconds read_time {0};
+
+    /// Time spent waiting for the stream to complete writes (see read_time).
+    std::chrono::nanoseconds write_time {0};
+
+    /// Adds the counters in rhs to this object.
+    connection_stats& operator+=(const connection_stats& rhs) noexcept
+    {
+        bytes_read += rhs.bytes_read;
+        bytes_written += rhs.bytes_written;
+        packets_read += rhs.packets_read;
+        packets_written += rhs.packets_written;
+        queries += rhs.queries;
+        statements_prepared += rhs.statements_prepared;
+        statements_executed += rhs.statements_executed;
+        statements_closed += rhs.statements_closed;
+        rows_decoded += rhs.rows_decoded;
+        decode_errors += rhs.decode_errors;
+        read_time += rhs.read_time;
+        write_time += rhs.write_time;
+        return *this;
+    }
+
+    /// Subtracts the counters in rhs from this object.
+    connection_stats& operator-=(const connection_stats& rhs) noexcept
+    {
+        bytes_read -= rhs.bytes_read;
+        bytes_written -= rhs.bytes_written;
+        packets_read -= rhs.packets_read;
+        packets_written -= rhs.packets_written;
+        queries -= rhs.queries;
+        statements_prepared -= rhs.statements_prepared;
+        statements_executed -= rhs.statements_executed;
+        statements_closed -= rhs.statements_closed;
+        rows_decoded -= rhs.rows_decoded;
+        decode_errors -= rhs.decode_errors;
+        read_time -= rhs.read_time;
+        write_time -= rhs.write_time;
+        return *this;
+    }
+};
+
+/// \relates connection_stats
+inline connection_stats operator+(connection_stats lhs, const connection_stats& rhs) noexcept
+{
+    return lhs += rhs;
+}
+
+/// \relates connection_stats
+inline connection_stats operator-(connection_stats lhs, const connection_stats& rhs) noexcept
+{
+    return lhs -= rhs;
+}
+
+} // mysql
+} // boost
+
+#endif
@@ -0,0 +1,160 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_DECIMAL_HPP
+#define BOOST_MYSQL_DECIMAL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace boost {
+namespace mysql {
+
+/**
+ * \ingroup values
+ * \brief A fixed-point number, representing MySQL DECIMAL data type.
+ * \details A decimal holds an integer (the unscaled value) and a scale,
+ * representing the number unscaled_value * 10^(-scale). The unscaled value
+ * is stored as a sign and a 128-bit magnitude, and can hold up to
+ * decimal::max_precision (38) decimal digits. Arithmetic is exact.
+ *
+ * The MySQL protocol sends DECIMAL values as strings, both in the text
+ * and the binary protocols, so boost::mysql::value holds them as
+ * std::string_view. Use value::get<decimal>() or value::get_optional<decimal>()
+ * to obtain the fixed-point representation, instead of parsing the strings yourself.
+ * DECIMAL columns with a precision bigger than 38 can't be represented with
+ * this type, and get_optional will return an empty optional for them.
+ *
+ * Each call to value::get<decimal>() on a string parses it again, so store the
+ * result if you need it more than once.
+ *
+ * To pass a decimal to a prepared statement, wrap it in a
+ * boost::mysql::statement_param. It is sent as DECIMAL, in textual form,
+ * so the server gets the exact number. To use it in format_sql,
+ * pass the result of to_string() instead.
+ */
+class decimal
+{
+public:
+    /// The maximum number of decimal digits a decimal can hold.
+    static constexpr unsigned max_precision = 38;
+
+    /// The maximum number of characters written by decimal::to_chars.
+    static constexpr std::size_t max_string_size = max_precision + 3; // sign, an extra leading zero and the dot
+
+    /// Constructs a zero with scale zero.
+    constexpr decimal() noexcept = default;
+
+    /**
+     * \brief Constructs the number unscaled_value * 10^(-scale).
+     * \details scale must be less or equal than max_precision.
+     */
+    constexpr decimal(std::int64_t unscaled_value, unsigned scale = 0) noexcept;
+
+    /**
+     * \brief Parses a number in the format used by MySQL (e.g. "-123.4500").
+     * \details The scale of the result is the number of fractional digits in the string.
+     * Returns an empty optional if the string is not a valid number or has more than
+     * max_precision significant digits.
+     */
+    static std::optional<decimal> parse(std::string_view from) noexcept;
+
+    /// The number of fractional digits.
+    constexpr unsigned scale() const noexcept { return scale_; }
+
+    /// Returns true if the number is less than zero.
+    constexpr bool is_negative() const noexcept { return negative_; }
+
+    /**
+     * \brief Returns the same number with a different scale.
+     * \details If new_scale is greater than scale(), the conversion is exact, and
+     * an empty optional is returned if the result has more than max_precision digits.
+     * Otherwise, the number is rounded half away from zero.
+     */
+    std::optional<decimal> rescale(unsigned new_scale) const noexcept;
+
+    /// Formats the number, including exactly scale() fractional digits.
+    std::string to_string() const;
+
+    /**
+     * \brief Formats the number like decimal::to_string, without allocating.
+     * \details output must point to a buffer of at least max_string_size characters.
+     * Returns the number of characters written. No NULL terminator is written.
+     */
+    std::size_t to_chars(char* output) const noexcept;
+
+    /// Converts the number to the nearest double (may lose precision).
+    double to_double() const noexcept;
+
+    /// Returns the opposite number.
+    decimal operator-() const noexcept;
+
+    /**
+     * \brief Adds two numbers exactly.
+     * \details The scale of the result is the maximum of both scales.
+     * Throws std::overflow_error if the result has more than max_precision digits.
+     */
+    decimal& operator+=(const decimal& rhs);
+
+    /// Subtracts two numbers exactly. See decimal::operator+= for details.
+    decimal& operator-=(const decimal& rhs);
+
+    /// Compares two numbers, regardless of their scales (e.g. 1.0 == 1.00).
+    bool operator==(const decimal& rhs) const noexcept { return compare(rhs) == 0; }
+
+    /// Compares two numbers, regardless of their scales.
+    bool operator!=(const decimal& rhs) const noexcept { return compare(rhs) != 0; }
+
+    /// Compares two numbers, regardless of their scales.
+    bool operator<(const decimal& rhs) const noexcept { return compare(rhs) < 0; }
+
+    /// Compares two numbers, regardless of their scales.
+    bool operator<=(const decimal& rhs) const noexcept { return compare(rhs) <= 0; }
+
+    /// Compares two numbers, regardless of their scales.
+    bool operator>(const decimal& rhs) const noexcept { return compare(rhs) > 0; }
+
+    /// Compares two numbers, regardless of their scales.
+    bool operator>=(const decimal& rhs) const noexcept { return compare(rhs) >= 0; }
+private:
+    std::uint64_t high_ {}; // magnitude of the unscaled value, most significant half
+    std::uint64_t low_ {};  // magnitude of the unscaled value, least significant half
+    std::uint8_t scale_ {};
+    bool negative_ {};      // never true for zero
+
+    int compare(const decimal& rhs) const noexcept;
+    decimal& add(const decimal& rhs, bool rhs_negative);
+};
+
+/**
+ * \relates decimal
+ * \brief Adds two decimals (see decimal::operator+=).
+ */
+inline decimal operator+(decimal lhs, const decimal& rhs) { return lhs += rhs; }
+
+/**
+ * \relates decimal
+ * \brief Subtracts two decimals (see decimal::operator-=).
+ */
+inline decimal operator-(decimal lhs, const decimal& rhs) { return lhs -= rhs; }
+
+/**
+ * \relates decimal
+ * \brief Streams a decimal.
+ */
+inline std::ostream& operator<<(std::ostream& os, const decimal& value) { return os << value.to_string(); }
+
+} // mysql
+} // boost
+
+#include "boost/mysql/impl/decimal.hpp"
+
+#endif
@@ -8,6 +8,7 @@
 #ifndef BOOST_MYSQL_DETAIL_AUTH_AUTH_CALCULATOR_HPP
 #define BOOST_MYSQL_DETAIL_AUTH_AUTH_CALCULATOR_HPP
 
+#include "boost/mysql/detail/config.hpp"
 #include "boost/mysql/error.hpp"
 #include <array>
 #include <string>
@@ -35,9 +36,9 @@ class auth_calculator
     const authentication_plugin* plugin_ {nullptr};
     std::string response_;
 
-    inline static const authentication_plugin* find_plugin(std::string_view name);
+    BOOST_MYSQL_DECL static const authentication_plugin* find_plugin(std::string_view name);
 public:
-    inline error_code calculate(
+    BOOST_MYSQL_DECL error_code calculate(
         std::string_view plugin_name,
         std::string_view password,
         std::string_view challenge,
@@ -55,6 +56,8 @@ public:
 } // mysql
 } // boost
 
+#ifdef BOOST_MYSQL_HEADER_ONLY
 #include "boost/mysql/detail/auth/impl/auth_calculator.ipp"
+#endif
 
 #endif /* INCLUDE_BOOST_MYSQL_DETAIL_AUTH_AUTH_CALCULATOR_HPP_ */
@@ -8,6 +8,7 @@
 #ifndef BOOST_MYSQL_DETAIL_AUTH_CACHING_SHA2_PASSWORD_HPP
 #define BOOST_MYSQL_DETAIL_AUTH_CACHING_SHA2_PASSWORD_HPP
 
+#include "boost/mysql/detail/config.hpp"
 #include <cstddef>
 #include <string_view>
 #include "boost/mysql/error.hpp"
@@ -26,7 +27,7 @@ namespace caching_sha2_password {
 // Doing the latter requires a SSL connection. It is possible to perform full
 // auth without an SSL connection, but that requires the server public key,
 // and we do not implement that.
-inline error_code compute_response(
+BOOST_MYSQL_DECL error_code compute_response(
     std::string_view password,
     std::string_view challenge,
     bool use_ssl,
@@ -38,6 +39,8 @@ inline error_code compute_response(
 } // mysql
 } // boost
 
+#ifdef BOOST_MYSQL_HEADER_ONLY
 #include "boost/mysql/detail/auth/impl/caching_sha2_password.ipp"
+#endif
 
 #endif /* INCLUDE_BOOST_MYSQL_DETAIL_AUTH_CACHING_SHA2_PASSWORD_HPP_ */
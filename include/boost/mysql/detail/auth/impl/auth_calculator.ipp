@@ -34,7 +34,7 @@ constexpr std::array<const authentication_plugin*, 2> all_authentication_plugins
 } // mysql
 } // boost
 
-inline const boost::mysql::detail::authentication_plugin*
+BOOST_MYSQL_DECL const boost::mysql::detail::authentication_plugin*
 boost::mysql::detail::auth_calculator::find_plugin(
     std::string_view name
 )
@@ -47,7 +47,7 @@ boost::mysql::detail::auth_calculator::find_plugin(
     return it == std::end(all_authentication_plugins) ? nullptr : *it;
 }
 
-inline boost::mysql::error_code
+BOOST_MYSQL_DECL boost::mysql::error_code
 boost::mysql::detail::auth_calculator::calculate(
     std::string_view plugin_name,
     std::string_view password,
@@ -59,7 +59,7 @@ inline void compute_auth_string(
 
 
 
-inline boost::mysql::error_code
+BOOST_MYSQL_DECL boost::mysql::error_code
 boost::mysql::detail::caching_sha2_password::compute_response(
     std::string_view password,
     std::string_view challenge,
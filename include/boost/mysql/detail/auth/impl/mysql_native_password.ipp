@@ -54,7 +54,7 @@ inline void compute_auth_string(
 } // boost
 
 
-inline boost::mysql::error_code
+BOOST_MYSQL_DECL boost::mysql::error_code
 boost::mysql::detail::mysql_native_password::compute_response(
     std::string_view password,
     std::string_view challenge,
@@ -8,6 +8,7 @@
 #ifndef BOOST_MYSQL_DETAIL_AUTH_MYSQL_NATIVE_PASSWORD_HPP
 #define BOOST_MYSQL_DETAIL_AUTH_MYSQL_NATIVE_PASSWORD_HPP
 
+#include "boost/mysql/detail/config.hpp"
 #include <cstdint>
 #include <string_view>
 #include "boost/mysql/error.hpp"
@@ -19,7 +20,7 @@ namespace mysql_native_password {
 
 // Authorization for this plugin is always challenge (nonce) -> response
 // (hashed password).
-inline error_code compute_response(
+BOOST_MYSQL_DECL error_code compute_response(
     std::string_view password,
     std::string_view challenge,
     bool use_ssl,
@@ -32,6 +33,8 @@ inline error_code compute_response(
 } // mysql
 } // boost
 
+#ifdef BOOST_MYSQL_HEADER_ONLY
 #include "boost/mysql/detail/auth/impl/mysql_native_password.ipp"
+#endif
 
 #endif
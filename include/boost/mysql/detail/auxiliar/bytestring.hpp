@@ -8,6 +8,8 @@
 #ifndef BOOST_MYSQL_DETAIL_AUXILIAR_BYTESTRING_HPP
 #define BOOST_MYSQL_DETAIL_AUXILIAR_BYTESTRING_HPP
 
+#include "boost/mysql/detail/auxiliar/resource_allocator.hpp"
+#include <cstdint>
 #include <vector>
 
 namespace boost {
@@ -19,6 +21,9 @@ using basic_bytestring = std::vector<std::uint8_t, Allocator>;
 
 using bytestring = std::vector<std::uint8_t>;
 
+// A bytestring whose memory is obtained from the connection's memory_resource
+using resource_bytestring = basic_bytestring<resource_allocator<std::uint8_t>>;
+
 }
 }
 }
@@ -0,0 +1,80 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_DETAIL_AUXILIAR_CONNECTION_COUNTERS_HPP
+#define BOOST_MYSQL_DETAIL_AUXILIAR_CONNECTION_COUNTERS_HPP
+
+#include "boost/mysql/connection_stats.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// A counter that may be read from any thread, but is only incremented by
+// a single thread at a time (the one running the connection's operations).
+// Incrementing is thus a relaxed load and store, rather than a locked read-modify-write
+class relaxed_counter
+{
+    std::atomic<std::uint64_t> value_ {0};
+public:
+    relaxed_counter() = default;
+    relaxed_counter(const relaxed_counter& rhs) noexcept: value_(rhs.get()) {}
+    relaxed_counter& operator=(const relaxed_counter& rhs) noexcept { value_.store(rhs.get(), std::memory_order_relaxed); return *this; }
+
+    std::uint64_t get() const noexcept { return value_.load(std::memory_order_relaxed); }
+    void add(std::uint64_t n) noexcept { value_.store(get() + n, std::memory_order_relaxed); }
+};
+
+// The counters behind connection::stats
+struct connection_counters
+{
+    relaxed_counter bytes_read;
+    relaxed_counter bytes_written;
+    relaxed_counter packets_read;
+    relaxed_counter packets_written;
+    relaxed_counter queries;
+    relaxed_counter statements_prepared;
+    relaxed_counter statements_executed;
+    relaxed_counter statements_closed;
+    relaxed_counter rows_decoded;
+    relaxed_counter decode_errors;
+    relaxed_counter read_time; // nanoseconds
+    relaxed_counter write_time; // nanoseconds
+
+    void add_time(relaxed_counter& counter, std::chrono::steady_clock::time_point start) noexcept
+    {
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        counter.add(static_cast<std::uint64_t>(elapsed.count()));
+    }
+
+    connection_stats snapshot() const noexcept
+    {
+        connection_stats res;
+        res.bytes_read = bytes_read.get();
+        res.bytes_written = bytes_written.get();
+        res.packets_read = packets_read.get();
+        res.packets_written = packets_written.get();
+        res.queries = queries.get();
+        res.statements_prepared = statements_prepared.get();
+        res.statements_executed = statements_executed.get();
+        res.statements_closed = statements_closed.get();
+        res.rows_decoded = rows_decoded.get();
+        res.decode_errors = decode_errors.get();
+        res.read_time = std::chrono::nanoseconds(static_cast<std::int64_t>(read_time.get()));
+        res.write_time = std::chrono::nanoseconds(static_cast<std::int64_t>(write_time.get()));
+        return res;
+    }
+};
+
+} // detail
+} // mysql
+} // boost
+
+#endif
@@ -15,10 +15,10 @@ namespace boost {
 namespace mysql {
 namespace detail {
 
-template <typename TLeft, typename TRight>
+template <typename TLeft, typename AllocLeft, typename TRight, typename AllocRight>
 inline bool container_equals(
-    const std::vector<TLeft>& lhs,
-    const std::vector<TRight>& rhs
+    const std::vector<TLeft, AllocLeft>& lhs,
+    const std::vector<TRight, AllocRight>& rhs
 )
 {
     if (lhs.size() != rhs.size())
@@ -0,0 +1,49 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_DETAIL_AUXILIAR_GTID_TRACKER_HPP
+#define BOOST_MYSQL_DETAIL_AUXILIAR_GTID_TRACKER_HPP
+
+#include "boost/mysql/detail/config.hpp"
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// Tracks GTIDs as the highest transaction number seen for each source
+// (a server UUID, optionally followed by a tag). to_string returns a GTID set
+// containing these transactions and all the previous ones from the same
+// sources (e.g. "3e11fa47-71ca-11e1-9e33-c80aa9429562:1-23"). Waiting for this set
+// on a replica ensures that the tracked transactions have been applied there
+class gtid_tracker
+{
+    std::map<std::string, std::uint64_t, std::less<>> last_; // source => highest transaction number
+public:
+    bool empty() const noexcept { return last_.empty(); }
+    void clear() noexcept { last_.clear(); }
+
+    // Adds the transactions in a GTID set, as reported by the server
+    // (e.g. "uuid1:1-5:7,uuid2:3"). Returns false and leaves the tracker
+    // unchanged if gtid_set is malformed
+    BOOST_MYSQL_DECL bool add(std::string_view gtid_set);
+
+    BOOST_MYSQL_DECL std::string to_string() const;
+};
+
+} // detail
+} // mysql
+} // boost
+
+#ifdef BOOST_MYSQL_HEADER_ONLY
+#include "boost/mysql/detail/auxiliar/impl/gtid_tracker.ipp"
+#endif
+
+#endif
@@ -0,0 +1,105 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_DETAIL_AUXILIAR_IMPL_GTID_TRACKER_IPP
+#define BOOST_MYSQL_DETAIL_AUXILIAR_IMPL_GTID_TRACKER_IPP
+
+#include <algorithm>
+#include <charconv>
+
+BOOST_MYSQL_DECL bool boost::mysql::detail::gtid_tracker::add(
+    std::string_view gtid_set
+)
+{
+    auto is_space = [](char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; };
+    auto is_uuid_char = [](char c) {
+        return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F') || c == '-';
+    };
+    auto is_tag_char = [](char c) {
+        return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+    };
+
+    auto parse_number = [](std::string_view from, std::uint64_t& to) {
+        auto res = std::from_chars(from.data(), from.data() + from.size(), to);
+        return res.ec == std::errc() && res.ptr == from.data() + from.size() && !from.empty();
+    };
+
+    // Parse everything first, so nothing is added if gtid_set is malformed
+    std::map<std::string, std::uint64_t, std::less<>> parsed;
+    while (!gtid_set.empty())
+    {
+        // Each comma-separated item is uuid(:tag|:interval)*
+        auto item = gtid_set.substr(0, gtid_set.find(','));
+        gtid_set.remove_prefix(std::min(gtid_set.size(), item.size() + 1));
+        while (!item.empty() && is_space(item.front()))
+            item.remove_prefix(1);
+        while (!item.empty() && is_space(item.back()))
+            item.remove_suffix(1);
+        if (item.empty())
+            continue;
+
+        auto uuid = item.substr(0, item.find(':'));
+        if (uuid.empty() || !std::all_of(uuid.begin(), uuid.end(), is_uuid_char) || uuid.size() == item.size())
+            return false;
+        item.remove_prefix(uuid.size() + 1);
+
+        std::string source (uuid);
+        while (!item.empty())
+        {
+            auto token = item.substr(0, item.find(':'));
+            item.remove_prefix(std::min(item.size(), token.size() + 1));
+            if (token.empty())
+                return false;
+            if (token.front() >= '0' && token.front() <= '9')
+            {
+                // An interval, N or N-M
+                auto dash = token.find('-');
+                auto last_str = dash == std::string_view::npos ? token : token.substr(dash + 1);
+                std::uint64_t first = 0, last = 0;
+                if (!parse_number(token.substr(0, dash), first) || !parse_number(last_str, last) || last < first)
+                {
+                    return false;
+                }
+                auto& current = parsed[source];
+                current = std::max(current, last);
+            }
+            else if (std::all_of(token.begin(), token.end(), is_tag_char))
+            {
+                source = std::string(uuid) + ':' + std::string(token);
+            }
+            else
+            {
+                return false;
+            }
+        }
+    }
+
+    for (const auto& entry: parsed)
+    {
+        auto& current = last_[entry.first];
+        current = std::max(current, entry.second);
+    }
+    return true;
+}
+
+BOOST_MYSQL_DECL std::string boost::mysql::detail::gtid_tracker::to_string() const
+{
+    std::string res;
+    for (const auto& entry: last_)
+    {
+        if (entry.second == 0)
+            continue;
+        if (!res.empty())
+            res += ',';
+        res += entry.first;
+        res += ":1-";
+        res += std::to_string(entry.second);
+    }
+    return res;
+}
+
+#endif
@@ -0,0 +1,51 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_DETAIL_AUXILIAR_OWNED_CONNECTION_PARAMS_HPP
+#define BOOST_MYSQL_DETAIL_AUXILIAR_OWNED_CONNECTION_PARAMS_HPP
+
+#include "boost/mysql/connection_params.hpp"
+#include <string>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// connection_params, plus copies of the strings it points to. Used by objects
+// that connect long after they were given the parameters. Not copyable,
+// as copies would point to the strings of the original object
+class owned_connection_params
+{
+    std::string username_;
+    std::string password_;
+    std::string database_;
+    connection_params params_ {"", ""};
+public:
+    owned_connection_params() = default;
+    explicit owned_connection_params(const connection_params& params) { assign(params); }
+    owned_connection_params(const owned_connection_params&) = delete;
+    owned_connection_params& operator=(const owned_connection_params&) = delete;
+
+    void assign(const connection_params& params)
+    {
+        username_ = params.username();
+        password_ = params.password();
+        database_ = params.database();
+        params_ = params;
+        params_.set_username(username_);
+        params_.set_password(password_);
+        params_.set_database(database_);
+    }
+
+    const connection_params& get() const noexcept { return params_; }
+};
+
+} // detail
+} // mysql
+} // boost
+
+#endif
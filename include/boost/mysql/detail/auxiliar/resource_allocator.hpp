@@ -0,0 +1,68 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_DETAIL_AUXILIAR_RESOURCE_ALLOCATOR_HPP
+#define BOOST_MYSQL_DETAIL_AUXILIAR_RESOURCE_ALLOCATOR_HPP
+
+#include <memory_resource>
+#include <cstddef>
+#include <type_traits>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// An allocator that obtains memory from a std::pmr::memory_resource.
+// Contrary to std::pmr::polymorphic_allocator, it propagates on move
+// assignment and swap. Rows and metadata hold string_views into their
+// buffers; this guarantees that moving a buffer never copies its contents,
+// which would leave these string_views dangling.
+template <typename T>
+class resource_allocator
+{
+    std::pmr::memory_resource* resource_;
+
+    template <typename U>
+    friend class resource_allocator;
+public:
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    resource_allocator() noexcept: resource_(std::pmr::get_default_resource()) {}
+    resource_allocator(std::pmr::memory_resource* resource) noexcept: resource_(resource) {}
+
+    template <typename U>
+    resource_allocator(const resource_allocator<U>& other) noexcept: resource_(other.resource_) {}
+
+    T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(resource_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept
+    {
+        resource_->deallocate(p, n * sizeof(T), alignof(T));
+    }
+
+    std::pmr::memory_resource* resource() const noexcept { return resource_; }
+
+    template <typename U>
+    bool operator==(const resource_allocator<U>& rhs) const noexcept
+    {
+        return resource_ == rhs.resource_ || resource_->is_equal(*rhs.resource_);
+    }
+
+    template <typename U>
+    bool operator!=(const resource_allocator<U>& rhs) const noexcept { return !(*this == rhs); }
+};
+
+} // detail
+} // mysql
+} // boost
+
+#endif
@@ -0,0 +1,69 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_DETAIL_AUXILIAR_RUNNING_IN_THIS_THREAD_HPP
+#define BOOST_MYSQL_DETAIL_AUXILIAR_RUNNING_IN_THIS_THREAD_HPP
+
+#include <boost/version.hpp>
+#if BOOST_VERSION >= 107400
+#include <boost/asio/any_io_executor.hpp>
+#else
+#include <boost/asio/executor.hpp>
+#endif
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/strand.hpp>
+#include <type_traits>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// The type-erased executor used by default by I/O objects
+#if BOOST_VERSION >= 107400
+using type_erased_executor = boost::asio::any_io_executor;
+#else
+using type_erased_executor = boost::asio::executor;
+#endif
+
+template <typename Executor, typename = void>
+struct has_running_in_this_thread : std::false_type {};
+
+template <typename Executor>
+struct has_running_in_this_thread<Executor, std::void_t<
+    decltype(std::declval<const Executor&>().running_in_this_thread())
+>> : std::true_type {};
+
+// Returns true if the calling thread is running a handler submitted to ex.
+// Type-erased executors are supported when they hold an io_context executor
+// or a strand over one. Returns false for executors where this can't be known
+template <typename Executor>
+bool running_in_this_thread(const Executor& ex) noexcept
+{
+    if constexpr (has_running_in_this_thread<Executor>::value)
+    {
+        return ex.running_in_this_thread();
+    }
+    else if constexpr (std::is_same_v<Executor, type_erased_executor>)
+    {
+        using io_executor = boost::asio::io_context::executor_type;
+        if (const auto* target = ex.template target<io_executor>())
+            return target->running_in_this_thread();
+        if (const auto* target = ex.template target<boost::asio::strand<io_executor>>())
+            return target->running_in_this_thread();
+        return false;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+} // detail
+} // mysql
+} // boost
+
+#endif
@@ -8,6 +8,7 @@
 #ifndef BOOST_MYSQL_DETAIL_AUXILIAR_TMP_HPP
 #define BOOST_MYSQL_DETAIL_AUXILIAR_TMP_HPP
 
+#include <memory>
 #include <type_traits>
 
 namespace boost {
@@ -30,6 +31,14 @@ struct is_one_of<T, Head>
 template <typename T, typename... Types>
 constexpr bool is_one_of_v = is_one_of<T, Types...>::value;
 
+// Whether the first type in a pack is std::allocator_arg_t (allocator-extended constructors)
+template <typename... Types>
+struct starts_with_allocator_arg : std::false_type {};
+
+template <typename Head, typename... Tail>
+struct starts_with_allocator_arg<Head, Tail...> :
+    std::is_same<std::decay_t<Head>, std::allocator_arg_t> {};
+
 } // detail
 } // mysql
 } // boost
@@ -0,0 +1,23 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_DETAIL_CONFIG_HPP
+#define BOOST_MYSQL_DETAIL_CONFIG_HPP
+
+// By default, the library is header-only: non-template functions are defined inline
+// in .ipp files, included by the headers declaring them. If BOOST_MYSQL_SEPARATE_COMPILATION
+// is defined, headers only declare these functions. They are then compiled,
+// together with explicit instantiations of the connection templates for TCP and
+// UNIX sockets, by including boost/mysql/src.hpp in a single translation unit.
+#ifdef BOOST_MYSQL_SEPARATE_COMPILATION
+#define BOOST_MYSQL_DECL
+#else
+#define BOOST_MYSQL_HEADER_ONLY
+#define BOOST_MYSQL_DECL inline
+#endif
+
+#endif
@@ -16,6 +16,14 @@ namespace boost {
 namespace mysql {
 namespace detail {
 
+// A request whose payload (including the command byte) has already been
+// composed by the caller. It is sent as is, without copying it, so the
+// memory it points to must be kept alive until the operation completes.
+struct serialized_request
+{
+    boost::asio::const_buffer payload;
+};
+
 template <typename StreamType, typename Serializable>
 void execute_generic(
     deserialize_row_fn deserializer,
@@ -39,6 +47,20 @@ async_execute_generic(
     error_info* info
 );
 
+// Executes into output, reusing the memory it owns. output is left invalid on error
+using execute_generic_into_signature = void(error_code);
+
+template <typename StreamType, typename Serializable, typename CompletionToken>
+BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, execute_generic_into_signature)
+async_execute_generic(
+    deserialize_row_fn deserializer,
+    channel<StreamType>& chan,
+    const Serializable& request,
+    resultset<StreamType>& output,
+    CompletionToken&& token,
+    error_info* info
+);
+
 } // detail
 } // mysql
 } // boost
@@ -35,6 +35,16 @@ async_execute_query(
     error_info* info
 );
 
+template <typename StreamType, typename CompletionToken>
+BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, execute_generic_into_signature)
+async_execute_query(
+    channel<StreamType>& chan,
+    std::string_view query,
+    resultset<StreamType>& output,
+    CompletionToken&& token,
+    error_info* info
+);
+
 }
 }
 }
@@ -39,6 +39,18 @@ async_execute_statement(
     error_info* info
 );
 
+template <typename StreamType, typename ForwardIterator, typename CompletionToken>
+BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, execute_generic_into_signature)
+async_execute_statement(
+    channel<StreamType>& chan,
+    std::uint32_t statement_id,
+    ForwardIterator params_begin,
+    ForwardIterator params_end,
+    resultset<StreamType>& output,
+    CompletionToken&& token,
+    error_info* info
+);
+
 } // detail
 } // mysql
 } // boost
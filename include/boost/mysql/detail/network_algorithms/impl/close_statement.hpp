@@ -18,7 +18,8 @@ void boost::mysql::detail::close_statement(
     error_info&
 )
 {
-    // Compose the close message
+    // Compose the close message. The command ends once written
+    chan.observe_command_start(command_type::close_statement, std::string_view());
     com_stmt_close_packet packet {int4(statement_id)};
 
     // Serialize it
@@ -41,7 +42,8 @@ boost::mysql::detail::async_close_statement(
     error_info*
 )
 {
-    // Compose the close message
+    // Compose the close message. The command ends once written
+    chan.observe_command_start(command_type::close_statement, std::string_view());
     com_stmt_close_packet packet {int4(statement_id)};
 
     // Serialize it
@@ -8,39 +8,105 @@
 #ifndef BOOST_MYSQL_DETAIL_NETWORK_ALGORITHMS_IMPL_EXECUTE_GENERIC_HPP
 #define BOOST_MYSQL_DETAIL_NETWORK_ALGORITHMS_IMPL_EXECUTE_GENERIC_HPP
 
+#include "boost/mysql/detail/protocol/query_messages.hpp"
+#include <boost/container/small_vector.hpp>
 #include <limits>
 
 namespace boost {
 namespace mysql {
 namespace detail {
 
+// The SQL text in a request, for observers
+inline std::string_view get_request_sql(const com_query_packet& request) noexcept { return request.query.value; }
+
+template <typename Serializable>
+std::string_view get_request_sql(const Serializable&) noexcept { return std::string_view(); }
+
 template <typename StreamType>
 class execute_processor
 {
     deserialize_row_fn deserializer_;
     channel<StreamType>& channel_;
-    bytestring buffer_;
+    resource_bytestring buffer_;
+    // Buffer sequence to send. Requests are usually composed of a few buffers,
+    // and write operations copy the sequence, so keep them in-place
+    boost::container::small_vector<boost::asio::const_buffer, 4> request_;
     std::size_t field_count_ {};
     ok_packet ok_packet_;
-    std::vector<field_metadata> fields_;
-    std::vector<bytestring> field_buffers_;
+    resource_bytestring field_definitions_; // all column definition packets, one after another
+    std::size_t num_field_definitions_ {};
 public:
     execute_processor(deserialize_row_fn deserializer, channel<StreamType>& chan):
-        deserializer_(deserializer), channel_(chan) {};
+        deserializer_(deserializer),
+        channel_(chan),
+        buffer_(chan.memory_resource()),
+        field_definitions_(chan.memory_resource())
+    {
+    }
+
+    // Takes the memory owned by r, to reuse it for this operation and for the
+    // resultset created by create_resultset(r). Must be called before process_request
+    void reuse_buffers(resultset<StreamType>& r) noexcept
+    {
+        r.release_buffers(buffer_, field_definitions_);
+    }
 
+    // If reference_strings is true, long strings in request (e.g. the query
+    // string or string statement parameters) are sent directly from the memory
+    // they live in, so they must be kept alive until the request is sent.
+    // Otherwise, the request is copied into a single buffer.
     template <typename Serializable>
     void process_request(
-        const Serializable& request
+        const Serializable& request,
+        bool reference_strings
     )
     {
+        channel_.observe_command_start(
+            static_cast<command_type>(Serializable::command_id),
+            get_request_sql(request)
+        );
+
         // Serialize the request
         capabilities caps = channel_.current_capabilities();
-        serialize_message(request, caps, buffer_);
+        if (reference_strings)
+        {
+            serialize_message_gather(request, caps, buffer_, request_);
+        }
+        else
+        {
+            serialize_message(request, caps, buffer_);
+            request_.assign(1, boost::asio::buffer(buffer_));
+        }
 
         // Prepare the channel
         channel_.reset_sequence_number();
     }
 
+    void process_request(
+        const serialized_request& request,
+        bool
+    )
+    {
+        // The payload starts with the command byte
+        std::string_view payload (
+            static_cast<const char*>(request.payload.data()),
+            request.payload.size()
+        );
+        if (!payload.empty())
+            channel_.observe_command_start(static_cast<command_type>(payload[0]), payload.substr(1));
+
+        request_.assign(1, request.payload);
+        channel_.reset_sequence_number();
+    }
+
+    // Called when the operation completes. Commands returning
+    // rows end when the last row is read, instead
+    void observe_completion(error_code err)
+    {
+        if (err || field_count_ == 0)
+            channel_.observe_command_end(err);
+    }
+
     void process_response(
         error_code& err,
         error_info& info
@@ -59,6 +125,7 @@ public:
             err = deserialize_message(ctx, ok_packet_);
             if (err)
                 return;
+            channel_.process_ok_packet(ok_packet_);
             field_count_ = 0;
         }
         else if (msg_type == error_packet_header)
@@ -93,8 +160,9 @@ public:
                 return;
             }
 
-            fields_.reserve(field_count_);
-            field_buffers_.reserve(field_count_);
+            // Column definitions are usually short, so this is most likely enough
+            constexpr std::size_t estimated_field_definition_size = 64;
+            field_definitions_.reserve(field_count_ * estimated_field_definition_size);
         }
     }
 
@@ -106,60 +174,64 @@ public:
         if (err)
             return err;
 
-        // Add it to our array
-        fields_.push_back(field_definition);
-        field_buffers_.push_back(std::move(buffer_));
-        buffer_ = bytestring();
+        // Store a copy of the packet, so buffer_ can be reused to read the next one.
+        // Field metadata is created when all packets have been read, as
+        // field_definitions_ may be reallocated until then
+        field_definitions_.insert(field_definitions_.end(), buffer_.begin(), buffer_.end());
+        ++num_field_definitions_;
 
         return error_code();
     }
 
-    resultset<StreamType> create_resultset() &&
+    void create_resultset(resultset<StreamType>& output) &&
     {
         if (field_count_ == 0)
         {
-            return resultset<StreamType>(
+            output.assign(
                 channel_,
                 std::move(buffer_),
+                std::move(field_definitions_),
                 ok_packet_
             );
         }
         else
         {
-            return resultset<StreamType>(
+            output.assign(
                 channel_,
-                resultset_metadata(std::move(field_buffers_), std::move(fields_)),
+                std::move(buffer_),
+                std::move(field_definitions_),
+                num_field_definitions_,
                 deserializer_
             );
         }
     }
 
+    resultset<StreamType> create_resultset() &&
+    {
+        resultset<StreamType> res;
+        std::move(*this).create_resultset(res);
+        return res;
+    }
+
     auto& get_channel() { return channel_; }
     auto& get_buffer() { return buffer_; }
+    const auto& get_request() const noexcept { return request_; }
 
     std::size_t field_count() const noexcept { return field_count_; }
 };
 
-} // detail
-} // mysql
-} // boost
-
-template <typename StreamType, typename Serializable>
-void boost::mysql::detail::execute_generic(
-    deserialize_row_fn deserializer,
-    channel<StreamType>& channel,
-    const Serializable& request,
-    resultset<StreamType>& output,
+// Sends the request and reads the response, up to the field definitions
+template <typename StreamType>
+void execute_generic_impl(
+    execute_processor<StreamType>& processor,
     error_code& err,
     error_info& info
 )
 {
-    // Compose a com_query message, reset seq num
-    execute_processor<StreamType> processor (deserializer, channel);
-    processor.process_request(request);
+    auto& channel = processor.get_channel();
 
-    // Send it
-    channel.write(boost::asio::buffer(processor.get_buffer()), err);
+    // Send the request
+    channel.write(processor.get_request(), err);
     if (err)
         return;
 
@@ -188,29 +260,79 @@ void boost::mysql::detail::execute_generic(
     }
 
     // No EOF packet is expected here, as we require deprecate EOF capabilities
-    output = std::move(processor).create_resultset();
+}
+
+} // detail
+} // mysql
+} // boost
+
+template <typename StreamType, typename Serializable>
+void boost::mysql::detail::execute_generic(
+    deserialize_row_fn deserializer,
+    channel<StreamType>& channel,
+    const Serializable& request,
+    resultset<StreamType>& output,
+    error_code& err,
+    error_info& info
+)
+{
+    // Compose a com_query message, reset seq num
+    execute_processor<StreamType> processor (deserializer, channel);
+    processor.reuse_buffers(output);
+    processor.process_request(request, true);
+
+    execute_generic_impl(processor, err, info);
+    if (!err)
+        std::move(processor).create_resultset(output);
+    processor.observe_completion(err);
 }
 
 namespace boost {
 namespace mysql {
 namespace detail {
 
-template<class StreamType, class Serializable>
+// If ExecuteInto, the operation executes into *output_, reusing its memory,
+// and completes with execute_generic_into_signature. Otherwise, it completes
+// with a new resultset (execute_generic_signature)
+template<class StreamType, class Serializable, bool ExecuteInto=false>
 struct execute_generic_op : async_op<StreamType>
 {
   std::shared_ptr<execute_processor<StreamType>> processor_;
+  resultset<StreamType>* output_;
   std::uint64_t remaining_fields_ {0};
 
   execute_generic_op(
     channel<StreamType>& chan,
     error_info* output_info,
     deserialize_row_fn deserializer,
-    const Serializable& request
+    const Serializable& request,
+    resultset<StreamType>* output = nullptr
   ) :
   async_op<StreamType>(chan, output_info),
-  processor_(std::make_shared<execute_processor<StreamType>>(deserializer, chan))
+  processor_(std::make_shared<execute_processor<StreamType>>(deserializer, chan)),
+  output_(output)
   {
-    processor_->process_request(request);
+    if constexpr (ExecuteInto)
+      processor_->reuse_buffers(*output_);
+
+    // Parameters need not be kept alive in async operations, so they get copied
+    processor_->process_request(request, false);
+  }
+
+  template<class Self>
+  void complete(Self& self, error_code err)
+  {
+    processor_->observe_completion(err);
+    if constexpr (ExecuteInto)
+    {
+      if (!err)
+        std::move(*processor_).create_resultset(*output_);
+      self.complete(err);
+    }
+    else
+    {
+      self.complete(err, err ? resultset<StreamType>() : std::move(*processor_).create_resultset());
+    }
   }
 
   template<class Self>
@@ -222,7 +344,7 @@ struct execute_generic_op : async_op<StreamType>
     // Error checking
     if (err)
     {
-      self.complete(err, resultset<StreamType>());
+      complete(self, err);
       return;
     }
 
@@ -230,8 +352,9 @@ struct execute_generic_op : async_op<StreamType>
     error_info info;
     BOOST_ASIO_CORO_REENTER(*this)
       {
-        // The request message has already been composed in the ctor. Send it
-        BOOST_ASIO_CORO_YIELD this->async_write(std::move(self), processor_->get_buffer());
+        // The request message has already been composed in the ctor,
+        // into a single buffer. Send it
+        BOOST_ASIO_CORO_YIELD this->async_write(std::move(self), processor_->get_request().front());
 
         // Read the response
         BOOST_ASIO_CORO_YIELD this->async_read(std::move(self), processor_->get_buffer());
@@ -241,7 +364,7 @@ struct execute_generic_op : async_op<StreamType>
         if (err)
         {
           conditional_assign(this->get_output_info(), std::move(info));
-          self.complete(err, resultset<StreamType>());
+          complete(self, err);
           BOOST_ASIO_CORO_YIELD break;
         }
         remaining_fields_ = processor_->field_count();
@@ -256,7 +379,7 @@ struct execute_generic_op : async_op<StreamType>
           err = processor_->process_field_definition();
           if (err)
           {
-            self.complete(err, resultset<StreamType>());
+            complete(self, err);
             BOOST_ASIO_CORO_YIELD break;
           }
 
@@ -264,10 +387,7 @@ struct execute_generic_op : async_op<StreamType>
         }
 
         // No EOF packet is expected here, as we require deprecate EOF capabilities
-        self.complete(
-            error_code(),
-            resultset<StreamType>(std::move(*processor_).create_resultset())
-        );
+        complete(self, error_code());
       }
   }
 };
@@ -302,5 +422,26 @@ boost::mysql::detail::async_execute_generic(
 //            chan, info, deserializer, request);
 }
 
+template <typename StreamType, typename Serializable, typename CompletionToken>
+BOOST_ASIO_INITFN_RESULT_TYPE(
+    CompletionToken,
+    boost::mysql::detail::execute_generic_into_signature
+)
+boost::mysql::detail::async_execute_generic(
+    deserialize_row_fn deserializer,
+    channel<StreamType>& chan,
+    const Serializable& request,
+    resultset<StreamType>& output,
+    CompletionToken&& token,
+    error_info* info
+)
+{
+    return boost::asio::async_compose<CompletionToken, execute_generic_into_signature>(
+        execute_generic_op<StreamType, Serializable, true>{
+            chan, info, deserializer, request, &output
+        },
+        token, chan);
+}
+
 
 #endif /* INCLUDE_MYSQL_IMPL_NETWORK_ALGORITHMS_READ_RESULTSET_HEAD_IPP_ */
@@ -54,5 +54,30 @@ boost::mysql::detail::async_execute_query(
     );
 }
 
+template <typename StreamType, typename CompletionToken>
+BOOST_ASIO_INITFN_RESULT_TYPE(
+    CompletionToken,
+    boost::mysql::detail::execute_generic_into_signature
+)
+boost::mysql::detail::async_execute_query(
+    channel<StreamType>& chan,
+    std::string_view query,
+    resultset<StreamType>& output,
+    CompletionToken&& token,
+    error_info* info
+)
+{
+    com_query_packet request { string_eof(query) };
+    return async_execute_generic(
+        &deserialize_text_row,
+        chan,
+        request,
+        output,
+        std::forward<CompletionToken>(token),
+        info
+    );
+}
+
+
 
 #endif /* INCLUDE_BOOST_MYSQL_DETAIL_NETWORK_ALGORITHMS_IMPL_EXECUTE_QUERY_HPP_ */
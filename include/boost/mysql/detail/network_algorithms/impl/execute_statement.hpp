@@ -80,6 +80,30 @@ boost::mysql::detail::async_execute_statement(
     );
 }
 
+template <typename StreamType, typename ForwardIterator, typename CompletionToken>
+BOOST_ASIO_INITFN_RESULT_TYPE(
+    CompletionToken,
+    boost::mysql::detail::execute_generic_into_signature
+)
+boost::mysql::detail::async_execute_statement(
+    channel<StreamType>& chan,
+    std::uint32_t statement_id,
+    ForwardIterator params_begin,
+    ForwardIterator params_end,
+    resultset<StreamType>& output,
+    CompletionToken&& token,
+    error_info* info
+)
+{
+    return async_execute_generic(
+        &deserialize_binary_row,
+        chan,
+        make_stmt_execute_packet(statement_id, params_begin, params_end),
+        output,
+        std::forward<CompletionToken>(token),
+        info
+    );
+}
 
 
 #endif /* INCLUDE_BOOST_MYSQL_DETAIL_NETWORK_ALGORITHMS_IMPL_EXECUTE_STATEMENT_HPP_ */
@@ -12,6 +12,9 @@
 #include "boost/mysql/detail/protocol/capabilities.hpp"
 #include "boost/mysql/detail/protocol/handshake_messages.hpp"
 #include "boost/mysql/detail/auth/auth_calculator.hpp"
+#include <boost/asio/basic_stream_socket.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <type_traits>
 
 namespace boost {
 namespace mysql {
@@ -27,6 +30,19 @@ inline capabilities conditional_capability(bool condition, std::uint32_t cap)
     return capabilities(condition ? cap : 0);
 }
 
+// UNIX sockets are secure transports: like the server, we don't negotiate
+// TLS over them unless ssl_mode::require is used, and let caching_sha2_password
+// send the password in plain text during full authentication.
+template <typename StreamType>
+struct is_secure_transport : std::false_type {};
+
+#ifdef BOOST_ASIO_HAS_LOCAL_SOCKETS
+template <typename Executor>
+struct is_secure_transport<
+    boost::asio::basic_stream_socket<boost::asio::local::stream_protocol, Executor>
+> : std::true_type {};
+#endif
+
 inline error_code deserialize_handshake(
     boost::asio::const_buffer buffer,
     handshake_packet& output,
@@ -74,12 +90,19 @@ class handshake_processor
 {
     connection_params params_;
     capabilities negotiated_caps_;
+    std::uint16_t status_flags_ {0};
+    std::string session_state_info_;
     auth_calculator auth_calc_;
+    bool secure_transport_;
 public:
-    handshake_processor(const connection_params& params): params_(params) {};
+    handshake_processor(const connection_params& params, bool secure_transport = false):
+        params_(params), secure_transport_(secure_transport) {};
     capabilities negotiated_capabilities() const noexcept { return negotiated_caps_; }
+    std::uint16_t status_flags() const noexcept { return status_flags_; }
+    std::string_view session_state_info() const noexcept { return session_state_info_; }
     const connection_params& params() const noexcept { return params_; }
     bool use_ssl() const noexcept { return negotiated_caps_.has(CLIENT_SSL); }
+    bool secure_channel() const noexcept { return use_ssl() || secure_transport_; }
 
     // Initial greeting processing
     error_code process_capabilities(const handshake_packet& handshake)
@@ -94,11 +117,11 @@ public:
             return make_error_code(errc::server_unsupported);
         }
         negotiated_caps_ = server_caps & (required_caps | optional_capabilities |
-                conditional_capability(ssl == ssl_mode::enable, CLIENT_SSL));
+                conditional_capability(ssl == ssl_mode::enable && !secure_transport_, CLIENT_SSL));
         return error_code();
     }
 
-    error_code process_handshake(bytestring& buffer, error_info& info)
+    error_code process_handshake(resource_bytestring& buffer, error_info& info)
     {
         // Deserialize server greeting
         handshake_packet handshake;
@@ -110,18 +133,19 @@ public:
         err = process_capabilities(handshake);
         if (err)
             return err;
+        status_flags_ = handshake.status_flags.value;
 
         // Compute auth response
         return auth_calc_.calculate(
             handshake.auth_plugin_name.value,
             params_.password(),
             handshake.auth_plugin_data.value(),
-            use_ssl()
+            secure_channel()
         );
     }
 
     // Response to that initial greeting
-    void compose_ssl_request(bytestring& buffer)
+    void compose_ssl_request(resource_bytestring& buffer)
     {
         ssl_request sslreq {
             int4(negotiated_capabilities().get()),
@@ -134,7 +158,7 @@ public:
         serialize_message(sslreq, negotiated_caps_, buffer);
     }
 
-    void compose_handshake_response(bytestring& buffer)
+    void compose_handshake_response(resource_bytestring& buffer)
     {
         // Compose response
         handshake_response_packet response {
@@ -153,7 +177,7 @@ public:
 
     // Server handshake response
     error_code process_handshake_server_response(
-        bytestring& buffer,
+        resource_bytestring& buffer,
         auth_result& result,
         error_info& info
     )
@@ -165,6 +189,12 @@ public:
         if (msg_type == ok_packet_header)
         {
             // Auth success via fast auth path
+            ok_packet ok;
+            err = deserialize_message(ctx, ok);
+            if (err)
+                return err;
+            status_flags_ = ok.status_flags.value;
+            session_state_info_ = ok.session_state_info.value;
             result = auth_result::complete;
             return error_code();
         }
@@ -186,7 +216,7 @@ public:
                 auth_sw.plugin_name.value,
                 params_.password(),
                 auth_sw.auth_plugin_data.value,
-                use_ssl()
+                secure_channel()
             );
             if (err)
                 return err;
@@ -218,7 +248,7 @@ public:
                 auth_calc_.plugin_name(),
                 params_.password(),
                 challenge,
-                use_ssl()
+                secure_channel()
             );
             if (err)
                 return err;
@@ -252,7 +282,7 @@ void boost::mysql::detail::handshake(
 )
 {
     // Set up processor
-    handshake_processor processor (params);
+    handshake_processor processor (params, is_secure_transport<StreamType>::value);
 
     // Read server greeting
     channel.read(channel.shared_buffer(), err);
@@ -263,6 +293,7 @@ void boost::mysql::detail::handshake(
     err = processor.process_handshake(channel.shared_buffer(), info);
     if (err)
         return;
+    channel.observe_handshake_phase(handshake_phase::greeting_received);
 
     // Setup SSL if required
     if (processor.use_ssl())
@@ -274,9 +305,10 @@ void boost::mysql::detail::handshake(
             return;
 
         // SSL handshake
-        channel.ssl_handshake(err);
+        channel.ssl_handshake(params.ssl(), err);
         if (err)
             return;
+        channel.observe_handshake_phase(handshake_phase::tls_established);
     }
 
     // Handshake response
@@ -304,10 +336,20 @@ void boost::mysql::detail::handshake(
             channel.write(boost::asio::buffer(channel.shared_buffer()), err);
             if (err)
                 return;
+            channel.observe_handshake_phase(handshake_phase::auth_round_trip);
         }
     };
 
     channel.set_current_capabilities(processor.negotiated_capabilities());
+    channel.set_current_collation(params.connection_collation());
+    channel.reset_session(
+        processor.params().database(),
+        processor.status_flags(),
+        processor.session_state_info()
+    );
+    channel.capture_handshake_complete();
+    channel.store_ssl_session();
+    channel.observe_handshake_phase(handshake_phase::authenticated);
 }
 
 namespace boost {
@@ -327,7 +369,7 @@ struct handshake_op : async_op<StreamType>
   const connection_params& params
   ) :
   async_op<StreamType>(channel, output_info),
-  processor_(params)
+  processor_(params, is_secure_transport<StreamType>::value)
   {
   }
 
@@ -335,6 +377,14 @@ struct handshake_op : async_op<StreamType>
   void complete(Self& self, error_code code, error_info&& info = {})
   {
     this->get_channel().set_current_capabilities(processor_.negotiated_capabilities());
+    this->get_channel().set_current_collation(processor_.params().connection_collation());
+    this->get_channel().reset_session(
+        processor_.params().database(),
+        processor_.status_flags(),
+        processor_.session_state_info()
+    );
+    if (!code)
+        this->get_channel().capture_handshake_complete();
     conditional_assign(this->get_output_info(), std::move(info));
     self.complete(code);
   }
@@ -366,6 +416,7 @@ struct handshake_op : async_op<StreamType>
           complete(self, err, std::move(info));
           BOOST_ASIO_CORO_YIELD break;
         }
+        this->get_channel().observe_handshake_phase(handshake_phase::greeting_received);
 
         // SSL
         if (processor_.use_ssl())
@@ -375,7 +426,11 @@ struct handshake_op : async_op<StreamType>
           BOOST_ASIO_CORO_YIELD this->async_write(std::move(self));
 
           // SSL handshake
-          BOOST_ASIO_CORO_YIELD this->get_channel().async_ssl_handshake(std::move(self));
+          BOOST_ASIO_CORO_YIELD this->get_channel().async_ssl_handshake(
+              processor_.params().ssl(),
+              std::move(self)
+          );
+          this->get_channel().observe_handshake_phase(handshake_phase::tls_established);
         }
 
         // Compose and send handshake response
@@ -403,9 +458,12 @@ struct handshake_op : async_op<StreamType>
           {
             // We received an auth switch response and we have the response ready to be sent
             BOOST_ASIO_CORO_YIELD this->async_write(std::move(self));
+            this->get_channel().observe_handshake_phase(handshake_phase::auth_round_trip);
           }
         }
 
+        this->get_channel().store_ssl_session();
+        this->get_channel().observe_handshake_phase(handshake_phase::authenticated);
         complete(self, error_code());
       }
   }
@@ -17,12 +17,25 @@ class prepare_statement_processor
 {
     channel<StreamType>& channel_;
     com_stmt_prepare_ok_packet response_;
+    std::vector<boost::asio::const_buffer> request_;
 public:
     prepare_statement_processor(channel<StreamType>& chan): channel_(chan) {}
-    void process_request(std::string_view statement)
+
+    // If reference_strings is true, a long statement is sent directly
+    // from the memory it lives in, instead of being copied
+    void process_request(std::string_view statement, bool reference_strings)
     {
+        channel_.observe_command_start(command_type::prepare, statement);
         com_stmt_prepare_packet packet { string_eof(statement) };
-        serialize_message(packet, channel_.current_capabilities(), channel_.shared_buffer());
+        if (reference_strings)
+        {
+            serialize_message_gather(packet, channel_.current_capabilities(),
+                    channel_.shared_buffer(), request_);
+        }
+        else
+        {
+            serialize_message(packet, channel_.current_capabilities(), channel_.shared_buffer());
+        }
         channel_.reset_sequence_number();
     }
     void process_response(error_code& err, error_info& info)
@@ -50,6 +63,7 @@ public:
         }
     }
     auto& get_buffer() noexcept { return channel_.shared_buffer(); }
+    const auto& get_request() const noexcept { return request_; }
     auto& get_channel() noexcept { return channel_; }
     const auto& get_response() const noexcept { return response_; }
 
@@ -59,25 +73,16 @@ public:
     }
 };
 
-} // detail
-} // mysql
-} // boost
-
+// Sends the request and reads the response, including metadata
 template <typename StreamType>
-void boost::mysql::detail::prepare_statement(
-    channel<StreamType>& channel,
-    std::string_view statement,
+void prepare_statement_impl(
+    prepare_statement_processor<StreamType>& processor,
     error_code& err,
-    error_info& info,
-    prepared_statement<StreamType>& output
+    error_info& info
 )
 {
-    // Prepare message
-    prepare_statement_processor<StreamType> processor (channel);
-    processor.process_request(statement);
-
     // Write message
-    processor.get_channel().write(boost::asio::buffer(processor.get_buffer()), err);
+    processor.get_channel().write(processor.get_request(), err);
     if (err)
         return;
 
@@ -99,9 +104,29 @@ void boost::mysql::detail::prepare_statement(
         if (err)
             return;
     }
+}
+
+} // detail
+} // mysql
+} // boost
+
+template <typename StreamType>
+void boost::mysql::detail::prepare_statement(
+    channel<StreamType>& channel,
+    std::string_view statement,
+    error_code& err,
+    error_info& info,
+    prepared_statement<StreamType>& output
+)
+{
+    // Prepare message
+    prepare_statement_processor<StreamType> processor (channel);
+    processor.process_request(statement, true);
 
-    // Compose response
-    output = prepared_statement<StreamType>(channel, processor.get_response());
+    prepare_statement_impl(processor, err, info);
+    if (!err)
+        output = prepared_statement<StreamType>(channel, processor.get_response());
+    channel.observe_command_end(err);
 }
 
 namespace boost {
@@ -123,7 +148,7 @@ struct prepare_statement_op : async_op<StreamType>
   processor_(chan),
       remaining_meta_(0)
   {
-    processor_.process_request(statement);
+    processor_.process_request(statement, false);
   }
 
   template<class Self>
@@ -135,7 +160,7 @@ struct prepare_statement_op : async_op<StreamType>
     // Error checking
     if (err)
     {
-      this->complete(self, err, prepared_statement<StreamType>());
+      self.complete(err, prepared_statement<StreamType>());
       return;
     }
 
@@ -153,8 +178,9 @@ struct prepare_statement_op : async_op<StreamType>
         processor_.process_response(err, info);
         if (err)
         {
+          processor_.get_channel().observe_command_end(err);
           detail::conditional_assign(this->get_output_info(), std::move(info));
-          this->complete(self, err, prepared_statement<StreamType>());
+          self.complete(err, prepared_statement<StreamType>());
           BOOST_ASIO_CORO_YIELD break;
         }
 
@@ -167,8 +193,8 @@ struct prepare_statement_op : async_op<StreamType>
         }
 
         // Compose response
-        this->complete(
-            self,
+        processor_.get_channel().observe_command_end(err);
+        self.complete(
             err,
             prepared_statement<StreamType>(processor_.get_channel(), processor_.get_response())
         );
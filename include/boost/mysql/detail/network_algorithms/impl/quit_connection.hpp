@@ -17,6 +17,8 @@ void compose_quit(
     channel<StreamType>& chan
 )
 {
+    // The command ends once written
+    chan.observe_command_start(command_type::quit, std::string_view());
     serialize_message(
         quit_packet(),
         chan.current_capabilities(),
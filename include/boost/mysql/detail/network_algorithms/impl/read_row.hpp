@@ -18,7 +18,7 @@ inline read_row_result process_read_message(
     deserialize_row_fn deserializer,
     capabilities current_capabilities,
     const std::vector<field_metadata>& meta,
-    const bytestring& buffer,
+    const resource_bytestring& buffer,
     std::vector<value>& output_values,
     ok_packet& output_ok_packet,
     error_code& err,
@@ -27,13 +27,14 @@ inline read_row_result process_read_message(
 {
     assert(deserializer);
 
-    // Message type: row, error or eof?
+    // Message type: row, error or eof? Rows whose first field is at least
+    // 16MB long start by 0xfe, too, but EOF packets are always shorter than that
     std::uint8_t msg_type;
     deserialization_context ctx (boost::asio::buffer(buffer), current_capabilities);
     std::tie(err, msg_type) = deserialize_message_type(ctx);
     if (err)
         return read_row_result::error;
-    if (msg_type == eof_packet_header)
+    if (msg_type == eof_packet_header && buffer.size() < MAX_PACKET_SIZE)
     {
         // end of resultset
         err = deserialize_message(ctx, output_ok_packet);
@@ -59,6 +60,62 @@ inline read_row_result process_read_message(
     }
 }
 
+// Like process_read_message, but rows are not deserialized
+inline read_row_result process_discarded_message(
+    capabilities current_capabilities,
+    const resource_bytestring& buffer,
+    ok_packet& output_ok_packet,
+    error_code& err,
+    error_info& info
+)
+{
+    // Rows may start by 0xfe, too, if their first field is at least 16MB long.
+    // EOF packets are always shorter than that
+    std::uint8_t msg_type;
+    deserialization_context ctx (boost::asio::buffer(buffer), current_capabilities);
+    std::tie(err, msg_type) = deserialize_message_type(ctx);
+    if (err)
+        return read_row_result::error;
+    if (msg_type == eof_packet_header && buffer.size() < MAX_PACKET_SIZE)
+    {
+        err = deserialize_message(ctx, output_ok_packet);
+        return err ? read_row_result::error : read_row_result::eof;
+    }
+    else if (msg_type == error_packet_header)
+    {
+        err = process_error_packet(ctx, info);
+        return read_row_result::error;
+    }
+    else
+    {
+        return read_row_result::row;
+    }
+}
+
+// Updates the channel after processing a message, which started at decode_start
+template <typename StreamType>
+void process_read_row_result(
+    channel<StreamType>& chan,
+    read_row_result result,
+    const ok_packet& ok,
+    error_code err,
+    std::chrono::steady_clock::time_point decode_start
+)
+{
+    if (result == read_row_result::row)
+    {
+        chan.observe_row_decoded(decode_start);
+    }
+    else
+    {
+        if (result == read_row_result::eof)
+            chan.process_ok_packet(ok);
+        else if (err.category() == mysql_error_category && err.value() >= static_cast<int>(errc::incomplete_message))
+            chan.observe_decode_error(); // as opposed to an error sent by the server
+        chan.observe_command_end(err);
+    }
+}
+
 } // detail
 } // mysql
 } // boost
@@ -69,7 +126,7 @@ boost::mysql::detail::read_row_result boost::mysql::detail::read_row(
     deserialize_row_fn deserializer,
     channel<StreamType>& channel,
     const std::vector<field_metadata>& meta,
-    bytestring& buffer,
+    resource_bytestring& buffer,
     std::vector<value>& output_values,
     ok_packet& output_ok_packet,
     error_code& err,
@@ -81,7 +138,8 @@ boost::mysql::detail::read_row_result boost::mysql::detail::read_row(
     if (err)
         return read_row_result::error;
 
-    return process_read_message(
+    auto decode_start = channel.observation_time();
+    auto result = process_read_message(
         deserializer,
         channel.current_capabilities(),
         meta,
@@ -91,6 +149,8 @@ boost::mysql::detail::read_row_result boost::mysql::detail::read_row(
         err,
         info
     );
+    process_read_row_result(channel, result, output_ok_packet, err, decode_start);
+    return result;
 }
 
 namespace boost{ namespace mysql { namespace detail {
@@ -100,7 +160,7 @@ struct read_row_op : async_op<StreamType>
 {
   deserialize_row_fn deserializer_;
   const std::vector<field_metadata>& meta_;
-  bytestring& buffer_;
+  resource_bytestring& buffer_;
   std::vector<value>& output_values_;
   ok_packet& output_ok_packet_;
 
@@ -109,7 +169,7 @@ struct read_row_op : async_op<StreamType>
       error_info* output_info,
   deserialize_row_fn deserializer,
   const std::vector<field_metadata>& meta,
-      bytestring& buffer,
+      resource_bytestring& buffer,
   std::vector<value>& output_values,
       ok_packet& output_ok_packet
   ) :
@@ -130,6 +190,7 @@ struct read_row_op : async_op<StreamType>
   {
     error_info info;
     read_row_result result = read_row_result::error;
+    std::chrono::steady_clock::time_point decode_start;
 
     // Error checking
     if (err)
@@ -145,6 +206,7 @@ struct read_row_op : async_op<StreamType>
         BOOST_ASIO_CORO_YIELD this->async_read(std::move(self), buffer_);
 
         // Process it
+        decode_start = this->get_channel().observation_time();
         result = process_read_message(
             deserializer_,
             this->get_channel().current_capabilities(),
@@ -155,6 +217,7 @@ struct read_row_op : async_op<StreamType>
             err,
             info
         );
+        process_read_row_result(this->get_channel(), result, output_ok_packet_, err, decode_start);
         detail::conditional_assign(this->get_output_info(), std::move(info));
         self.complete(err, result);
       }
@@ -172,7 +235,7 @@ boost::mysql::detail::async_read_row(
     deserialize_row_fn deserializer,
     channel<StreamType>& chan,
     const std::vector<field_metadata>& meta,
-    bytestring& buffer,
+    resource_bytestring& buffer,
     std::vector<value>& output_values,
     ok_packet& output_ok_packet,
     CompletionToken&& token,
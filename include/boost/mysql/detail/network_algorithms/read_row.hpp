@@ -29,7 +29,7 @@ read_row_result read_row(
     deserialize_row_fn deserializer,
     channel<StreamType>& channel,
     const std::vector<field_metadata>& meta,
-    bytestring& buffer,
+    resource_bytestring& buffer,
     std::vector<value>& output_values,
     ok_packet& output_ok_packet,
     error_code& err,
@@ -44,7 +44,7 @@ async_read_row(
     deserialize_row_fn deserializer,
     channel<StreamType>& channel,
     const std::vector<field_metadata>& meta,
-    bytestring& buffer,
+    resource_bytestring& buffer,
     std::vector<value>& output_values,
     ok_packet& output_ok_packet,
     CompletionToken&& token,
@@ -8,9 +8,10 @@
 #ifndef BOOST_MYSQL_DETAIL_PROTOCOL_BINARY_DESERIALIZATION_HPP
 #define BOOST_MYSQL_DETAIL_PROTOCOL_BINARY_DESERIALIZATION_HPP
 
+#include "boost/mysql/detail/config.hpp"
 #include "boost/mysql/detail/protocol/serialization.hpp"
 #include "boost/mysql/error.hpp"
-#include "boost/mysql/value.hpp"
+#include "boost/mysql/row.hpp"
 #include "boost/mysql/metadata.hpp"
 #include <vector>
 
@@ -18,13 +19,13 @@ namespace boost {
 namespace mysql {
 namespace detail {
 
-inline errc deserialize_binary_value(
+BOOST_MYSQL_DECL errc deserialize_binary_value(
     deserialization_context& ctx,
     const field_metadata& meta,
     value& output
 );
 
-inline error_code deserialize_binary_row(
+BOOST_MYSQL_DECL error_code deserialize_binary_row(
     deserialization_context& ctx,
     const std::vector<field_metadata>& meta,
     std::vector<value>& output
@@ -34,6 +35,8 @@ inline error_code deserialize_binary_row(
 } // mysql
 } // boost
 
+#ifdef BOOST_MYSQL_HEADER_ONLY
 #include "boost/mysql/detail/protocol/impl/binary_deserialization.ipp"
+#endif
 
 #endif /* INCLUDE_BOOST_MYSQL_DETAIL_PROTOCOL_BINARY_DESERIALIZATION_HPP_ */
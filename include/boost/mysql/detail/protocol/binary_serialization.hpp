@@ -8,28 +8,42 @@
 #ifndef BOOST_MYSQL_DETAIL_PROTOCOL_BINARY_SERIALIZATION_HPP
 #define BOOST_MYSQL_DETAIL_PROTOCOL_BINARY_SERIALIZATION_HPP
 
+#include "boost/mysql/detail/config.hpp"
 #include "boost/mysql/value.hpp"
+#include "boost/mysql/statement_param.hpp"
 #include "boost/mysql/detail/protocol/serialization.hpp"
 
 namespace boost {
 namespace mysql {
 namespace detail {
 
-inline std::size_t get_binary_value_size(
+BOOST_MYSQL_DECL std::size_t get_binary_value_size(
     const serialization_context& ctx,
     const value& input
 ) noexcept;
 
-inline void serialize_binary_value(
+BOOST_MYSQL_DECL void serialize_binary_value(
     serialization_context& ctx,
     const value& input
 ) noexcept;
 
+BOOST_MYSQL_DECL std::size_t get_binary_value_size(
+    const serialization_context& ctx,
+    const statement_param& input
+) noexcept;
+
+BOOST_MYSQL_DECL void serialize_binary_value(
+    serialization_context& ctx,
+    const statement_param& input
+) noexcept;
+
 
 } // detail
 } // mysql
 } // boost
 
+#ifdef BOOST_MYSQL_HEADER_ONLY
 #include "boost/mysql/detail/protocol/impl/binary_serialization.ipp"
+#endif
 
 #endif
@@ -83,7 +83,7 @@ public:
 * CLIENT_CONNECT_ATTRS: unset //  Client supports connection attributes
 * CLIENT_PLUGIN_AUTH_LENENC_CLIENT_DATA: mandatory //  Enable authentication response packet to be larger than 255 bytes
 * CLIENT_CAN_HANDLE_EXPIRED_PASSWORDS: unset //  Don't close the connection for a user account with expired password
-* CLIENT_SESSION_TRACK: unset //  Capable of handling server state change information
+* CLIENT_SESSION_TRACK: optional //  Capable of handling server state change information
 * CLIENT_DEPRECATE_EOF: mandatory //  Client no longer needs EOF_Packet and will use OK_Packet instead
 * CLIENT_SSL_VERIFY_SERVER_CERT: unset //  Verify server certificate
 * CLIENT_OPTIONAL_RESULTSET_METADATA: unset //  The client can handle optional metadata information in the resultset
@@ -95,6 +95,7 @@ public:
 * CLIENT_PLUGIN_AUTH: mandatory //  Client supports plugin authentication
 * CLIENT_PLUGIN_AUTH_LENENC_CLIENT_DATA: mandatory //  Enable authentication response packet to be larger than 255 bytes
 * CLIENT_DEPRECATE_EOF: mandatory //  Client no longer needs EOF_Packet and will use OK_Packet instead
+* CLIENT_SESSION_TRACK: optional //  Capable of handling server state change information
  */
 
 constexpr capabilities mandatory_capabilities {
@@ -105,7 +106,9 @@ constexpr capabilities mandatory_capabilities {
     CLIENT_SECURE_CONNECTION
 };
 
-constexpr capabilities optional_capabilities {0};
+constexpr capabilities optional_capabilities {
+    CLIENT_SESSION_TRACK
+};
 
 } // detail
 } // mysql
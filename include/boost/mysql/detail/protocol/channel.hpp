@@ -9,7 +9,14 @@
 #define BOOST_MYSQL_DETAIL_PROTOCOL_CHANNEL_HPP
 
 #include "boost/mysql/error.hpp"
+#include "boost/mysql/collation.hpp"
+#include "boost/mysql/connection_params.hpp"
+#include "boost/mysql/session_state.hpp"
+#include "boost/mysql/connection_observer.hpp"
+#include "boost/mysql/protocol_capture.hpp"
+#include "boost/mysql/connection_stats.hpp"
 #include "boost/mysql/detail/auxiliar/bytestring.hpp"
+#include "boost/mysql/detail/auxiliar/connection_counters.hpp"
 #include "boost/mysql/detail/protocol/capabilities.hpp"
 #include <boost/asio/buffer.hpp>
 #include <boost/asio/async_result.hpp>
@@ -18,12 +25,16 @@
 #include <boost/asio/coroutine.hpp>
 #include <boost/beast/core/async_base.hpp>
 #include <array>
+#include <chrono>
+#include <memory_resource>
 #include <optional>
 
 namespace boost {
 namespace mysql {
 namespace detail {
 
+struct ok_packet;
+
 // Implements the message layer of the MySQL protocol
 template <typename Stream>
 class channel
@@ -31,78 +42,144 @@ class channel
     // TODO: static asserts for Stream concept
     struct ssl_block
     {
-        boost::asio::ssl::context ctx;
+        std::optional<boost::asio::ssl::context> own_ctx; // only if the user didn't supply one
         boost::asio::ssl::stream<Stream&> stream;
 
-        ssl_block(Stream& base_stream):
-            ctx(boost::asio::ssl::context::tls_client),
-            stream (base_stream, ctx) {}
+        ssl_block(Stream& base_stream, boost::asio::ssl::context* user_ctx):
+            stream (
+                base_stream,
+                user_ctx ? *user_ctx : own_ctx.emplace(boost::asio::ssl::context::tls_client)
+            ) {}
     };
 
     Stream& stream_;
+    std::pmr::memory_resource* resource_; // for all buffers owned by the connection
     std::optional<ssl_block> ssl_block_;
+    ssl_session_cache* session_cache_ {}; // set during TLS handshake
     std::uint8_t sequence_number_ {0};
     std::array<std::uint8_t, 4> header_buffer_ {}; // for async ops
-    bytestring shared_buff_; // for async ops
+    resource_bytestring shared_buff_; // for async ops
+    resource_bytestring read_ahead_buff_; // bytes read from the stream but not yet consumed
+    std::size_t read_ahead_first_ {0};
+    std::size_t read_ahead_last_ {0};
+    std::size_t read_ahead_size_ {0}; // 0 means disabled
+    bool reading_ahead_ {false}; // whether the last prepare_read() targeted read_ahead_buff_
     capabilities current_caps_;
+    collation current_collation_ {collation::utf8_general_ci};
+    session_state session_state_; // includes the status flags
+    connection_observer* observer_ {}; // nothing is measured if null
+    bool command_in_progress_ {false};
+    std::chrono::steady_clock::time_point command_start_;
+    command_stats command_stats_;
+    std::pmr::string sql_digest_; // command_stats_.sql_digest points here
+    capture_writer* capture_ {}; // messages are captured only if set
+    bool handshake_complete_ {false}; // client messages are captured without payload until set
+    connection_counters counters_; // always updated
 
     bool process_sequence_number(std::uint8_t got);
     std::uint8_t next_sequence_number() { return sequence_number_++; }
 
+    template <typename BufferSeq>
+    void capture_client_message(std::uint8_t first_sequence_number, const BufferSeq& buffers);
+
     error_code process_header_read(std::uint32_t& size_to_read); // reads from header_buffer_
     void process_header_write(std::uint32_t size_to_write); // writes to header_buffer_
 
-    void create_ssl_block() { ssl_block_.emplace(stream_); }
+    void create_ssl_block(const ssl_options& opts);
 
     template <typename BufferSeq>
     std::size_t read_impl(BufferSeq&& buff, error_code& ec);
 
+    template <typename BufferSeq, typename CompletionCondition>
+    std::size_t read_impl(BufferSeq&& buff, CompletionCondition cond, error_code& ec);
+
     template <typename BufferSeq>
     std::size_t write_impl(BufferSeq&& buff, error_code& ec);
 
     template <typename BufferSeq, typename CompletionToken>
     auto async_read_impl(BufferSeq&& buff, CompletionToken&& token);
 
+    template <typename BufferSeq, typename CompletionCondition, typename CompletionToken>
+    auto async_read_impl(BufferSeq&& buff, CompletionCondition cond, CompletionToken&& token);
+
     template <typename BufferSeq, typename CompletionToken>
     auto async_write_impl(BufferSeq&& buff, CompletionToken&& token);
 
-    struct read_op;
+    // Read-ahead. Messages are read in two steps (header and payload). With read-ahead
+    // enabled, small steps read up to read_ahead_size_ bytes from the stream into
+    // read_ahead_buff_, so following steps can be served without a read call.
+    // Reading into buff is done as follows:
+    //   if (!copy_from_read_ahead(buff))
+    //       commit_read(buff, read(prepare_read(buff), transfer_at_least(buff.size())));
+    // These functions advance buff past the bytes they copy into it
+    bool copy_from_read_ahead(boost::asio::mutable_buffer& buff) noexcept; // true if buff is full
+    boost::asio::mutable_buffer prepare_read(boost::asio::mutable_buffer buff);
+    void commit_read(boost::asio::mutable_buffer& buff, std::size_t bytes_transferred) noexcept;
+    void read_exactly(boost::asio::mutable_buffer buff, error_code& ec);
+
+    // Counter updates and observer notifications for completed reads and writes. I/O errors end the current command
+    void observe_read(std::size_t payload_size, error_code err);
+    void observe_write(std::size_t payload_size, error_code err);
+    void observe_io(std::size_t payload_size, error_code err, bool is_write);
+
+    template <typename Allocator> struct read_op;
+
+    template <typename ConstBufferSequence>
     struct write_op;
 public:
     using executor_type = typename Stream::executor_type;
 
-    channel(Stream& stream): stream_(stream) {}
+    channel(
+        Stream& stream,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) :
+        stream_(stream),
+        resource_(resource),
+        shared_buff_(resource),
+        read_ahead_buff_(resource),
+        session_state_(resource),
+        sql_digest_(resource)
+    {
+    }
 
     executor_type get_executor() {return stream_.get_executor();}
 
     // Reading
-    void read(bytestring& buffer, error_code& code);
+    template <typename Allocator>
+    void read(basic_bytestring<Allocator>& buffer, error_code& code);
 
     using read_signature = void(error_code);
 
-    template <typename CompletionToken>
+    template <typename Allocator, typename CompletionToken>
     BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, read_signature)
-    async_read(bytestring& buffer, CompletionToken&& token);
+    async_read(basic_bytestring<Allocator>& buffer, CompletionToken&& token);
 
-    // Writing
-    void write(boost::asio::const_buffer buffer, error_code& code);
+    // Writing. The message payload is the concatenation of all the buffers
+    // in the sequence, which are written without copying them
+    template <typename ConstBufferSequence>
+    void write(const ConstBufferSequence& buffers, error_code& code);
 
     using write_signature = void(error_code);
 
-    template <typename CompletionToken>
+    template <typename ConstBufferSequence, typename CompletionToken>
     BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, write_signature)
-    async_write(boost::asio::const_buffer buffer, CompletionToken&& token);
+    async_write(const ConstBufferSequence& buffers, CompletionToken&& token);
 
     // SSL
     bool ssl_active() const noexcept { return ssl_block_.has_value(); }
 
-    void ssl_handshake(error_code& ec);
+    void ssl_handshake(const ssl_options& opts, error_code& ec);
 
     using ssl_handshake_signature = void(error_code);
 
     template <typename CompletionToken>
     BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, ssl_handshake_signature)
-    async_ssl_handshake(CompletionToken&& token);
+    async_ssl_handshake(const ssl_options& opts, CompletionToken&& token);
+
+    // Stores the current TLS session in the session cache passed to ssl_handshake, if any.
+    // Should be called once the MySQL handshake is complete: in TLS 1.3, session
+    // tickets are sent by the server after the TLS handshake has finished
+    void store_ssl_session();
 
     // Closing (only available for sockets)
     error_code close();
@@ -119,9 +196,57 @@ public:
     capabilities current_capabilities() const noexcept { return current_caps_; }
     void set_current_capabilities(capabilities value) noexcept { current_caps_ = value; }
 
+    // Connection collation, as sent to the server during handshake
+    collation current_collation() const noexcept { return current_collation_; }
+    void set_current_collation(collation value) noexcept { current_collation_ = value; }
+
+    // Server status flags, as reported by the last OK packet
+    std::uint16_t status_flags() const noexcept { return session_state_.status_flags(); }
+
+    // Session state, updated with the status flags and session state changes of each OK packet.
+    // reset_session is called on handshake, after setting the current capabilities
+    const session_state& current_session() const noexcept { return session_state_; }
+    void reset_session(std::string_view schema, std::uint16_t status_flags, std::string_view session_state_info);
+    void process_ok_packet(const ok_packet& pack);
+
+    // Read-ahead: maximum number of bytes to request from the stream in a single read.
+    // Takes effect the next time the read-ahead buffer is empty
+    std::size_t read_ahead_size() const noexcept { return read_ahead_size_; }
+    void set_read_ahead_size(std::size_t value) noexcept { read_ahead_size_ = value; }
+
+    // Observer (see connection_observer). The observe_ functions update the connection
+    // counters, and notify the observer, if any. Commands end when their response is complete (or on error),
+    // as reported by the network algorithms. Commands without a response
+    // (quit and close_statement) end when they have been written
+    connection_observer* observer() const noexcept { return observer_; }
+    void set_observer(connection_observer* value) noexcept { observer_ = value; command_in_progress_ = false; }
+    std::chrono::steady_clock::time_point observation_time() const noexcept
+    {
+        return observer_ ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+    }
+    void observe_handshake_phase(handshake_phase phase) { if (observer_) observer_->on_handshake_phase(phase); }
+    void observe_command_start(command_type type, std::string_view sql);
+    void observe_row_decoded(std::chrono::steady_clock::time_point decode_start);
+    void observe_decode_error() noexcept { counters_.decode_errors.add(1); }
+    void observe_command_end(error_code err);
+
+    // Protocol capture (see capture_writer). Successfully read and written messages are
+    // recorded. capture_handshake_complete should be called once the handshake is complete.
+    // Until then, client messages are recorded without payload, as they carry
+    // authentication data (including the password in clear text, for caching_sha2_password)
+    capture_writer* capture() const noexcept { return capture_; }
+    void set_capture(capture_writer* value) noexcept { capture_ = value; }
+    void capture_handshake_complete();
+
+    // Counters (see connection_stats). May be called from any thread
+    connection_stats stats() const noexcept { return counters_.snapshot(); }
+
+    // Memory resource. Buffers for resultsets, rows and metadata should be created using this
+    std::pmr::memory_resource* memory_resource() const noexcept { return resource_; }
+
     // Internal buffer
-    const bytestring& shared_buffer() const noexcept { return shared_buff_; }
-    bytestring& shared_buffer() noexcept { return shared_buff_; }
+    const resource_bytestring& shared_buffer() const noexcept { return shared_buff_; }
+    resource_bytestring& shared_buffer() noexcept { return shared_buff_; }
 };
 
 template <
@@ -161,8 +286,8 @@ public:
     template<class Self>
     void async_read(Self&& self) { async_read(std::move(self), channel_.shared_buffer()); }
 
-    template<class Self>
-    void async_read(Self&& self, bytestring& buff)
+    template<class Self, typename Allocator>
+    void async_read(Self&& self, basic_bytestring<Allocator>& buff)
     {
         channel_.async_read(
             buff,
@@ -170,15 +295,21 @@ public:
         );
     }
 
-    template<class Self>
-    void async_write(Self&& self, const bytestring& buff)
+    template<class Self, typename ConstBufferSequence>
+    void async_write(Self&& self, const ConstBufferSequence& buffers)
     {
         channel_.async_write(
-            boost::asio::buffer(buff),
+            buffers,
             std::move(self)
         );
     }
 
+    template<class Self, typename Allocator>
+    void async_write(Self&& self, const basic_bytestring<Allocator>& buff)
+    {
+        async_write(std::move(self), boost::asio::buffer(buff));
+    }
+
     template <class Self>
     void async_write(Self&& self) { async_write(std::move(self), channel_.shared_buffer()); }
 };
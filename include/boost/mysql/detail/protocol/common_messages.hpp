@@ -8,6 +8,7 @@
 #ifndef BOOST_MYSQL_DETAIL_PROTOCOL_COMMON_MESSAGES_HPP
 #define BOOST_MYSQL_DETAIL_PROTOCOL_COMMON_MESSAGES_HPP
 
+#include "boost/mysql/detail/config.hpp"
 #include "boost/mysql/detail/protocol/serialization.hpp"
 #include "boost/mysql/detail/protocol/constants.hpp"
 #include "boost/mysql/collation.hpp"
@@ -41,8 +42,8 @@ struct ok_packet
     int_lenenc last_insert_id;
     int2 status_flags; // server_status_flags
     int2 warnings;
-    // CLIENT_SESSION_TRACK: not implemented
     string_lenenc info;
+    string_lenenc session_state_info; // if CLIENT_SESSION_TRACK and SERVER_SESSION_STATE_CHANGED
 };
 
 template <>
@@ -53,7 +54,8 @@ struct get_struct_fields<ok_packet>
         &ok_packet::last_insert_id,
         &ok_packet::status_flags,
         &ok_packet::warnings,
-        &ok_packet::info
+        &ok_packet::info,
+        &ok_packet::session_state_info
     );
 };
 
@@ -61,7 +63,7 @@ template <>
 struct serialization_traits<ok_packet, serialization_tag::struct_with_fields> :
     noop_serialize<ok_packet>
 {
-    static inline errc deserialize_(deserialization_context& ctx, ok_packet& output) noexcept;
+    static BOOST_MYSQL_DECL errc deserialize_(deserialization_context& ctx, ok_packet& output) noexcept;
 };
 
 // err packet
@@ -123,7 +125,7 @@ template <>
 struct serialization_traits<column_definition_packet, serialization_tag::struct_with_fields> :
     noop_serialize<column_definition_packet>
 {
-    static inline errc deserialize_(deserialization_context& ctx, column_definition_packet& output) noexcept;
+    static BOOST_MYSQL_DECL errc deserialize_(deserialization_context& ctx, column_definition_packet& output) noexcept;
 };
 
 // connection quit
@@ -139,13 +141,15 @@ struct get_struct_fields<quit_packet>
 };
 
 // aux
-inline error_code process_error_packet(deserialization_context& ctx, error_info& info);
+BOOST_MYSQL_DECL error_code process_error_packet(deserialization_context& ctx, error_info& info);
 
 
 } // detail
 } // mysql
 } // boost
 
+#ifdef BOOST_MYSQL_HEADER_ONLY
 #include "boost/mysql/detail/protocol/impl/common_messages.ipp"
+#endif
 
 #endif /* INCLUDE_BOOST_MYSQL_DETAIL_PROTOCOL_COMMON_MESSAGES_HPP_ */
@@ -73,6 +73,18 @@ constexpr std::uint8_t auth_switch_request_header = 0xfe;
 constexpr std::uint8_t auth_more_data_header = 0x01;
 constexpr std::string_view fast_auth_complete_challenge = "\3";
 
+// Session state change types (in OK packets, if CLIENT_SESSION_TRACK)
+namespace session_track {
+
+constexpr std::uint8_t system_variables = 0;
+constexpr std::uint8_t schema = 1;
+constexpr std::uint8_t state_change = 2;
+constexpr std::uint8_t gtids = 3;
+constexpr std::uint8_t transaction_characteristics = 4;
+constexpr std::uint8_t transaction_state = 5;
+
+} // session_track
+
 // Column flags
 namespace column_flags {
 
@@ -8,6 +8,7 @@
 #ifndef BOOST_MYSQL_DETAIL_PROTOCOL_HANDSHAKE_MESSAGES_HPP
 #define BOOST_MYSQL_DETAIL_PROTOCOL_HANDSHAKE_MESSAGES_HPP
 
+#include "boost/mysql/detail/config.hpp"
 #include "boost/mysql/detail/protocol/serialization.hpp"
 #include "boost/mysql/detail/auxiliar/static_string.hpp"
 
@@ -48,7 +49,7 @@ template <>
 struct serialization_traits<handshake_packet, serialization_tag::struct_with_fields> :
     noop_serialize<handshake_packet>
 {
-    static inline errc deserialize_(deserialization_context& ctx, handshake_packet& output) noexcept;
+    static BOOST_MYSQL_DECL errc deserialize_(deserialization_context& ctx, handshake_packet& output) noexcept;
 };
 
 // response
@@ -83,9 +84,9 @@ template <>
 struct serialization_traits<handshake_response_packet, serialization_tag::struct_with_fields> :
     noop_deserialize<handshake_response_packet>
 {
-    static inline std::size_t get_size_(const serialization_context& ctx,
+    static BOOST_MYSQL_DECL std::size_t get_size_(const serialization_context& ctx,
             const handshake_response_packet& value) noexcept;
-    static inline void serialize_(serialization_context& ctx,
+    static BOOST_MYSQL_DECL void serialize_(serialization_context& ctx,
             const handshake_response_packet& value) noexcept;
 };
 
@@ -143,7 +144,7 @@ template <>
 struct serialization_traits<auth_switch_request_packet, serialization_tag::struct_with_fields> :
     noop_serialize<auth_switch_request_packet>
 {
-    static inline errc deserialize_(deserialization_context& ctx,
+    static BOOST_MYSQL_DECL errc deserialize_(deserialization_context& ctx,
             auth_switch_request_packet& output) noexcept;
 };
 
@@ -166,6 +167,8 @@ struct get_struct_fields<auth_more_data_packet>
 } // mysql
 } // boost
 
+#ifdef BOOST_MYSQL_HEADER_ONLY
 #include "boost/mysql/detail/protocol/impl/handshake_messages.ipp"
+#endif
 
 #endif /* INCLUDE_BOOST_MYSQL_DETAIL_PROTOCOL_HANDSHAKE_MESSAGES_HPP_ */
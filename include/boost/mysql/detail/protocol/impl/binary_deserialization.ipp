@@ -307,7 +307,7 @@ inline errc deserialize_binary_value_time(
 } // mysql
 } // boost
 
-inline boost::mysql::errc boost::mysql::detail::deserialize_binary_value(
+BOOST_MYSQL_DECL boost::mysql::errc boost::mysql::detail::deserialize_binary_value(
     deserialization_context& ctx,
     const field_metadata& meta,
     value& output
@@ -356,7 +356,7 @@ inline boost::mysql::errc boost::mysql::detail::deserialize_binary_value(
     }
 }
 
-inline boost::mysql::error_code boost::mysql::detail::deserialize_binary_row(
+BOOST_MYSQL_DECL boost::mysql::error_code boost::mysql::detail::deserialize_binary_row(
     deserialization_context& ctx,
     const std::vector<field_metadata>& meta,
     std::vector<value>& output
@@ -380,7 +380,7 @@ inline boost::mysql::error_code boost::mysql::detail::deserialize_binary_row(
     ctx.advance(null_bitmap.byte_count());
 
     // Actual values
-    for (std::vector<value>::size_type i = 0; i < output.size(); ++i)
+    for (std::size_t i = 0; i < output.size(); ++i)
     {
         if (null_bitmap.is_null(null_bitmap_begin, i))
         {
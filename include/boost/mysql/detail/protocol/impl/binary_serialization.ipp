@@ -110,6 +110,26 @@ inline void serialize_binary_value_impl(
     );
 }
 
+// DECIMAL is sent as a length-encoded string, like the server does
+inline std::size_t get_binary_value_size_impl(
+    const serialization_context& ctx,
+    const decimal& input
+) noexcept
+{
+    char buffer [decimal::max_string_size];
+    std::size_t size = input.to_chars(buffer);
+    return get_size(ctx, string_lenenc(std::string_view(buffer, size)));
+}
+
+inline void serialize_binary_value_impl(
+    serialization_context& ctx,
+    const decimal& input
+) noexcept
+{
+    char buffer [decimal::max_string_size];
+    std::size_t size = input.to_chars(buffer);
+    serialize(ctx, string_lenenc(std::string_view(buffer, size)));
+}
 
 struct size_visitor
 {
@@ -148,7 +168,7 @@ struct serialize_visitor
 } // boost
 
 
-inline std::size_t boost::mysql::detail::get_binary_value_size(
+BOOST_MYSQL_DECL std::size_t boost::mysql::detail::get_binary_value_size(
     const serialization_context& ctx,
     const value& input
 ) noexcept
@@ -156,7 +176,7 @@ inline std::size_t boost::mysql::detail::get_binary_value_size(
     return std::visit(size_visitor(ctx), input.to_variant());
 }
 
-inline void boost::mysql::detail::serialize_binary_value(
+BOOST_MYSQL_DECL void boost::mysql::detail::serialize_binary_value(
     serialization_context& ctx,
     const value& input
 ) noexcept
@@ -164,6 +184,27 @@ inline void boost::mysql::detail::serialize_binary_value(
     std::visit(serialize_visitor(ctx), input.to_variant());
 }
 
+BOOST_MYSQL_DECL std::size_t boost::mysql::detail::get_binary_value_size(
+    const serialization_context& ctx,
+    const statement_param& input
+) noexcept
+{
+    if (const auto* d = std::get_if<decimal>(&input.to_variant()))
+        return get_binary_value_size_impl(ctx, *d);
+    return get_binary_value_size(ctx, std::get<value>(input.to_variant()));
+}
+
+BOOST_MYSQL_DECL void boost::mysql::detail::serialize_binary_value(
+    serialization_context& ctx,
+    const statement_param& input
+) noexcept
+{
+    if (const auto* d = std::get_if<decimal>(&input.to_variant()))
+        serialize_binary_value_impl(ctx, *d);
+    else
+        serialize_binary_value(ctx, std::get<value>(input.to_variant()));
+}
+
 
 
 #endif
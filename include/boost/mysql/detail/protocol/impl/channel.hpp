@@ -11,7 +11,12 @@
 #include <boost/asio/read.hpp>
 #include <boost/asio/write.hpp>
 #include <boost/asio/compose.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/beast/core/buffers_cat.hpp>
+#include <boost/beast/core/buffers_prefix.hpp>
+#include <boost/beast/core/buffers_suffix.hpp>
 #include <cassert>
+#include <cstring>
 #include "boost/mysql/detail/protocol/common_messages.hpp"
 #include "boost/mysql/detail/protocol/constants.hpp"
 #include "boost/mysql/detail/auxiliar/valgrind.hpp"
@@ -31,6 +36,14 @@ inline std::uint32_t compute_size_to_write(
     ));
 }
 
+// Messages of n * MAX_PACKET_SIZE bytes are followed by an empty packet
+inline std::size_t compute_num_packets(
+    std::size_t payload_size
+)
+{
+    return payload_size / MAX_PACKET_SIZE + 1;
+}
+
 } // detail
 } // mysql
 } // boost
@@ -97,6 +110,24 @@ std::size_t boost::mysql::detail::channel<Stream>::read_impl(
     }
 }
 
+template <typename Stream>
+template <typename BufferSeq, typename CompletionCondition>
+std::size_t boost::mysql::detail::channel<Stream>::read_impl(
+    BufferSeq&& buff,
+    CompletionCondition cond,
+    error_code& ec
+)
+{
+    if (ssl_active())
+    {
+        return boost::asio::read(ssl_block_->stream, std::forward<BufferSeq>(buff), cond, ec);
+    }
+    else
+    {
+        return boost::asio::read(stream_, std::forward<BufferSeq>(buff), cond, ec);
+    }
+}
+
 template <typename Stream>
 template <typename BufferSeq>
 std::size_t boost::mysql::detail::channel<Stream>::write_impl(
@@ -139,6 +170,34 @@ auto boost::mysql::detail::channel<Stream>::async_read_impl(
     }
 }
 
+template <typename Stream>
+template <typename BufferSeq, typename CompletionCondition, typename CompletionToken>
+auto boost::mysql::detail::channel<Stream>::async_read_impl(
+    BufferSeq&& buff,
+    CompletionCondition cond,
+    CompletionToken&& token
+)
+{
+    if (ssl_active())
+    {
+        return boost::asio::async_read(
+            ssl_block_->stream,
+            std::forward<BufferSeq>(buff),
+            cond,
+            std::forward<CompletionToken>(token)
+        );
+    }
+    else
+    {
+        return boost::asio::async_read(
+            stream_,
+            std::forward<BufferSeq>(buff),
+            cond,
+            std::forward<CompletionToken>(token)
+        );
+    }
+}
+
 template <typename Stream>
 template <typename BufferSeq, typename CompletionToken>
 auto boost::mysql::detail::channel<Stream>::async_write_impl(
@@ -165,51 +224,123 @@ auto boost::mysql::detail::channel<Stream>::async_write_impl(
 }
 
 template <typename Stream>
+bool boost::mysql::detail::channel<Stream>::copy_from_read_ahead(
+    boost::asio::mutable_buffer& buff
+) noexcept
+{
+    auto size = (std::min)(buff.size(), read_ahead_last_ - read_ahead_first_);
+    if (size)
+    {
+        std::memcpy(buff.data(), read_ahead_buff_.data() + read_ahead_first_, size);
+        read_ahead_first_ += size;
+        buff += size;
+    }
+    return buff.size() == 0;
+}
+
+template <typename Stream>
+boost::asio::mutable_buffer boost::mysql::detail::channel<Stream>::prepare_read(
+    boost::asio::mutable_buffer buff
+)
+{
+    // Big reads go directly to their destination, as they wouldn't
+    // fit in the read-ahead buffer. This includes all reads if read-ahead is disabled
+    assert(read_ahead_first_ == read_ahead_last_);
+    reading_ahead_ = buff.size() < read_ahead_size_;
+    if (!reading_ahead_)
+        return buff;
+    read_ahead_first_ = read_ahead_last_ = 0;
+    read_ahead_buff_.resize(read_ahead_size_);
+    return boost::asio::buffer(read_ahead_buff_);
+}
+
+template <typename Stream>
+void boost::mysql::detail::channel<Stream>::commit_read(
+    boost::asio::mutable_buffer& buff,
+    std::size_t bytes_transferred
+) noexcept
+{
+    if (reading_ahead_)
+    {
+        read_ahead_last_ = bytes_transferred;
+        valgrind_make_mem_defined(boost::asio::buffer(read_ahead_buff_.data(), bytes_transferred));
+        copy_from_read_ahead(buff);
+    }
+    else
+    {
+        valgrind_make_mem_defined(boost::asio::buffer(buff.data(), bytes_transferred));
+        buff += bytes_transferred;
+    }
+}
+
+template <typename Stream>
+void boost::mysql::detail::channel<Stream>::read_exactly(
+    boost::asio::mutable_buffer buff,
+    error_code& ec
+)
+{
+    if (copy_from_read_ahead(buff))
+        return;
+    auto start = std::chrono::steady_clock::now();
+    auto bytes_transferred = read_impl(
+        prepare_read(buff),
+        boost::asio::transfer_at_least(buff.size()),
+        ec
+    );
+    counters_.add_time(counters_.read_time, start);
+    commit_read(buff, bytes_transferred);
+}
+
+template <typename Stream>
+template <typename Allocator>
 void boost::mysql::detail::channel<Stream>::read(
-    bytestring& buffer,
+    basic_bytestring<Allocator>& buffer,
     error_code& code
 )
 {
     std::size_t transferred_size = 0;
     std::uint32_t size_to_read = 0;
+    std::uint8_t first_sequence_number = sequence_number_;
     buffer.clear();
     code.clear();
-    auto header_buff = boost::asio::buffer(header_buffer_);
 
     do
     {
         // Read header
-        read_impl(header_buff, code);
-        valgrind_make_mem_defined(header_buff);
+        read_exactly(boost::asio::buffer(header_buffer_), code);
         if (code)
-            return;
+            break;
 
         // See how many bytes we should be reading
         code = process_header_read(size_to_read);
         if (code)
-            return;
+            break;
 
         // Read the rest of the message
         buffer.resize(buffer.size() + size_to_read);
-        auto read_buffer = boost::asio::buffer(buffer.data() + transferred_size, size_to_read);
-        read_impl(read_buffer, code);
-        valgrind_make_mem_defined(read_buffer);
+        read_exactly(boost::asio::buffer(buffer.data() + transferred_size, size_to_read), code);
         if (code)
-            return;
+            break;
         transferred_size += size_to_read;
 
     } while (size_to_read == MAX_PACKET_SIZE);
+
+    observe_read(transferred_size, code);
+    if (capture_ && !code)
+        capture_->write(capture_record_type::server_message, first_sequence_number, boost::asio::buffer(buffer));
 }
 
 template <typename Stream>
+template <typename ConstBufferSequence>
 void boost::mysql::detail::channel<Stream>::write(
-    boost::asio::const_buffer buffer,
+    const ConstBufferSequence& buffers,
     error_code& code
 )
 {
     std::size_t transferred_size = 0;
-    auto bufsize = buffer.size();
-    auto first = static_cast<const std::uint8_t*>(buffer.data());
+    auto bufsize = boost::asio::buffer_size(buffers);
+    boost::beast::buffers_suffix<ConstBufferSequence> remaining (buffers);
+    std::uint8_t first_sequence_number = sequence_number_;
 
     // If the packet is empty, we should still write the header, saying
     // we are sending an empty packet.
@@ -217,34 +348,49 @@ void boost::mysql::detail::channel<Stream>::write(
     {
         auto size_to_write = compute_size_to_write(bufsize, transferred_size);
         process_header_write(size_to_write);
+        auto start = std::chrono::steady_clock::now();
         write_impl(
-            std::array<boost::asio::const_buffer, 2> {
+            boost::beast::buffers_cat(
                 boost::asio::buffer(header_buffer_),
-                boost::asio::buffer(first + transferred_size, size_to_write)
-            },
+                boost::beast::buffers_prefix(size_to_write, remaining)
+            ),
             code
         );
+        counters_.add_time(counters_.write_time, start);
         if (code)
-            return;
+            break;
+        remaining.consume(size_to_write);
         transferred_size += size_to_write;
     } while (transferred_size < bufsize);
+
+    observe_write(bufsize, code);
+    if (!code)
+        capture_client_message(first_sequence_number, buffers);
 }
 
 template<class Stream>
+template<typename Allocator>
 struct
     boost::mysql::detail::channel<Stream>::
         read_op : async_op<Stream>
 {
-  bytestring& buffer_;
+  basic_bytestring<Allocator>& buffer_;
   std::size_t total_transferred_size_ = 0;
+  std::uint32_t size_to_read_ = 0;
+  boost::asio::mutable_buffer pending_; // the part of the header or payload left to read
+  error_code code_;
+  bool cont_ = false; // whether we performed any async op, or everything was read ahead
+  std::uint8_t first_sequence_number_;
+  std::chrono::steady_clock::time_point read_start_;
 
   read_op(
       channel<Stream>& chan,
   error_info* output_info,
-      bytestring& buffer
+      basic_bytestring<Allocator>& buffer
   ) :
   async_op<Stream>(chan, output_info),
-  buffer_(buffer)
+  buffer_(buffer),
+  first_sequence_number_(chan.sequence_number())
   {
   }
 
@@ -256,58 +402,84 @@ struct
   )
   {
     // Error checking
+    channel<Stream>& chan = this->get_channel();
     if (code)
     {
+      chan.counters_.add_time(chan.counters_.read_time, read_start_);
+      chan.observe_read(total_transferred_size_, code);
       self.complete(code);
       return;
     }
 
     // Non-error path
-    std::uint32_t size_to_read = 0;
-    channel<Stream>& chan = this->get_channel();
     BOOST_ASIO_CORO_REENTER(*this)
       {
         do
         {
-          BOOST_ASIO_CORO_YIELD chan.async_read_impl(
-                            boost::asio::buffer(chan.header_buffer_),
-                            std::move(self)
-                        );
-          valgrind_make_mem_defined(boost::asio::buffer(chan.header_buffer_));
-
-          code = chan.process_header_read(size_to_read);
-          if (code)
+          pending_ = boost::asio::buffer(chan.header_buffer_);
+          if (!chan.copy_from_read_ahead(pending_))
           {
-            self.complete(code);
-            BOOST_ASIO_CORO_YIELD break;
+            cont_ = true;
+            read_start_ = std::chrono::steady_clock::now();
+            BOOST_ASIO_CORO_YIELD chan.async_read_impl(
+                              chan.prepare_read(pending_),
+                              boost::asio::transfer_at_least(pending_.size()),
+                              std::move(self)
+                          );
+            chan.counters_.add_time(chan.counters_.read_time, read_start_);
+            chan.commit_read(pending_, bytes_transferred);
           }
 
-          buffer_.resize(buffer_.size() + size_to_read);
+          code_ = chan.process_header_read(size_to_read_);
+          if (code_)
+            break;
 
-          BOOST_ASIO_CORO_YIELD chan.async_read_impl(
-                            boost::asio::buffer(buffer_.data() + total_transferred_size_, size_to_read),
-                            std::move(self)
-                        );
-          valgrind_make_mem_defined(
-              boost::asio::buffer(buffer_.data() + total_transferred_size_, bytes_transferred)
-          );
+          buffer_.resize(buffer_.size() + size_to_read_);
+          pending_ = boost::asio::buffer(buffer_.data() + total_transferred_size_, size_to_read_);
+          if (!chan.copy_from_read_ahead(pending_))
+          {
+            cont_ = true;
+            read_start_ = std::chrono::steady_clock::now();
+            BOOST_ASIO_CORO_YIELD chan.async_read_impl(
+                              chan.prepare_read(pending_),
+                              boost::asio::transfer_at_least(pending_.size()),
+                              std::move(self)
+                          );
+            chan.counters_.add_time(chan.counters_.read_time, read_start_);
+            chan.commit_read(pending_, bytes_transferred);
+          }
 
-          total_transferred_size_ += bytes_transferred;
-        } while (bytes_transferred == MAX_PACKET_SIZE);
+          total_transferred_size_ += size_to_read_;
+        } while (size_to_read_ == MAX_PACKET_SIZE);
 
-        self.complete(error_code());
+        if (!cont_)
+        {
+          // ensure return as if by post
+          BOOST_ASIO_CORO_YIELD boost::asio::post(std::move(self));
+        }
+
+        chan.observe_read(total_transferred_size_, code_);
+        if (chan.capture_ && !code_)
+        {
+          chan.capture_->write(
+              capture_record_type::server_message,
+              first_sequence_number_,
+              boost::asio::buffer(buffer_)
+          );
+        }
+        self.complete(code_);
       }
   }
 };
 
 template <typename Stream>
-template <typename CompletionToken>
+template <typename Allocator, typename CompletionToken>
 BOOST_ASIO_INITFN_RESULT_TYPE(
     CompletionToken,
     typename boost::mysql::detail::channel<Stream>::read_signature
 )
 boost::mysql::detail::channel<Stream>::async_read(
-    bytestring& buffer,
+    basic_bytestring<Allocator>& buffer,
     CompletionToken&& token
 )
 {
@@ -315,26 +487,34 @@ boost::mysql::detail::channel<Stream>::async_read(
     return boost::asio::async_compose<
         CompletionToken,
         typename boost::mysql::detail::channel<Stream>::read_signature>(
-          read_op(*this, nullptr, buffer),
+          read_op<Allocator>(*this, nullptr, buffer),
           token, *this);
 //    return op::initiate(std::forward<CompletionToken>(token), *this, nullptr, buffer);
 }
 
 template<typename Stream>
+template<typename ConstBufferSequence>
 struct
     boost::mysql::detail::channel<Stream>::
         write_op : async_op<Stream>
 {
-  boost::asio::const_buffer buffer_;
+  boost::beast::buffers_suffix<ConstBufferSequence> remaining_;
+  std::size_t total_size_;
   std::size_t total_transferred_size_ = 0;
+  std::uint8_t first_sequence_number_;
+  ConstBufferSequence buffers_; // for captures
+  std::chrono::steady_clock::time_point write_start_;
 
   write_op(
       channel<Stream>& chan,
       error_info* output_info,
-      boost::asio::const_buffer buffer
+      const ConstBufferSequence& buffers
   ) :
   async_op<Stream>(chan, output_info),
-  buffer_(buffer)
+  remaining_(buffers),
+  total_size_(boost::asio::buffer_size(buffers)),
+  first_sequence_number_(chan.sequence_number()),
+  buffers_(buffers)
   {
   }
 
@@ -346,63 +526,111 @@ struct
   )
   {
     // Error handling
+    channel<Stream>& chan = this->get_channel();
     if (code)
     {
+      chan.counters_.add_time(chan.counters_.write_time, write_start_);
+      chan.observe_write(total_size_, code);
       self.complete(code);
       return;
     }
 
     // Non-error path
     std::uint32_t size_to_write;
-    channel<Stream>& chan = this->get_channel();
     BOOST_ASIO_CORO_REENTER(*this)
       {
         // Force write the packet header on an empty packet, at least.
         do
         {
-          size_to_write = compute_size_to_write(buffer_.size(), total_transferred_size_);
+          size_to_write = compute_size_to_write(total_size_, total_transferred_size_);
           chan.process_header_write(size_to_write);
+          write_start_ = std::chrono::steady_clock::now();
 
           BOOST_ASIO_CORO_YIELD chan.async_write_impl(
-                            std::array<boost::asio::const_buffer, 2> {
+                            boost::beast::buffers_cat(
                                 boost::asio::buffer(chan.header_buffer_),
-                                boost::asio::buffer(buffer_ + total_transferred_size_, size_to_write)
-                            },
+                                boost::beast::buffers_prefix(size_to_write, remaining_)
+                            ),
                             std::move(self)
                         );
 
-          total_transferred_size_ += (bytes_transferred - 4); // header size
+          chan.counters_.add_time(chan.counters_.write_time, write_start_);
+          remaining_.consume(bytes_transferred - 4); // header size
+          total_transferred_size_ += (bytes_transferred - 4);
 
-        } while (total_transferred_size_ < buffer_.size());
+        } while (total_transferred_size_ < total_size_);
 
+        chan.observe_write(total_size_, error_code());
+        chan.capture_client_message(first_sequence_number_, buffers_);
         self.complete(error_code());
       }
   }
 };
 
 template <typename Stream>
-template <typename CompletionToken>
+template <typename ConstBufferSequence, typename CompletionToken>
 BOOST_ASIO_INITFN_RESULT_TYPE(
     CompletionToken,
     typename boost::mysql::detail::channel<Stream>::write_signature
 )
 boost::mysql::detail::channel<Stream>::async_write(
-    boost::asio::const_buffer buffer,
+    const ConstBufferSequence& buffers,
     CompletionToken&& token
 )
 {
   return boost::asio::async_compose<CompletionToken,
                                     typename boost::mysql::detail::channel<Stream>::write_signature>
-      (write_op(*this, nullptr, buffer), token, *this);
-//    return op::initiate(std::forward<CompletionToken>(token), *this, nullptr, buffer);
+      (write_op<ConstBufferSequence>(*this, nullptr, buffers), token, *this);
+}
+
+template <typename Stream>
+void boost::mysql::detail::channel<Stream>::create_ssl_block(
+    const ssl_options& opts
+)
+{
+    // The server doesn't send anything after the handshake packet until
+    // it receives our SSL request, so no TLS bytes can have been read ahead
+    assert(read_ahead_first_ == read_ahead_last_);
+    ssl_block_.emplace(stream_, opts.context());
+    session_cache_ = opts.session_cache();
+    if (session_cache_)
+    {
+        // Attempt to resume a previous session. If the server
+        // doesn't accept it, a full handshake is performed
+        SSL_SESSION* session = session_cache_->get_session();
+        if (session)
+        {
+            SSL_set_session(ssl_block_->stream.native_handle(), session); // increments ref count
+            SSL_SESSION_free(session);
+        }
+    }
+}
+
+template <typename Stream>
+void boost::mysql::detail::channel<Stream>::store_ssl_session()
+{
+    if (!ssl_active() || !session_cache_)
+        return;
+    SSL_SESSION* session = SSL_get1_session(ssl_block_->stream.native_handle());
+    if (!session)
+        return;
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L
+    if (!SSL_SESSION_is_resumable(session))
+    {
+        SSL_SESSION_free(session);
+        return;
+    }
+#endif
+    session_cache_->set_session(session);
 }
 
 template <typename Stream>
 void boost::mysql::detail::channel<Stream>::ssl_handshake(
+    const ssl_options& opts,
     error_code& ec
 )
 {
-    create_ssl_block();
+    create_ssl_block(opts);
     ssl_block_->stream.handshake(boost::asio::ssl::stream_base::client, ec);
 }
 
@@ -413,20 +641,203 @@ BOOST_ASIO_INITFN_RESULT_TYPE(
     typename boost::mysql::detail::channel<Stream>::ssl_handshake_signature
 )
 boost::mysql::detail::channel<Stream>::async_ssl_handshake(
+    const ssl_options& opts,
     CompletionToken&& token
 )
 {
-    create_ssl_block();
+    create_ssl_block(opts);
     return ssl_block_->stream.async_handshake(
         boost::asio::ssl::stream_base::client,
         std::forward<CompletionToken>(token)
     );
 }
 
+template <typename Stream>
+void boost::mysql::detail::channel<Stream>::reset_session(
+    std::string_view schema,
+    std::uint16_t status_flags,
+    std::string_view session_state_info
+)
+{
+    session_state_.reset(current_caps_.has(CLIENT_SESSION_TRACK), schema, status_flags);
+    if (!session_state_info.empty())
+    {
+        session_state_.apply_changes(session_state_info);
+    }
+}
+
+template <typename Stream>
+void boost::mysql::detail::channel<Stream>::process_ok_packet(
+    const ok_packet& pack
+)
+{
+    session_state_.set_status_flags(pack.status_flags.value);
+    if (!pack.session_state_info.value.empty())
+    {
+        // Malformed information is ignored, as it does not affect
+        // the outcome of the operation that produced the packet
+        session_state_.apply_changes(pack.session_state_info.value);
+    }
+}
+
+template <typename Stream>
+void boost::mysql::detail::channel<Stream>::observe_read(
+    std::size_t payload_size,
+    error_code err
+)
+{
+    if (!err)
+    {
+        auto num_packets = compute_num_packets(payload_size);
+        counters_.packets_read.add(num_packets);
+        counters_.bytes_read.add(payload_size + 4 * num_packets);
+    }
+    if (observer_)
+        observe_io(payload_size, err, false);
+}
+
+template <typename Stream>
+void boost::mysql::detail::channel<Stream>::observe_write(
+    std::size_t payload_size,
+    error_code err
+)
+{
+    if (!err)
+    {
+        auto num_packets = compute_num_packets(payload_size);
+        counters_.packets_written.add(num_packets);
+        counters_.bytes_written.add(payload_size + 4 * num_packets);
+    }
+    if (observer_)
+        observe_io(payload_size, err, true);
+}
+
+template <typename Stream>
+void boost::mysql::detail::channel<Stream>::observe_io(
+    std::size_t payload_size,
+    error_code err,
+    bool is_write
+)
+{
+    assert(observer_);
+    if (err)
+    {
+        observe_command_end(err);
+        return;
+    }
+
+    std::size_t bytes = payload_size + 4 * compute_num_packets(payload_size);
+    if (is_write)
+    {
+        observer_->on_packet_written(bytes);
+        if (!command_in_progress_)
+            return;
+        command_stats_.bytes_written += bytes;
+        if (command_stats_.type == command_type::quit || command_stats_.type == command_type::close_statement)
+            observe_command_end(error_code()); // no response is sent for these
+    }
+    else
+    {
+        observer_->on_packet_read(bytes);
+        if (command_in_progress_)
+            command_stats_.bytes_read += bytes;
+    }
+}
+
+template <typename Stream>
+void boost::mysql::detail::channel<Stream>::observe_command_start(
+    command_type type,
+    std::string_view sql
+)
+{
+    switch (type)
+    {
+    case command_type::query: counters_.queries.add(1); break;
+    case command_type::prepare: counters_.statements_prepared.add(1); break;
+    case command_type::execute: counters_.statements_executed.add(1); break;
+    case command_type::close_statement: counters_.statements_closed.add(1); break;
+    default: break;
+    }
+    if (!observer_)
+        return;
+    sql_digest(sql, sql_digest_);
+    command_stats_ = command_stats();
+    command_stats_.type = type;
+    command_stats_.sql_digest = sql_digest_;
+    command_in_progress_ = true;
+    observer_->on_command_start(type, sql_digest_);
+    command_start_ = std::chrono::steady_clock::now();
+}
+
+template <typename Stream>
+void boost::mysql::detail::channel<Stream>::observe_row_decoded(
+    std::chrono::steady_clock::time_point decode_start
+)
+{
+    counters_.rows_decoded.add(1);
+    if (!observer_)
+        return;
+    std::chrono::nanoseconds decode_time = std::chrono::steady_clock::now() - decode_start;
+    if (command_in_progress_)
+    {
+        ++command_stats_.num_rows;
+        command_stats_.decode_time += decode_time;
+    }
+    observer_->on_row_decoded(decode_time);
+}
+
+template <typename Stream>
+void boost::mysql::detail::channel<Stream>::observe_command_end(
+    error_code err
+)
+{
+    if (!command_in_progress_)
+        return;
+    command_in_progress_ = false;
+    command_stats_.elapsed = std::chrono::steady_clock::now() - command_start_;
+    observer_->on_command_end(command_stats_, err);
+}
+
+template <typename Stream>
+template <typename BufferSeq>
+void boost::mysql::detail::channel<Stream>::capture_client_message(
+    std::uint8_t first_sequence_number,
+    const BufferSeq& buffers
+)
+{
+    if (!capture_)
+        return;
+    if (handshake_complete_)
+        capture_->write(capture_record_type::client_message, first_sequence_number, buffers);
+    else
+        capture_->write(capture_record_type::client_message, first_sequence_number, boost::asio::const_buffer());
+}
+
+template <typename Stream>
+void boost::mysql::detail::channel<Stream>::capture_handshake_complete()
+{
+    handshake_complete_ = true;
+    if (!capture_)
+        return;
+    std::array<std::uint8_t, 6> payload;
+    serialization_context ctx (capabilities(0), payload.data());
+    serialize(
+        ctx,
+        int4(current_caps_.get()),
+        int2(static_cast<std::uint16_t>(current_collation_))
+    );
+    capture_->write(capture_record_type::handshake_complete, 0, boost::asio::buffer(payload));
+}
+
 template <typename Stream>
 boost::mysql::error_code boost::mysql::detail::channel<Stream>::close()
 {
+    // Leave the channel ready to connect again
     error_code err;
+    read_ahead_first_ = read_ahead_last_ = 0;
+    sequence_number_ = 0;
+    handshake_complete_ = false;
+    ssl_block_.reset();
     stream_.shutdown(Stream::shutdown_both, err);
     stream_.close(err);
     return err;
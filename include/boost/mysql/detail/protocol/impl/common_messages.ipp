@@ -8,7 +8,7 @@
 #ifndef BOOST_MYSQL_DETAIL_PROTOCOL_IMPL_COMMON_MESSAGES_IPP
 #define BOOST_MYSQL_DETAIL_PROTOCOL_IMPL_COMMON_MESSAGES_IPP
 
-inline boost::mysql::errc
+BOOST_MYSQL_DECL boost::mysql::errc
 boost::mysql::detail::serialization_traits<
     boost::mysql::detail::ok_packet,
     boost::mysql::detail::serialization_tag::struct_with_fields
@@ -29,11 +29,18 @@ boost::mysql::detail::serialization_traits<
         {
             err = deserialize(ctx, output.info);
         }
+        if (err == errc::ok &&
+            ctx.get_capabilities().has(CLIENT_SESSION_TRACK) &&
+            (output.status_flags.value & SERVER_SESSION_STATE_CHANGED) &&
+            ctx.enough_size(1))
+        {
+            err = deserialize(ctx, output.session_state_info);
+        }
         return err;
     }
 }
 
-inline boost::mysql::errc
+BOOST_MYSQL_DECL boost::mysql::errc
 boost::mysql::detail::serialization_traits<
     boost::mysql::detail::column_definition_packet,
     boost::mysql::detail::serialization_tag::struct_with_fields
@@ -62,7 +69,7 @@ boost::mysql::detail::serialization_traits<
     );
 }
 
-inline boost::mysql::error_code boost::mysql::detail::process_error_packet(
+BOOST_MYSQL_DECL boost::mysql::error_code boost::mysql::detail::process_error_packet(
     deserialization_context& ctx,
     error_info& info
 )
@@ -9,7 +9,7 @@
 #define BOOST_MYSQL_DETAIL_PROTOCOL_IMPL_HANDSHAKE_MESSAGES_IPP
 
 
-inline boost::mysql::errc
+BOOST_MYSQL_DECL boost::mysql::errc
 boost::mysql::detail::serialization_traits<
     boost::mysql::detail::handshake_packet,
     boost::mysql::detail::serialization_tag::struct_with_fields
@@ -106,7 +106,7 @@ boost::mysql::detail::serialization_traits<
     return res;
 }
 
-inline void
+BOOST_MYSQL_DECL void
 boost::mysql::detail::serialization_traits<
     boost::mysql::detail::handshake_response_packet,
     boost::mysql::detail::serialization_tag::struct_with_fields
@@ -132,7 +132,7 @@ boost::mysql::detail::serialization_traits<
     serialize(ctx, value.client_plugin_name);
 }
 
-inline boost::mysql::errc
+BOOST_MYSQL_DECL boost::mysql::errc
 boost::mysql::detail::serialization_traits<
     boost::mysql::detail::auth_switch_request_packet,
     boost::mysql::detail::serialization_tag::struct_with_fields
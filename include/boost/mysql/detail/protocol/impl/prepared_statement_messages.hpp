@@ -44,6 +44,24 @@ inline bool is_unsigned(
     return std::holds_alternative<std::uint64_t>(input.to_variant());
 }
 
+// Decimals are sent as NEWDECIMAL strings
+inline protocol_field_type get_protocol_field_type(
+    const statement_param& input
+) noexcept
+{
+    if (const auto* v = std::get_if<value>(&input.to_variant()))
+        return get_protocol_field_type(*v);
+    return protocol_field_type::newdecimal;
+}
+
+inline bool is_unsigned(
+    const statement_param& input
+) noexcept
+{
+    const auto* v = std::get_if<value>(&input.to_variant());
+    return v && is_unsigned(*v);
+}
+
 } // detail
 } // mysql
 } // boost
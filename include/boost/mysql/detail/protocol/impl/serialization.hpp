@@ -340,6 +340,40 @@ void boost::mysql::detail::serialize_message(
     assert(ctx.first() == buffer.data() + buffer.size());
 }
 
+template <typename Serializable, typename Allocator, typename BufferVector>
+void boost::mysql::detail::serialize_message_gather(
+    const Serializable& input,
+    capabilities caps,
+    basic_bytestring<Allocator>& buffer,
+    BufferVector& output
+)
+{
+    // Serialize, leaving out long strings. The computed size is an upper bound
+    // for the serialized size, and also bounds the number of long strings
+    serialization_context ctx (caps);
+    std::size_t size = get_size(ctx, input);
+    std::vector<referenced_string> references;
+    references.reserve(size / min_referenced_string_size);
+    buffer.resize(size);
+    ctx.set_first(buffer.data());
+    ctx.enable_string_references(references);
+    serialize(ctx, input);
+    buffer.resize(ctx.first() - buffer.data());
+
+    // Interleave the serialized chunks with the referenced strings
+    output.clear();
+    std::size_t offset = 0;
+    for (const auto& ref: references)
+    {
+        if (ref.offset > offset)
+            output.push_back(boost::asio::buffer(buffer.data() + offset, ref.offset - offset));
+        output.push_back(ref.contents);
+        offset = ref.offset;
+    }
+    if (offset < buffer.size() || output.empty())
+        output.push_back(boost::asio::buffer(buffer.data() + offset, buffer.size() - offset));
+}
+
 template <typename Deserializable>
 boost::mysql::error_code boost::mysql::detail::deserialize_message(
     deserialization_context& ctx,
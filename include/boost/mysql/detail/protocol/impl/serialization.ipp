@@ -26,7 +26,7 @@ inline std::string_view get_string(
 } // mysql
 } // boost
 
-inline boost::mysql::errc
+BOOST_MYSQL_DECL boost::mysql::errc
 boost::mysql::detail::serialization_traits<
     boost::mysql::detail::int_lenenc,
     boost::mysql::detail::serialization_tag::none
@@ -69,7 +69,7 @@ boost::mysql::detail::serialization_traits<
 }
 
 
-inline void
+BOOST_MYSQL_DECL void
 boost::mysql::detail::serialization_traits<
     boost::mysql::detail::int_lenenc,
     boost::mysql::detail::serialization_tag::none
@@ -99,7 +99,7 @@ boost::mysql::detail::serialization_traits<
     }
 }
 
-inline std::size_t
+BOOST_MYSQL_DECL std::size_t
 boost::mysql::detail::serialization_traits<
     boost::mysql::detail::int_lenenc,
     boost::mysql::detail::serialization_tag::none
@@ -118,7 +118,7 @@ boost::mysql::detail::serialization_traits<
         return 9;
 }
 
-inline boost::mysql::errc
+BOOST_MYSQL_DECL boost::mysql::errc
 boost::mysql::detail::serialization_traits<
     boost::mysql::detail::string_null,
     boost::mysql::detail::serialization_tag::none
@@ -137,7 +137,7 @@ boost::mysql::detail::serialization_traits<
     return errc::ok;
 }
 
-inline boost::mysql::errc
+BOOST_MYSQL_DECL boost::mysql::errc
 boost::mysql::detail::serialization_traits<
     boost::mysql::detail::string_eof,
     boost::mysql::detail::serialization_tag::none
@@ -151,7 +151,7 @@ boost::mysql::detail::serialization_traits<
     return errc::ok;
 }
 
-inline boost::mysql::errc
+BOOST_MYSQL_DECL boost::mysql::errc
 boost::mysql::detail::serialization_traits<
     boost::mysql::detail::string_lenenc,
     boost::mysql::detail::serialization_tag::none
@@ -181,7 +181,7 @@ boost::mysql::detail::serialization_traits<
     return errc::ok;
 }
 
-inline std::pair<boost::mysql::error_code, std::uint8_t>
+BOOST_MYSQL_DECL std::pair<boost::mysql::error_code, std::uint8_t>
 boost::mysql::detail::deserialize_message_type(
     deserialization_context& ctx
 )
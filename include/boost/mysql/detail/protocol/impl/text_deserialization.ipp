@@ -308,7 +308,7 @@ inline bool is_next_field_null(
 } // mysql
 } // boost
 
-inline boost::mysql::errc boost::mysql::detail::deserialize_text_value(
+BOOST_MYSQL_DECL boost::mysql::errc boost::mysql::detail::deserialize_text_value(
     std::string_view from,
     const field_metadata& meta,
     value& output
@@ -355,14 +355,14 @@ inline boost::mysql::errc boost::mysql::detail::deserialize_text_value(
 }
 
 
-boost::mysql::error_code boost::mysql::detail::deserialize_text_row(
+BOOST_MYSQL_DECL boost::mysql::error_code boost::mysql::detail::deserialize_text_row(
     deserialization_context& ctx,
     const std::vector<field_metadata>& fields,
     std::vector<value>& output
 )
 {
     output.resize(fields.size());
-    for (std::vector<value>::size_type i = 0; i < fields.size(); ++i)
+    for (std::size_t i = 0; i < fields.size(); ++i)
     {
         if (is_next_field_null(ctx))
         {
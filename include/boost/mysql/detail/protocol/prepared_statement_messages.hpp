@@ -11,6 +11,7 @@
 #include "boost/mysql/detail/protocol/serialization.hpp"
 #include "boost/mysql/detail/protocol/constants.hpp"
 #include "boost/mysql/value.hpp"
+#include "boost/mysql/statement_param.hpp"
 
 namespace boost {
 namespace mysql {
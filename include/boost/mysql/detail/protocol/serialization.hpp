@@ -8,6 +8,7 @@
 #ifndef BOOST_MYSQL_DETAIL_PROTOCOL_SERIALIZATION_HPP
 #define BOOST_MYSQL_DETAIL_PROTOCOL_SERIALIZATION_HPP
 
+#include "boost/mysql/detail/config.hpp"
 #include <boost/endian/conversion.hpp>
 #include <type_traits>
 #include <algorithm>
@@ -61,9 +62,9 @@ struct serialization_traits<T, serialization_tag::fixed_size_int>
 template <>
 struct serialization_traits<int_lenenc, serialization_tag::none>
 {
-    static inline errc deserialize_(deserialization_context& ctx, int_lenenc& output) noexcept;
-    static inline void serialize_(serialization_context& ctx, int_lenenc input) noexcept;
-    static inline std::size_t get_size_(const serialization_context&, int_lenenc input) noexcept;
+    static BOOST_MYSQL_DECL errc deserialize_(deserialization_context& ctx, int_lenenc& output) noexcept;
+    static BOOST_MYSQL_DECL void serialize_(serialization_context& ctx, int_lenenc input) noexcept;
+    static BOOST_MYSQL_DECL std::size_t get_size_(const serialization_context&, int_lenenc input) noexcept;
 };
 
 
@@ -87,7 +88,7 @@ struct serialization_traits<string_fixed<N>, serialization_tag::none>
 template <>
 struct serialization_traits<string_null, serialization_tag::none>
 {
-    static inline errc deserialize_(deserialization_context& ctx, string_null& output) noexcept;
+    static BOOST_MYSQL_DECL errc deserialize_(deserialization_context& ctx, string_null& output) noexcept;
     static inline void serialize_(serialization_context& ctx, string_null input) noexcept
     {
         ctx.write(input.value.data(), input.value.size());
@@ -103,10 +104,10 @@ struct serialization_traits<string_null, serialization_tag::none>
 template <>
 struct serialization_traits<string_eof, serialization_tag::none>
 {
-    static inline errc deserialize_(deserialization_context& ctx, string_eof& output) noexcept;
+    static BOOST_MYSQL_DECL errc deserialize_(deserialization_context& ctx, string_eof& output) noexcept;
     static inline void serialize_(serialization_context& ctx, string_eof input) noexcept
     {
-        ctx.write(input.value.data(), input.value.size());
+        ctx.write_string(input.value.data(), input.value.size());
     }
     static inline std::size_t get_size_(const serialization_context&, string_eof input) noexcept
     {
@@ -118,11 +119,11 @@ struct serialization_traits<string_eof, serialization_tag::none>
 template <>
 struct serialization_traits<string_lenenc, serialization_tag::none>
 {
-    static inline errc deserialize_(deserialization_context& ctx, string_lenenc& output) noexcept;
+    static BOOST_MYSQL_DECL errc deserialize_(deserialization_context& ctx, string_lenenc& output) noexcept;
     static inline void serialize_(serialization_context& ctx, string_lenenc input) noexcept
     {
         serialize(ctx, int_lenenc(input.value.size()));
-        ctx.write(input.value.data(), input.value.size());
+        ctx.write_string(input.value.data(), input.value.size());
     }
     static inline std::size_t get_size_(const serialization_context& ctx, string_lenenc input) noexcept
     {
@@ -193,6 +194,18 @@ void serialize_message(
     basic_bytestring<Allocator>& buffer
 );
 
+// Like serialize_message, but long strings are referenced instead of copied.
+// output is filled with the buffer sequence composing the message, pointing
+// into buffer and into the strings referenced by input, which must be kept alive.
+// BufferVector is a std::vector-like container of boost::asio::const_buffer
+template <typename Serializable, typename Allocator, typename BufferVector>
+void serialize_message_gather(
+    const Serializable& input,
+    capabilities caps,
+    basic_bytestring<Allocator>& buffer,
+    BufferVector& output
+);
+
 template <typename Deserializable>
 error_code deserialize_message(
     deserialization_context& ctx,
@@ -203,7 +216,7 @@ error_code deserialize_message(
 template <typename... Types>
 void serialize_fields(serialization_context& ctx, const Types&... fields) noexcept;
 
-inline std::pair<error_code, std::uint8_t> deserialize_message_type(
+BOOST_MYSQL_DECL std::pair<error_code, std::uint8_t> deserialize_message_type(
     deserialization_context& ctx
 );
 
@@ -213,6 +226,8 @@ inline std::pair<error_code, std::uint8_t> deserialize_message_type(
 } // boost
 
 #include "boost/mysql/detail/protocol/impl/serialization.hpp"
+#ifdef BOOST_MYSQL_HEADER_ONLY
 #include "boost/mysql/detail/protocol/impl/serialization.ipp"
+#endif
 
 #endif
@@ -12,15 +12,31 @@
 #include <boost/asio/buffer.hpp>
 #include <cstdint>
 #include <cstring>
+#include <cassert>
+#include <vector>
 
 namespace boost {
 namespace mysql {
 namespace detail {
 
+// Strings at least this long may be sent directly from the memory they live in,
+// rather than being copied into the serialization buffer
+constexpr std::size_t min_referenced_string_size = 4096;
+
+// A string that has been referenced rather than copied. offset is the position
+// in the serialization buffer the string would have been written to
+struct referenced_string
+{
+    std::size_t offset;
+    boost::asio::const_buffer contents;
+};
+
 class serialization_context
 {
     std::uint8_t* first_;
     capabilities capabilities_;
+    std::uint8_t* base_ {};
+    std::vector<referenced_string>* references_ {};
 public:
     serialization_context(capabilities caps, std::uint8_t* first = nullptr) noexcept:
         first_(first), capabilities_(caps) {};
@@ -31,6 +47,30 @@ public:
     capabilities get_capabilities() const noexcept { return capabilities_; }
     void write(const void* buffer, std::size_t size) noexcept { memcpy(first_, buffer, size); advance(size); }
     void write(std::uint8_t elm) noexcept { *first_ = elm; ++first_; }
+
+    // Makes write_string() record long strings in output instead of copying them.
+    // Must be called after set_first(). output must have enough capacity to hold
+    // all the references, so write_string() never allocates
+    void enable_string_references(std::vector<referenced_string>& output) noexcept
+    {
+        base_ = first_;
+        references_ = &output;
+    }
+    void write_string(const void* buffer, std::size_t size) noexcept
+    {
+        if (references_ && size >= min_referenced_string_size)
+        {
+            assert(references_->size() < references_->capacity());
+            references_->push_back(referenced_string{
+                static_cast<std::size_t>(first_ - base_),
+                boost::asio::buffer(buffer, size)
+            });
+        }
+        else
+        {
+            write(buffer, size);
+        }
+    }
 };
 
 }
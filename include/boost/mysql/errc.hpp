@@ -1413,6 +1413,10 @@ enum class errc : int
     unknown_auth_plugin = 65541, ///< The user employs an authentication plugin not known to this library.
     auth_plugin_requires_ssl = 65542, ///< The authentication plugin requires the connection to use SSL.
     wrong_num_params = 65543, ///< The number of parameters passed to the prepared statement does not match the number of actual parameters.
+    wrong_num_format_args = 65544, ///< The number of arguments passed to format_sql does not match the number of placeholders in the format string.
+    invalid_format_string = 65545, ///< The format string passed to format_sql is malformed (e.g. contains an unmatched brace).
+    unformattable_value = 65546, ///< A value passed to format_sql can't be represented as a SQL literal (e.g. a non-finite floating point number).
+    unsupported_character_set = 65547, ///< The operation does not support the connection's character set.
 };
 
 } // mysql
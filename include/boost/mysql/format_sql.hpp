@@ -0,0 +1,112 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_FORMAT_SQL_HPP
+#define BOOST_MYSQL_FORMAT_SQL_HPP
+
+#include "boost/mysql/value.hpp"
+#include "boost/mysql/error.hpp"
+#include "boost/mysql/collation.hpp"
+#include <string>
+#include <string_view>
+
+/**
+ * \defgroup format Client-side SQL formatting
+ * \brief Classes and functions to safely compose SQL text queries
+ * with runtime values in the client.
+ */
+
+namespace boost {
+namespace mysql {
+
+/**
+ * \ingroup format
+ * \brief Options controlling how values are converted into SQL literals.
+ * \details String escaping depends on the connection's character set
+ * (some multi-byte character sets, like gbk or sjis, may contain
+ * backslash or quote bytes within multi-byte characters) and on whether
+ * the server has the NO_BACKSLASH_ESCAPES SQL mode enabled. Use
+ * connection::format_opts to obtain the options matching the current
+ * state of a connection.
+ */
+class format_options
+{
+    collation connection_collation_;
+    bool backslash_escapes_;
+public:
+    /// Initializing constructor.
+    constexpr explicit format_options(
+        collation connection_col = collation::utf8_general_ci, ///< The connection's collation.
+        bool backslash_escapes = true ///< false if the server has NO_BACKSLASH_ESCAPES enabled.
+    ) noexcept :
+        connection_collation_(connection_col),
+        backslash_escapes_(backslash_escapes)
+    {
+    }
+
+    /// Retrieves the connection collation.
+    constexpr collation connection_collation() const noexcept { return connection_collation_; }
+
+    /// Returns whether backslashes are treated as escape characters by the server.
+    constexpr bool backslash_escapes() const noexcept { return backslash_escapes_; }
+};
+
+/**
+ * \ingroup format
+ * \brief Composes a SQL query by replacing placeholders with SQL literals
+ * (iterator, sync with error code version).
+ * \details Each {} placeholder in format_str is replaced by the SQL literal
+ * corresponding to the next value in the range [params_first, params_last).
+ * Use {{ and }} to insert literal braces. The number of placeholders must match
+ * the number of values passed in.
+ *
+ * Values are converted as follows:
+ *   - NULL values are written as NULL.
+ *   - Integers and floating point values are written as numeric literals.
+ *   - Strings are written as single-quoted string literals, escaped according
+ *     to opts. Never rely on the caller quoting strings in format_str.
+ *   - Dates, datetimes and times are written as single-quoted string literals.
+ *
+ * output is cleared before writing the query, but its capacity is retained,
+ * so the same buffer may be reused across calls and passed to connection::query.
+ */
+template <typename ForwardIterator>
+void format_sql(std::string_view format_str, ForwardIterator params_first, ForwardIterator params_last,
+        const format_options& opts, std::string& output, error_code& err, error_info& info);
+
+/// Composes a SQL query (iterator, sync with exceptions version).
+template <typename ForwardIterator>
+void format_sql(std::string_view format_str, ForwardIterator params_first, ForwardIterator params_last,
+        const format_options& opts, std::string& output);
+
+/**
+ * \ingroup format
+ * \brief Composes a SQL query (collection, sync with error code version).
+ * \details Collection should be a sequence for which std::begin() and
+ * std::end() return forward iterators to a valid boost::mysql::value range.
+ */
+template <typename Collection>
+void format_sql(std::string_view format_str, const Collection& params,
+        const format_options& opts, std::string& output, error_code& err, error_info& info)
+{
+    format_sql(format_str, std::begin(params), std::end(params), opts, output, err, info);
+}
+
+/// Composes a SQL query (collection, sync with exceptions version).
+template <typename Collection>
+void format_sql(std::string_view format_str, const Collection& params,
+        const format_options& opts, std::string& output)
+{
+    format_sql(format_str, std::begin(params), std::end(params), opts, output);
+}
+
+} // mysql
+} // boost
+
+#include "boost/mysql/impl/format_sql.hpp"
+
+#endif
@@ -0,0 +1,126 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_HISTOGRAM_OBSERVER_HPP
+#define BOOST_MYSQL_HISTOGRAM_OBSERVER_HPP
+
+#include "boost/mysql/connection_observer.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace boost {
+namespace mysql {
+
+/**
+ * \ingroup observability
+ * \brief A lock-free histogram of durations, with logarithmic buckets.
+ * \details Bucket 0 counts zero durations, and bucket i > 0 counts durations of
+ * [2^(i-1), 2^i) nanoseconds. The last bucket also counts any longer durations.
+ * Percentiles are thus reported with a relative error below 2x, which
+ * is enough to tell apart a 100us query from a 10ms one, at a fixed memory
+ * cost and without any locking.
+ *
+ * All functions may be called concurrently. Recording a value takes two relaxed
+ * atomic increments, so readers may see a sum that doesn't match the counts
+ * while values are being recorded.
+ */
+class latency_histogram
+{
+public:
+    /// The number of buckets.
+    static constexpr std::size_t num_buckets = 64;
+
+    /// Constructs an empty histogram.
+    latency_histogram() = default;
+
+    latency_histogram(const latency_histogram&) = delete;
+    latency_histogram& operator=(const latency_histogram&) = delete;
+
+    /// Records a duration. Negative durations are recorded as zero.
+    void record(std::chrono::nanoseconds value) noexcept;
+
+    /// The number of durations recorded.
+    std::uint64_t count() const noexcept;
+
+    /// The sum of the durations recorded.
+    std::chrono::nanoseconds sum() const noexcept
+    {
+        return std::chrono::nanoseconds(sum_.load(std::memory_order_relaxed));
+    }
+
+    /// The number of durations recorded in bucket i. Precondition: `i < num_buckets`.
+    std::uint64_t bucket_count(std::size_t i) const noexcept
+    {
+        return buckets_[i].load(std::memory_order_relaxed);
+    }
+
+    /// The smallest duration that would be recorded in bucket i + 1. Precondition: `i < num_buckets`.
+    static std::chrono::nanoseconds bucket_upper_bound(std::size_t i) noexcept;
+
+    /**
+     * \brief An upper bound for the given percentile, in the [0, 1] range.
+     * \details Returns the upper bound of the bucket containing the percentile,
+     * or zero if the histogram is empty.
+     */
+    std::chrono::nanoseconds percentile(double p) const noexcept;
+
+    /// Sets all counts to zero.
+    void reset() noexcept;
+private:
+    std::array<std::atomic<std::uint64_t>, num_buckets> buckets_ {};
+    std::atomic<std::int64_t> sum_ {0};
+};
+
+/**
+ * \ingroup observability
+ * \brief An observer recording command latencies in histograms.
+ * \details Records the time each command takes, split into the time spent
+ * deserializing rows and the rest (mostly waiting for the server and the
+ * network, see command_stats::network_time). Also counts failed commands.
+ *
+ * A single object may be shared by any number of connections, including
+ * connections used from different threads. Read the histograms at any time
+ * to export them to your metrics system.
+ */
+class histogram_observer : public connection_observer
+{
+    latency_histogram elapsed_;
+    latency_histogram network_time_;
+    latency_histogram decode_time_;
+    std::atomic<std::uint64_t> num_errors_ {0};
+public:
+    /// Constructs an observer with empty histograms.
+    histogram_observer() = default;
+
+    /// Total command latencies (command_stats::elapsed).
+    const latency_histogram& elapsed() const noexcept { return elapsed_; }
+
+    /// Latencies excluding row deserialization (command_stats::network_time).
+    const latency_histogram& network_time() const noexcept { return network_time_; }
+
+    /// Time spent deserializing rows, per command (command_stats::decode_time).
+    const latency_histogram& decode_time() const noexcept { return decode_time_; }
+
+    /// The number of commands that completed with an error.
+    std::uint64_t num_errors() const noexcept { return num_errors_.load(std::memory_order_relaxed); }
+
+    /// Sets all histograms and counters to zero.
+    void reset() noexcept;
+
+    // Private, do not use.
+    void on_command_end(const command_stats& stats, error_code err) override;
+};
+
+} // mysql
+} // boost
+
+#include "boost/mysql/impl/histogram_observer.hpp"
+
+#endif
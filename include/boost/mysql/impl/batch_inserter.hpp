@@ -0,0 +1,280 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_BATCH_INSERTER_HPP
+#define BOOST_MYSQL_IMPL_BATCH_INSERTER_HPP
+
+#include "boost/mysql/detail/network_algorithms/execute_generic.hpp"
+#include "boost/mysql/detail/protocol/text_deserialization.hpp"
+#include "boost/mysql/detail/protocol/query_messages.hpp"
+#include "boost/mysql/detail/auxiliar/stringize.hpp"
+#include <boost/asio/coroutine.hpp>
+#include <boost/asio/post.hpp>
+
+template <typename Stream>
+boost::mysql::batch_inserter<Stream>::batch_inserter(
+    detail::channel<Stream>& chan,
+    std::string_view insert_prefix,
+    const format_options& opts,
+    std::size_t max_size
+) :
+    channel_(&chan),
+    opts_(opts),
+    max_size_(max_size)
+{
+    buffer_.push_back(static_cast<char>(detail::com_query_packet::command_id));
+    buffer_.append(insert_prefix.data(), insert_prefix.size());
+    buffer_.push_back(' ');
+    prefix_size_ = buffer_.size();
+}
+
+// Appends a row to the buffer, returning the buffer size before the row was added.
+// If the row can't be formatted, the buffer is left untouched.
+template <typename Stream>
+template <typename ForwardIterator>
+std::size_t boost::mysql::batch_inserter<Stream>::append_row(
+    ForwardIterator first,
+    ForwardIterator last,
+    error_code& err,
+    error_info& info
+)
+{
+    std::size_t previous_size = buffer_.size();
+    if (num_rows_ > 0)
+        buffer_.push_back(',');
+    buffer_.push_back('(');
+    for (std::size_t i = 0; first != last; ++first, ++i)
+    {
+        if (i > 0)
+            buffer_.push_back(',');
+        err = detail::format_value(value(*first), opts_, buffer_);
+        if (err)
+        {
+            buffer_.resize(previous_size);
+            info.set_message(detail::stringize(
+                "batch_inserter::add_row: can't format value ", i));
+            return previous_size;
+        }
+    }
+    buffer_.push_back(')');
+    ++num_rows_;
+    return previous_size;
+}
+
+template <typename Stream>
+void boost::mysql::batch_inserter<Stream>::on_flushed(
+    std::size_t sent_size,
+    const resultset<Stream>& result
+)
+{
+    affected_rows_ += result.affected_rows();
+    if (sent_size == buffer_.size())
+    {
+        buffer_.resize(prefix_size_);
+        num_rows_ = 0;
+    }
+    else
+    {
+        // The last row didn't fit in the statement we sent. Make it the
+        // first row of the next one, removing the separating comma
+        buffer_.erase(prefix_size_, sent_size + 1 - prefix_size_);
+        num_rows_ = 1;
+    }
+}
+
+template <typename Stream>
+void boost::mysql::batch_inserter<Stream>::flush_impl(
+    std::size_t size_to_send,
+    error_code& err,
+    error_info& info
+)
+{
+    resultset<Stream> result;
+    detail::execute_generic(
+        &detail::deserialize_text_row,
+        *channel_,
+        detail::serialized_request{boost::asio::buffer(buffer_.data(), size_to_send)},
+        result,
+        err,
+        info
+    );
+    if (!err)
+        on_flushed(size_to_send, result);
+}
+
+template <typename Stream>
+template <typename ForwardIterator>
+void boost::mysql::batch_inserter<Stream>::add_row(
+    ForwardIterator first,
+    ForwardIterator last,
+    error_code& err,
+    error_info& info
+)
+{
+    assert(valid());
+    detail::clear_errors(err, info);
+    std::size_t previous_size = append_row(first, last, err, info);
+    if (!err && buffer_.size() > max_size_ && num_rows_ > 1)
+    {
+        flush_impl(previous_size, err, info);
+    }
+}
+
+template <typename Stream>
+template <typename ForwardIterator>
+void boost::mysql::batch_inserter<Stream>::add_row(
+    ForwardIterator first,
+    ForwardIterator last
+)
+{
+    detail::error_block blk;
+    add_row(first, last, blk.err, blk.info);
+    blk.check();
+}
+
+template <typename Stream>
+void boost::mysql::batch_inserter<Stream>::flush(
+    error_code& err,
+    error_info& info
+)
+{
+    assert(valid());
+    detail::clear_errors(err, info);
+    if (num_rows_ > 0)
+    {
+        flush_impl(buffer_.size(), err, info);
+    }
+}
+
+template <typename Stream>
+void boost::mysql::batch_inserter<Stream>::flush()
+{
+    detail::error_block blk;
+    flush(blk.err, blk.info);
+    blk.check();
+}
+
+template <typename Stream>
+struct boost::mysql::batch_inserter<Stream>::flush_op : boost::asio::coroutine
+{
+    batch_inserter<Stream>& inserter_;
+    std::size_t size_to_send_; // zero if there is nothing to send
+    error_code initial_err_;
+    error_info* output_info_;
+
+    flush_op(
+        batch_inserter<Stream>& inserter,
+        std::size_t size_to_send,
+        error_code initial_err,
+        error_info* output_info
+    ) :
+        inserter_(inserter),
+        size_to_send_(size_to_send),
+        initial_err_(initial_err),
+        output_info_(output_info)
+    {
+    }
+
+    template <class Self>
+    void operator()(
+        Self& self,
+        error_code err = {},
+        resultset<Stream> result = {}
+    )
+    {
+        BOOST_ASIO_CORO_REENTER(*this)
+        {
+            if (initial_err_ || size_to_send_ == 0)
+            {
+                // Nothing to send; just complete, avoiding an inline call to the handler
+                BOOST_ASIO_CORO_YIELD boost::asio::post(inserter_.channel_->get_executor(), std::move(self));
+                self.complete(initial_err_);
+                BOOST_ASIO_CORO_YIELD break;
+            }
+
+            BOOST_ASIO_CORO_YIELD detail::async_execute_generic(
+                &detail::deserialize_text_row,
+                *inserter_.channel_,
+                detail::serialized_request{boost::asio::buffer(inserter_.buffer_.data(), size_to_send_)},
+                std::move(self),
+                output_info_
+            );
+            if (!err)
+                inserter_.on_flushed(size_to_send_, result);
+            self.complete(err);
+        }
+    }
+};
+
+template <typename Stream>
+template <typename CompletionToken>
+auto boost::mysql::batch_inserter<Stream>::async_flush_impl(
+    std::size_t size_to_send,
+    error_code err,
+    CompletionToken&& token,
+    error_info* info
+)
+{
+    return boost::asio::async_compose<CompletionToken, flush_signature>(
+        flush_op(*this, size_to_send, err, info),
+        token,
+        *channel_
+    );
+}
+
+template <typename Stream>
+template <typename ForwardIterator, typename CompletionToken>
+BOOST_MYSQL_INITFN_RESULT_TYPE(
+    CompletionToken,
+    typename boost::mysql::batch_inserter<Stream>::add_row_signature
+)
+boost::mysql::batch_inserter<Stream>::async_add_row(
+    ForwardIterator first,
+    ForwardIterator last,
+    CompletionToken&& token,
+    error_info* info
+)
+{
+    assert(valid());
+    detail::conditional_clear(info);
+
+    // Values are formatted before initiating the operation, so they need not be kept alive
+    error_code err;
+    error_info nonnull_info;
+    std::size_t previous_size = append_row(first, last, err, nonnull_info);
+    detail::conditional_assign(info, std::move(nonnull_info));
+    bool must_flush = !err && buffer_.size() > max_size_ && num_rows_ > 1;
+    return async_flush_impl(
+        must_flush ? previous_size : 0,
+        err,
+        std::forward<CompletionToken>(token),
+        info
+    );
+}
+
+template <typename Stream>
+template <typename CompletionToken>
+BOOST_MYSQL_INITFN_RESULT_TYPE(
+    CompletionToken,
+    typename boost::mysql::batch_inserter<Stream>::flush_signature
+)
+boost::mysql::batch_inserter<Stream>::async_flush(
+    CompletionToken&& token,
+    error_info* info
+)
+{
+    assert(valid());
+    detail::conditional_clear(info);
+    return async_flush_impl(
+        num_rows_ > 0 ? buffer_.size() : 0,
+        error_code(),
+        std::forward<CompletionToken>(token),
+        info
+    );
+}
+
+#endif
@@ -0,0 +1,114 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_COMPACT_ROW_HPP
+#define BOOST_MYSQL_IMPL_COMPACT_ROW_HPP
+
+#include <cstdint>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// Whether str points into the memory range [first, first + size).
+// Addresses are compared as integers, as first may be stale
+inline bool is_contained(std::string_view str, std::uintptr_t first, std::size_t size) noexcept
+{
+    auto str_first = reinterpret_cast<std::uintptr_t>(str.data());
+    return str_first >= first && str_first + str.size() <= first + size;
+}
+
+} // detail
+} // mysql
+} // boost
+
+inline boost::mysql::compact_row::compact_row(
+    owning_row&& r
+) :
+    buffer_(std::move(r.buffer_)),
+    values_(buffer_.get_allocator())
+{
+    // buffer_ now owns the memory r used to own, so string values still point into it
+    const auto& input = r.values();
+    auto buffer_first = reinterpret_cast<std::uintptr_t>(buffer_.data());
+    std::size_t buffer_size = buffer_.size();
+    bool has_external_strings = false;
+    values_.reserve(input.size());
+    for (const auto& v: input)
+    {
+        if (v.is<std::string_view>() && !v.get<std::string_view>().empty() &&
+            !detail::is_contained(v.get<std::string_view>(), buffer_first, buffer_size))
+        {
+            has_external_strings = true;
+            values_.emplace_back(); // filled below
+        }
+        else
+        {
+            values_.push_back(compact_value::from_value(v, buffer_.data()));
+        }
+    }
+
+    // Strings pointing to memory not owned by the row are copied at the end of the buffer
+    if (has_external_strings)
+    {
+        for (std::size_t i = 0; i < input.size(); ++i)
+        {
+            const auto& v = input[i];
+            if (v.is<std::string_view>() && !v.get<std::string_view>().empty() &&
+                !detail::is_contained(v.get<std::string_view>(), buffer_first, buffer_size))
+            {
+                auto str = v.get<std::string_view>();
+                auto offset = buffer_.size();
+                buffer_.insert(buffer_.end(), str.begin(), str.end());
+                std::string_view copied (reinterpret_cast<const char*>(buffer_.data() + offset), str.size());
+                values_[i] = compact_value::from_value(value(copied), buffer_.data());
+            }
+        }
+    }
+}
+
+inline boost::mysql::row boost::mysql::compact_row::to_row() const
+{
+    std::vector<value> res;
+    res.reserve(values_.size());
+    for (const auto& v: values_)
+        res.push_back(v.to_value(buffer_.data()));
+    return row(std::move(res));
+}
+
+inline bool boost::mysql::operator==(
+    const compact_row& lhs,
+    const compact_row& rhs
+)
+{
+    if (lhs.size() != rhs.size())
+        return false;
+    for (std::size_t i = 0; i < lhs.size(); ++i)
+    {
+        if (lhs[i] != rhs[i])
+            return false;
+    }
+    return true;
+}
+
+inline bool boost::mysql::operator==(
+    const compact_row& lhs,
+    const row& rhs
+)
+{
+    const auto& rhs_values = rhs.values();
+    if (lhs.size() != rhs_values.size())
+        return false;
+    for (std::size_t i = 0; i < lhs.size(); ++i)
+    {
+        if (lhs[i] != rhs_values[i])
+            return false;
+    }
+    return true;
+}
+
+#endif
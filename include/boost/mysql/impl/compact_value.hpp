@@ -0,0 +1,108 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_COMPACT_VALUE_HPP
+#define BOOST_MYSQL_IMPL_COMPACT_VALUE_HPP
+
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <variant>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+static_assert(sizeof(compact_value) == 16);
+
+template <typename T>
+std::uint64_t to_payload(T input) noexcept
+{
+    static_assert(sizeof(T) <= sizeof(std::uint64_t));
+    std::uint64_t res = 0;
+    std::memcpy(&res, &input, sizeof(T));
+    return res;
+}
+
+template <typename T>
+T from_payload(std::uint64_t payload) noexcept
+{
+    T res;
+    std::memcpy(&res, &payload, sizeof(T));
+    return res;
+}
+
+} // detail
+} // mysql
+} // boost
+
+inline boost::mysql::compact_value boost::mysql::compact_value::from_value(
+    const value& v,
+    const std::uint8_t* base
+) noexcept
+{
+    // Adding an alternative to value requires a new kind, handled here
+    static_assert(std::variant_size_v<value::variant_type> == 9, "compact_value doesn't handle every value alternative");
+    auto var = v.to_variant();
+    switch (var.index())
+    {
+    case 0: return compact_value();
+    case 1: return compact_value(kind::int64, detail::to_payload(std::get<1>(var)));
+    case 2: return compact_value(kind::uint64, std::get<2>(var));
+    case 3:
+    {
+        auto str = std::get<3>(var);
+        std::uint64_t offset = 0;
+        if (!str.empty())
+        {
+            offset = reinterpret_cast<const std::uint8_t*>(str.data()) - base;
+            assert(offset <= std::numeric_limits<std::uint32_t>::max());
+        }
+        assert(str.size() <= std::numeric_limits<std::uint32_t>::max());
+        return compact_value(kind::string, (offset << 32) | str.size());
+    }
+    case 4: return compact_value(kind::float_, detail::to_payload(std::get<4>(var)));
+    case 5: return compact_value(kind::double_, detail::to_payload(std::get<5>(var)));
+    case 6: return compact_value(kind::date, detail::to_payload(
+        static_cast<std::int64_t>(std::get<6>(var).time_since_epoch().count())));
+    case 7: return compact_value(kind::datetime, detail::to_payload(
+        static_cast<std::int64_t>(std::get<7>(var).time_since_epoch().count())));
+    case 8: return compact_value(kind::time, detail::to_payload(
+        static_cast<std::int64_t>(std::get<8>(var).count())));
+    default: assert(false); return compact_value();
+    }
+}
+
+inline boost::mysql::value boost::mysql::compact_value::to_value(
+    const std::uint8_t* base
+) const noexcept
+{
+    switch (kind_)
+    {
+    case kind::null: return value();
+    case kind::int64: return value(detail::from_payload<std::int64_t>(payload_));
+    case kind::uint64: return value(payload_);
+    case kind::string:
+    {
+        auto size = static_cast<std::size_t>(payload_ & 0xffffffff);
+        if (size == 0)
+            return value(std::string_view());
+        const char* first = reinterpret_cast<const char*>(base + (payload_ >> 32));
+        return value(std::string_view(first, size));
+    }
+    case kind::float_: return value(detail::from_payload<float>(payload_));
+    case kind::double_: return value(detail::from_payload<double>(payload_));
+    case kind::date: return value(date(::date::days(
+        static_cast<::date::days::rep>(detail::from_payload<std::int64_t>(payload_)))));
+    case kind::datetime: return value(datetime(std::chrono::microseconds(
+        detail::from_payload<std::int64_t>(payload_))));
+    case kind::time: return value(time(detail::from_payload<std::int64_t>(payload_)));
+    default: assert(false); return value();
+    }
+}
+
+#endif
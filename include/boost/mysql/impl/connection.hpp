@@ -14,9 +14,17 @@
 #include "boost/mysql/detail/network_algorithms/quit_connection.hpp"
 #include "boost/mysql/detail/network_algorithms/close_connection.hpp"
 #include "boost/mysql/detail/network_algorithms/connect.hpp"
+#include "boost/mysql/detail/protocol/constants.hpp"
 #include "boost/mysql/detail/auxiliar/check_completion_token.hpp"
 #include <boost/asio/buffer.hpp>
 
+template <typename Stream>
+boost::mysql::format_options boost::mysql::connection<Stream>::format_opts() const noexcept
+{
+    bool no_backslash_escapes = channel_.status_flags() & detail::SERVER_STATUS_NO_BACKSLASH_ESCAPES;
+    return format_options(channel_.current_collation(), !no_backslash_escapes);
+}
+
 template <typename Stream>
 void boost::mysql::connection<Stream>::handshake(
     const connection_params& params,
@@ -111,6 +119,52 @@ boost::mysql::connection<Stream>::async_query(
     );
 }
 
+template <typename Stream>
+void boost::mysql::connection<Stream>::query(
+    std::string_view query_string,
+    resultset<Stream>& output,
+    error_code& err,
+    error_info& info
+)
+{
+    detail::clear_errors(err, info);
+    detail::execute_query(channel_, query_string, output, err, info);
+}
+
+template <typename Stream>
+void boost::mysql::connection<Stream>::query(
+    std::string_view query_string,
+    resultset<Stream>& output
+)
+{
+    detail::error_block blk;
+    detail::execute_query(channel_, query_string, output, blk.err, blk.info);
+    blk.check();
+}
+
+template <typename Stream>
+template <typename CompletionToken>
+BOOST_MYSQL_INITFN_RESULT_TYPE(
+    CompletionToken,
+    typename boost::mysql::connection<Stream>::query_into_signature
+)
+boost::mysql::connection<Stream>::async_query(
+    std::string_view query_string,
+    resultset<Stream>& output,
+    CompletionToken&& token,
+    error_info* info
+)
+{
+    detail::conditional_clear(info);
+    return detail::async_execute_query(
+        channel_,
+        query_string,
+        output,
+        std::forward<CompletionToken>(token),
+        info
+    );
+}
+
 template <typename Stream>
 boost::mysql::prepared_statement<Stream> boost::mysql::connection<Stream>::prepare_statement(
     std::string_view statement,
@@ -0,0 +1,193 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_CONNECTION_OBSERVER_HPP
+#define BOOST_MYSQL_IMPL_CONNECTION_OBSERVER_HPP
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// Letters, digits, _, $ and any non-ASCII character (UTF-8 identifiers)
+inline bool is_identifier_char(char c) noexcept
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+        c == '_' || c == '$' || static_cast<unsigned char>(c) >= 0x80;
+}
+
+inline bool is_digit(char c) noexcept { return c >= '0' && c <= '9'; }
+
+inline bool is_space(char c) noexcept
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+// Returns the position past the end of the quoted text starting at
+// sql[first], which is the opening quote. Quotes may be escaped by doubling them
+// and, except for identifiers, by a backslash
+inline std::size_t skip_quoted(std::string_view sql, std::size_t first) noexcept
+{
+    char quote = sql[first];
+    std::size_t i = first + 1;
+    while (i < sql.size())
+    {
+        char c = sql[i];
+        if (c == '\\' && quote != '`')
+        {
+            i += 2;
+        }
+        else if (c == quote)
+        {
+            if (i + 1 < sql.size() && sql[i + 1] == quote)
+                i += 2;
+            else
+                return i + 1;
+        }
+        else
+        {
+            ++i;
+        }
+    }
+    return sql.size();
+}
+
+// Returns the position past the end of the numeric literal starting at sql[first]
+inline std::size_t skip_number(std::string_view sql, std::size_t first) noexcept
+{
+    std::size_t i = first;
+    if (sql[i] == '0' && i + 1 < sql.size() && (sql[i + 1] == 'x' || sql[i + 1] == 'b'))
+    {
+        // 0x1F, 0b101
+        i += 2;
+        while (i < sql.size() && is_identifier_char(sql[i]))
+            ++i;
+        return i;
+    }
+    while (i < sql.size() && (is_digit(sql[i]) || sql[i] == '.'))
+        ++i;
+    if (i < sql.size() && (sql[i] == 'e' || sql[i] == 'E'))
+    {
+        // Exponent, as in 1.5e-3
+        std::size_t j = i + 1;
+        if (j < sql.size() && (sql[j] == '+' || sql[j] == '-'))
+            ++j;
+        if (j < sql.size() && is_digit(sql[j]))
+        {
+            i = j;
+            while (i < sql.size() && is_digit(sql[i]))
+                ++i;
+        }
+    }
+    return i;
+}
+
+} // detail
+} // mysql
+} // boost
+
+template <typename Allocator>
+void boost::mysql::sql_digest(
+    std::string_view sql,
+    std::basic_string<char, std::char_traits<char>, Allocator>& output
+)
+{
+    output.clear();
+    bool pending_space = false;   // whitespace or comments have been skipped
+    bool prev_identifier = false; // last character copied was part of an identifier or keyword
+
+    auto append = [&](std::string_view chunk) {
+        if (pending_space && !output.empty())
+            output.push_back(' ');
+        pending_space = false;
+        output.append(chunk.data(), chunk.size());
+    };
+
+    std::size_t i = 0;
+    while (i < sql.size())
+    {
+        char c = sql[i];
+        char next = i + 1 < sql.size() ? sql[i + 1] : '\0';
+        if (detail::is_space(c))
+        {
+            pending_space = true;
+            prev_identifier = false;
+            ++i;
+            continue;
+        }
+        else if (c == '#' || (c == '-' && next == '-' && (i + 2 == sql.size() || detail::is_space(sql[i + 2]))))
+        {
+            // Single line comment
+            auto pos = sql.find('\n', i);
+            i = pos == std::string_view::npos ? sql.size() : pos;
+            pending_space = true;
+            prev_identifier = false;
+            continue;
+        }
+        else if (c == '/' && next == '*')
+        {
+            auto pos = sql.find("*/", i + 2);
+            i = pos == std::string_view::npos ? sql.size() : pos + 2;
+            pending_space = true;
+            prev_identifier = false;
+            continue;
+        }
+        else if (c == '\'' || c == '"')
+        {
+            i = detail::skip_quoted(sql, i);
+            append("?");
+            prev_identifier = false;
+        }
+        else if (c == '`')
+        {
+            auto last = detail::skip_quoted(sql, i);
+            append(sql.substr(i, last - i));
+            i = last;
+            prev_identifier = false;
+        }
+        else if (
+            !prev_identifier &&
+            (c == 'x' || c == 'X' || c == 'b' || c == 'B' || c == 'n' || c == 'N') &&
+            next == '\''
+        )
+        {
+            // X'1F', B'101', N'text'
+            i = detail::skip_quoted(sql, i + 1);
+            append("?");
+            prev_identifier = false;
+        }
+        else if (!prev_identifier && (detail::is_digit(c) || (c == '.' && detail::is_digit(next))))
+        {
+            i = detail::skip_number(sql, i);
+            append("?");
+            prev_identifier = false;
+        }
+        else
+        {
+            append(sql.substr(i, 1));
+            prev_identifier = detail::is_identifier_char(c);
+            ++i;
+            continue;
+        }
+
+        // A literal or quoted identifier has been written. Whitespace is
+        // not required after them, but a space would have been there
+        // if the next token were an identifier (e.g. 'a'AS x)
+        if (i < sql.size() && detail::is_identifier_char(sql[i]))
+            pending_space = true;
+    }
+}
+
+inline std::string boost::mysql::sql_digest(
+    std::string_view sql
+)
+{
+    std::string res;
+    sql_digest(sql, res);
+    return res;
+}
+
+#endif
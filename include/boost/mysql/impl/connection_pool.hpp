@@ -0,0 +1,190 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_CONNECTION_POOL_HPP
+#define BOOST_MYSQL_IMPL_CONNECTION_POOL_HPP
+
+#include <boost/asio/coroutine.hpp>
+#include <boost/asio/post.hpp>
+#include <algorithm>
+
+template <typename Stream>
+void boost::mysql::pooled_connection<Stream>::release() noexcept
+{
+    if (conn_)
+    {
+        pool_->release(*conn_);
+        pool_ = nullptr;
+        conn_ = nullptr;
+    }
+}
+
+template <typename Stream>
+boost::mysql::connection_pool<Stream>::connection_pool(
+    const executor_type& ex,
+    const endpoint_type& endpoint,
+    const connection_params& params,
+    pool_options opts
+) :
+    executor_(ex),
+    endpoint_(endpoint),
+    params_(params),
+    opts_(std::move(opts)),
+    wait_timer_(ex)
+{
+    wait_timer_.expires_at(std::chrono::steady_clock::time_point::max());
+}
+
+template <typename Stream>
+boost::mysql::resilient_connection<Stream>&
+boost::mysql::connection_pool<Stream>::create_connection()
+{
+    connections_.push_back(std::make_unique<resilient_connection<Stream>>(executor_));
+    connections_.back()->set_retry_policy(opts_.retry);
+    return *connections_.back();
+}
+
+template <typename Stream>
+void boost::mysql::connection_pool<Stream>::destroy_connection(
+    resilient_connection<Stream>& conn
+)
+{
+    connections_.erase(std::find_if(connections_.begin(), connections_.end(),
+        [&conn](const auto& ptr) { return ptr.get() == &conn; }));
+    error_code ignored;
+    wait_timer_.cancel_one(ignored); // there is room for a new connection
+}
+
+template <typename Stream>
+void boost::mysql::connection_pool<Stream>::release(
+    resilient_connection<Stream>& conn
+) noexcept
+{
+    idle_.push_back(&conn);
+    error_code ignored;
+    wait_timer_.cancel_one(ignored);
+}
+
+template <typename Stream>
+boost::mysql::pooled_connection<Stream> boost::mysql::connection_pool<Stream>::acquire(
+    error_code& err,
+    error_info& info
+)
+{
+    detail::clear_errors(err, info);
+    if (!idle_.empty())
+    {
+        auto* conn = idle_.back();
+        idle_.pop_back();
+        return make_handle(*conn);
+    }
+    if (connections_.size() >= opts_.max_size)
+    {
+        err = boost::asio::error::would_block;
+        info.set_message("All the connections in the pool are in use");
+        return pooled_connection<Stream>();
+    }
+    auto& conn = create_connection();
+    conn.connect(endpoint_, params_.get(), err, info);
+    if (err)
+    {
+        destroy_connection(conn);
+        return pooled_connection<Stream>();
+    }
+    return make_handle(conn);
+}
+
+template <typename Stream>
+boost::mysql::pooled_connection<Stream> boost::mysql::connection_pool<Stream>::acquire()
+{
+    detail::error_block blk;
+    auto res = acquire(blk.err, blk.info);
+    blk.check();
+    return res;
+}
+
+template <typename Stream>
+struct boost::mysql::connection_pool<Stream>::acquire_op : boost::asio::coroutine
+{
+    connection_pool<Stream>& pool_;
+    error_info* output_info_;
+    resilient_connection<Stream>* conn_ {};
+
+    acquire_op(connection_pool<Stream>& pool, error_info* output_info) :
+        pool_(pool), output_info_(output_info) {}
+
+    template <class Self>
+    void operator()(
+        Self& self,
+        error_code err = {}
+    )
+    {
+        BOOST_ASIO_CORO_REENTER(*this)
+        {
+            // Avoid completing inline. Connections are taken after this point,
+            // so they are never lost if the operation doesn't run
+            BOOST_ASIO_CORO_YIELD boost::asio::post(pool_.executor_, std::move(self));
+
+            for (;;)
+            {
+                if (!pool_.idle_.empty())
+                {
+                    conn_ = pool_.idle_.back();
+                    pool_.idle_.pop_back();
+                    self.complete(error_code(), pool_.make_handle(*conn_));
+                    BOOST_ASIO_CORO_YIELD break;
+                }
+
+                if (pool_.connections_.size() < pool_.opts_.max_size)
+                {
+                    conn_ = &pool_.create_connection();
+                    BOOST_ASIO_CORO_YIELD conn_->async_connect(
+                        pool_.endpoint_,
+                        pool_.params_.get(),
+                        std::move(self),
+                        output_info_
+                    );
+                    if (err)
+                    {
+                        pool_.destroy_connection(*conn_);
+                        self.complete(err, pooled_connection<Stream>());
+                    }
+                    else
+                    {
+                        self.complete(error_code(), pool_.make_handle(*conn_));
+                    }
+                    BOOST_ASIO_CORO_YIELD break;
+                }
+
+                // Wait until a connection is released (the wait completes
+                // with operation_aborted when woken up)
+                BOOST_ASIO_CORO_YIELD pool_.wait_timer_.async_wait(std::move(self));
+            }
+        }
+    }
+};
+
+template <typename Stream>
+template <typename CompletionToken>
+BOOST_MYSQL_INITFN_RESULT_TYPE(
+    CompletionToken,
+    typename boost::mysql::connection_pool<Stream>::acquire_signature
+)
+boost::mysql::connection_pool<Stream>::async_acquire(
+    CompletionToken&& token,
+    error_info* info
+)
+{
+    detail::conditional_clear(info);
+    return boost::asio::async_compose<CompletionToken, acquire_signature>(
+        acquire_op(*this, info),
+        token,
+        executor_
+    );
+}
+
+#endif
@@ -0,0 +1,307 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_DECIMAL_HPP
+#define BOOST_MYSQL_IMPL_DECIMAL_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// Minimal unsigned 128-bit arithmetic, enough to implement decimal.
+// All values handled here are less than 10^38, so additions never overflow
+struct uint128
+{
+    std::uint64_t high;
+    std::uint64_t low;
+};
+
+constexpr uint128 pow10_37 { 0x0785ee10d5da46d9, 0x00f436a000000000 };
+constexpr uint128 pow10_38 { 0x4b3b4ca85a86c47a, 0x098a224000000000 };
+
+inline int compare(uint128 lhs, uint128 rhs) noexcept
+{
+    if (lhs.high != rhs.high)
+        return lhs.high < rhs.high ? -1 : 1;
+    if (lhs.low != rhs.low)
+        return lhs.low < rhs.low ? -1 : 1;
+    return 0;
+}
+
+inline uint128 add(uint128 lhs, uint128 rhs) noexcept
+{
+    uint128 res { lhs.high + rhs.high, lhs.low + rhs.low };
+    if (res.low < lhs.low)
+        ++res.high;
+    return res;
+}
+
+// Requires lhs >= rhs
+inline uint128 subtract(uint128 lhs, uint128 rhs) noexcept
+{
+    uint128 res { lhs.high - rhs.high, lhs.low - rhs.low };
+    if (lhs.low < rhs.low)
+        --res.high;
+    return res;
+}
+
+// Multiplies by 10. Returns false if the result would not be less than 10^38
+inline bool multiply10(uint128& value) noexcept
+{
+    if (compare(value, pow10_37) >= 0)
+        return false;
+    uint128 times2 { (value.high << 1) | (value.low >> 63), value.low << 1 };
+    uint128 times8 { (value.high << 3) | (value.low >> 61), value.low << 3 };
+    value = add(times2, times8);
+    return true;
+}
+
+// Divides by 10, returning the remainder. Long division using 32-bit digits
+inline unsigned divide10(uint128& value) noexcept
+{
+    std::uint64_t rem = value.high % 10;
+    value.high /= 10;
+    std::uint64_t part = (rem << 32) | (value.low >> 32);
+    std::uint64_t quotient_high = part / 10;
+    rem = part % 10;
+    part = (rem << 32) | (value.low & 0xffffffff);
+    value.low = (quotient_high << 32) | (part / 10);
+    return static_cast<unsigned>(part % 10);
+}
+
+inline bool is_zero(uint128 value) noexcept { return value.high == 0 && value.low == 0; }
+
+} // detail
+} // mysql
+} // boost
+
+constexpr boost::mysql::decimal::decimal(
+    std::int64_t unscaled_value,
+    unsigned scale
+) noexcept :
+    high_(0),
+    low_(unscaled_value < 0 ?
+        ~static_cast<std::uint64_t>(unscaled_value) + 1 :
+        static_cast<std::uint64_t>(unscaled_value)),
+    scale_(static_cast<std::uint8_t>(scale)),
+    negative_(unscaled_value < 0)
+{
+    assert(scale <= max_precision);
+}
+
+inline std::optional<boost::mysql::decimal> boost::mysql::decimal::parse(
+    std::string_view from
+) noexcept
+{
+    decimal res;
+    std::size_t i = 0;
+    if (!from.empty() && (from[0] == '-' || from[0] == '+'))
+    {
+        res.negative_ = from[0] == '-';
+        ++i;
+    }
+
+    detail::uint128 magnitude {0, 0};
+    unsigned num_digits = 0; // significant digits only
+    unsigned scale = 0;
+    bool has_digits = false;
+    bool has_dot = false;
+    for (; i < from.size(); ++i)
+    {
+        char c = from[i];
+        if (c == '.' && !has_dot)
+        {
+            has_dot = true;
+            continue;
+        }
+        if (c < '0' || c > '9')
+            return {};
+        has_digits = true;
+        if (has_dot && ++scale > max_precision)
+            return {};
+        if (num_digits > 0 || c != '0')
+        {
+            if (++num_digits > max_precision)
+                return {};
+            bool ok = detail::multiply10(magnitude);
+            assert(ok); // magnitude has at most 37 digits
+            (void)ok;
+            magnitude = detail::add(magnitude, detail::uint128{0, static_cast<std::uint64_t>(c - '0')});
+        }
+    }
+    if (!has_digits)
+        return {};
+
+    res.high_ = magnitude.high;
+    res.low_ = magnitude.low;
+    res.scale_ = static_cast<std::uint8_t>(scale);
+    if (detail::is_zero(magnitude))
+        res.negative_ = false;
+    return res;
+}
+
+inline std::optional<boost::mysql::decimal> boost::mysql::decimal::rescale(
+    unsigned new_scale
+) const noexcept
+{
+    if (new_scale > max_precision)
+        return {};
+    detail::uint128 magnitude { high_, low_ };
+    if (new_scale >= scale_)
+    {
+        for (unsigned i = scale_; i < new_scale; ++i)
+        {
+            if (!detail::multiply10(magnitude))
+                return {};
+        }
+    }
+    else
+    {
+        unsigned last_digit = 0;
+        for (unsigned i = new_scale; i < scale_; ++i)
+            last_digit = detail::divide10(magnitude);
+        if (last_digit >= 5)
+            magnitude = detail::add(magnitude, detail::uint128{0, 1});
+    }
+    decimal res;
+    res.high_ = magnitude.high;
+    res.low_ = magnitude.low;
+    res.scale_ = static_cast<std::uint8_t>(new_scale);
+    res.negative_ = negative_ && !detail::is_zero(magnitude);
+    return res;
+}
+
+inline std::string boost::mysql::decimal::to_string() const
+{
+    char buffer [max_string_size];
+    return std::string(buffer, to_chars(buffer));
+}
+
+inline std::size_t boost::mysql::decimal::to_chars(
+    char* output
+) const noexcept
+{
+    // Digits are generated in reverse order
+    char buffer [max_precision + 2]; // digits, an extra leading zero and the dot
+    std::size_t size = 0;
+    detail::uint128 magnitude { high_, low_ };
+    do
+    {
+        if (size == scale_ && size != 0)
+            buffer[size++] = '.';
+        buffer[size++] = static_cast<char>('0' + detail::divide10(magnitude));
+    } while (!detail::is_zero(magnitude) || size <= scale_);
+
+    char* it = output;
+    if (negative_)
+        *it++ = '-';
+    while (size > 0)
+        *it++ = buffer[--size];
+    return static_cast<std::size_t>(it - output);
+}
+
+inline double boost::mysql::decimal::to_double() const noexcept
+{
+    double res = static_cast<double>(high_) * 18446744073709551616.0 + static_cast<double>(low_);
+    res /= std::pow(10.0, scale_);
+    return negative_ ? -res : res;
+}
+
+inline boost::mysql::decimal boost::mysql::decimal::operator-() const noexcept
+{
+    decimal res (*this);
+    res.negative_ = !negative_ && !detail::is_zero({ high_, low_ });
+    return res;
+}
+
+inline boost::mysql::decimal& boost::mysql::decimal::add(
+    const decimal& rhs,
+    bool rhs_negative
+)
+{
+    unsigned scale = std::max(scale_, rhs.scale_);
+    auto lhs_scaled = rescale(scale);
+    auto rhs_scaled = rhs.rescale(scale);
+    if (!lhs_scaled || !rhs_scaled)
+        throw std::overflow_error("decimal: result exceeds max_precision digits");
+    detail::uint128 lhs_mag { lhs_scaled->high_, lhs_scaled->low_ };
+    detail::uint128 rhs_mag { rhs_scaled->high_, rhs_scaled->low_ };
+
+    detail::uint128 res;
+    bool res_negative;
+    if (negative_ == rhs_negative)
+    {
+        res = detail::add(lhs_mag, rhs_mag);
+        if (detail::compare(res, detail::pow10_38) >= 0)
+            throw std::overflow_error("decimal: result exceeds max_precision digits");
+        res_negative = negative_;
+    }
+    else if (detail::compare(lhs_mag, rhs_mag) >= 0)
+    {
+        res = detail::subtract(lhs_mag, rhs_mag);
+        res_negative = negative_;
+    }
+    else
+    {
+        res = detail::subtract(rhs_mag, lhs_mag);
+        res_negative = rhs_negative;
+    }
+
+    high_ = res.high;
+    low_ = res.low;
+    scale_ = static_cast<std::uint8_t>(scale);
+    negative_ = res_negative && !detail::is_zero(res);
+    return *this;
+}
+
+inline boost::mysql::decimal& boost::mysql::decimal::operator+=(
+    const decimal& rhs
+)
+{
+    return add(rhs, rhs.negative_);
+}
+
+inline boost::mysql::decimal& boost::mysql::decimal::operator-=(
+    const decimal& rhs
+)
+{
+    return add(rhs, !rhs.negative_ && !detail::is_zero({ rhs.high_, rhs.low_ }));
+}
+
+inline int boost::mysql::decimal::compare(
+    const decimal& rhs
+) const noexcept
+{
+    if (negative_ != rhs.negative_)
+        return negative_ ? -1 : 1;
+
+    // Compare magnitudes at the same scale. If rescaling overflows,
+    // that number has the greater magnitude, as the other one fits
+    int res;
+    if (scale_ == rhs.scale_)
+    {
+        res = detail::compare({ high_, low_ }, { rhs.high_, rhs.low_ });
+    }
+    else if (scale_ < rhs.scale_)
+    {
+        auto lhs = rescale(rhs.scale_);
+        res = lhs ? detail::compare({ lhs->high_, lhs->low_ }, { rhs.high_, rhs.low_ }) : 1;
+    }
+    else
+    {
+        auto rhs_scaled = rhs.rescale(scale_);
+        res = rhs_scaled ? detail::compare({ high_, low_ }, { rhs_scaled->high_, rhs_scaled->low_ }) : -1;
+    }
+    return negative_ ? -res : res;
+}
+
+#endif
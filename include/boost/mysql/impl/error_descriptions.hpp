@@ -1412,6 +1412,10 @@ constexpr error_entry all_errors [] = {
     { errc::unknown_auth_plugin, "The user employs an authentication plugin not known to this library" },
     { errc::auth_plugin_requires_ssl, "The authentication plugin requires the connection to use SSL" },
     { errc::wrong_num_params, "The number of parameters passed to the prepared statement does not match the number of actual parameters" },
+    { errc::wrong_num_format_args, "The number of arguments passed to format_sql does not match the number of placeholders in the format string" },
+    { errc::invalid_format_string, "The format string passed to format_sql is malformed" },
+    { errc::unformattable_value, "A value passed to format_sql can't be represented as a SQL literal" },
+    { errc::unsupported_character_set, "The operation does not support the connection's character set" },
 };
 
 } // detail
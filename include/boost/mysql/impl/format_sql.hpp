@@ -0,0 +1,415 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_FORMAT_SQL_HPP
+#define BOOST_MYSQL_IMPL_FORMAT_SQL_HPP
+
+#include "boost/mysql/detail/auxiliar/stringize.hpp"
+#include <cmath>
+#include <cstdio>
+#include <iterator>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// Character sets, from the point of view of escaping. ASCII compatible character
+// sets never contain bytes < 0x80 within multi-byte characters, so they
+// can be escaped byte by byte. The others need to be processed character by character,
+// as their multi-byte characters may contain backslashes or quotes.
+enum class escape_charset
+{
+    ascii_compatible,
+    big5,
+    sjis, // also cp932
+    gbk,
+    gb18030,
+    unsupported // ucs2, utf16, utf16le, utf32: not valid as client character sets
+};
+
+inline escape_charset get_escape_charset(collation value) noexcept
+{
+    auto id = static_cast<std::uint16_t>(value);
+    switch (value)
+    {
+    case collation::big5_chinese_ci:
+    case collation::big5_bin:
+        return escape_charset::big5;
+    case collation::sjis_japanese_ci:
+    case collation::sjis_bin:
+    case collation::cp932_japanese_ci:
+    case collation::cp932_bin:
+        return escape_charset::sjis;
+    case collation::gbk_chinese_ci:
+    case collation::gbk_bin:
+        return escape_charset::gbk;
+    case collation::gb18030_chinese_ci:
+    case collation::gb18030_bin:
+    case collation::gb18030_unicode_520_ci:
+        return escape_charset::gb18030;
+    case collation::ucs2_general_ci:
+    case collation::ucs2_bin:
+    case collation::ucs2_general_mysql500_ci:
+    case collation::utf16_general_ci:
+    case collation::utf16_bin:
+    case collation::utf16le_general_ci:
+    case collation::utf16le_bin:
+    case collation::utf32_general_ci:
+    case collation::utf32_bin:
+        return escape_charset::unsupported;
+    default:
+        // utf16_unicode_ci...utf16_vietnamese_ci, ucs2_unicode_ci...ucs2_vietnamese_ci,
+        // utf32_unicode_ci...utf32_vietnamese_ci
+        if ((id >= 101 && id <= 124) || (id >= 128 && id <= 151) || (id >= 160 && id <= 183))
+            return escape_charset::unsupported;
+        return escape_charset::ascii_compatible;
+    }
+}
+
+inline bool in_range(unsigned char c, unsigned char lower, unsigned char upper) noexcept
+{
+    return c >= lower && c <= upper;
+}
+
+// Does c look like the first byte of a multi-byte character?
+inline bool is_mb_lead(escape_charset charset, unsigned char c) noexcept
+{
+    switch (charset)
+    {
+    case escape_charset::big5:
+    case escape_charset::gbk:
+    case escape_charset::gb18030:
+        return in_range(c, 0x81, 0xfe);
+    case escape_charset::sjis:
+        return in_range(c, 0x81, 0x9f) || in_range(c, 0xe0, 0xfc);
+    default:
+        return false;
+    }
+}
+
+// Returns the length of the valid multi-byte character starting at first,
+// or zero if there is no such character
+inline std::size_t get_mb_length(
+    escape_charset charset,
+    const unsigned char* first,
+    const unsigned char* last
+) noexcept
+{
+    std::size_t size = last - first;
+    if (size < 2 || !is_mb_lead(charset, first[0]))
+        return 0;
+    unsigned char trail = first[1];
+    switch (charset)
+    {
+    case escape_charset::big5:
+        return (in_range(trail, 0x40, 0x7e) || in_range(trail, 0xa1, 0xfe)) ? 2 : 0;
+    case escape_charset::sjis:
+        return (in_range(trail, 0x40, 0x7e) || in_range(trail, 0x80, 0xfc)) ? 2 : 0;
+    case escape_charset::gbk:
+        return (in_range(trail, 0x40, 0x7e) || in_range(trail, 0x80, 0xfe)) ? 2 : 0;
+    case escape_charset::gb18030:
+        if (in_range(trail, 0x40, 0x7e) || in_range(trail, 0x80, 0xfe))
+            return 2;
+        if (size >= 4 && in_range(trail, 0x30, 0x39) &&
+                in_range(first[2], 0x81, 0xfe) && in_range(first[3], 0x30, 0x39))
+            return 4;
+        return 0;
+    default:
+        return 0;
+    }
+}
+
+// Appends input to output, escaped so it can be placed between single quotes.
+// Follows the same rules as the C API mysql_real_escape_string_quote
+inline error_code escape_string(
+    std::string_view input,
+    const format_options& opts,
+    std::string& output
+)
+{
+    auto charset = get_escape_charset(opts.connection_collation());
+    if (charset == escape_charset::unsupported)
+        return make_error_code(errc::unsupported_character_set);
+
+    const auto* first = reinterpret_cast<const unsigned char*>(input.data());
+    const auto* last = first + input.size();
+    while (first != last)
+    {
+        // Valid multi-byte characters are copied as they are
+        std::size_t mb_length = get_mb_length(charset, first, last);
+        if (mb_length)
+        {
+            output.append(reinterpret_cast<const char*>(first), mb_length);
+            first += mb_length;
+            continue;
+        }
+
+        unsigned char c = *first++;
+        if (!opts.backslash_escapes())
+        {
+            // Only quotes need escaping, by doubling them
+            if (c == '\'')
+                output.push_back('\'');
+            output.push_back(static_cast<char>(c));
+            continue;
+        }
+
+        // If c looks like the start of a multi-byte character but the sequence
+        // is not valid, escape it. Otherwise, the backslash we might insert
+        // for the following byte could turn it into a valid character
+        // (e.g. 0xbf27 is not a valid gbk character, but 0xbf5c is)
+        char escape = 0;
+        if (is_mb_lead(charset, c))
+        {
+            escape = static_cast<char>(c);
+        }
+        else
+        {
+            switch (c)
+            {
+            case 0: escape = '0'; break;
+            case '\n': escape = 'n'; break;
+            case '\r': escape = 'r'; break;
+            case '\\': escape = '\\'; break;
+            case '\'': escape = '\''; break;
+            case '"': escape = '"'; break;
+            case '\032': escape = 'Z'; break;
+            }
+        }
+
+        if (escape)
+        {
+            output.push_back('\\');
+            output.push_back(escape);
+        }
+        else
+        {
+            output.push_back(static_cast<char>(c));
+        }
+    }
+    return error_code();
+}
+
+inline void append_ymd(
+    const ::date::year_month_day& ymd,
+    std::string& output
+)
+{
+    char buffer [32] {};
+    snprintf(buffer, sizeof(buffer), "%04d-%02u-%02u",
+        static_cast<int>(ymd.year()),
+        static_cast<unsigned>(ymd.month()),
+        static_cast<unsigned>(ymd.day())
+    );
+    output += buffer;
+}
+
+inline void append_time_of_day(
+    std::chrono::microseconds value, // may be negative or greater than 24h
+    std::string& output
+)
+{
+    char buffer [64] {};
+    const char* sign = value < std::chrono::microseconds(0) ? "-" : "";
+    auto abs_value = std::chrono::microseconds(std::abs(value.count()));
+    auto hours = std::chrono::duration_cast<std::chrono::hours>(abs_value).count();
+    auto mins = std::chrono::duration_cast<std::chrono::minutes>(abs_value % std::chrono::hours(1)).count();
+    auto secs = std::chrono::duration_cast<std::chrono::seconds>(abs_value % std::chrono::minutes(1)).count();
+    auto micros = (abs_value % std::chrono::seconds(1)).count();
+    snprintf(buffer, sizeof(buffer), "%s%02u:%02u:%02u.%06u",
+        sign,
+        static_cast<unsigned>(hours),
+        static_cast<unsigned>(mins),
+        static_cast<unsigned>(secs),
+        static_cast<unsigned>(micros)
+    );
+    output += buffer;
+}
+
+struct format_visitor
+{
+    const format_options& opts;
+    std::string& output;
+
+    format_visitor(const format_options& opts, std::string& output): opts(opts), output(output) {}
+
+    error_code operator()(std::nullptr_t) const
+    {
+        output += "NULL";
+        return error_code();
+    }
+    error_code operator()(std::int64_t v) const
+    {
+        char buffer [32] {};
+        snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(v));
+        output += buffer;
+        return error_code();
+    }
+    error_code operator()(std::uint64_t v) const
+    {
+        char buffer [32] {};
+        snprintf(buffer, sizeof(buffer), "%llu", static_cast<unsigned long long>(v));
+        output += buffer;
+        return error_code();
+    }
+    error_code operator()(std::string_view v) const
+    {
+        output.push_back('\'');
+        auto err = escape_string(v, opts, output);
+        output.push_back('\'');
+        return err;
+    }
+    error_code operator()(float v) const { return format_floating_point(v, 9); }
+    error_code operator()(double v) const { return format_floating_point(v, 17); }
+    error_code operator()(const date& v) const
+    {
+        output.push_back('\'');
+        append_ymd(::date::year_month_day(v), output);
+        output.push_back('\'');
+        return error_code();
+    }
+    error_code operator()(const datetime& v) const
+    {
+        auto days = ::date::floor<::date::days>(v);
+        output.push_back('\'');
+        append_ymd(::date::year_month_day(days), output);
+        output.push_back(' ');
+        append_time_of_day(v - days, output);
+        output.push_back('\'');
+        return error_code();
+    }
+    error_code operator()(const time& v) const
+    {
+        output.push_back('\'');
+        append_time_of_day(v, output);
+        output.push_back('\'');
+        return error_code();
+    }
+
+    // Exponential notation makes the server parse the literal as a DOUBLE.
+    // precision is the number of digits required for the value to round-trip
+    error_code format_floating_point(double v, int precision) const
+    {
+        if (!std::isfinite(v))
+            return make_error_code(errc::unformattable_value);
+        char buffer [64] {};
+        snprintf(buffer, sizeof(buffer), "%.*e", precision - 1, v);
+        output += buffer;
+        return error_code();
+    }
+};
+
+inline error_code format_value(
+    const value& v,
+    const format_options& opts,
+    std::string& output
+)
+{
+    return std::visit(format_visitor(opts, output), v.to_variant());
+}
+
+} // detail
+} // mysql
+} // boost
+
+template <typename ForwardIterator>
+void boost::mysql::format_sql(
+    std::string_view format_str,
+    ForwardIterator params_first,
+    ForwardIterator params_last,
+    const format_options& opts,
+    std::string& output,
+    error_code& err,
+    error_info& info
+)
+{
+    detail::clear_errors(err, info);
+    output.clear();
+
+    std::size_t num_placeholders = 0;
+    auto param_count = std::distance(params_first, params_last);
+    auto it = format_str.begin();
+    auto end = format_str.end();
+    while (it != end)
+    {
+        char c = *it++;
+        if (c == '{')
+        {
+            if (it != end && *it == '{') // escaped brace
+            {
+                ++it;
+                output.push_back('{');
+            }
+            else if (it != end && *it == '}') // placeholder
+            {
+                ++it;
+                if (params_first == params_last)
+                {
+                    // Keep counting placeholders to generate a meaningful message
+                    ++num_placeholders;
+                    continue;
+                }
+                err = detail::format_value(value(*params_first), opts, output);
+                if (err)
+                {
+                    info.set_message(detail::stringize(
+                        "format_sql: can't format argument ", num_placeholders));
+                    return;
+                }
+                ++params_first;
+                ++num_placeholders;
+            }
+            else
+            {
+                err = detail::make_error_code(errc::invalid_format_string);
+                info.set_message(detail::stringize(
+                    "format_sql: unmatched '{' at position ", (it - format_str.begin()) - 1));
+                return;
+            }
+        }
+        else if (c == '}')
+        {
+            if (it == end || *it != '}')
+            {
+                err = detail::make_error_code(errc::invalid_format_string);
+                info.set_message(detail::stringize(
+                    "format_sql: unmatched '}' at position ", (it - format_str.begin()) - 1));
+                return;
+            }
+            ++it;
+            output.push_back('}');
+        }
+        else
+        {
+            output.push_back(c);
+        }
+    }
+
+    if (num_placeholders != static_cast<std::size_t>(param_count))
+    {
+        err = detail::make_error_code(errc::wrong_num_format_args);
+        info.set_message(detail::stringize(
+            "format_sql: format string has ", num_placeholders, " placeholders, but got ",
+            param_count, " arguments"));
+    }
+}
+
+template <typename ForwardIterator>
+void boost::mysql::format_sql(
+    std::string_view format_str,
+    ForwardIterator params_first,
+    ForwardIterator params_last,
+    const format_options& opts,
+    std::string& output
+)
+{
+    detail::error_block blk;
+    format_sql(format_str, params_first, params_last, opts, output, blk.err, blk.info);
+    blk.check();
+}
+
+#endif
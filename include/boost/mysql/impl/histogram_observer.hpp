@@ -0,0 +1,106 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_HISTOGRAM_OBSERVER_HPP
+#define BOOST_MYSQL_IMPL_HISTOGRAM_OBSERVER_HPP
+
+#include <cassert>
+
+inline void boost::mysql::latency_histogram::record(
+    std::chrono::nanoseconds value
+) noexcept
+{
+    auto ns = value.count() > 0 ? static_cast<std::uint64_t>(value.count()) : 0u;
+
+    // Bucket index is the number of significant bits
+    std::size_t bucket = 0;
+    while (ns >> bucket)
+        ++bucket;
+    if (bucket >= num_buckets)
+        bucket = num_buckets - 1;
+
+    buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(static_cast<std::int64_t>(ns), std::memory_order_relaxed);
+}
+
+inline std::uint64_t boost::mysql::latency_histogram::count() const noexcept
+{
+    std::uint64_t res = 0;
+    for (const auto& bucket: buckets_)
+        res += bucket.load(std::memory_order_relaxed);
+    return res;
+}
+
+inline std::chrono::nanoseconds boost::mysql::latency_histogram::bucket_upper_bound(
+    std::size_t i
+) noexcept
+{
+    assert(i < num_buckets);
+    if (i == num_buckets - 1)
+        return std::chrono::nanoseconds::max();
+    return std::chrono::nanoseconds(std::int64_t(1) << i);
+}
+
+inline std::chrono::nanoseconds boost::mysql::latency_histogram::percentile(
+    double p
+) const noexcept
+{
+    // Take a snapshot, so the result is consistent even if values are being recorded
+    std::array<std::uint64_t, num_buckets> counts;
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < num_buckets; ++i)
+    {
+        counts[i] = buckets_[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+    if (total == 0)
+        return std::chrono::nanoseconds(0);
+
+    // The rank of the requested value, between 1 and total
+    p = p < 0.0 ? 0.0 : (p > 1.0 ? 1.0 : p);
+    auto rank = static_cast<std::uint64_t>(p * static_cast<double>(total));
+    if (rank == 0)
+        rank = 1;
+
+    std::uint64_t accumulated = 0;
+    for (std::size_t i = 0; i < num_buckets; ++i)
+    {
+        accumulated += counts[i];
+        if (accumulated >= rank)
+            return bucket_upper_bound(i);
+    }
+    return bucket_upper_bound(num_buckets - 1);
+}
+
+inline void boost::mysql::latency_histogram::reset() noexcept
+{
+    for (auto& bucket: buckets_)
+        bucket.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+}
+
+inline void boost::mysql::histogram_observer::reset() noexcept
+{
+    elapsed_.reset();
+    network_time_.reset();
+    decode_time_.reset();
+    num_errors_.store(0, std::memory_order_relaxed);
+}
+
+inline void boost::mysql::histogram_observer::on_command_end(
+    const command_stats& stats,
+    error_code err
+)
+{
+    elapsed_.record(stats.elapsed);
+    network_time_.record(stats.network_time());
+    decode_time_.record(stats.decode_time);
+    if (err)
+        num_errors_.fetch_add(1, std::memory_order_relaxed);
+}
+
+#endif
@@ -8,6 +8,9 @@
 #ifndef BOOST_MYSQL_IMPL_METADATA_IPP
 #define BOOST_MYSQL_IMPL_METADATA_IPP
 
+#include <cassert>
+#include <limits>
+
 namespace boost {
 namespace mysql {
 namespace detail {
@@ -81,14 +84,151 @@ inline field_type compute_field_type(
 } // mysql
 } // boost
 
-inline boost::mysql::field_type boost::mysql::field_metadata::type() const noexcept
+BOOST_MYSQL_DECL boost::mysql::field_type boost::mysql::field_metadata::type() const noexcept
 {
     if (field_type_ == field_type::_not_computed)
     {
-        field_type_ = detail::compute_field_type(msg_.type, msg_.flags.value);
+        field_type_ = detail::compute_field_type(type_, flags_);
         assert(field_type_ != field_type::_not_computed);
     }
     return field_type_;
 }
 
+BOOST_MYSQL_DECL void boost::mysql::detail::resultset_metadata::assign(
+    resource_bytestring&& buffer,
+    std::size_t num_fields
+)
+{
+    // buffer_ won't change from now on, so fields can point into it
+    buffer_ = std::move(buffer);
+    deserialization_context ctx (boost::asio::buffer(buffer_), capabilities());
+    fields_.clear();
+    fields_.reserve(num_fields);
+    for (std::size_t i = 0; i < num_fields; ++i)
+    {
+        column_definition_packet msg;
+        auto err = deserialize(ctx, msg);
+        assert(err == errc::ok); // validated when the packets were read
+        (void)err;
+        fields_.emplace_back(msg);
+    }
+    if (name_index_.resource() == buffer_.get_allocator().resource())
+        name_index_.assign(fields_);
+    else
+        name_index_ = field_name_index(fields_, buffer_.get_allocator().resource());
+}
+
+BOOST_MYSQL_DECL boost::mysql::field_name_index::field_name_index(
+    const std::vector<field_metadata>& fields,
+    std::pmr::memory_resource* resource
+) :
+    table_(resource),
+    names_(resource)
+{
+    assign(fields);
+}
+
+BOOST_MYSQL_DECL void boost::mysql::field_name_index::assign(
+    const std::vector<field_metadata>& fields
+)
+{
+    if (fields.empty())
+    {
+        table_.clear();
+        names_.clear();
+        return;
+    }
+
+    // Copy the names, so the index doesn't depend on the memory owned by fields
+    std::size_t names_size = 0;
+    for (const auto& field: fields)
+        names_size += field.field_name().size();
+    assert(names_size <= std::numeric_limits<std::uint32_t>::max());
+    names_.clear();
+    names_.reserve(names_size);
+    for (const auto& field: fields)
+    {
+        auto name = field.field_name();
+        names_.insert(names_.end(), name.begin(), name.end());
+    }
+
+    // The table is kept at most half full, so probe sequences are short
+    std::size_t table_size = 2;
+    shift_ = 63;
+    while (table_size < 2 * fields.size())
+    {
+        table_size *= 2;
+        --shift_;
+    }
+
+    // Look for a seed that places each name in its own slot. If none is found,
+    // the last one is used, and collisions are resolved by linear probing
+    constexpr unsigned max_seed_attempts = 8;
+    for (unsigned attempt = 0; attempt < max_seed_attempts; ++attempt)
+    {
+        seed_ = attempt * 0x9e3779b97f4a7c15;
+        table_.assign(table_size, entry{0, 0, 0, npos});
+        bool collisions = false;
+        std::uint32_t name_offset = 0;
+        for (std::size_t i = 0; i < fields.size(); ++i)
+        {
+            auto name = fields[i].field_name();
+            auto name_size = static_cast<std::uint32_t>(name.size());
+            collisions |= insert(detail::hash_field_name(name), name_offset, name_size, i);
+            name_offset += name_size;
+        }
+        if (!collisions)
+            break;
+    }
+}
+
+BOOST_MYSQL_DECL std::size_t boost::mysql::field_name_index::slot(
+    std::uint64_t hash
+) const noexcept
+{
+    return static_cast<std::size_t>(((hash ^ seed_) * 0x9e3779b97f4a7c15) >> shift_);
+}
+
+// Returns true if the name didn't land in its own slot
+BOOST_MYSQL_DECL bool boost::mysql::field_name_index::insert(
+    std::uint64_t hash,
+    std::uint32_t name_offset,
+    std::uint32_t name_size,
+    std::size_t index
+) noexcept
+{
+    std::size_t mask = table_.size() - 1;
+    bool collision = false;
+    std::string_view new_name (names_.data() + name_offset, name_size);
+    for (std::size_t pos = slot(hash);; pos = (pos + 1) & mask)
+    {
+        auto& e = table_[pos];
+        if (e.index == npos)
+        {
+            e = entry{hash, name_offset, name_size, index};
+            return collision;
+        }
+        if (e.hash == hash && name(e) == new_name)
+            return collision; // duplicate name, keep the first one
+        collision = true;
+    }
+}
+
+BOOST_MYSQL_DECL std::size_t boost::mysql::field_name_index::find(
+    const field_name_key& key
+) const noexcept
+{
+    if (table_.empty())
+        return npos;
+    std::size_t mask = table_.size() - 1;
+    for (std::size_t pos = slot(key.hash());; pos = (pos + 1) & mask)
+    {
+        const auto& e = table_[pos];
+        if (e.index == npos)
+            return npos;
+        if (e.hash == key.hash() && name(e) == key.name())
+            return e.index;
+    }
+}
+
 #endif
@@ -123,6 +123,92 @@ boost::mysql::prepared_statement<StreamType>::async_execute(
     }
 }
 
+template <typename Stream>
+template <typename Collection>
+void boost::mysql::prepared_statement<Stream>::execute(
+    const Collection& params,
+    resultset<Stream>& output,
+    error_code& err,
+    error_info& info
+) const
+{
+    assert(valid());
+
+    detail::clear_errors(err, info);
+
+    // Verify we got passed the right number of params
+    check_num_params(std::begin(params), std::end(params), err, info);
+    if (!err)
+    {
+        detail::execute_statement(
+            *channel_,
+            stmt_msg_.statement_id.value,
+            std::begin(params),
+            std::end(params),
+            output,
+            err,
+            info
+        );
+    }
+}
+
+template <typename Stream>
+template <typename Collection>
+void boost::mysql::prepared_statement<Stream>::execute(
+    const Collection& params,
+    resultset<Stream>& output
+) const
+{
+    detail::error_block blk;
+    execute(params, output, blk.err, blk.info);
+    blk.check();
+}
+
+template <typename StreamType>
+template <typename Collection, typename CompletionToken>
+BOOST_ASIO_INITFN_RESULT_TYPE(
+    CompletionToken,
+    typename boost::mysql::prepared_statement<StreamType>::execute_into_signature
+)
+boost::mysql::prepared_statement<StreamType>::async_execute(
+    const Collection& params,
+    resultset<StreamType>& output,
+    CompletionToken&& token,
+    error_info* info
+) const
+{
+    detail::conditional_clear(info);
+    detail::check_completion_token<CompletionToken, execute_into_signature>();
+
+    // Check we got passed the right number of params
+    error_code err;
+    error_info nonnull_info;
+    check_num_params(std::begin(params), std::end(params), err, nonnull_info);
+    if (err)
+    {
+        detail::conditional_assign(info, std::move(nonnull_info));
+        boost::asio::async_completion<CompletionToken, execute_into_signature> completion (token);
+        boost::asio::post(boost::beast::bind_front_handler(
+            std::move(completion.completion_handler),
+            err
+        ));
+        return completion.result.get();
+    }
+    else
+    {
+        // Actually execute the statement
+        return detail::async_execute_statement(
+            *channel_,
+            stmt_msg_.statement_id.value,
+            std::begin(params),
+            std::end(params),
+            output,
+            std::forward<CompletionToken>(token),
+            info
+        );
+    }
+}
+
 template <typename StreamType>
 void boost::mysql::prepared_statement<StreamType>::close(
     error_code& code,
@@ -0,0 +1,162 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_PROTOCOL_CAPTURE_HPP
+#define BOOST_MYSQL_IMPL_PROTOCOL_CAPTURE_HPP
+
+#include "boost/mysql/detail/protocol/serialization.hpp"
+#include <boost/asio/buffer.hpp>
+#include <array>
+#include <cstring>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+constexpr std::array<char, 8> capture_magic { 'B', 'M', 'Y', 'S', 'Q', 'L', 'C', 'P' };
+constexpr std::uint32_t capture_version = 1;
+constexpr std::size_t capture_record_header_size = 14;
+
+} // detail
+} // mysql
+} // boost
+
+inline boost::mysql::capture_writer::capture_writer(
+    std::ostream& output
+) :
+    output_(output),
+    start_(std::chrono::steady_clock::now())
+{
+    std::array<std::uint8_t, 4> version;
+    detail::serialization_context ctx (detail::capabilities(0), version.data());
+    detail::serialize(ctx, detail::int4(detail::capture_version));
+    output_.write(detail::capture_magic.data(), detail::capture_magic.size());
+    output_.write(reinterpret_cast<const char*>(version.data()), version.size());
+}
+
+template <typename ConstBufferSequence>
+void boost::mysql::capture_writer::write(
+    capture_record_type type,
+    std::uint8_t sequence_number,
+    const ConstBufferSequence& payload
+)
+{
+    auto timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start_);
+
+    std::array<std::uint8_t, detail::capture_record_header_size> header;
+    detail::serialization_context ctx (detail::capabilities(0), header.data());
+    detail::serialize(
+        ctx,
+        detail::int1(static_cast<std::uint8_t>(type)),
+        detail::int1(sequence_number),
+        detail::int8(static_cast<std::uint64_t>(timestamp.count())),
+        detail::int4(static_cast<std::uint32_t>(boost::asio::buffer_size(payload)))
+    );
+    output_.write(reinterpret_cast<const char*>(header.data()), header.size());
+
+    auto last = boost::asio::buffer_sequence_end(payload);
+    for (auto it = boost::asio::buffer_sequence_begin(payload); it != last; ++it)
+    {
+        boost::asio::const_buffer buff (*it);
+        output_.write(static_cast<const char*>(buff.data()), buff.size());
+    }
+}
+
+inline void boost::mysql::capture_writer::write(
+    const capture_record& record
+)
+{
+    write(record.type, record.sequence_number, boost::asio::buffer(record.payload));
+}
+
+inline bool boost::mysql::capture_reader::read(
+    capture_record& output,
+    error_code& err
+)
+{
+    err.clear();
+
+    // Header
+    if (!header_read_)
+    {
+        std::array<char, 12> header;
+        if (!input_.read(header.data(), header.size()) ||
+            std::memcmp(header.data(), detail::capture_magic.data(), detail::capture_magic.size()) != 0)
+        {
+            err = detail::make_error_code(errc::protocol_value_error);
+            return false;
+        }
+        detail::int4 version;
+        detail::deserialization_context ctx (
+            boost::asio::buffer(header.data() + detail::capture_magic.size(), 4),
+            detail::capabilities(0)
+        );
+        detail::deserialize(ctx, version);
+        if (version.value != detail::capture_version)
+        {
+            err = detail::make_error_code(errc::protocol_value_error);
+            return false;
+        }
+        header_read_ = true;
+    }
+
+    // Record header. A clean EOF means there are no more records
+    std::array<std::uint8_t, detail::capture_record_header_size> header;
+    input_.read(reinterpret_cast<char*>(header.data()), header.size());
+    if (input_.gcount() == 0 && input_.eof())
+        return false;
+    if (static_cast<std::size_t>(input_.gcount()) != header.size())
+    {
+        err = detail::make_error_code(errc::incomplete_message);
+        return false;
+    }
+    detail::int1 type;
+    detail::int1 sequence_number;
+    detail::int8 timestamp;
+    detail::int4 size;
+    detail::deserialization_context ctx (boost::asio::buffer(header), detail::capabilities(0));
+    detail::deserialize(ctx, type, sequence_number, timestamp, size);
+    if (type.value > static_cast<std::uint8_t>(capture_record_type::handshake_complete))
+    {
+        err = detail::make_error_code(errc::protocol_value_error);
+        return false;
+    }
+
+    // Payload
+    output.type = static_cast<capture_record_type>(type.value);
+    output.sequence_number = sequence_number.value;
+    output.timestamp = std::chrono::nanoseconds(static_cast<std::int64_t>(timestamp.value));
+    output.payload.resize(size.value);
+    if (!input_.read(reinterpret_cast<char*>(output.payload.data()), size.value))
+    {
+        err = detail::make_error_code(errc::incomplete_message);
+        return false;
+    }
+    return true;
+}
+
+inline bool boost::mysql::capture_reader::read(
+    capture_record& output
+)
+{
+    detail::error_block blk;
+    bool res = read(output, blk.err);
+    blk.check();
+    return res;
+}
+
+inline std::vector<boost::mysql::capture_record> boost::mysql::capture_reader::read_all()
+{
+    std::vector<capture_record> res;
+    capture_record record;
+    while (read(record))
+        res.push_back(std::move(record));
+    return res;
+}
+
+#endif
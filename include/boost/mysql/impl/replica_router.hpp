@@ -0,0 +1,601 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_REPLICA_ROUTER_HPP
+#define BOOST_MYSQL_IMPL_REPLICA_ROUTER_HPP
+
+#include <boost/asio/coroutine.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/post.hpp>
+#include <cstdint>
+
+template <typename Stream>
+boost::mysql::replica_router<Stream>::replica_router(
+    const executor_type& ex,
+    const endpoint_type& primary,
+    const std::vector<endpoint_type>& replicas,
+    const connection_params& params,
+    router_options opts
+) :
+    executor_(ex),
+    opts_(std::move(opts))
+{
+    servers_.reserve(replicas.size() + 1);
+    servers_.push_back(std::make_unique<server>(ex, primary, params, opts_.pool));
+    for (const auto& ep: replicas)
+        servers_.push_back(std::make_unique<server>(ex, ep, params, opts_.pool));
+}
+
+template <typename Stream>
+std::size_t boost::mysql::replica_router<Stream>::pick_server(
+    access_mode mode
+)
+{
+    if (mode == access_mode::write || (opts_.read_your_writes && untracked_writes_))
+        return 0;
+
+    std::size_t num_replicas = servers_.size() - 1;
+    std::size_t res = 0;
+    if (opts_.balancing == balancing_strategy::round_robin)
+    {
+        for (std::size_t i = 0; i < num_replicas && res == 0; ++i)
+        {
+            std::size_t candidate = (next_replica_ + i) % num_replicas + 1;
+            if (servers_[candidate]->available)
+            {
+                res = candidate;
+                next_replica_ = candidate % num_replicas;
+            }
+        }
+    }
+    else
+    {
+        for (std::size_t candidate = 1; candidate <= num_replicas; ++candidate)
+        {
+            if (servers_[candidate]->available && (res == 0 ||
+                servers_[candidate]->pool.num_in_use() < servers_[res]->pool.num_in_use()))
+            {
+                res = candidate;
+            }
+        }
+    }
+    return res;
+}
+
+template <typename Stream>
+std::string boost::mysql::replica_router<Stream>::wait_query(
+    std::size_t server_index
+) const
+{
+    if (server_index == 0 || !opts_.read_your_writes || written_gtids_.empty())
+        return std::string();
+    // GTID sets only contain hex digits, letters, underscores, colons,
+    // dashes and commas (checked by gtid_tracker), so they can be inlined safely
+    return "SELECT WAIT_FOR_EXECUTED_GTID_SET('" + written_gtids_.to_string() +
+        "', " + std::to_string(opts_.gtid_wait_timeout.count()) + ")";
+}
+
+template <typename Stream>
+bool boost::mysql::replica_router<Stream>::caught_up(
+    const std::vector<owning_row>& rows
+) noexcept
+{
+    // WAIT_FOR_EXECUTED_GTID_SET returns 0 on success and 1 on timeout
+    if (rows.size() != 1 || rows[0].values().size() != 1)
+        return false;
+    return rows[0].values()[0].template get_optional<std::int64_t>() == std::int64_t(0);
+}
+
+template <typename Stream>
+bool boost::mysql::replica_router<Stream>::is_server_failure(
+    const error_code& err
+) noexcept
+{
+    // A full pool (would_block) or a cancelled operation says
+    // nothing about the server's health
+    return is_connection_error(err) &&
+        err != boost::asio::error::would_block &&
+        err != boost::asio::error::operation_aborted;
+}
+
+template <typename Stream>
+std::size_t boost::mysql::replica_router<Stream>::server_index(
+    const pooled_connection<Stream>& conn
+) const noexcept
+{
+    for (std::size_t i = 0; i < servers_.size(); ++i)
+    {
+        if (&servers_[i]->pool == &conn.pool())
+            return i;
+    }
+    assert(false);
+    return 0;
+}
+
+template <typename Stream>
+std::string_view boost::mysql::replica_router<Stream>::status_query(
+    std::size_t server_index
+) const noexcept
+{
+    // SHOW REPLICA STATUS was introduced in MySQL 8.0.22 and MariaDB 10.5.1
+    return servers_[server_index]->legacy_status_syntax ? "SHOW SLAVE STATUS" : "SHOW REPLICA STATUS";
+}
+
+template <typename Stream>
+void boost::mysql::replica_router<Stream>::update_status(
+    std::size_t server_index,
+    const resultset<Stream>& result,
+    const std::vector<owning_row>& rows
+)
+{
+    // MariaDB and MySQL before 8.0.22 use the old column name. The column is
+    // NULL if replication is not running, and there are no rows if the
+    // server is not a replica at all
+    auto& srv = *servers_[server_index];
+    auto column = result.field_index("Seconds_Behind_Source");
+    if (column == field_name_index::npos)
+        column = result.field_index("Seconds_Behind_Master");
+    srv.lag.reset();
+    if (!rows.empty() && column < rows[0].values().size())
+    {
+        auto lag = rows[0].values()[column].template get_optional<std::int64_t>();
+        if (lag)
+            srv.lag = std::chrono::seconds(*lag);
+    }
+    srv.available = srv.lag && *srv.lag <= opts_.max_replica_lag;
+}
+
+template <typename Stream>
+void boost::mysql::replica_router<Stream>::track_writes(
+    const resilient_connection<Stream>& conn
+)
+{
+    if (!opts_.read_your_writes)
+        return;
+    auto gtids = conn.connection().session().gtids();
+    if (gtids.empty())
+    {
+        // Statements that commit no transaction (e.g. SET) report no GTIDs.
+        // If previous writes reported them, the server is configured to, and
+        // this is the case. Otherwise, it may not report GTIDs at all
+        if (written_gtids_.empty())
+            untracked_writes_ = true;
+    }
+    else if (written_gtids_.add(gtids))
+    {
+        // Replicas are waited for every transaction of each source up to
+        // the last one, including any earlier untracked write
+        untracked_writes_ = false;
+    }
+    else
+    {
+        untracked_writes_ = true;
+    }
+}
+
+// acquire
+template <typename Stream>
+boost::mysql::pooled_connection<Stream> boost::mysql::replica_router<Stream>::acquire(
+    access_mode mode,
+    error_code& err,
+    error_info& info
+)
+{
+    detail::clear_errors(err, info);
+    bool force_primary = false;
+    for (;;)
+    {
+        auto index = force_primary ? 0 : pick_server(mode);
+        auto wait_sql = wait_query(index);
+        auto conn = servers_[index]->pool.acquire(err, info);
+        if (err)
+        {
+            if (index == 0 || !is_server_failure(err))
+                return conn;
+            mark_down(index);
+            detail::clear_errors(err, info);
+            continue;
+        }
+        if (!wait_sql.empty())
+        {
+            auto rows = conn->query(wait_sql, err, info);
+            if (err || !caught_up(rows))
+            {
+                // The replica didn't catch up in time, or can't wait
+                // for GTIDs. Either way, the primary has the data
+                if (is_server_failure(err))
+                    mark_down(index);
+                detail::clear_errors(err, info);
+                force_primary = true;
+                continue;
+            }
+        }
+        return conn;
+    }
+}
+
+template <typename Stream>
+boost::mysql::pooled_connection<Stream> boost::mysql::replica_router<Stream>::acquire(
+    access_mode mode
+)
+{
+    detail::error_block blk;
+    auto res = acquire(mode, blk.err, blk.info);
+    blk.check();
+    return res;
+}
+
+template <typename Stream>
+struct boost::mysql::replica_router<Stream>::acquire_op : boost::asio::coroutine
+{
+    replica_router<Stream>& router_;
+    access_mode mode_;
+    error_info* output_info_;
+    bool force_primary_ {false};
+    std::size_t index_ {0};
+    std::string wait_sql_;
+    pooled_connection<Stream> conn_;
+
+    acquire_op(replica_router<Stream>& router, access_mode mode, error_info* output_info) :
+        router_(router), mode_(mode), output_info_(output_info) {}
+
+    template <class Self>
+    void operator()(
+        Self& self,
+        error_code err,
+        pooled_connection<Stream> conn
+    )
+    {
+        conn_ = std::move(conn);
+        (*this)(self, err);
+    }
+
+    template <class Self>
+    void operator()(
+        Self& self,
+        error_code err = {},
+        std::vector<owning_row> rows = {}
+    )
+    {
+        BOOST_ASIO_CORO_REENTER(*this)
+        {
+            for (;;)
+            {
+                index_ = force_primary_ ? 0 : router_.pick_server(mode_);
+                wait_sql_ = router_.wait_query(index_);
+                BOOST_ASIO_CORO_YIELD router_.servers_[index_]->pool.async_acquire(
+                    std::move(self),
+                    output_info_
+                );
+                if (err)
+                {
+                    if (index_ == 0 || !is_server_failure(err))
+                    {
+                        self.complete(err, pooled_connection<Stream>());
+                        BOOST_ASIO_CORO_YIELD break;
+                    }
+                    router_.mark_down(index_);
+                    detail::conditional_clear(output_info_);
+                    continue;
+                }
+                if (!wait_sql_.empty())
+                {
+                    BOOST_ASIO_CORO_YIELD conn_->async_query(wait_sql_, std::move(self), output_info_);
+                    if (err || !caught_up(rows))
+                    {
+                        if (is_server_failure(err))
+                            router_.mark_down(index_);
+                        detail::conditional_clear(output_info_);
+                        conn_.release();
+                        force_primary_ = true;
+                        continue;
+                    }
+                }
+                self.complete(error_code(), std::move(conn_));
+                BOOST_ASIO_CORO_YIELD break;
+            }
+        }
+    }
+};
+
+template <typename Stream>
+template <typename CompletionToken>
+BOOST_MYSQL_INITFN_RESULT_TYPE(
+    CompletionToken,
+    typename boost::mysql::replica_router<Stream>::acquire_signature
+)
+boost::mysql::replica_router<Stream>::async_acquire(
+    access_mode mode,
+    CompletionToken&& token,
+    error_info* info
+)
+{
+    detail::conditional_clear(info);
+    return boost::asio::async_compose<CompletionToken, acquire_signature>(
+        acquire_op(*this, mode, info),
+        token,
+        executor_
+    );
+}
+
+// query
+template <typename Stream>
+std::vector<boost::mysql::owning_row> boost::mysql::replica_router<Stream>::query(
+    std::string_view query_string,
+    error_code& err,
+    error_info& info
+)
+{
+    detail::clear_errors(err, info);
+    auto mode = opts_.is_read && opts_.is_read(query_string) ? access_mode::read : access_mode::write;
+    for (;;)
+    {
+        auto conn = acquire(mode, err, info);
+        if (err)
+            return {};
+        auto index = server_index(conn);
+        auto rows = conn->query(query_string, err, info);
+        if (err && index != 0 && is_server_failure(err))
+        {
+            // Reads can be retried elsewhere
+            mark_down(index);
+            detail::clear_errors(err, info);
+            continue;
+        }
+        if (!err && mode == access_mode::write)
+            track_writes(*conn);
+        return rows;
+    }
+}
+
+template <typename Stream>
+std::vector<boost::mysql::owning_row> boost::mysql::replica_router<Stream>::query(
+    std::string_view query_string
+)
+{
+    detail::error_block blk;
+    auto res = query(query_string, blk.err, blk.info);
+    blk.check();
+    return res;
+}
+
+template <typename Stream>
+struct boost::mysql::replica_router<Stream>::query_op : boost::asio::coroutine
+{
+    replica_router<Stream>& router_;
+    std::string_view query_string_;
+    error_info* output_info_;
+    access_mode mode_;
+    std::size_t index_ {0};
+    pooled_connection<Stream> conn_;
+
+    query_op(replica_router<Stream>& router, std::string_view query_string, error_info* output_info) :
+        router_(router),
+        query_string_(query_string),
+        output_info_(output_info),
+        mode_(router.opts_.is_read && router.opts_.is_read(query_string) ?
+            access_mode::read : access_mode::write)
+    {
+    }
+
+    template <class Self>
+    void operator()(
+        Self& self,
+        error_code err,
+        pooled_connection<Stream> conn
+    )
+    {
+        conn_ = std::move(conn);
+        (*this)(self, err);
+    }
+
+    template <class Self>
+    void operator()(
+        Self& self,
+        error_code err = {},
+        std::vector<owning_row> rows = {}
+    )
+    {
+        BOOST_ASIO_CORO_REENTER(*this)
+        {
+            for (;;)
+            {
+                BOOST_ASIO_CORO_YIELD router_.async_acquire(mode_, std::move(self), output_info_);
+                if (err)
+                {
+                    self.complete(err, std::vector<owning_row>());
+                    BOOST_ASIO_CORO_YIELD break;
+                }
+                index_ = router_.server_index(conn_);
+                BOOST_ASIO_CORO_YIELD conn_->async_query(query_string_, std::move(self), output_info_);
+                if (err && index_ != 0 && is_server_failure(err))
+                {
+                    router_.mark_down(index_);
+                    detail::conditional_clear(output_info_);
+                    conn_.release();
+                    continue;
+                }
+                if (!err && mode_ == access_mode::write)
+                    router_.track_writes(*conn_);
+                conn_.release();
+                self.complete(err, std::move(rows));
+                BOOST_ASIO_CORO_YIELD break;
+            }
+        }
+    }
+};
+
+template <typename Stream>
+template <typename CompletionToken>
+BOOST_MYSQL_INITFN_RESULT_TYPE(
+    CompletionToken,
+    typename boost::mysql::replica_router<Stream>::query_signature
+)
+boost::mysql::replica_router<Stream>::async_query(
+    std::string_view query_string,
+    CompletionToken&& token,
+    error_info* info
+)
+{
+    detail::conditional_clear(info);
+    return boost::asio::async_compose<CompletionToken, query_signature>(
+        query_op(*this, query_string, info),
+        token,
+        executor_
+    );
+}
+
+// check_replicas
+template <typename Stream>
+void boost::mysql::replica_router<Stream>::check_replicas(
+    error_code& err,
+    error_info& info
+)
+{
+    detail::clear_errors(err, info);
+    for (std::size_t i = 1; i < servers_.size(); ++i)
+    {
+        error_code replica_err;
+        error_info replica_info;
+        auto conn = servers_[i]->pool.acquire(replica_err, replica_info);
+        if (!replica_err)
+        {
+            auto rows = conn->query(status_query(i), replica_err, replica_info);
+            if (replica_err == detail::make_error_code(errc::parse_error) && !servers_[i]->legacy_status_syntax)
+            {
+                servers_[i]->legacy_status_syntax = true;
+                rows = conn->query(status_query(i), replica_err, replica_info);
+            }
+            if (!replica_err)
+                update_status(i, conn->last_result(), rows);
+        }
+        if (replica_err)
+        {
+            mark_down(i);
+            servers_[i]->lag.reset();
+            if (!err)
+            {
+                err = replica_err;
+                info = std::move(replica_info);
+            }
+        }
+    }
+}
+
+template <typename Stream>
+void boost::mysql::replica_router<Stream>::check_replicas()
+{
+    detail::error_block blk;
+    check_replicas(blk.err, blk.info);
+    blk.check();
+}
+
+template <typename Stream>
+struct boost::mysql::replica_router<Stream>::check_op : boost::asio::coroutine
+{
+    replica_router<Stream>& router_;
+    error_info* output_info_;
+    std::size_t index_ {1};
+    pooled_connection<Stream> conn_;
+    error_code first_err_;
+    error_info first_info_;
+
+    check_op(replica_router<Stream>& router, error_info* output_info) :
+        router_(router), output_info_(output_info) {}
+
+    template <class Self>
+    void operator()(
+        Self& self,
+        error_code err,
+        pooled_connection<Stream> conn
+    )
+    {
+        conn_ = std::move(conn);
+        (*this)(self, err);
+    }
+
+    template <class Self>
+    void operator()(
+        Self& self,
+        error_code err = {},
+        std::vector<owning_row> rows = {}
+    )
+    {
+        BOOST_ASIO_CORO_REENTER(*this)
+        {
+            if (router_.servers_.size() == 1)
+            {
+                // Avoid completing inline
+                BOOST_ASIO_CORO_YIELD boost::asio::post(router_.executor_, std::move(self));
+            }
+
+            for (; index_ < router_.servers_.size(); ++index_)
+            {
+                BOOST_ASIO_CORO_YIELD router_.servers_[index_]->pool.async_acquire(
+                    std::move(self),
+                    output_info_
+                );
+                if (!err)
+                {
+                    BOOST_ASIO_CORO_YIELD conn_->async_query(
+                        router_.status_query(index_),
+                        std::move(self),
+                        output_info_
+                    );
+                    if (err == detail::make_error_code(errc::parse_error) && !router_.servers_[index_]->legacy_status_syntax)
+                    {
+                        router_.servers_[index_]->legacy_status_syntax = true;
+                        BOOST_ASIO_CORO_YIELD conn_->async_query(
+                            router_.status_query(index_),
+                            std::move(self),
+                            output_info_
+                        );
+                    }
+                    if (!err)
+                        router_.update_status(index_, conn_->last_result(), rows);
+                    conn_.release();
+                }
+                if (err)
+                {
+                    router_.mark_down(index_);
+                    router_.servers_[index_]->lag.reset();
+                    if (!first_err_)
+                    {
+                        first_err_ = err;
+                        if (output_info_)
+                            first_info_ = std::move(*output_info_);
+                    }
+                }
+            }
+
+            if (output_info_)
+                *output_info_ = std::move(first_info_);
+            self.complete(first_err_);
+        }
+    }
+};
+
+template <typename Stream>
+template <typename CompletionToken>
+BOOST_MYSQL_INITFN_RESULT_TYPE(
+    CompletionToken,
+    typename boost::mysql::replica_router<Stream>::check_replicas_signature
+)
+boost::mysql::replica_router<Stream>::async_check_replicas(
+    CompletionToken&& token,
+    error_info* info
+)
+{
+    detail::conditional_clear(info);
+    return boost::asio::async_compose<CompletionToken, check_replicas_signature>(
+        check_op(*this, info),
+        token,
+        executor_
+    );
+}
+
+#endif
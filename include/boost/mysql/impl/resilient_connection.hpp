@@ -0,0 +1,710 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_RESILIENT_CONNECTION_HPP
+#define BOOST_MYSQL_IMPL_RESILIENT_CONNECTION_HPP
+
+#include <boost/asio/coroutine.hpp>
+#include <boost/asio/post.hpp>
+#include <algorithm>
+
+template <typename Stream>
+template <typename... Args>
+boost::mysql::resilient_connection<Stream>::resilient_connection(
+    Args&&... args
+) :
+    conn_(std::forward<Args>(args)...),
+    timer_(conn_.next_layer().get_executor()),
+    rng_(std::random_device{}())
+{
+}
+
+template <typename Stream>
+void boost::mysql::resilient_connection<Stream>::set_connect_params(
+    const endpoint_type& endpoint,
+    const connection_params& params
+)
+{
+    endpoint_ = endpoint;
+    params_.assign(params);
+}
+
+template <typename Stream>
+void boost::mysql::resilient_connection<Stream>::disconnect()
+{
+    connected_ = false;
+    conn_.reset_channel();
+}
+
+template <typename Stream>
+bool boost::mysql::resilient_connection<Stream>::is_prepared(
+    std::size_t index
+) const noexcept
+{
+    const auto& entry = statements_[index];
+    return entry.stmt.valid() && entry.generation == generation_;
+}
+
+template <typename Stream>
+std::size_t boost::mysql::resilient_connection<Stream>::find_or_add_statement(
+    std::string_view sql
+)
+{
+    auto it = std::find_if(statements_.begin(), statements_.end(),
+        [sql](const statement_entry& entry) { return entry.sql == sql; });
+    if (it != statements_.end())
+        return static_cast<std::size_t>(it - statements_.begin());
+    bool idempotent = policy_.is_idempotent && policy_.is_idempotent(sql);
+    statements_.push_back(statement_entry{std::string(sql), idempotent, {}, 0});
+    return statements_.size() - 1;
+}
+
+template <typename Stream>
+void boost::mysql::resilient_connection<Stream>::prepare_entry(
+    std::size_t index,
+    error_code& err,
+    error_info& info
+)
+{
+    auto stmt = conn_.prepare_statement(statements_[index].sql, err, info);
+    if (!err)
+    {
+        statements_[index].stmt = std::move(stmt);
+        statements_[index].generation = generation_;
+    }
+}
+
+template <typename Stream>
+bool boost::mysql::resilient_connection<Stream>::on_failure(
+    const error_code& err,
+    bool request_sent,
+    bool idempotent,
+    bool in_transaction,
+    std::size_t& num_failures
+)
+{
+    if (!is_connection_error(err))
+        return false;
+    disconnect();
+    if (err == boost::asio::error::operation_aborted)
+        return false;
+
+    // If the request reached the server, we can't know whether it was executed,
+    // and a transaction in progress has been rolled back
+    if (request_sent && (!idempotent || in_transaction))
+        return false;
+    return num_failures++ < policy_.max_retries;
+}
+
+template <typename Stream>
+std::chrono::milliseconds boost::mysql::resilient_connection<Stream>::next_backoff(
+    std::size_t num_connect_failures
+)
+{
+    std::uniform_real_distribution<double> dist (0.0, 1.0);
+    return detail::compute_backoff(policy_, num_connect_failures, dist(rng_));
+}
+
+// Attempts. Each of them runs an operation once, synchronously (run)
+// or asynchronously (async_run, whose handler gets an error_code and,
+// optionally, a result, which is then passed to store)
+template <typename Stream>
+struct boost::mysql::resilient_connection<Stream>::connect_attempt
+{
+    static constexpr bool sends_request = false; // all the work is done by the reconnection
+    bool idempotent {true};
+
+    void run(resilient_connection<Stream>&, error_code&, error_info&) {}
+
+    template <typename Handler>
+    void async_run(resilient_connection<Stream>&, Handler&&, error_info*) {}
+
+    template <typename Self>
+    void complete(Self& self, error_code err) { self.complete(err); }
+};
+
+template <typename Stream>
+struct boost::mysql::resilient_connection<Stream>::query_op : boost::asio::coroutine
+{
+    resilient_connection<Stream>& conn_;
+    std::string_view sql_;
+    error_info* output_info_;
+
+    query_op(resilient_connection<Stream>& conn, std::string_view sql, error_info* output_info) :
+        conn_(conn), sql_(sql), output_info_(output_info) {}
+
+    template <class Self>
+    void operator()(
+        Self& self,
+        error_code err = {},
+        std::vector<owning_row> rows = {}
+    )
+    {
+        BOOST_ASIO_CORO_REENTER(*this)
+        {
+            BOOST_ASIO_CORO_YIELD conn_.conn_.async_query(sql_, conn_.last_result_, std::move(self), output_info_);
+            if (err)
+            {
+                self.complete(err, std::move(rows));
+                BOOST_ASIO_CORO_YIELD break;
+            }
+            BOOST_ASIO_CORO_YIELD conn_.last_result_.async_fetch_all(std::move(self), output_info_);
+            self.complete(err, std::move(rows));
+        }
+    }
+};
+
+template <typename Stream>
+struct boost::mysql::resilient_connection<Stream>::query_attempt
+{
+    static constexpr bool sends_request = true;
+    bool idempotent;
+    std::string_view sql;
+    std::vector<owning_row> rows;
+
+    void run(resilient_connection<Stream>& conn, error_code& err, error_info& info)
+    {
+        conn.conn_.query(sql, conn.last_result_, err, info);
+        if (!err)
+            rows = conn.last_result_.fetch_all(err, info);
+    }
+
+    template <typename Handler>
+    void async_run(resilient_connection<Stream>& conn, Handler&& handler, error_info* info)
+    {
+        boost::asio::async_compose<Handler, query_signature>(
+            query_op(conn, sql, info),
+            handler,
+            conn.conn_.next_layer()
+        );
+    }
+
+    void store(std::vector<owning_row>&& value) { rows = std::move(value); }
+
+    template <typename Self>
+    void complete(Self& self, error_code err) { self.complete(err, std::move(rows)); }
+};
+
+// Prepares the statement if required and, if execute is true, executes it,
+// preparing it again if the server doesn't know about it
+template <typename Stream>
+struct boost::mysql::resilient_connection<Stream>::statement_op : boost::asio::coroutine
+{
+    resilient_connection<Stream>& conn_;
+    std::size_t index_;
+    bool execute_;
+    std::vector<value> params_;
+    error_info* output_info_;
+    bool reprepared_ {false};
+
+    statement_op(
+        resilient_connection<Stream>& conn,
+        std::size_t index,
+        bool execute,
+        std::vector<value> params,
+        error_info* output_info
+    ) :
+        conn_(conn), index_(index), execute_(execute), params_(std::move(params)), output_info_(output_info) {}
+
+    template <class Self>
+    void operator()(
+        Self& self,
+        error_code err,
+        prepared_statement<Stream> stmt
+    )
+    {
+        if (!err)
+        {
+            conn_.statements_[index_].stmt = std::move(stmt);
+            conn_.statements_[index_].generation = conn_.generation_;
+        }
+        (*this)(self, err);
+    }
+
+    template <class Self>
+    void operator()(
+        Self& self,
+        error_code err = {},
+        std::vector<owning_row> rows = {}
+    )
+    {
+        BOOST_ASIO_CORO_REENTER(*this)
+        {
+            if (!execute_ && conn_.is_prepared(index_))
+            {
+                BOOST_ASIO_CORO_YIELD boost::asio::post(conn_.conn_.next_layer().get_executor(), std::move(self));
+                self.complete(err, std::move(rows));
+                BOOST_ASIO_CORO_YIELD break;
+            }
+
+            for (;;)
+            {
+                if (!conn_.is_prepared(index_))
+                {
+                    BOOST_ASIO_CORO_YIELD conn_.conn_.async_prepare_statement(
+                        conn_.statements_[index_].sql,
+                        std::move(self),
+                        output_info_
+                    );
+                    if (err || !execute_)
+                    {
+                        self.complete(err, std::move(rows));
+                        BOOST_ASIO_CORO_YIELD break;
+                    }
+                }
+
+                BOOST_ASIO_CORO_YIELD conn_.statements_[index_].stmt.async_execute(
+                    params_,
+                    conn_.last_result_,
+                    std::move(self),
+                    output_info_
+                );
+                if (err == detail::make_error_code(errc::unknown_stmt_handler) && !reprepared_)
+                {
+                    reprepared_ = true;
+                    conn_.statements_[index_].stmt = prepared_statement<Stream>();
+                    continue;
+                }
+                if (err)
+                {
+                    self.complete(err, std::move(rows));
+                    BOOST_ASIO_CORO_YIELD break;
+                }
+
+                BOOST_ASIO_CORO_YIELD conn_.last_result_.async_fetch_all(std::move(self), output_info_);
+                self.complete(err, std::move(rows));
+                BOOST_ASIO_CORO_YIELD break;
+            }
+        }
+    }
+};
+
+template <typename Stream>
+template <bool Execute>
+struct boost::mysql::resilient_connection<Stream>::statement_attempt
+{
+    static constexpr bool sends_request = true;
+    bool idempotent;
+    std::size_t index;
+    std::vector<value> params;
+    std::vector<owning_row> rows;
+
+    void run(resilient_connection<Stream>& conn, error_code& err, error_info& info)
+    {
+        bool reprepared = false;
+        for (;;)
+        {
+            if (!conn.is_prepared(index))
+            {
+                conn.prepare_entry(index, err, info);
+                if (err)
+                    return;
+            }
+            if (!Execute)
+                return;
+            conn.statements_[index].stmt.execute(params, conn.last_result_, err, info);
+            if (err == detail::make_error_code(errc::unknown_stmt_handler) && !reprepared)
+            {
+                reprepared = true;
+                conn.statements_[index].stmt = prepared_statement<Stream>();
+                continue;
+            }
+            if (!err)
+                rows = conn.last_result_.fetch_all(err, info);
+            return;
+        }
+    }
+
+    template <typename Handler>
+    void async_run(resilient_connection<Stream>& conn, Handler&& handler, error_info* info)
+    {
+        boost::asio::async_compose<Handler, void(error_code, std::vector<owning_row>)>(
+            statement_op(conn, index, Execute, params, info),
+            handler,
+            conn.conn_.next_layer()
+        );
+    }
+
+    void store(std::vector<owning_row>&& value) { rows = std::move(value); }
+
+    template <typename Self>
+    void complete(Self& self, error_code err)
+    {
+        if constexpr (Execute)
+            self.complete(err, std::move(rows));
+        else
+            self.complete(err, err ? statement_handle() : statement_handle(index));
+    }
+};
+
+// Retry loop
+template <typename Stream>
+template <typename Attempt>
+void boost::mysql::resilient_connection<Stream>::run_with_retries(
+    Attempt& attempt,
+    error_code& err,
+    error_info& info
+)
+{
+    std::size_t num_failures = 0;
+    std::size_t num_connect_failures = 0;
+    for (;;)
+    {
+        detail::clear_errors(err, info);
+        bool request_sent = false;
+        bool in_transaction = false;
+        if (!connected_)
+        {
+            conn_.connect(endpoint_, params_.get(), err, info);
+            if (!err)
+            {
+                on_connected();
+                if (Attempt::sends_request)
+                    ++num_reconnects_;
+            }
+        }
+        if (!err && Attempt::sends_request)
+        {
+            request_sent = true;
+            in_transaction = conn_.session().in_transaction();
+            attempt.run(*this, err, info);
+        }
+        if (!err || !on_failure(err, request_sent, attempt.idempotent, in_transaction, num_failures))
+            return;
+
+        // Reconnecting after a request failed is immediate; backoff applies to failed reconnections
+        if (!request_sent)
+        {
+            timer_.expires_after(next_backoff(++num_connect_failures));
+            timer_.wait(err);
+            if (err)
+                return;
+        }
+    }
+}
+
+template <typename Stream>
+template <typename Attempt>
+struct boost::mysql::resilient_connection<Stream>::retry_op : boost::asio::coroutine
+{
+    resilient_connection<Stream>& conn_;
+    Attempt attempt_;
+    error_info* output_info_;
+    std::size_t num_failures_ {0};
+    std::size_t num_connect_failures_ {0};
+    bool request_sent_ {false};
+    bool in_transaction_ {false};
+
+    retry_op(resilient_connection<Stream>& conn, Attempt&& attempt, error_info* output_info) :
+        conn_(conn), attempt_(std::move(attempt)), output_info_(output_info) {}
+
+    template <class Self, class... Results>
+    void operator()(
+        Self& self,
+        error_code err = {},
+        Results&&... results
+    )
+    {
+        BOOST_ASIO_CORO_REENTER(*this)
+        {
+            for (;;)
+            {
+                detail::conditional_clear(output_info_);
+                request_sent_ = false;
+                if (!conn_.connected_)
+                {
+                    BOOST_ASIO_CORO_YIELD conn_.conn_.async_connect(
+                        conn_.endpoint_,
+                        conn_.params_.get(),
+                        std::move(self),
+                        output_info_
+                    );
+                    if (!err)
+                    {
+                        conn_.on_connected();
+                        if (Attempt::sends_request)
+                            ++conn_.num_reconnects_;
+                    }
+                }
+                if (!err && Attempt::sends_request)
+                {
+                    request_sent_ = true;
+                    in_transaction_ = conn_.conn_.session().in_transaction();
+                    BOOST_ASIO_CORO_YIELD attempt_.async_run(conn_, std::move(self), output_info_);
+                    if constexpr (sizeof...(Results) > 0)
+                    {
+                        if (!err)
+                            attempt_.store(std::forward<Results>(results)...);
+                    }
+                }
+                if (!err || !conn_.on_failure(err, request_sent_, attempt_.idempotent, in_transaction_, num_failures_))
+                {
+                    attempt_.complete(self, err);
+                    BOOST_ASIO_CORO_YIELD break;
+                }
+
+                if (!request_sent_)
+                {
+                    BOOST_ASIO_CORO_YIELD
+                    {
+                        conn_.timer_.expires_after(conn_.next_backoff(++num_connect_failures_));
+                        conn_.timer_.async_wait(std::move(self));
+                    }
+                    if (err)
+                    {
+                        attempt_.complete(self, err);
+                        BOOST_ASIO_CORO_YIELD break;
+                    }
+                }
+            }
+        }
+    }
+};
+
+// connect
+template <typename Stream>
+void boost::mysql::resilient_connection<Stream>::connect(
+    const endpoint_type& endpoint,
+    const connection_params& params,
+    error_code& err,
+    error_info& info
+)
+{
+    set_connect_params(endpoint, params);
+    disconnect();
+    connect_attempt attempt;
+    run_with_retries(attempt, err, info);
+}
+
+template <typename Stream>
+void boost::mysql::resilient_connection<Stream>::connect(
+    const endpoint_type& endpoint,
+    const connection_params& params
+)
+{
+    detail::error_block blk;
+    connect(endpoint, params, blk.err, blk.info);
+    blk.check();
+}
+
+template <typename Stream>
+template <typename CompletionToken>
+BOOST_MYSQL_INITFN_RESULT_TYPE(
+    CompletionToken,
+    typename boost::mysql::resilient_connection<Stream>::connect_signature
+)
+boost::mysql::resilient_connection<Stream>::async_connect(
+    const endpoint_type& endpoint,
+    const connection_params& params,
+    CompletionToken&& token,
+    error_info* info
+)
+{
+    set_connect_params(endpoint, params);
+    disconnect();
+    return boost::asio::async_compose<CompletionToken, connect_signature>(
+        retry_op<connect_attempt>(*this, connect_attempt(), info),
+        token,
+        conn_.next_layer()
+    );
+}
+
+// query
+template <typename Stream>
+std::vector<boost::mysql::owning_row> boost::mysql::resilient_connection<Stream>::query(
+    std::string_view query_string,
+    error_code& err,
+    error_info& info
+)
+{
+    query_attempt attempt {policy_.is_idempotent && policy_.is_idempotent(query_string), query_string, {}};
+    run_with_retries(attempt, err, info);
+    return std::move(attempt.rows);
+}
+
+template <typename Stream>
+std::vector<boost::mysql::owning_row> boost::mysql::resilient_connection<Stream>::query(
+    std::string_view query_string
+)
+{
+    detail::error_block blk;
+    auto res = query(query_string, blk.err, blk.info);
+    blk.check();
+    return res;
+}
+
+template <typename Stream>
+template <typename CompletionToken>
+BOOST_MYSQL_INITFN_RESULT_TYPE(
+    CompletionToken,
+    typename boost::mysql::resilient_connection<Stream>::query_signature
+)
+boost::mysql::resilient_connection<Stream>::async_query(
+    std::string_view query_string,
+    CompletionToken&& token,
+    error_info* info
+)
+{
+    return boost::asio::async_compose<CompletionToken, query_signature>(
+        retry_op<query_attempt>(
+            *this,
+            query_attempt{policy_.is_idempotent && policy_.is_idempotent(query_string), query_string, {}},
+            info
+        ),
+        token,
+        conn_.next_layer()
+    );
+}
+
+// prepare_statement
+template <typename Stream>
+typename boost::mysql::resilient_connection<Stream>::statement_handle
+boost::mysql::resilient_connection<Stream>::prepare_statement(
+    std::string_view statement,
+    error_code& err,
+    error_info& info
+)
+{
+    statement_attempt<false> attempt {true, find_or_add_statement(statement), {}, {}};
+    run_with_retries(attempt, err, info);
+    return err ? statement_handle() : statement_handle(attempt.index);
+}
+
+template <typename Stream>
+typename boost::mysql::resilient_connection<Stream>::statement_handle
+boost::mysql::resilient_connection<Stream>::prepare_statement(
+    std::string_view statement
+)
+{
+    detail::error_block blk;
+    auto res = prepare_statement(statement, blk.err, blk.info);
+    blk.check();
+    return res;
+}
+
+template <typename Stream>
+template <typename CompletionToken>
+BOOST_MYSQL_INITFN_RESULT_TYPE(
+    CompletionToken,
+    typename boost::mysql::resilient_connection<Stream>::prepare_statement_signature
+)
+boost::mysql::resilient_connection<Stream>::async_prepare_statement(
+    std::string_view statement,
+    CompletionToken&& token,
+    error_info* info
+)
+{
+    return boost::asio::async_compose<CompletionToken, prepare_statement_signature>(
+        retry_op<statement_attempt<false>>(
+            *this,
+            statement_attempt<false>{true, find_or_add_statement(statement), {}, {}},
+            info
+        ),
+        token,
+        conn_.next_layer()
+    );
+}
+
+// execute
+template <typename Stream>
+template <typename Collection>
+std::vector<boost::mysql::owning_row> boost::mysql::resilient_connection<Stream>::execute(
+    statement_handle stmt,
+    const Collection& params,
+    error_code& err,
+    error_info& info
+)
+{
+    assert(stmt.valid() && stmt.index_ < statements_.size());
+    statement_attempt<true> attempt {
+        statements_[stmt.index_].idempotent,
+        stmt.index_,
+        std::vector<value>(std::begin(params), std::end(params)),
+        {}
+    };
+    run_with_retries(attempt, err, info);
+    return std::move(attempt.rows);
+}
+
+template <typename Stream>
+template <typename Collection>
+std::vector<boost::mysql::owning_row> boost::mysql::resilient_connection<Stream>::execute(
+    statement_handle stmt,
+    const Collection& params
+)
+{
+    detail::error_block blk;
+    auto res = execute(stmt, params, blk.err, blk.info);
+    blk.check();
+    return res;
+}
+
+template <typename Stream>
+template <typename Collection, typename CompletionToken>
+BOOST_MYSQL_INITFN_RESULT_TYPE(
+    CompletionToken,
+    typename boost::mysql::resilient_connection<Stream>::execute_signature
+)
+boost::mysql::resilient_connection<Stream>::async_execute(
+    statement_handle stmt,
+    const Collection& params,
+    CompletionToken&& token,
+    error_info* info
+)
+{
+    assert(stmt.valid() && stmt.index_ < statements_.size());
+    return boost::asio::async_compose<CompletionToken, execute_signature>(
+        retry_op<statement_attempt<true>>(
+            *this,
+            statement_attempt<true>{
+                statements_[stmt.index_].idempotent,
+                stmt.index_,
+                std::vector<value>(std::begin(params), std::end(params)),
+                {}
+            },
+            info
+        ),
+        token,
+        conn_.next_layer()
+    );
+}
+
+// close
+template <typename Stream>
+void boost::mysql::resilient_connection<Stream>::close(
+    error_code& err,
+    error_info& info
+)
+{
+    connected_ = false;
+    conn_.close(err, info);
+}
+
+template <typename Stream>
+void boost::mysql::resilient_connection<Stream>::close()
+{
+    detail::error_block blk;
+    close(blk.err, blk.info);
+    blk.check();
+}
+
+template <typename Stream>
+template <typename CompletionToken>
+BOOST_MYSQL_INITFN_RESULT_TYPE(
+    CompletionToken,
+    typename boost::mysql::resilient_connection<Stream>::close_signature
+)
+boost::mysql::resilient_connection<Stream>::async_close(
+    CompletionToken&& token,
+    error_info* info
+)
+{
+    connected_ = false;
+    return conn_.async_close(std::forward<CompletionToken>(token), info);
+}
+
+#endif
@@ -0,0 +1,103 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_RESILIENT_CONNECTION_IPP
+#define BOOST_MYSQL_IMPL_RESILIENT_CONNECTION_IPP
+
+#include <algorithm>
+
+BOOST_MYSQL_DECL bool boost::mysql::is_read_only_query(
+    std::string_view sql
+) noexcept
+{
+    auto is_space = [](char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; };
+
+    // Skip whitespace, parentheses and comments
+    std::size_t i = 0;
+    while (i < sql.size())
+    {
+        if (is_space(sql[i]) || sql[i] == '(')
+        {
+            ++i;
+        }
+        else if (sql[i] == '#' || (sql.substr(i, 2) == "--" && (i + 2 == sql.size() || is_space(sql[i + 2]))))
+        {
+            auto end = sql.find('\n', i);
+            if (end == std::string_view::npos)
+                return false;
+            i = end + 1;
+        }
+        else if (sql.substr(i, 2) == "/*")
+        {
+            if (sql.substr(i, 3) == "/*!") // executable comment
+                return false;
+            auto end = sql.find("*/", i + 2);
+            if (end == std::string_view::npos)
+                return false;
+            i = end + 2;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    // Compare the first keyword, case insensitively
+    auto end = i;
+    while (end < sql.size() && ((sql[end] >= 'a' && sql[end] <= 'z') || (sql[end] >= 'A' && sql[end] <= 'Z')))
+        ++end;
+    auto keyword = sql.substr(i, end - i);
+    auto matches = [keyword](std::string_view expected) {
+        return keyword.size() == expected.size() && std::equal(keyword.begin(), keyword.end(), expected.begin(),
+            [](char lhs, char rhs) { return (lhs | 0x20) == rhs; });
+    };
+    return matches("select") || matches("show") || matches("describe") ||
+           matches("desc") || matches("explain");
+}
+
+BOOST_MYSQL_DECL bool boost::mysql::is_connection_error(
+    const error_code& err
+) noexcept
+{
+    if (!err)
+        return false;
+    if (err.category() != detail::mysql_error_category)
+        return true; // network and TLS errors
+    switch (static_cast<errc>(err.value()))
+    {
+    case errc::con_count_error:
+    case errc::server_shutdown:
+    case errc::aborting_connection:
+    case errc::new_aborting_connection:
+    case errc::net_read_interrupted:
+    case errc::too_many_user_connections:
+    case errc::session_was_killed:
+    case errc::incomplete_message:
+    case errc::extra_bytes:
+    case errc::sequence_number_mismatch:
+    case errc::protocol_value_error:
+        return true;
+    default:
+        return false;
+    }
+}
+
+BOOST_MYSQL_DECL std::chrono::milliseconds boost::mysql::detail::compute_backoff(
+    const retry_policy& policy,
+    std::size_t n,
+    double random
+) noexcept
+{
+    auto max = static_cast<double>(policy.max_backoff.count());
+    auto res = static_cast<double>(policy.initial_backoff.count());
+    for (std::size_t i = 1; i < n && res < max; ++i)
+        res *= policy.backoff_multiplier;
+    res = std::min(res, max) * (1.0 - policy.jitter * random);
+    return std::chrono::milliseconds(static_cast<std::chrono::milliseconds::rep>(res));
+}
+
+#endif
@@ -68,7 +68,7 @@ std::vector<boost::mysql::owning_row> boost::mysql::resultset<StreamType>::fetch
     {
         for (std::size_t i = 0; i < count; ++i)
         {
-            detail::bytestring buff;
+            detail::resource_bytestring buff (channel_->memory_resource());
             std::vector<value> values;
 
             auto result = detail::read_row(
@@ -122,6 +122,50 @@ std::vector<boost::mysql::owning_row> boost::mysql::resultset<StreamType>::fetch
     return fetch_many(std::numeric_limits<std::size_t>::max());
 }
 
+template <typename StreamType>
+void boost::mysql::resultset<StreamType>::discard_remaining(
+    error_code& err,
+    error_info& info
+)
+{
+    assert(valid());
+
+    detail::clear_errors(err, info);
+
+    while (!complete())
+    {
+        channel_->read(buffer_, err);
+        if (err)
+            return;
+        auto result = detail::process_discarded_message(
+            channel_->current_capabilities(),
+            buffer_,
+            ok_packet_,
+            err,
+            info
+        );
+        if (result == detail::read_row_result::error)
+        {
+            channel_->observe_command_end(err);
+            return;
+        }
+        if (result == detail::read_row_result::eof)
+        {
+            channel_->process_ok_packet(ok_packet_);
+            channel_->observe_command_end(err);
+            eof_received_ = true;
+        }
+    }
+}
+
+template <typename StreamType>
+void boost::mysql::resultset<StreamType>::discard_remaining()
+{
+    detail::error_block blk;
+    discard_remaining(blk.err, blk.info);
+    blk.check();
+}
+
 template<typename StreamType>
 struct boost::mysql::resultset<StreamType>::fetch_one_op : detail::async_op<StreamType>
 {
@@ -194,12 +238,13 @@ struct boost::mysql::resultset<StreamType>::fetch_many_op_impl
 {
   resultset<StreamType>& parent_resultset;
   std::vector<owning_row> rows;
-  detail::bytestring buffer;
+  detail::resource_bytestring buffer;
   std::vector<value> values;
   std::size_t remaining;
 
   fetch_many_op_impl(resultset<StreamType>& obj, std::size_t count):
   parent_resultset(obj),
+  buffer(obj.channel_->memory_resource()),
   remaining(count)
   {
   };
@@ -208,7 +253,7 @@ struct boost::mysql::resultset<StreamType>::fetch_many_op_impl
   {
     rows.emplace_back(std::move(values), std::move(buffer));
     values = std::vector<value>();
-    buffer = detail::bytestring();
+    buffer = detail::resource_bytestring(parent_resultset.channel_->memory_resource());
     --remaining;
   }
 };
@@ -316,5 +361,90 @@ boost::mysql::resultset<StreamType>::async_fetch_all(
     );
 }
 
+template<typename StreamType>
+struct boost::mysql::resultset<StreamType>::discard_remaining_op : detail::async_op<StreamType>
+{
+  resultset<StreamType>& resultset_;
+  bool cont_ = false;
+
+  discard_remaining_op(
+    detail::channel<StreamType>& chan,
+    error_info* output_info,
+    resultset<StreamType>& obj):
+  detail::async_op<StreamType>(chan, output_info),
+  resultset_(obj)
+  {
+  }
+
+  template<class Self>
+  void operator()(
+      Self& self,
+      error_code err = {}
+  )
+  {
+    error_info info;
+    detail::read_row_result result = detail::read_row_result::error;
+
+    // Error checking
+    if (err)
+    {
+      self.complete(err);
+      return;
+    }
+
+    // Normal path
+    BOOST_ASIO_CORO_REENTER(*this)
+      {
+        while (!resultset_.complete())
+        {
+          cont_ = true;
+          BOOST_ASIO_CORO_YIELD this->async_read(std::move(self), resultset_.buffer_);
+          result = detail::process_discarded_message(
+              this->get_channel().current_capabilities(),
+              resultset_.buffer_,
+              resultset_.ok_packet_,
+              err,
+              info
+          );
+          if (result == detail::read_row_result::error)
+          {
+            this->get_channel().observe_command_end(err);
+            detail::conditional_assign(this->get_output_info(), std::move(info));
+            self.complete(err);
+            BOOST_ASIO_CORO_YIELD break;
+          }
+          if (result == detail::read_row_result::eof)
+          {
+            this->get_channel().process_ok_packet(resultset_.ok_packet_);
+            this->get_channel().observe_command_end(err);
+            resultset_.eof_received_ = true;
+          }
+        }
+        if (!cont_)
+        {
+          // ensure return as if by post
+          BOOST_ASIO_CORO_YIELD boost::asio::post(std::move(self));
+        }
+        self.complete(error_code());
+      }
+  }
+};
+
+template <typename StreamType>
+template <typename CompletionToken>
+BOOST_ASIO_INITFN_RESULT_TYPE(
+    CompletionToken,
+    typename boost::mysql::resultset<StreamType>::discard_remaining_signature
+)
+boost::mysql::resultset<StreamType>::async_discard_remaining(
+    CompletionToken&& token,
+    error_info* info
+)
+{
+    assert(valid());
+    detail::conditional_clear(info);
+    return boost::asio::async_compose<CompletionToken, discard_remaining_signature>(
+        discard_remaining_op(*channel_, info, *this), token, *this);
+}
 
 #endif
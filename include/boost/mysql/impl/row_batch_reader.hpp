@@ -0,0 +1,164 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_ROW_BATCH_READER_HPP
+#define BOOST_MYSQL_IMPL_ROW_BATCH_READER_HPP
+
+#include <boost/asio/coroutine.hpp>
+#include <boost/asio/post.hpp>
+#include <cassert>
+
+// Shared with the background fetch, which may outlive the reader
+template <typename StreamType>
+struct boost::mysql::row_batch_reader<StreamType>::state :
+    std::enable_shared_from_this<state>
+{
+    resultset<StreamType>& result;
+    std::size_t batch_size;
+
+    // Never expires. Cancelled to wake up the reader when a batch is fetched
+    boost::asio::steady_timer batch_ready_timer;
+
+    // The batch fetched in the background, valid if ready == true
+    bool fetching {false};
+    bool ready {false};
+    std::vector<owning_row> rows;
+    error_code err;
+    error_info info;
+
+    state(resultset<StreamType>& result, std::size_t batch_size):
+        result(result),
+        batch_size(batch_size),
+        batch_ready_timer(result.get_executor(), boost::asio::steady_timer::time_point::max())
+    {
+    }
+
+    void start_fetch()
+    {
+        assert(!fetching && !ready);
+        fetching = true;
+        if (result.complete())
+        {
+            // Nothing left to fetch: produce an empty batch, as if by post
+            boost::asio::post(result.get_executor(), [self = this->shared_from_this()] {
+                self->on_fetched(error_code(), {});
+            });
+        }
+        else
+        {
+            result.async_fetch_many(batch_size, [self = this->shared_from_this()] (
+                error_code err,
+                std::vector<owning_row> rows
+            ) {
+                self->on_fetched(err, std::move(rows));
+            }, &info);
+        }
+    }
+
+    void on_fetched(error_code fetch_err, std::vector<owning_row> fetched_rows)
+    {
+        fetching = false;
+        ready = true;
+        err = fetch_err;
+        rows = std::move(fetched_rows);
+        batch_ready_timer.cancel();
+    }
+};
+
+template <typename StreamType>
+struct boost::mysql::row_batch_reader<StreamType>::read_batch_op : boost::asio::coroutine
+{
+    std::shared_ptr<state> state_;
+    error_info* output_info_;
+
+    read_batch_op(std::shared_ptr<state> st, error_info* output_info):
+        state_(std::move(st)),
+        output_info_(output_info)
+    {
+    }
+
+    template <typename Self>
+    void operator()(
+        Self& self,
+        error_code = {}
+    )
+    {
+        BOOST_ASIO_CORO_REENTER(*this)
+        {
+            if (state_->ready)
+            {
+                // ensure return as if by post
+                BOOST_ASIO_CORO_YIELD boost::asio::post(std::move(self));
+            }
+            else
+            {
+                if (!state_->fetching)
+                    state_->start_fetch();
+                while (!state_->ready)
+                {
+                    BOOST_ASIO_CORO_YIELD state_->batch_ready_timer.async_wait(std::move(self));
+                }
+            }
+
+            // Take the fetched batch, and start fetching the next one
+            state_->ready = false;
+            {
+                std::vector<owning_row> rows (std::move(state_->rows));
+                error_code err = state_->err;
+                if (err && output_info_)
+                    *output_info_ = std::move(state_->info);
+                else if (!err && !rows.empty() && !state_->result.complete())
+                    state_->start_fetch();
+                self.complete(err, std::move(rows));
+            }
+        }
+    }
+};
+
+template <typename StreamType>
+boost::mysql::row_batch_reader<StreamType>::row_batch_reader(
+    resultset<StreamType>& result,
+    std::size_t batch_size
+) :
+    state_(std::make_shared<state>(result, batch_size))
+{
+    assert(result.valid());
+    assert(batch_size > 0);
+}
+
+template <typename StreamType>
+std::size_t boost::mysql::row_batch_reader<StreamType>::batch_size() const noexcept
+{
+    return state_->batch_size;
+}
+
+template <typename StreamType>
+bool boost::mysql::row_batch_reader<StreamType>::complete() const noexcept
+{
+    return state_->result.complete() && !state_->fetching && (!state_->ready || state_->rows.empty());
+}
+
+template <typename StreamType>
+template <typename CompletionToken>
+BOOST_ASIO_INITFN_RESULT_TYPE(
+    CompletionToken,
+    typename boost::mysql::row_batch_reader<StreamType>::read_batch_signature
+)
+boost::mysql::row_batch_reader<StreamType>::async_read_batch(
+    CompletionToken&& token,
+    error_info* info
+)
+{
+    detail::conditional_clear(info);
+    return boost::asio::async_compose<CompletionToken, read_batch_signature>(
+        read_batch_op(state_, info),
+        token,
+        state_->result
+    );
+}
+
+#endif
@@ -0,0 +1,120 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_SESSION_STATE_HPP
+#define BOOST_MYSQL_IMPL_SESSION_STATE_HPP
+
+#include "boost/mysql/detail/protocol/serialization.hpp"
+#include "boost/mysql/detail/protocol/constants.hpp"
+
+inline std::optional<std::string_view> boost::mysql::session_state::system_variable(
+    std::string_view name
+) const
+{
+    auto it = system_variables_.find(name);
+    if (it == system_variables_.end())
+        return {};
+    return std::string_view(it->second);
+}
+
+inline bool boost::mysql::session_state::autocommit() const noexcept
+{
+    return status_flags_ & detail::SERVER_STATUS_AUTOCOMMIT;
+}
+
+inline bool boost::mysql::session_state::in_transaction() const noexcept
+{
+    return status_flags_ & detail::SERVER_STATUS_IN_TRANS;
+}
+
+inline void boost::mysql::session_state::reset(
+    bool tracking,
+    std::string_view schema,
+    std::uint16_t status_flags
+)
+{
+    tracking_ = tracking;
+    status_flags_ = status_flags;
+    schema_ = schema;
+    system_variables_.clear();
+    transaction_state_.clear();
+    transaction_characteristics_.clear();
+    gtids_.clear();
+}
+
+inline bool boost::mysql::session_state::apply_changes(
+    std::string_view session_state_info
+)
+{
+    using namespace detail;
+
+    // A sequence of (type, data) pairs. The format of data depends on type
+    deserialization_context ctx (boost::asio::buffer(session_state_info), capabilities());
+    while (ctx.enough_size(1))
+    {
+        int1 type;
+        string_lenenc data;
+        if (deserialize(ctx, type, data) != errc::ok)
+            return false;
+        deserialization_context data_ctx (boost::asio::buffer(data.value), capabilities());
+        switch (type.value)
+        {
+        case session_track::system_variables:
+        {
+            string_lenenc name, value;
+            if (deserialize(data_ctx, name, value) != errc::ok)
+                return false;
+            auto it = system_variables_.find(name.value);
+            if (it == system_variables_.end())
+                system_variables_.emplace(name.value, value.value);
+            else
+                it->second = value.value;
+            break;
+        }
+        case session_track::schema:
+        {
+            string_lenenc schema;
+            if (deserialize(data_ctx, schema) != errc::ok)
+                return false;
+            schema_ = schema.value;
+            break;
+        }
+        case session_track::gtids:
+        {
+            int1 encoding; // always zero
+            string_lenenc gtids;
+            if (deserialize(data_ctx, encoding, gtids) != errc::ok)
+                return false;
+            gtids_ = gtids.value;
+            break;
+        }
+        case session_track::transaction_characteristics:
+        {
+            string_lenenc characteristics;
+            if (deserialize(data_ctx, characteristics) != errc::ok)
+                return false;
+            transaction_characteristics_ = characteristics.value;
+            break;
+        }
+        case session_track::transaction_state:
+        {
+            string_lenenc state;
+            if (deserialize(data_ctx, state) != errc::ok)
+                return false;
+            transaction_state_ = state.value;
+            break;
+        }
+        default:
+            // state_change just flags that something changed. Types added
+            // by newer servers are skipped, as their length is known
+            break;
+        }
+    }
+    return true;
+}
+
+#endif
@@ -0,0 +1,181 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_SHARDED_POOL_HPP
+#define BOOST_MYSQL_IMPL_SHARDED_POOL_HPP
+
+#include <boost/asio/bind_executor.hpp>
+#include <boost/asio/coroutine.hpp>
+#include <boost/asio/dispatch.hpp>
+#include <boost/asio/post.hpp>
+#include <cassert>
+
+template <typename Stream>
+boost::mysql::sharded_pool<Stream>::sharded_pool(
+    const std::vector<executor_type>& executors,
+    const endpoint_type& endpoint,
+    const connection_params& params,
+    pool_options opts
+) :
+    max_in_flight_(opts.max_size)
+{
+    assert(!executors.empty());
+    shards_.reserve(executors.size());
+    for (const auto& ex: executors)
+        shards_.push_back(std::make_unique<shard_data>(ex, endpoint, params, opts));
+}
+
+template <typename Stream>
+std::size_t boost::mysql::sharded_pool<Stream>::local_shard() const noexcept
+{
+    for (std::size_t i = 0; i < shards_.size(); ++i)
+    {
+        if (detail::running_in_this_thread(shards_[i]->executor))
+            return i;
+    }
+    return npos;
+}
+
+template <typename Stream>
+std::size_t boost::mysql::sharded_pool<Stream>::least_loaded() noexcept
+{
+    // Start at a different shard each time, so ties are spread evenly
+    auto num_shards = shards_.size();
+    auto start = next_shard_.fetch_add(1, std::memory_order_relaxed) % num_shards;
+    auto res = start;
+    auto min_load = shards_[res]->in_flight.load(std::memory_order_relaxed);
+    for (std::size_t i = 1; i < num_shards && min_load != 0; ++i)
+    {
+        auto candidate = (start + i) % num_shards;
+        auto load = shards_[candidate]->in_flight.load(std::memory_order_relaxed);
+        if (load < min_load)
+        {
+            res = candidate;
+            min_load = load;
+        }
+    }
+    return res;
+}
+
+template <typename Stream>
+std::size_t boost::mysql::sharded_pool<Stream>::pick_shard(
+    std::size_t local
+) noexcept
+{
+    // Loads are read without synchronization, so the choice is a heuristic:
+    // a shard may get more than max_size queries, which then wait for a connection
+    std::size_t res = local;
+    if (local == npos)
+    {
+        res = least_loaded();
+    }
+    else if (shards_[local]->in_flight.load(std::memory_order_relaxed) >= max_in_flight_)
+    {
+        auto candidate = least_loaded();
+        if (shards_[candidate]->in_flight.load(std::memory_order_relaxed) <
+            shards_[local]->in_flight.load(std::memory_order_relaxed))
+        {
+            res = candidate;
+            num_stolen_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    shards_[res]->in_flight.fetch_add(1, std::memory_order_relaxed);
+    return res;
+}
+
+template <typename Stream>
+struct boost::mysql::sharded_pool<Stream>::query_op : boost::asio::coroutine
+{
+    sharded_pool<Stream>& pool_;
+    std::string_view query_string_;
+    error_info* output_info_;
+    std::size_t shard_;
+    pooled_connection<Stream> conn_;
+    error_code err_;
+    std::vector<owning_row> rows_;
+
+    query_op(
+        sharded_pool<Stream>& pool,
+        std::string_view query_string,
+        error_info* output_info,
+        std::size_t shard
+    ) :
+        pool_(pool), query_string_(query_string), output_info_(output_info), shard_(shard) {}
+
+    template <class Self>
+    void operator()(
+        Self& self,
+        error_code err,
+        pooled_connection<Stream> conn
+    )
+    {
+        conn_ = std::move(conn);
+        (*this)(self, err);
+    }
+
+    template <class Self>
+    void operator()(
+        Self& self,
+        error_code err = {},
+        std::vector<owning_row> rows = {}
+    )
+    {
+        // The shard's pool and connections are not thread-safe. Binding the
+        // intermediate handlers to the shard's executor makes them run there
+        auto& sh = *pool_.shards_[shard_];
+        BOOST_ASIO_CORO_REENTER(*this)
+        {
+            BOOST_ASIO_CORO_YIELD boost::asio::dispatch(
+                boost::asio::bind_executor(sh.executor, std::move(self))
+            );
+            BOOST_ASIO_CORO_YIELD sh.pool.async_acquire(
+                boost::asio::bind_executor(sh.executor, std::move(self)),
+                output_info_
+            );
+            if (!err)
+            {
+                BOOST_ASIO_CORO_YIELD conn_->async_query(
+                    query_string_,
+                    boost::asio::bind_executor(sh.executor, std::move(self)),
+                    output_info_
+                );
+                rows_ = std::move(rows);
+                conn_.release();
+            }
+            err_ = err;
+            sh.in_flight.fetch_sub(1, std::memory_order_relaxed);
+
+            // Go back to the handler's executor
+            BOOST_ASIO_CORO_YIELD boost::asio::post(std::move(self));
+            self.complete(err_, std::move(rows_));
+        }
+    }
+};
+
+template <typename Stream>
+template <typename CompletionToken>
+BOOST_MYSQL_INITFN_RESULT_TYPE(
+    CompletionToken,
+    typename boost::mysql::sharded_pool<Stream>::query_signature
+)
+boost::mysql::sharded_pool<Stream>::async_query(
+    std::string_view query_string,
+    CompletionToken&& token,
+    error_info* info
+)
+{
+    detail::conditional_clear(info);
+    auto local = local_shard();
+    auto target = pick_shard(local);
+    return boost::asio::async_compose<CompletionToken, query_signature>(
+        query_op(*this, query_string, info, target),
+        token,
+        shards_[local == npos ? target : local]->executor
+    );
+}
+
+#endif
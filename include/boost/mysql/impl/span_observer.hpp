@@ -0,0 +1,71 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_SPAN_OBSERVER_HPP
+#define BOOST_MYSQL_IMPL_SPAN_OBSERVER_HPP
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+inline std::string_view get_span_name(const command_stats& stats) noexcept
+{
+    switch (stats.type)
+    {
+    case command_type::query:
+    {
+        // The first keyword. Digests have no leading whitespace or comments
+        std::size_t size = 0;
+        while (size < stats.sql_digest.size() && is_identifier_char(stats.sql_digest[size]))
+            ++size;
+        return size ? stats.sql_digest.substr(0, size) : std::string_view("query");
+    }
+    case command_type::prepare: return "prepare";
+    case command_type::execute: return "execute";
+    case command_type::close_statement: return "close_statement";
+    case command_type::quit: return "quit";
+    default: return "unknown";
+    }
+}
+
+} // detail
+} // mysql
+} // boost
+
+template <typename Function>
+void boost::mysql::span_record::for_each_attribute(
+    Function&& f
+) const
+{
+    f(std::string_view("db.system"), std::string_view("mysql"));
+    f(std::string_view("db.operation"), name);
+    if (!stats.sql_digest.empty())
+        f(std::string_view("db.statement"), stats.sql_digest);
+    f(std::string_view("db.mysql.rows"), static_cast<std::int64_t>(stats.num_rows));
+    f(std::string_view("db.mysql.bytes_read"), static_cast<std::int64_t>(stats.bytes_read));
+    f(std::string_view("db.mysql.bytes_written"), static_cast<std::int64_t>(stats.bytes_written));
+    f(std::string_view("db.mysql.network_time_ns"), static_cast<std::int64_t>(stats.network_time().count()));
+    f(std::string_view("db.mysql.decode_time_ns"), static_cast<std::int64_t>(stats.decode_time.count()));
+}
+
+inline void boost::mysql::span_observer::on_command_end(
+    const command_stats& stats,
+    error_code err
+)
+{
+    auto end_time = std::chrono::system_clock::now();
+    span_record rec {
+        detail::get_span_name(stats),
+        end_time - std::chrono::duration_cast<std::chrono::system_clock::duration>(stats.elapsed),
+        end_time,
+        stats,
+        err
+    };
+    sink_(rec);
+}
+
+#endif
@@ -0,0 +1,44 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_SSL_SESSION_CACHE_HPP
+#define BOOST_MYSQL_IMPL_SSL_SESSION_CACHE_HPP
+
+inline bool boost::mysql::ssl_session_cache::has_session() const noexcept
+{
+    std::lock_guard<std::mutex> guard (mtx_);
+    return session_ != nullptr;
+}
+
+inline void boost::mysql::ssl_session_cache::clear() noexcept
+{
+    set_session(nullptr);
+}
+
+inline SSL_SESSION* boost::mysql::ssl_session_cache::get_session() const noexcept
+{
+    std::lock_guard<std::mutex> guard (mtx_);
+    if (session_)
+        SSL_SESSION_up_ref(session_);
+    return session_;
+}
+
+inline void boost::mysql::ssl_session_cache::set_session(
+    SSL_SESSION* session
+) noexcept
+{
+    SSL_SESSION* old_session = nullptr;
+    {
+        std::lock_guard<std::mutex> guard (mtx_);
+        old_session = session_;
+        session_ = session;
+    }
+    if (old_session)
+        SSL_SESSION_free(old_session);
+}
+
+#endif
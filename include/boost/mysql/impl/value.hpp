@@ -9,6 +9,7 @@
 #define BOOST_MYSQL_IMPL_VALUE_HPP
 
 #include "boost/mysql/detail/auxiliar/container_equals.hpp"
+#include <charconv>
 
 namespace boost {
 namespace mysql {
@@ -155,6 +156,29 @@ boost::mysql::value::get_optional<double>() const noexcept
     return res;
 }
 
+template <>
+inline std::optional<boost::mysql::decimal>
+boost::mysql::value::get_optional<boost::mysql::decimal>() const noexcept
+{
+    if (auto* str = std::get_if<std::string_view>(&repr_))
+    {
+        return decimal::parse(*str);
+    }
+    else if (auto* int_val = std::get_if<std::int64_t>(&repr_))
+    {
+        return decimal(*int_val);
+    }
+    else if (auto* uint_val = std::get_if<std::uint64_t>(&repr_))
+    {
+        if (*uint_val <= static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()))
+            return decimal(static_cast<std::int64_t>(*uint_val));
+        char buffer [32];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), *uint_val);
+        return decimal::parse(std::string_view(buffer, result.ptr - buffer));
+    }
+    return {};
+}
+
 template <typename T>
 constexpr T boost::mysql::value::get() const
 {
@@ -8,9 +8,12 @@
 #ifndef BOOST_MYSQL_METADATA_HPP
 #define BOOST_MYSQL_METADATA_HPP
 
+#include "boost/mysql/detail/config.hpp"
 #include "boost/mysql/detail/protocol/common_messages.hpp"
 #include "boost/mysql/detail/auxiliar/bytestring.hpp"
+#include "boost/mysql/detail/auxiliar/resource_allocator.hpp"
 #include "boost/mysql/field_type.hpp"
+#include <vector>
 
 namespace boost {
 namespace mysql {
@@ -23,33 +26,54 @@ namespace mysql {
  */
 class field_metadata
 {
-    detail::column_definition_packet msg_;
+    // Only what the accessors expose is kept (e.g. the catalog, always "def",
+    // is dropped), laid out to keep the object small
+    std::string_view database_;
+    std::string_view table_;
+    std::string_view org_table_;
+    std::string_view name_;
+    std::string_view org_name_;
+    std::uint32_t column_length_ {};
+    std::uint16_t flags_ {};
+    collation character_set_ {};
+    detail::protocol_field_type type_ {};
+    std::uint8_t decimals_ {};
     mutable field_type field_type_ { field_type::_not_computed };
 
-    bool flag_set(std::uint16_t flag) const noexcept { return msg_.flags.value & flag; }
+    bool flag_set(std::uint16_t flag) const noexcept { return flags_ & flag; }
 public:
     /// Default constructor.
     field_metadata() = default;
 
     // Private, do not use.
-    field_metadata(const detail::column_definition_packet& msg) noexcept: msg_(msg) {};
+    field_metadata(const detail::column_definition_packet& msg) noexcept:
+        database_(msg.schema.value),
+        table_(msg.table.value),
+        org_table_(msg.org_table.value),
+        name_(msg.name.value),
+        org_name_(msg.org_name.value),
+        column_length_(msg.column_length.value),
+        flags_(msg.flags.value),
+        character_set_(msg.character_set),
+        type_(msg.type),
+        decimals_(msg.decimals.value) {};
 
     /// Returns the name of the database (schema) the field belongs to.
-    std::string_view database() const noexcept { return msg_.schema.value; }
+    std::string_view database() const noexcept { return database_; }
 
     /**
      * \brief Returns the name of the virtual table the field belongs to.
      * \details If the table was aliased, this will be the name of the alias
      * (e.g. in "SELECT * FROM employees emp", table() will be "emp").
      */
-    std::string_view table() const noexcept { return msg_.table.value; }
+    std::string_view table() const noexcept { return table_; }
 
     /**
      * \brief Returns the name of the physical table the field belongs to.
      * \details E.g. in "SELECT * FROM employees emp",
      * original_table() will be "employees".
      */
-    std::string_view original_table() const noexcept { return msg_.org_table.value; }
+    std::string_view original_table() const noexcept { return org_table_; }
 
     /**
      * \brief Returns the actual name of the field.
@@ -57,28 +81,28 @@ public:
      * (e.g. in "SELECT id AS employee_id FROM employees",
      * field_name() will be "employee_id").
      */
-    std::string_view field_name() const noexcept { return msg_.name.value; }
+    std::string_view field_name() const noexcept { return name_; }
 
     /**
      * \brief Returns the original (physical) name of the field.
      * \details E.g. in "SELECT id AS employee_id FROM employees",
      * original_field_name() will be "id".
      */
-    std::string_view original_field_name() const noexcept { return msg_.org_name.value; }
+    std::string_view original_field_name() const noexcept { return org_name_; }
 
     /// Returns the character set (collation) for the column.
-    collation character_set() const noexcept { return msg_.character_set; }
+    collation character_set() const noexcept { return character_set_; }
 
     /// Returns the maximum length of the field.
-    unsigned column_length() const noexcept { return msg_.column_length.value; }
+    unsigned column_length() const noexcept { return column_length_; }
 
-    detail::protocol_field_type protocol_type() const noexcept { return msg_.type; }
+    detail::protocol_field_type protocol_type() const noexcept { return type_; }
 
     /// Returns the type of the field (see field_type for more info).
     field_type type() const noexcept;
 
     /// Returns the number of decimals of the field.
-    unsigned decimals() const noexcept { return msg_.decimals.value; }
+    unsigned decimals() const noexcept { return decimals_; }
 
     /// Returns true if the field is not allowed to be NULL, false if it is nullable.
     bool is_not_null() const noexcept { return flag_set(detail::column_flags::not_null); }
@@ -110,26 +134,142 @@ public:
 
 namespace detail {
 
+// FNV-1a. constexpr, so field_name_key can be hashed at compile time
+constexpr std::uint64_t hash_field_name(std::string_view name) noexcept
+{
+    std::uint64_t res = 0xcbf29ce484222325;
+    for (char c: name)
+    {
+        res ^= static_cast<unsigned char>(c);
+        res *= 0x100000001b3;
+    }
+    return res;
+}
+
+} // detail
+
+/**
+ * \ingroup resultsets
+ * \brief A field name together with its hash, to look up values by name.
+ * \details The constructor is constexpr. If you declare keys as constexpr
+ * variables, the hash is computed at compile time, and a lookup just
+ * involves a table access and a string comparison:
+ * `constexpr field_name_key id_key ("id"); result.at(row, id_key);`
+ *
+ * The key does not own the name, which must outlive it.
+ */
+class field_name_key
+{
+    std::string_view name_;
+    std::uint64_t hash_;
+public:
+    /// Computes the hash for name.
+    constexpr explicit field_name_key(std::string_view name) noexcept:
+        name_(name), hash_(detail::hash_field_name(name)) {};
+
+    /// The field name.
+    constexpr std::string_view name() const noexcept { return name_; }
+
+    /// The hash of the field name.
+    constexpr std::uint64_t hash() const noexcept { return hash_; }
+};
+
+/**
+ * \ingroup resultsets
+ * \brief Maps field names to their position in a row.
+ * \details Resultsets build this index once, when their metadata is read,
+ * so values can be looked up by field name (see resultset::field_index)
+ * without scanning the list of fields. The hash table is sized and seeded so that, in
+ * the usual case, each field name lands in its own slot.
+ *
+ * Names are compared exactly (case sensitive), as returned by field_metadata::field_name.
+ * If several fields have the same name, lookups return the first one.
+ * The index keeps its own copy of the names, so it doesn't depend on the
+ * field_metadata objects it was built from.
+ */
+class field_name_index
+{
+public:
+    /// Returned by find() when no field has the given name.
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    /// Constructs an empty index.
+    field_name_index() = default;
+
+    /// Builds the index for fields, allocating memory from resource.
+    explicit field_name_index(
+        const std::vector<field_metadata>& fields,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    );
+
+    /// Rebuilds the index for fields, reusing the memory it already owns.
+    void assign(const std::vector<field_metadata>& fields);
+
+    /// Returns the position of the first field named key.name(), or npos.
+    std::size_t find(const field_name_key& key) const noexcept;
+
+    /// Returns the position of the first field named name, or npos.
+    std::size_t find(std::string_view name) const noexcept { return find(field_name_key(name)); }
+
+    /// The memory resource the index allocates from.
+    std::pmr::memory_resource* resource() const noexcept { return table_.get_allocator().resource(); }
+private:
+    struct entry
+    {
+        std::uint64_t hash;
+        std::uint32_t name_offset; // into names_
+        std::uint32_t name_size;
+        std::size_t index; // npos for empty slots
+    };
+
+    std::vector<entry, detail::resource_allocator<entry>> table_;
+    std::vector<char, detail::resource_allocator<char>> names_; // all field names, one after another
+    std::uint64_t seed_ {};
+    unsigned shift_ {};
+
+    std::string_view name(const entry& e) const noexcept { return std::string_view(names_.data() + e.name_offset, e.name_size); }
+    std::size_t slot(std::uint64_t hash) const noexcept;
+    bool insert(std::uint64_t hash, std::uint32_t name_offset, std::uint32_t name_size, std::size_t index) noexcept;
+};
+
+namespace detail {
+
 class resultset_metadata
 {
-    std::vector<bytestring> buffers_;
-    std::vector<field_metadata> fields_;
+    resource_bytestring buffer_; // column definition packets, one after another
+    std::vector<field_metadata> fields_; // point into buffer_
+    field_name_index name_index_; // rebuilt in place, reusing its memory
 public:
     resultset_metadata() = default;
-    resultset_metadata(std::vector<bytestring>&& buffers, std::vector<field_metadata>&& fields):
-        buffers_(std::move(buffers)), fields_(std::move(fields)) {};
+
+    // buffer must contain num_fields valid column definition packets, one after another
+    resultset_metadata(resource_bytestring&& buffer, std::size_t num_fields) { assign(std::move(buffer), num_fields); }
+
     resultset_metadata(const resultset_metadata&) = delete;
     resultset_metadata(resultset_metadata&&) = default;
     resultset_metadata& operator=(const resultset_metadata&) = delete;
     resultset_metadata& operator=(resultset_metadata&&) = default;
     ~resultset_metadata() = default;
     const auto& fields() const noexcept { return fields_; }
+    const field_name_index& name_index() const noexcept { return name_index_; }
+
+    // Same as the constructor, but reusing the memory owned by *this
+    BOOST_MYSQL_DECL void assign(resource_bytestring&& buffer, std::size_t num_fields);
+
+    // Gives away the buffer, so its memory can be reused. Leaves *this without fields
+    resource_bytestring release_buffer() noexcept
+    {
+        fields_.clear();
+        return std::move(buffer_);
+    }
 };
 
 } // detail
 } // mysql
 } // boost
 
+#ifdef BOOST_MYSQL_HEADER_ONLY
 #include "boost/mysql/impl/metadata.ipp"
+#endif
 
 #endif
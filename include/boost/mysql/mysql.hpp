@@ -9,5 +9,13 @@
 #define BOOST_MYSQL_MYSQL_HPP
 
 #include "boost/mysql/connection.hpp"
+#include "boost/mysql/resilient_connection.hpp"
+#include "boost/mysql/connection_pool.hpp"
+#include "boost/mysql/replica_router.hpp"
+#include "boost/mysql/sharded_pool.hpp"
+#include "boost/mysql/compact_row.hpp"
+#include "boost/mysql/row_batch_reader.hpp"
+#include "boost/mysql/histogram_observer.hpp"
+#include "boost/mysql/span_observer.hpp"
 
 #endif
@@ -131,12 +131,40 @@ public:
         );
     }
 
+    /**
+     * \brief Executes a statement into an existing resultset (collection, sync with error code version).
+     * \details Like the other overloads, but output is overwritten instead of
+     * returning a new resultset, reusing the memory it owns.
+     * See connection::query(std::string_view, resultset<Stream>&, error_code&, error_info&)
+     * for details.
+     */
+    template <typename Collection>
+    void execute(const Collection& params, resultset<Stream>& output,
+            error_code& err, error_info& info) const;
+
+    /// Executes a statement into an existing resultset (collection, sync with exceptions version).
+    template <typename Collection>
+    void execute(const Collection& params, resultset<Stream>& output) const;
+
+    /// The handler signature for prepared_statement::async_execute with an output resultset.
+    using execute_into_signature = void(error_code);
+
+    /**
+     * \brief Executes a statement into an existing resultset (collection, async version).
+     * \details It is **not** necessary to keep the collection of parameters or the
+     * values they may point to alive. output must be kept alive until the operation completes.
+     */
+    template <typename Collection, typename CompletionToken>
+    BOOST_MYSQL_INITFN_RESULT_TYPE(CompletionToken, execute_into_signature)
+    async_execute(const Collection& params, resultset<Stream>& output,
+            CompletionToken&& token, error_info* info=nullptr) const;
 
     /**
      * \brief Executes a statement (iterator, sync with error code version).
      * \details params_first and params_last should point to a valid range, identifying
      * the parameters to be used. They should be forward iterators, at least. The value_type
-     * of these iterators should be convertible to boost::mysql::value.
+     * of these iterators should be convertible to boost::mysql::value, or be
+     * boost::mysql::statement_param to pass decimals.
      */
     template <typename ForwardIterator>
     resultset<Stream> execute(ForwardIterator params_first, ForwardIterator params_last,
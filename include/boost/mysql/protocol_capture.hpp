@@ -0,0 +1,146 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_PROTOCOL_CAPTURE_HPP
+#define BOOST_MYSQL_PROTOCOL_CAPTURE_HPP
+
+#include "boost/mysql/error.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+namespace boost {
+namespace mysql {
+
+/**
+ * \ingroup observability
+ * \brief The kinds of records in a protocol capture.
+ */
+enum class capture_record_type : std::uint8_t
+{
+    /// A message sent to the server.
+    client_message = 0,
+
+    /// A message received from the server.
+    server_message = 1,
+
+    /**
+     * \brief The handshake has completed successfully.
+     * \details The payload holds the negotiated capabilities (4 bytes) and the
+     * connection collation (2 bytes), little-endian. Records after this one
+     * can be replayed without performing a handshake.
+     */
+    handshake_complete = 2
+};
+
+/**
+ * \ingroup observability
+ * \brief A record in a protocol capture (see capture_writer).
+ * \details Records hold whole protocol messages. Messages longer than 16MB
+ * are sent as several packets, with consecutive sequence numbers.
+ */
+struct capture_record
+{
+    /// The kind of record.
+    capture_record_type type {capture_record_type::client_message};
+
+    /// The sequence number of the first packet in the message.
+    std::uint8_t sequence_number {0};
+
+    /// When the message was written or read, relative to the creation of the capture_writer.
+    std::chrono::nanoseconds timestamp {0};
+
+    /// The message payload, without packet headers.
+    std::vector<std::uint8_t> payload;
+};
+
+/**
+ * \ingroup observability
+ * \brief Writes the messages exchanged by a connection to a compact binary capture.
+ * \details Pass a pointer to this object to connection::set_capture, and every
+ * message successfully written or read by the connection will be appended to the
+ * output stream, as seen by the protocol layer (i.e. before encryption for TLS
+ * connections). Replaying a capture allows reproducing the traffic of a real
+ * deployment (e.g. wide rows, huge BLOBs or many tiny queries) without access
+ * to the server that produced it.
+ *
+ * The format consists of a header, the 8 bytes `BMYSQLCP` followed by a
+ * 4 byte version number (currently 1), and a sequence of records. Each record is
+ * the record type (1 byte), the sequence number (1 byte), the timestamp in
+ * nanoseconds (8 bytes), the payload size (4 bytes) and the payload. Integers
+ * are little-endian. Use capture_reader to read the records back.
+ *
+ * Captures contain all data exchanged with the server after the handshake,
+ * including any sensitive data it may return. Messages sent by the client during
+ * the handshake are recorded with an empty payload, as they contain authentication
+ * data: caching_sha2_password sends the password in clear text when it performs
+ * full authentication. Messages sent by the server during the handshake are
+ * recorded in full. Treat captures accordingly.
+ *
+ * Writing to the output stream is synchronous, so use a buffered stream, like
+ * std::ofstream. A capture_writer may only be used by a single connection.
+ * Stream errors are not reported to the connection: check the output stream state.
+ */
+class capture_writer
+{
+    std::ostream& output_;
+    std::chrono::steady_clock::time_point start_;
+public:
+    /// Writes the capture header to output, and takes note of the current time.
+    explicit capture_writer(std::ostream& output);
+
+    /// Retrieves the output stream.
+    std::ostream& output() noexcept { return output_; }
+
+    /// Writes a record, composed of the given bytes.
+    template <typename ConstBufferSequence>
+    void write(
+        capture_record_type type,
+        std::uint8_t sequence_number,
+        const ConstBufferSequence& payload
+    );
+
+    /// Writes a record.
+    void write(const capture_record& record);
+};
+
+/**
+ * \ingroup observability
+ * \brief Reads records from a capture created with capture_writer.
+ */
+class capture_reader
+{
+    std::istream& input_;
+    bool header_read_ {false};
+public:
+    /// Constructor. The header is read together with the first record.
+    explicit capture_reader(std::istream& input) noexcept: input_(input) {}
+
+    /**
+     * \brief Reads the next record into output.
+     * \details Returns false, with an empty err, if there are no more records.
+     * If the input has an invalid header or contains an invalid or truncated
+     * record, returns false and sets err.
+     */
+    bool read(capture_record& output, error_code& err);
+
+    /// Reads the next record into output (throwing version).
+    bool read(capture_record& output);
+
+    /// Reads all the remaining records.
+    std::vector<capture_record> read_all();
+};
+
+} // mysql
+} // boost
+
+#include "boost/mysql/impl/protocol_capture.hpp"
+
+#endif
@@ -0,0 +1,267 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_REPLICA_ROUTER_HPP
+#define BOOST_MYSQL_REPLICA_ROUTER_HPP
+
+#include "boost/mysql/connection_pool.hpp"
+#include "boost/mysql/detail/auxiliar/gtid_tracker.hpp"
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace boost {
+namespace mysql {
+
+/**
+ * \ingroup connection
+ * \brief How a replica_router distributes reads among replicas.
+ */
+enum class balancing_strategy
+{
+    round_robin,      ///< Each read goes to the next available replica.
+    least_outstanding ///< Each read goes to the available replica with fewest connections in use.
+};
+
+/**
+ * \ingroup connection
+ * \brief Whether a connection acquired from a replica_router will be used for reads or writes.
+ */
+enum class access_mode
+{
+    read, ///< Read-only work, which may be served by a replica.
+    write ///< Writes or transactions, which are served by the primary.
+};
+
+/**
+ * \ingroup connection
+ * \brief Configuration for a replica_router.
+ */
+struct router_options
+{
+    /// Options for each of the connection pools (one per server).
+    pool_options pool;
+
+    /// How reads are distributed among replicas.
+    balancing_strategy balancing {balancing_strategy::round_robin};
+
+    /**
+     * \brief Replicas lagging behind more than this are not sent reads.
+     * \details Lag is measured by replica_router::check_replicas.
+     */
+    std::chrono::seconds max_replica_lag {30};
+
+    /**
+     * \brief Whether reads should observe the writes previously made through the router.
+     * \details See replica_router for details and server requirements.
+     */
+    bool read_your_writes {false};
+
+    /// How long a replica read waits for the replica to catch up before falling back to the primary.
+    std::chrono::seconds gtid_wait_timeout {1};
+
+    /// Decides whether a query is a read, which may be sent to a replica.
+    std::function<bool(std::string_view)> is_read {&is_read_only_query};
+};
+
+/**
+ * \ingroup connection
+ * \brief Splits reads and writes across a primary server and its replicas.
+ * \details Holds a connection_pool per server. Queries classified as reads by
+ * router_options::is_read are sent to a replica, chosen according to
+ * router_options::balancing. Anything else goes to the primary. If there
+ * are no available replicas, reads go to the primary, too.
+ *
+ * Statements that must run together on the primary, like the ones in a transaction,
+ * should use a connection obtained with acquire(access_mode::write). Writes
+ * made this way should be reported with track_writes if read_your_writes is enabled.
+ *
+ * Replicas are considered available until check_replicas reports otherwise, or
+ * a read fails with a connection error (see is_connection_error). In the latter case,
+ * the read is retried on another server. A full replica pool (boost::asio::error::would_block)
+ * or a cancelled operation is not a connection error: it is reported, and the replica
+ * stays available. check_replicas runs `SHOW REPLICA STATUS`
+ * (or `SHOW SLAVE STATUS`, for older servers) on every replica, and marks as unavailable
+ * the ones that are not replicating or lag more than router_options::max_replica_lag.
+ * It should be called periodically, e.g. from a timer. The router user needs the
+ * REPLICATION CLIENT privilege for it.
+ *
+ * When router_options::read_your_writes is enabled, the router records the GTIDs
+ * of the transactions it writes to the primary, and replica reads first wait
+ * (using `WAIT_FOR_EXECUTED_GTID_SET`) for the replica to apply them. If the wait
+ * times out, the read is served by the primary. This requires GTID-based replication,
+ * and the primary to report GTIDs to clients (session_track_gtids = OWN_GTID).
+ * Statements that commit no transaction, like `SET time_zone = ...`, report no GTIDs.
+ * Once a write has reported GTIDs, writes without them are assumed to have committed
+ * nothing. Before that, the router can't tell them from writes to a server that
+ * doesn't report GTIDs, so reads go to the primary until a write reports GTIDs.
+ * With such a server, all reads after the first write go to the primary.
+ *
+ * Like connection_pool, the router is not thread-safe.
+ */
+template <
+    typename Stream ///< The underlying socket type, e.g. boost::asio::ip::tcp::socket.
+>
+class replica_router
+{
+public:
+    /// The endpoint type associated to this router.
+    using endpoint_type = typename Stream::endpoint_type;
+
+    /// The executor type associated to this router.
+    using executor_type = typename Stream::executor_type;
+private:
+    struct server
+    {
+        connection_pool<Stream> pool;
+        bool available {true};
+        std::optional<std::chrono::seconds> lag;
+        bool legacy_status_syntax {false}; // use SHOW SLAVE STATUS
+
+        server(const executor_type& ex, const endpoint_type& ep,
+               const connection_params& params, const pool_options& opts) :
+            pool(ex, ep, params, opts) {}
+    };
+
+    struct acquire_op;
+    struct query_op;
+    struct check_op;
+
+    executor_type executor_;
+    router_options opts_;
+    std::vector<std::unique_ptr<server>> servers_; // servers_[0] is the primary
+    std::size_t next_replica_ {0};
+    detail::gtid_tracker written_gtids_;
+    bool untracked_writes_ {false};
+
+    std::size_t pick_server(access_mode mode);
+    std::string wait_query(std::size_t server_index) const;
+    static bool caught_up(const std::vector<owning_row>& rows) noexcept;
+    static bool is_server_failure(const error_code& err) noexcept; // whether err should mark a server down
+    std::size_t server_index(const pooled_connection<Stream>& conn) const noexcept;
+    std::string_view status_query(std::size_t server_index) const noexcept;
+    void mark_down(std::size_t server_index) noexcept { servers_[server_index]->available = false; }
+    void update_status(std::size_t server_index, const resultset<Stream>& result,
+            const std::vector<owning_row>& rows);
+public:
+    /**
+     * \brief Constructor.
+     * \details No connection is opened until needed. Endpoints and params are copied.
+     * All servers use the same credentials.
+     */
+    replica_router(const executor_type& ex, const endpoint_type& primary,
+            const std::vector<endpoint_type>& replicas,
+            const connection_params& params, router_options opts = {});
+
+    replica_router(const replica_router&) = delete;
+    replica_router& operator=(const replica_router&) = delete;
+
+    /// Retrieves the executor associated to this router.
+    executor_type get_executor() const { return executor_; }
+
+    /// The pool of connections to the primary.
+    connection_pool<Stream>& primary() noexcept { return servers_[0]->pool; }
+
+    /// The number of replicas.
+    std::size_t num_replicas() const noexcept { return servers_.size() - 1; }
+
+    /// The pool of connections to the i-th replica.
+    connection_pool<Stream>& replica(std::size_t i) noexcept { return servers_.at(i + 1)->pool; }
+
+    /// Whether the i-th replica is being sent reads.
+    bool replica_available(std::size_t i) const { return servers_.at(i + 1)->available; }
+
+    /// The lag of the i-th replica, as reported by the last check_replicas, if known.
+    std::optional<std::chrono::seconds> replica_lag(std::size_t i) const { return servers_.at(i + 1)->lag; }
+
+    /**
+     * \brief The GTID set that replica reads wait for, as a string.
+     * \details Empty unless router_options::read_your_writes is enabled
+     * and GTIDs have been reported for writes.
+     */
+    std::string written_gtids() const { return written_gtids_.to_string(); }
+
+    /**
+     * \brief Records the GTIDs reported to a connection, for read-your-writes.
+     * \details Call this after writing through a connection obtained
+     * with acquire(access_mode::write). Does nothing if
+     * router_options::read_your_writes is disabled. Writes made
+     * through query() are recorded automatically.
+     */
+    void track_writes(const resilient_connection<Stream>& conn);
+
+    /**
+     * \brief Acquires a connection to the primary or to a replica (sync with error code version).
+     * \details For access_mode::read, the connection points to a replica if one is
+     * available and has applied the writes made through the router (if read_your_writes
+     * is enabled), and to the primary otherwise. As connection_pool::acquire, fails
+     * with boost::asio::error::would_block if the chosen pool is full.
+     */
+    pooled_connection<Stream> acquire(access_mode mode, error_code& err, error_info& info);
+
+    /// Acquires a connection to the primary or to a replica (sync with exceptions version).
+    pooled_connection<Stream> acquire(access_mode mode);
+
+    /// Handler signature for acquire.
+    using acquire_signature = void(error_code, pooled_connection<Stream>);
+
+    /// Acquires a connection to the primary or to a replica (async version).
+    template <typename CompletionToken>
+    BOOST_MYSQL_INITFN_RESULT_TYPE(CompletionToken, acquire_signature)
+    async_acquire(access_mode mode, CompletionToken&& token, error_info* info=nullptr);
+
+    /**
+     * \brief Runs a query on the primary or on a replica and reads all the rows (sync with error code version).
+     * \details Reads (as classified by router_options::is_read) go to a replica,
+     * and anything else to the primary. A read failing with a connection error
+     * marks its replica as unavailable and is retried on another server.
+     */
+    std::vector<owning_row> query(std::string_view query_string, error_code&, error_info&);
+
+    /// Runs a query on the primary or on a replica and reads all the rows (sync with exceptions version).
+    std::vector<owning_row> query(std::string_view query_string);
+
+    /// Handler signature for query.
+    using query_signature = void(error_code, std::vector<owning_row>);
+
+    /// Runs a query on the primary or on a replica and reads all the rows (async version).
+    template <typename CompletionToken>
+    BOOST_MYSQL_INITFN_RESULT_TYPE(CompletionToken, query_signature)
+    async_query(std::string_view query_string, CompletionToken&& token, error_info* info=nullptr);
+
+    /**
+     * \brief Queries the replication status of every replica (sync with error code version).
+     * \details Updates replica_lag and replica_available for every replica. Replicas
+     * that can't be checked are marked as unavailable, and the first error found is returned.
+     */
+    void check_replicas(error_code&, error_info&);
+
+    /// Queries the replication status of every replica (sync with exceptions version).
+    void check_replicas();
+
+    /// Handler signature for check_replicas.
+    using check_replicas_signature = void(error_code);
+
+    /// Queries the replication status of every replica (async version).
+    template <typename CompletionToken>
+    BOOST_MYSQL_INITFN_RESULT_TYPE(CompletionToken, check_replicas_signature)
+    async_check_replicas(CompletionToken&& token, error_info* info=nullptr);
+};
+
+/// A replica_router over TCP.
+using tcp_replica_router = replica_router<boost::asio::ip::tcp::socket>;
+
+} // mysql
+} // boost
+
+#include "boost/mysql/impl/replica_router.hpp"
+
+#endif
@@ -0,0 +1,345 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_RESILIENT_CONNECTION_HPP
+#define BOOST_MYSQL_RESILIENT_CONNECTION_HPP
+
+#include "boost/mysql/connection.hpp"
+#include "boost/mysql/detail/config.hpp"
+#include "boost/mysql/detail/auxiliar/owned_connection_params.hpp"
+#include "boost/mysql/detail/auxiliar/async_result_macro.hpp"
+#include <boost/asio/steady_timer.hpp>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace boost {
+namespace mysql {
+
+/**
+ * \ingroup connection
+ * \brief Returns whether a SQL text query is read-only, and can thus be safely retried.
+ * \details Looks at the first keyword of the query, skipping whitespace, comments
+ * and opening parentheses. Queries starting with SELECT, SHOW, DESCRIBE, DESC or
+ * EXPLAIN are considered read-only, unless an executable comment precedes the keyword.
+ * This is a heuristic: a SELECT calling a stored function may still modify data.
+ * This is the default value of retry_policy::is_idempotent.
+ */
+BOOST_MYSQL_DECL bool is_read_only_query(std::string_view sql) noexcept;
+
+/**
+ * \ingroup connection
+ * \brief Returns whether an error means that the connection to the server was lost.
+ * \details True for network and TLS errors, errors the server sends before closing
+ * the connection (e.g. errc::server_shutdown or errc::session_was_killed),
+ * errors meaning the server didn't accept the connection (e.g. errc::con_count_error),
+ * and client errors caused by malformed messages, after which the connection
+ * can't be used anymore.
+ */
+BOOST_MYSQL_DECL bool is_connection_error(const error_code& err) noexcept;
+
+/**
+ * \ingroup connection
+ * \brief Controls how a resilient_connection reconnects and retries operations.
+ * \details After a failed connection attempt, resilient_connection waits
+ * `min(initial_backoff * backoff_multiplier^(n-1), max_backoff)` before the n-th
+ * reconnection attempt. A random fraction of each wait, up to jitter, is
+ * subtracted from it, so that clients disconnected at the same time don't
+ * reconnect in lockstep. The first reconnection after losing an established
+ * connection is immediate.
+ */
+struct retry_policy
+{
+    /// The maximum number of times an operation is retried after failing (zero disables retries).
+    std::size_t max_retries {5};
+
+    /// The wait before the first reconnection retry.
+    std::chrono::milliseconds initial_backoff {100};
+
+    /// The maximum wait between reconnection retries.
+    std::chrono::milliseconds max_backoff {10000};
+
+    /// The factor applied to the wait after each failed reconnection.
+    double backoff_multiplier {2.0};
+
+    /// The maximum fraction of each wait that is randomly subtracted from it, between 0 and 1.
+    double jitter {0.5};
+
+    /**
+     * \brief Decides whether a text query or statement may be retried after the connection is lost.
+     * \details Receives the SQL text of the query or statement. If the connection
+     * is lost after it has been sent, there is no way to know whether the server
+     * executed it, so only operations that can be run twice should be retried.
+     * Defaults to is_read_only_query. Set it to an empty function to never retry.
+     */
+    std::function<bool(std::string_view)> is_idempotent {&is_read_only_query};
+};
+
+namespace detail {
+
+// The wait before the n-th reconnection retry (n >= 1). random should be in [0, 1)
+BOOST_MYSQL_DECL std::chrono::milliseconds compute_backoff(const retry_policy& policy,
+        std::size_t n, double random) noexcept;
+
+} // detail
+
+/**
+ * \ingroup connection
+ * \brief A socket_connection that reconnects and retries operations when the connection is lost.
+ * \details Stores the endpoint and parameters passed to connect(), and uses them to
+ * reconnect, with a jittered exponential backoff (see retry_policy), when an operation
+ * fails with a connection error (see is_connection_error). After reconnecting,
+ * the operation is retried if it is idempotent and no transaction was active
+ * when the connection was lost. Otherwise, the error is reported to the caller,
+ * and the connection is re-established by the next operation. Connection attempts
+ * themselves are always retried, as nothing has been sent to the server yet.
+ *
+ * Prepared statements are identified by their SQL text, and are prepared again,
+ * the first time they are executed, after each reconnection. An execution that
+ * fails with errc::unknown_stmt_handler also re-prepares the statement and tries again.
+ *
+ * Queries and statements return all their rows at once. The resultset holding the
+ * rest of the results (e.g. resultset::affected_rows()) is available as last_result().
+ *
+ * Session state (variables, temporary tables, transactions, user locks...)
+ * is lost on reconnection. The underlying connection can be accessed using
+ * connection(), for example to query its stats(). Operations issued directly
+ * on it are not retried.
+ *
+ * connect() must be called before any other operation. Only one operation
+ * may be outstanding at a time. Objects of this type can't be copied or moved.
+ */
+template <
+    typename Stream ///< The underlying socket type, e.g. boost::asio::ip::tcp::socket.
+>
+class resilient_connection
+{
+public:
+    /// The endpoint type associated to this connection.
+    using endpoint_type = typename Stream::endpoint_type;
+
+    /// Identifies a statement prepared by resilient_connection::prepare_statement.
+    class statement_handle
+    {
+        std::size_t index_ {static_cast<std::size_t>(-1)};
+        explicit statement_handle(std::size_t index) noexcept: index_(index) {}
+        friend class resilient_connection;
+    public:
+        /// Constructs an invalid handle.
+        statement_handle() = default;
+
+        /// Returns true if the handle was returned by prepare_statement.
+        bool valid() const noexcept { return index_ != static_cast<std::size_t>(-1); }
+    };
+private:
+    // Allows closing the channel before reconnecting
+    class connection_impl : public socket_connection<Stream>
+    {
+    public:
+        using socket_connection<Stream>::socket_connection;
+        void reset_channel() { this->get_channel().close(); }
+    };
+
+    struct statement_entry
+    {
+        std::string sql;
+        bool idempotent;
+        prepared_statement<Stream> stmt;
+        std::uint64_t generation {0}; // the value of generation_ when stmt was prepared
+    };
+
+    template <typename Attempt> struct retry_op;
+    struct connect_attempt;
+    struct query_attempt;
+    template <bool Execute> struct statement_attempt;
+    struct query_op;
+    struct statement_op;
+
+    connection_impl conn_;
+    endpoint_type endpoint_ {};
+    detail::owned_connection_params params_;
+    retry_policy policy_;
+    boost::asio::steady_timer timer_;
+    std::minstd_rand rng_;
+    bool connected_ {false};
+    std::uint64_t generation_ {0}; // incremented on each successful connection
+    std::size_t num_reconnects_ {0};
+    std::vector<statement_entry> statements_;
+    resultset<Stream> last_result_;
+
+    void set_connect_params(const endpoint_type& endpoint, const connection_params& params);
+    void on_connected() noexcept { connected_ = true; ++generation_; }
+    void disconnect();
+    bool is_prepared(std::size_t index) const noexcept;
+    std::size_t find_or_add_statement(std::string_view sql);
+    void prepare_entry(std::size_t index, error_code& err, error_info& info);
+    bool on_failure(const error_code& err, bool request_sent, bool idempotent,
+            bool in_transaction, std::size_t& num_failures);
+    std::chrono::milliseconds next_backoff(std::size_t num_connect_failures);
+    template <typename Attempt>
+    void run_with_retries(Attempt& attempt, error_code& err, error_info& info);
+public:
+    /**
+     * \brief Initializing constructor.
+     * \details Creates the underlying socket_connection by forwarding any passed in arguments to its constructor.
+     */
+    template <typename... Args>
+    explicit resilient_connection(Args&&... args);
+
+    resilient_connection(const resilient_connection&) = delete;
+    resilient_connection& operator=(const resilient_connection&) = delete;
+
+    /// Retrieves the underlying connection.
+    socket_connection<Stream>& connection() noexcept { return conn_; }
+
+    /// Retrieves the underlying connection.
+    const socket_connection<Stream>& connection() const noexcept { return conn_; }
+
+    /// Retrieves the retry policy.
+    const retry_policy& get_retry_policy() const noexcept { return policy_; }
+
+    /// Sets the retry policy. Statements already prepared keep their idempotency.
+    void set_retry_policy(retry_policy value) { policy_ = std::move(value); }
+
+    /// Returns true if the connection is established, as far as the last operation knows.
+    bool is_connected() const noexcept { return connected_; }
+
+    /// The number of times the connection has been re-established after being lost.
+    std::size_t num_reconnects() const noexcept { return num_reconnects_; }
+
+    /**
+     * \brief The resultset of the last query or statement execution.
+     * \details After a successful query or execution, it is complete(), and can be used
+     * to retrieve affected_rows(), last_insert_id(), warning_count(), info() and fields().
+     */
+    const resultset<Stream>& last_result() const noexcept { return last_result_; }
+
+    /**
+     * \brief Connects to the MySQL server (sync with error code version).
+     * \details Copies endpoint and params, which will be used to reconnect,
+     * closes the current connection, if any, and connects, retrying on failure
+     * as specified by the retry policy.
+     */
+    void connect(const endpoint_type& endpoint, const connection_params& params,
+            error_code& err, error_info& info);
+
+    /// Connects to the MySQL server (sync with exceptions version).
+    void connect(const endpoint_type& endpoint, const connection_params& params);
+
+    /// Handler signature for resilient_connection::async_connect.
+    using connect_signature = void(error_code);
+
+    /// Connects to the MySQL server (async version). endpoint and params are copied.
+    template <typename CompletionToken>
+    BOOST_MYSQL_INITFN_RESULT_TYPE(CompletionToken, connect_signature)
+    async_connect(const endpoint_type& endpoint, const connection_params& params,
+            CompletionToken&& token, error_info* info=nullptr);
+
+    /**
+     * \brief Runs a text query and reads all of its rows (sync with error code version).
+     * \details Retried if retry_policy::is_idempotent returns true for query_string.
+     */
+    std::vector<owning_row> query(std::string_view query_string, error_code&, error_info&);
+
+    /// Runs a text query and reads all of its rows (sync with exceptions version).
+    std::vector<owning_row> query(std::string_view query_string);
+
+    /// Handler signature for resilient_connection::async_query.
+    using query_signature = void(error_code, std::vector<owning_row>);
+
+    /**
+     * \brief Runs a text query and reads all of its rows (async version).
+     * \details query_string should be kept alive until the operation completes.
+     */
+    template <typename CompletionToken>
+    BOOST_MYSQL_INITFN_RESULT_TYPE(CompletionToken, query_signature)
+    async_query(std::string_view query_string, CompletionToken&& token, error_info* info=nullptr);
+
+    /**
+     * \brief Prepares a statement, and remembers it by its SQL text (sync with error code version).
+     * \details Preparing the same SQL text twice returns the same handle. Preparing
+     * is always retried. Whether executions are retried is decided by
+     * retry_policy::is_idempotent, with the statement's SQL text. The statement
+     * is kept until the resilient_connection is destroyed.
+     */
+    statement_handle prepare_statement(std::string_view statement, error_code&, error_info&);
+
+    /// Prepares a statement, and remembers it by its SQL text (sync with exceptions version).
+    statement_handle prepare_statement(std::string_view statement);
+
+    /// Handler signature for resilient_connection::async_prepare_statement.
+    using prepare_statement_signature = void(error_code, statement_handle);
+
+    /// Prepares a statement, and remembers it by its SQL text (async version).
+    template <typename CompletionToken>
+    BOOST_MYSQL_INITFN_RESULT_TYPE(CompletionToken, prepare_statement_signature)
+    async_prepare_statement(std::string_view statement, CompletionToken&& token, error_info* info=nullptr);
+
+    /**
+     * \brief Executes a prepared statement and reads all of its rows (sync with error code version).
+     * \details stmt must be valid and have been returned by this object. params is a
+     * collection of boost::mysql::value, as for prepared_statement::execute. The statement
+     * is prepared again first if the connection has been re-established since it was last prepared.
+     */
+    template <typename Collection>
+    std::vector<owning_row> execute(statement_handle stmt, const Collection& params,
+            error_code&, error_info&);
+
+    /// Executes a prepared statement and reads all of its rows (sync with exceptions version).
+    template <typename Collection>
+    std::vector<owning_row> execute(statement_handle stmt, const Collection& params);
+
+    /// Handler signature for resilient_connection::async_execute.
+    using execute_signature = void(error_code, std::vector<owning_row>);
+
+    /**
+     * \brief Executes a prepared statement and reads all of its rows (async version).
+     * \details params are copied. Any strings they point to should be kept
+     * alive until the operation completes.
+     */
+    template <typename Collection, typename CompletionToken>
+    BOOST_MYSQL_INITFN_RESULT_TYPE(CompletionToken, execute_signature)
+    async_execute(statement_handle stmt, const Collection& params,
+            CompletionToken&& token, error_info* info=nullptr);
+
+    /**
+     * \brief Closes the connection (sync with error code version).
+     * \details Not retried. The next operation reconnects, if issued.
+     */
+    void close(error_code&, error_info&);
+
+    /// Closes the connection (sync with exceptions version).
+    void close();
+
+    /// Handler signature for resilient_connection::async_close.
+    using close_signature = void(error_code);
+
+    /// Closes the connection (async version).
+    template <typename CompletionToken>
+    BOOST_MYSQL_INITFN_RESULT_TYPE(CompletionToken, close_signature)
+    async_close(CompletionToken&& token, error_info* info=nullptr);
+};
+
+/**
+ * \ingroup connection
+ * \brief A resilient_connection over a TCP socket.
+ */
+using resilient_tcp_connection = resilient_connection<boost::asio::ip::tcp::socket>;
+
+} // mysql
+} // boost
+
+#include "boost/mysql/impl/resilient_connection.hpp"
+#ifdef BOOST_MYSQL_HEADER_ONLY
+#include "boost/mysql/impl/resilient_connection.ipp"
+#endif
+
+#endif
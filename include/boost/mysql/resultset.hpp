@@ -18,6 +18,7 @@
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/local/stream_protocol.hpp>
 #include <cassert>
+#include <stdexcept>
 
 /**
  * \defgroup resultsets Resultsets
@@ -44,6 +45,9 @@ namespace mysql {
  *
  * You can test whether a resultset is complete or not by calling
  * resultset::complete().
+ * A resultset must be complete before issuing any other operation on the
+ * connection. If you are not interested in the remaining rows, use
+ * resultset::discard_remaining, which is much cheaper than fetch_all.
  *
  * Resultsets also contain metadata about the fields in the query.
  * You can access them at any point using resultset::fields().
@@ -72,13 +76,19 @@ class resultset
     channel_type* channel_;
     detail::resultset_metadata meta_;
     row current_row_;
-    detail::bytestring buffer_;
+    detail::resource_bytestring buffer_;
     detail::ok_packet ok_packet_;
     bool eof_received_ {false};
 
+    void reset_current_row()
+    {
+        current_row_.values().clear();
+    }
+
     struct fetch_one_op;
     struct fetch_many_op;
     struct fetch_many_op_impl;
+    struct discard_remaining_op;
 
   public:
     using executor_type = typename channel_type::executor_type;
@@ -87,10 +97,60 @@ class resultset
 
     // Private, do not use
     resultset(channel_type& channel, detail::resultset_metadata&& meta, detail::deserialize_row_fn deserializer):
-        deserializer_(deserializer), channel_(&channel), meta_(std::move(meta)) {};
-    resultset(channel_type& channel, detail::bytestring&& buffer, const detail::ok_packet& ok_pack):
+        deserializer_(deserializer),
+        channel_(&channel),
+        meta_(std::move(meta)),
+        buffer_(channel.memory_resource()) {};
+    resultset(channel_type& channel, detail::resource_bytestring&& buffer, const detail::ok_packet& ok_pack):
         channel_(&channel), buffer_(std::move(buffer)), ok_packet_(ok_pack), eof_received_(true) {};
 
+    // Private, do not use. Gives away the memory owned by *this, so it can be
+    // reused by an operation that will later call assign(). Leaves *this invalid.
+    // Invalid resultsets own no memory worth reusing, so buffers are left untouched
+    void release_buffers(detail::resource_bytestring& buffer, detail::resource_bytestring& field_definitions) noexcept
+    {
+        if (!valid())
+            return;
+        buffer = std::move(buffer_);
+        buffer.clear();
+        field_definitions = meta_.release_buffer();
+        field_definitions.clear();
+        channel_ = nullptr;
+    }
+
+    // Private, do not use. Same as the constructors, but reusing the memory owned by *this
+    void assign(
+        channel_type& channel,
+        detail::resource_bytestring&& buffer,
+        detail::resource_bytestring&& field_definitions,
+        std::size_t num_fields,
+        detail::deserialize_row_fn deserializer
+    )
+    {
+        deserializer_ = deserializer;
+        channel_ = &channel;
+        meta_.assign(std::move(field_definitions), num_fields);
+        reset_current_row();
+        buffer_ = std::move(buffer);
+        ok_packet_ = detail::ok_packet();
+        eof_received_ = false;
+    }
+    void assign(
+        channel_type& channel,
+        detail::resource_bytestring&& buffer,
+        detail::resource_bytestring&& field_definitions,
+        const detail::ok_packet& ok_pack
+    )
+    {
+        deserializer_ = nullptr;
+        channel_ = &channel;
+        meta_.assign(std::move(field_definitions), 0);
+        reset_current_row();
+        buffer_ = std::move(buffer);
+        ok_packet_ = ok_pack;
+        eof_received_ = true;
+    }
+
     executor_type get_executor() {assert(channel_);return channel_->get_executor();}
 
     /// Retrieves the stream object associated with the underlying connection.
@@ -142,6 +202,22 @@ class resultset
     /// Fetches all available rows (sync with exceptions version).
     std::vector<owning_row> fetch_all();
 
+    /**
+     * \brief Reads and discards all remaining rows (sync with error code version).
+     * \details Use this function when you are not interested in the rest of the rows,
+     * but need the resultset to be complete() to issue further operations on
+     * the connection. Rows are read into a single buffer, owned by the resultset,
+     * and are not deserialized, so no memory is allocated once the buffer
+     * is big enough to hold a row. This is much faster than fetch_all.
+     *
+     * The resultset is guaranteed to be complete() after this call returns successfully.
+     * As with the other fetch methods, this invalidates the row returned by fetch_one.
+     */
+    void discard_remaining(error_code& err, error_info& info);
+
+    /// Reads and discards all remaining rows (sync with exceptions version).
+    void discard_remaining();
+
     /// Handler signature for resultset::async_fetch_one.
     using fetch_one_signature = void(error_code, const row*);
 
@@ -166,6 +242,14 @@ class resultset
     BOOST_MYSQL_INITFN_RESULT_TYPE(CompletionToken, fetch_all_signature)
     async_fetch_all(CompletionToken&& token, error_info* info=nullptr);
 
+    /// Handler signature for resultset::async_discard_remaining.
+    using discard_remaining_signature = void(error_code);
+
+    /// Reads and discards all remaining rows (async version).
+    template <typename CompletionToken>
+    BOOST_MYSQL_INITFN_RESULT_TYPE(CompletionToken, discard_remaining_signature)
+    async_discard_remaining(CompletionToken&& token, error_info* info=nullptr);
+
     /**
      * \brief Returns whether this object represents a valid resultset.
      * \details Returns false for default-constructed resultsets. It is
@@ -186,6 +270,33 @@ class resultset
      */
     const std::vector<field_metadata>& fields() const noexcept { return meta_.fields(); }
 
+    /**
+     * \brief Returns the position of the field called key.name() in fields(), or field_name_index::npos.
+     * \details Uses a field_name_index built when the metadata was read, so it runs
+     * in constant time. Look the position up once and use it to index
+     * row::values() for every row read from this resultset.
+     */
+    std::size_t field_index(const field_name_key& key) const noexcept { return meta_.name_index().find(key); }
+
+    /// Returns the position of the field called name in fields(). See field_index(const field_name_key&).
+    std::size_t field_index(std::string_view name) const noexcept { return field_index(field_name_key(name)); }
+
+    /**
+     * \brief Returns the value for the field called key.name() in r.
+     * \details r must have been read from this resultset, since its last query.
+     * Throws std::out_of_range if there is no such field.
+     */
+    const value& at(const row& r, const field_name_key& key) const
+    {
+        std::size_t res = field_index(key);
+        if (res == field_name_index::npos)
+            throw std::out_of_range("resultset::at: no field with the given name");
+        return r.values().at(res);
+    }
+
+    /// Returns the value for the field called name in r. See at(const row&, const field_name_key&).
+    const value& at(const row& r, std::string_view name) const { return at(r, field_name_key(name)); }
+
     /**
      * \brief The number of rows affected by the SQL that generated this resultset.
      * \warning The resultset **must be complete** before calling this function.
@@ -29,6 +29,9 @@ namespace mysql {
  * as actual type), it will point to an externally owned piece of memory.
  * Thus, the row base class is not owning; this is contrary to owning_row,
  * that actually owns the string memory of its values.
+ *
+ * To look values up by field name, use resultset::field_index or
+ * resultset::at, which use the field_name_index built by the resultset.
  */
 class row
 {
@@ -52,10 +55,11 @@ public:
  */
 class owning_row : public row
 {
-    detail::bytestring buffer_;
+    detail::resource_bytestring buffer_;
+    friend class compact_row;
 public:
     owning_row() = default;
-    owning_row(std::vector<value>&& values, detail::bytestring&& buffer) :
+    owning_row(std::vector<value>&& values, detail::resource_bytestring&& buffer) :
             row(std::move(values)), buffer_(std::move(buffer)) {};
     owning_row(const owning_row&) = delete;
     owning_row(owning_row&&) = default;
@@ -0,0 +1,93 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_ROW_BATCH_READER_HPP
+#define BOOST_MYSQL_ROW_BATCH_READER_HPP
+
+#include "boost/mysql/resultset.hpp"
+#include "boost/mysql/detail/auxiliar/async_result_macro.hpp"
+#include <boost/asio/steady_timer.hpp>
+#include <memory>
+#include <vector>
+
+namespace boost {
+namespace mysql {
+
+/**
+ * \ingroup resultsets
+ * \brief Reads the rows in a resultset in batches, fetching the next batch in the background.
+ * \details Each call to async_read_batch returns the next batch of at most
+ * batch_size() rows. Before completing, it starts fetching the following batch,
+ * so reading from the network overlaps with the processing of the current batch.
+ * This hides the network latency when rows are processed at a similar pace
+ * as they arrive. Once all rows have been returned, async_read_batch returns an
+ * empty batch.
+ *
+ * async_read_batch plays well with coroutines:
+ * \code
+ * row_batch_reader<boost::asio::ip::tcp::socket> reader (result, 1000); // result is a tcp_resultset
+ * for (auto batch = co_await reader.async_read_batch(use_awaitable); !batch.empty();
+ *      batch = co_await reader.async_read_batch(use_awaitable))
+ * {
+ *     process(batch);
+ * }
+ * \endcode
+ *
+ * At most two batches are in memory at a given time: the one being processed and
+ * the one being fetched. As the background fetch uses the connection, no other
+ * operation may be issued on it until the resultset is complete() and the last
+ * batch has been returned. The resultset must outlive the reader and any background
+ * fetch. The reader is not thread-safe: all operations must run in the
+ * resultset's executor (or in a strand).
+ */
+template <typename StreamType>
+class row_batch_reader
+{
+    struct state;
+    struct read_batch_op;
+
+    std::shared_ptr<state> state_;
+public:
+    /**
+     * \brief Constructs a reader returning batches of at most batch_size rows from result.
+     * \details result must be valid(). No rows are fetched until async_read_batch is called.
+     */
+    row_batch_reader(resultset<StreamType>& result, std::size_t batch_size);
+
+    /// The maximum number of rows in a batch.
+    std::size_t batch_size() const noexcept;
+
+    /**
+     * \brief Returns whether all rows have been returned.
+     * \details Once true, async_read_batch always returns empty batches.
+     */
+    bool complete() const noexcept;
+
+    /// Handler signature for row_batch_reader::async_read_batch.
+    using read_batch_signature = void(error_code, std::vector<owning_row>);
+
+    /**
+     * \brief Reads the next batch of rows (async version).
+     * \details Returns the rows fetched in the background by the previous call, if any,
+     * or fetches them otherwise. The returned batch is empty if all rows have
+     * already been returned. If fetching a batch fails, the error is reported
+     * by this function, and no more batches are fetched in the background.
+     *
+     * The returned rows are valid as long as the resultset is alive, as with
+     * resultset::fetch_many. Only one async_read_batch may be outstanding at a time.
+     */
+    template <typename CompletionToken>
+    BOOST_MYSQL_INITFN_RESULT_TYPE(CompletionToken, read_batch_signature)
+    async_read_batch(CompletionToken&& token, error_info* info=nullptr);
+};
+
+} // mysql
+} // boost
+
+#include "boost/mysql/impl/row_batch_reader.hpp"
+
+#endif
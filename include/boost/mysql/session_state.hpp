@@ -0,0 +1,129 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_SESSION_STATE_HPP
+#define BOOST_MYSQL_SESSION_STATE_HPP
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace boost {
+namespace mysql {
+
+/**
+ * \ingroup connection
+ * \brief The state of a session, as reported by the server (see connection::session).
+ * \details When the server supports it (MySQL 5.7+, MariaDB 10.2+), connections negotiate
+ * session state tracking (the CLIENT_SESSION_TRACK capability) during handshake.
+ * The server then attaches the changes to the session state to the OK packets it
+ * sends, and the connection keeps track of them here, at no extra round trip.
+ * This allows connection pools and proxies to skip statements like `USE db` or
+ * `SET autocommit=1` when the session is already in the desired state.
+ *
+ * What is tracked depends on the server configuration:
+ * - The current schema (session_track_schema, ON by default).
+ * - The system variables listed in session_track_system_variables. By default,
+ *   time_zone, autocommit, character_set_client, character_set_results and
+ *   character_set_connection. Only the variables changed since the handshake are
+ *   reported, so system_variable returns an empty optional for unchanged ones.
+ * - The transaction state (session_track_transaction_info, OFF by default).
+ * - The GTIDs of committed transactions (session_track_gtids, OFF by default).
+ *
+ * These server variables can be changed for the current session with SET statements.
+ * autocommit() and in_transaction() come from the server status flags, and are
+ * available even if session tracking was not negotiated.
+ *
+ * The state is updated as the OK packets are received: for statements returning
+ * rows, once the resultset is complete.
+ */
+class session_state
+{
+    using string_type = std::pmr::string;
+
+    bool tracking_ {false};
+    std::uint16_t status_flags_ {0};
+    string_type schema_;
+    std::pmr::map<string_type, string_type, std::less<>> system_variables_;
+    string_type transaction_state_;
+    string_type transaction_characteristics_;
+    string_type gtids_;
+public:
+    /// Constructs an empty state, allocating memory from resource.
+    explicit session_state(
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) :
+        schema_(resource),
+        system_variables_(resource),
+        transaction_state_(resource),
+        transaction_characteristics_(resource),
+        gtids_(resource)
+    {
+    }
+
+    /// Returns true if the server agreed to send session state changes.
+    bool tracking() const noexcept { return tracking_; }
+
+    /**
+     * \brief The current default schema (database), or an empty string if none.
+     * \details Reflects the database passed to the handshake, and any
+     * subsequent `USE` statement if tracking() is true.
+     */
+    std::string_view schema() const noexcept { return schema_; }
+
+    /**
+     * \brief The value of a tracked system variable, if the server has reported it.
+     * \details Returns an empty optional if the variable has not changed since
+     * the handshake, or it is not tracked. Variable names are lowercase.
+     */
+    std::optional<std::string_view> system_variable(std::string_view name) const;
+
+    /**
+     * \brief The transaction state, as 8 characters (e.g. "T_______"), or an empty string if unknown.
+     * \details Only reported if session_track_transaction_info is enabled. See the MySQL docs
+     * for the meaning of each character.
+     */
+    std::string_view transaction_state() const noexcept { return transaction_state_; }
+
+    /**
+     * \brief SQL that would restore the characteristics of the current transaction,
+     *        or an empty string if unknown or there are none.
+     * \details Only reported if session_track_transaction_info is CHARACTERISTICS.
+     */
+    std::string_view transaction_characteristics() const noexcept { return transaction_characteristics_; }
+
+    /// The last GTIDs reported by the server, or an empty string.
+    std::string_view gtids() const noexcept { return gtids_; }
+
+    /// Returns true if autocommit is enabled, according to the server status flags.
+    bool autocommit() const noexcept;
+
+    /// Returns true if a transaction is active, according to the server status flags.
+    bool in_transaction() const noexcept;
+
+    // Private, do not use. Called on handshake
+    void reset(bool tracking, std::string_view schema, std::uint16_t status_flags);
+
+    // Private, do not use. Status flags, as reported by the last OK packet
+    std::uint16_t status_flags() const noexcept { return status_flags_; }
+    void set_status_flags(std::uint16_t value) noexcept { status_flags_ = value; }
+
+    // Private, do not use. Applies the session state information field of an OK packet.
+    // Returns false if it is malformed; changes before the malformed one are kept
+    bool apply_changes(std::string_view session_state_info);
+};
+
+} // mysql
+} // boost
+
+#include "boost/mysql/impl/session_state.hpp"
+
+#endif
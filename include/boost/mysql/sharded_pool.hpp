@@ -0,0 +1,145 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_SHARDED_POOL_HPP
+#define BOOST_MYSQL_SHARDED_POOL_HPP
+
+#include "boost/mysql/connection_pool.hpp"
+#include "boost/mysql/detail/auxiliar/running_in_this_thread.hpp"
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace boost {
+namespace mysql {
+
+/**
+ * \ingroup connection
+ * \brief A set of connection pools, one per executor, usable from any thread.
+ * \details Designed for a thread-per-core model, where the application runs an
+ * io_context per thread (or core). Each of these executors gets a shard: a
+ * connection_pool whose connections live in that executor, and
+ * are only used from the threads running it. Connections never cross shards.
+ *
+ * async_query can be called from any thread. Queries issued from a thread running
+ * one of the shard executors run in that shard (the local shard). If the local
+ * shard is saturated (it has as many queries in flight as pool_options::max_size),
+ * the query is run in the least loaded shard instead (work stealing).
+ * Queries issued from other threads go to the least loaded shard.
+ *
+ * Loads are tracked with atomic counters, so shards are chosen without
+ * locking. The query then runs in the chosen shard's executor, and the completion
+ * handler is posted back to its associated executor. If it has none, the handler
+ * runs in the executor of the local shard, or the chosen one if there is no local shard.
+ *
+ * Local shards are detected for io_context executors and strands over them
+ * (possibly type-erased in an any_io_executor, or a boost::asio::executor before
+ * Boost 1.74). For other executors, every query is treated as issued from a foreign thread.
+ *
+ * Individual shards can be accessed with shard(), but only
+ * from the threads running the shard executor.
+ * The sharded_pool must outlive any outstanding operation.
+ */
+template <
+    typename Stream ///< The underlying socket type, e.g. boost::asio::ip::tcp::socket.
+>
+class sharded_pool
+{
+public:
+    /// The endpoint type associated to this pool.
+    using endpoint_type = typename Stream::endpoint_type;
+
+    /// The executor type associated to this pool.
+    using executor_type = typename Stream::executor_type;
+
+    /// Returned by local_shard when not called from a shard executor.
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+private:
+    struct shard_data
+    {
+        executor_type executor;
+        connection_pool<Stream> pool;
+        std::atomic<std::size_t> in_flight {0};
+
+        shard_data(const executor_type& ex, const endpoint_type& ep,
+                   const connection_params& params, const pool_options& opts) :
+            executor(ex), pool(ex, ep, params, opts) {}
+    };
+
+    struct query_op;
+
+    std::vector<std::unique_ptr<shard_data>> shards_;
+    std::size_t max_in_flight_;
+    std::atomic<std::size_t> next_shard_ {0};
+    std::atomic<std::size_t> num_stolen_ {0};
+
+    std::size_t least_loaded() noexcept;
+    std::size_t pick_shard(std::size_t local) noexcept;
+public:
+    /**
+     * \brief Constructor.
+     * \details Creates a shard per executor, each one with its own connection_pool
+     * configured by opts. No connection is opened until needed.
+     * executors must not be empty.
+     */
+    sharded_pool(const std::vector<executor_type>& executors, const endpoint_type& endpoint,
+            const connection_params& params, pool_options opts = {});
+
+    sharded_pool(const sharded_pool&) = delete;
+    sharded_pool& operator=(const sharded_pool&) = delete;
+
+    /// The number of shards.
+    std::size_t num_shards() const noexcept { return shards_.size(); }
+
+    /// The executor of the i-th shard.
+    const executor_type& shard_executor(std::size_t i) const { return shards_.at(i)->executor; }
+
+    /**
+     * \brief The connection pool of the i-th shard.
+     * \details Must only be used from a thread running shard_executor(i).
+     */
+    connection_pool<Stream>& shard(std::size_t i) { return shards_.at(i)->pool; }
+
+    /// The number of queries issued to the i-th shard that have not completed yet.
+    std::size_t num_in_flight(std::size_t i) const { return shards_.at(i)->in_flight.load(); }
+
+    /// The number of queries that ran in a shard other than their local one because it was saturated.
+    std::size_t num_stolen() const noexcept { return num_stolen_.load(); }
+
+    /**
+     * \brief The shard whose executor is running in the calling thread, or npos.
+     * \details Can be called from any thread.
+     */
+    std::size_t local_shard() const noexcept;
+
+    /// Handler signature for async_query.
+    using query_signature = void(error_code, std::vector<owning_row>);
+
+    /**
+     * \brief Runs a query in a shard and reads all the rows (async version).
+     * \details Can be called from any thread. See the class description
+     * for how the shard is chosen. There are no sync versions, as
+     * they would block one of the shard threads.
+     * The string pointed to by query_string should be kept alive by the caller
+     * until the operation completes.
+     */
+    template <typename CompletionToken>
+    BOOST_MYSQL_INITFN_RESULT_TYPE(CompletionToken, query_signature)
+    async_query(std::string_view query_string, CompletionToken&& token, error_info* info=nullptr);
+};
+
+/// A sharded_pool over TCP.
+using tcp_sharded_pool = sharded_pool<boost::asio::ip::tcp::socket>;
+
+} // mysql
+} // boost
+
+#include "boost/mysql/impl/sharded_pool.hpp"
+
+#endif
@@ -0,0 +1,107 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_SPAN_OBSERVER_HPP
+#define BOOST_MYSQL_SPAN_OBSERVER_HPP
+
+#include "boost/mysql/connection_observer.hpp"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+namespace boost {
+namespace mysql {
+
+/**
+ * \ingroup observability
+ * \brief A completed command, described as a tracing span.
+ * \details Follows the OpenTelemetry semantic conventions for database
+ * client spans, so it maps directly to an OpenTelemetry span (or to the
+ * equivalent concept in other tracing systems). See span_observer.
+ */
+struct span_record
+{
+    /**
+     * \brief The span name.
+     * \details For queries, the first keyword in the SQL text, as written (e.g. `SELECT`).
+     * For other commands, the command name (`prepare`, `execute`, `close_statement` or `quit`).
+     */
+    std::string_view name;
+
+    /// When the command started.
+    std::chrono::system_clock::time_point start_time;
+
+    /// When the command completed.
+    std::chrono::system_clock::time_point end_time;
+
+    /// The command measurements.
+    const command_stats& stats;
+
+    /// The error the command failed with, if any. The span status should be set to error if non-empty.
+    error_code error;
+
+    /**
+     * \brief Invokes f(key, value) for each span attribute.
+     * \details Keys are std::string_view. Values are either std::string_view or std::int64_t.
+     * Attributes are `db.system`, `db.operation`, `db.statement` (the SQL digest,
+     * only if not empty) and the following non-standard ones: `db.mysql.rows`,
+     * `db.mysql.bytes_read`, `db.mysql.bytes_written`, `db.mysql.network_time_ns`
+     * and `db.mysql.decode_time_ns`.
+     */
+    template <typename Function>
+    void for_each_attribute(Function&& f) const;
+};
+
+/**
+ * \ingroup observability
+ * \brief An observer that reports each command as a span, OpenTelemetry style.
+ * \details The sink function is invoked with a span_record every time a
+ * command completes. Spans are reported once complete, with their start time
+ * computed from the command duration, so this observer holds no per-command
+ * state and may be shared by several connections (as long as the sink is
+ * safe to call concurrently, if connections are used from several threads).
+ *
+ * The span_record and the strings it points to are only valid during the call.
+ * For example, to report spans with the OpenTelemetry C++ API:
+ * \code
+ * span_observer obs ([tracer](const span_record& rec) {
+ *     opentelemetry::trace::StartSpanOptions opts;
+ *     opts.start_system_time = rec.start_time;
+ *     opts.kind = opentelemetry::trace::SpanKind::kClient;
+ *     auto span = tracer->StartSpan(std::string(rec.name), opts);
+ *     rec.for_each_attribute([&](std::string_view key, auto value) {
+ *         span->SetAttribute(key, value);
+ *     });
+ *     if (rec.error)
+ *         span->SetStatus(opentelemetry::trace::StatusCode::kError, rec.error.message());
+ *     span->End(); // the command has just completed
+ * });
+ * conn.set_observer(&obs);
+ * \endcode
+ */
+class span_observer : public connection_observer
+{
+public:
+    /// The type of the function invoked for each span.
+    using sink_type = std::function<void(const span_record&)>;
+
+    /// Constructs an observer reporting spans to sink.
+    explicit span_observer(sink_type sink): sink_(std::move(sink)) {}
+
+    // Private, do not use.
+    void on_command_end(const command_stats& stats, error_code err) override;
+private:
+    sink_type sink_;
+};
+
+} // mysql
+} // boost
+
+#include "boost/mysql/impl/span_observer.hpp"
+
+#endif
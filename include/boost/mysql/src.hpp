@@ -0,0 +1,50 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_SRC_HPP
+#define BOOST_MYSQL_SRC_HPP
+
+// Compiles the library when building with BOOST_MYSQL_SEPARATE_COMPILATION.
+// Include this file in exactly one translation unit of your program
+// (or link to the Boost_mysql_compiled CMake target, which does so).
+
+#ifndef BOOST_MYSQL_SEPARATE_COMPILATION
+#error "boost/mysql/src.hpp requires BOOST_MYSQL_SEPARATE_COMPILATION to be defined"
+#endif
+
+#include "boost/mysql/mysql.hpp"
+
+#include "boost/mysql/detail/auxiliar/impl/gtid_tracker.ipp"
+#include "boost/mysql/detail/auth/impl/auth_calculator.ipp"
+#include "boost/mysql/detail/auth/impl/caching_sha2_password.ipp"
+#include "boost/mysql/detail/auth/impl/mysql_native_password.ipp"
+#include "boost/mysql/detail/protocol/impl/binary_deserialization.ipp"
+#include "boost/mysql/detail/protocol/impl/binary_serialization.ipp"
+#include "boost/mysql/detail/protocol/impl/common_messages.ipp"
+#include "boost/mysql/detail/protocol/impl/handshake_messages.ipp"
+#include "boost/mysql/detail/protocol/impl/serialization.ipp"
+#include "boost/mysql/detail/protocol/impl/text_deserialization.ipp"
+#include "boost/mysql/impl/metadata.ipp"
+#include "boost/mysql/impl/resilient_connection.ipp"
+
+// Explicit instantiations, declared extern in connection.hpp
+#define BOOST_MYSQL_INSTANTIATE_STREAM(Stream) \
+    template class boost::mysql::detail::channel<Stream>; \
+    template class boost::mysql::connection<Stream>; \
+    template class boost::mysql::socket_connection<Stream>; \
+    template class boost::mysql::resultset<Stream>; \
+    template class boost::mysql::prepared_statement<Stream>; \
+    template class boost::mysql::batch_inserter<Stream>;
+
+BOOST_MYSQL_INSTANTIATE_STREAM(boost::asio::ip::tcp::socket)
+#ifdef BOOST_ASIO_HAS_LOCAL_SOCKETS
+BOOST_MYSQL_INSTANTIATE_STREAM(boost::asio::local::stream_protocol::socket)
+#endif
+
+#undef BOOST_MYSQL_INSTANTIATE_STREAM
+
+#endif
@@ -0,0 +1,67 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_SSL_SESSION_CACHE_HPP
+#define BOOST_MYSQL_SSL_SESSION_CACHE_HPP
+
+#include <openssl/ssl.h>
+#include <mutex>
+
+namespace boost {
+namespace mysql {
+
+/**
+ * \ingroup connparams
+ * \brief Stores a TLS session, so it can be resumed by subsequent connections.
+ * \details Resuming a TLS session (using session IDs or session tickets) skips
+ * the certificate exchange and key agreement of a full TLS handshake,
+ * making connection establishment considerably cheaper.
+ *
+ * Use it by setting it in the ssl_options of the connection_params
+ * passed to connection::handshake or connection::connect. Every successful
+ * TLS handshake stores its session in the cache, and every handshake
+ * attempts to resume the stored session, if any. If the server
+ * refuses to resume it, a full handshake is performed.
+ *
+ * A cache holds a single session, and should only be used for connections
+ * to the same server. It is safe to use a cache from several threads
+ * concurrently. The cache must be kept alive until the handshake operations
+ * that use it complete.
+ */
+class ssl_session_cache
+{
+    mutable std::mutex mtx_;
+    SSL_SESSION* session_ {};
+public:
+    /// Constructs an empty cache.
+    ssl_session_cache() = default;
+    ssl_session_cache(const ssl_session_cache&) = delete;
+    ssl_session_cache& operator=(const ssl_session_cache&) = delete;
+    ~ssl_session_cache() { clear(); }
+
+    /// Returns true if the cache holds a session.
+    bool has_session() const noexcept;
+
+    /// Removes the stored session, if any. Subsequent handshakes will be full handshakes.
+    void clear() noexcept;
+
+    // Private. Do not use.
+    // Returns the stored session with its reference count incremented,
+    // or nullptr. The caller must call SSL_SESSION_free on it.
+    SSL_SESSION* get_session() const noexcept;
+
+    // Private. Do not use.
+    // Stores session, taking ownership of one reference to it.
+    void set_session(SSL_SESSION* session) noexcept;
+};
+
+} // mysql
+} // boost
+
+#include "boost/mysql/impl/ssl_session_cache.hpp"
+
+#endif
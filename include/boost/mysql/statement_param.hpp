@@ -0,0 +1,69 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_STATEMENT_PARAM_HPP
+#define BOOST_MYSQL_STATEMENT_PARAM_HPP
+
+#include "boost/mysql/decimal.hpp"
+#include "boost/mysql/value.hpp"
+#include <type_traits>
+#include <variant>
+
+namespace boost {
+namespace mysql {
+
+/**
+ * \ingroup stmt
+ * \brief A prepared statement parameter: a boost::mysql::value or a boost::mysql::decimal.
+ * \details boost::mysql::value holds values retrieved from the server, where
+ * DECIMAL is a string, so it can't hold a decimal. To pass decimals to
+ * prepared_statement::execute, use a collection of statement_param.
+ * Decimals are sent as DECIMAL, in textual form, so the server gets the exact number.
+ *
+ * Like value, a statement_param holding a string doesn't own it.
+ */
+class statement_param
+{
+public:
+    /// Type of a variant representing the parameter.
+    using variant_type = std::variant<value, decimal>;
+
+    /// Constructs a NULL parameter.
+    constexpr statement_param() = default;
+
+    /// Constructs a parameter from a value.
+    constexpr statement_param(const value& v) noexcept: repr_(v) {}
+
+    /// Constructs a DECIMAL parameter.
+    constexpr statement_param(const decimal& v) noexcept: repr_(v) {}
+
+    /// Constructs a parameter from anything a value can be constructed from (e.g. an int or a string).
+    template <
+        typename T,
+        typename = std::enable_if_t<
+            !std::is_same_v<T, value> && !std::is_same_v<T, decimal> && !std::is_same_v<T, statement_param>
+        >
+    >
+    explicit constexpr statement_param(const T& v) noexcept: repr_(value(v)) {}
+
+    /// Checks if the parameter is NULL.
+    constexpr bool is_null() const noexcept
+    {
+        const auto* v = std::get_if<value>(&repr_);
+        return v && v->is_null();
+    }
+
+    /// Converts the parameter to a variant.
+    constexpr const variant_type& to_variant() const noexcept { return repr_; }
+private:
+    variant_type repr_;
+};
+
+} // mysql
+} // boost
+
+#endif
@@ -8,6 +8,7 @@
 #ifndef BOOST_MYSQL_VALUE_HPP
 #define BOOST_MYSQL_VALUE_HPP
 
+#include "boost/mysql/decimal.hpp"
 #include <variant>
 #include <cstdint>
 #include <string_view>
@@ -75,6 +76,11 @@ using time = std::chrono::microseconds;
  *     of a std::uint64_t, it will be converted to this type.
  *   - If the actual type was float, and the requested type
  *     was double, it will be converted.
+ *   - If the requested type is boost::mysql::decimal, the actual type
+ *     is std::string_view and the string holds a valid number, it will be parsed
+ *     (see decimal::parse). The string is parsed again on every call.
+ *     Integers are also converted to decimal (with zero scale),
+ *     as long as they fit in decimal::max_precision digits.
  *
  * The mapping from database types (e.g. TINY, VARCHAR...) to C++
  * types is not one to one. The following lists the mapping from database
@@ -181,6 +187,7 @@ using time = std::chrono::microseconds;
  *   no better representation for them is available at the moment:
  *     - **DECIMAL**. A fixed precision numeric value. In this case, the string will contain
  *       the textual representation of the number (e.g. the string "20.52" for 20.52).
+ *       Use value::get<boost::mysql::decimal>() to get it as a fixed-point number.
  *     - **NUMERIC**. Alias for DECIMAL.
  *     - **BIT**. A bitset between 1 and 64 bits wide. In this case, the string will contain
  *       the binary representation of the bitset.
@@ -0,0 +1,183 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_TEST_COMMON_CAPTURE_REPLAY_HPP
+#define BOOST_MYSQL_TEST_COMMON_CAPTURE_REPLAY_HPP
+
+#include "boost/mysql/connection.hpp"
+#include "boost/mysql/protocol_capture.hpp"
+#include "boost/mysql/detail/protocol/text_deserialization.hpp"
+#include "boost/mysql/detail/protocol/binary_deserialization.hpp"
+#include "fake_server.hpp"
+#include "test_stream.hpp"
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace mysql {
+namespace test {
+
+// Replays a protocol capture (see capture_writer) through connection and
+// resultset, against an in-memory stream, as fast as possible. This allows
+// benchmarking the client with real traffic shapes without a server.
+//
+// The handshake is not replayed: the connection is set up with the capabilities
+// and collation in the capture's handshake_complete record, so captures of
+// TLS connections can be replayed, too. Afterwards, each message the client sent
+// is sent again, as captured, and its response is read as the client would:
+// rows returned by queries and statement executions are read and deserialized
+// one by one, using resultset::fetch_one. The server messages are served from
+// memory, in the order they were captured.
+//
+// Captures must contain whole commands. Operations other than queries, statements
+// and quit (e.g. pings) are supported as long as their response is a single message.
+class capture_replayer
+{
+    class replay_connection : public connection<test_stream>
+    {
+    public:
+        using connection<test_stream>::connection;
+        using connection<test_stream>::get_channel;
+    };
+
+    detail::capabilities caps_;
+    collation collation_ {collation::utf8_general_ci};
+    std::vector<capture_record> commands_; // client messages after the handshake
+    std::size_t server_bytes_size_ {0};
+    boost::asio::io_context ctx_;
+    replay_connection conn_ {ctx_};
+public:
+    struct stats
+    {
+        std::size_t num_commands {0};
+        std::size_t num_rows {0};
+        std::size_t bytes_read {0}; // including packet headers
+    };
+
+    // Throws std::invalid_argument if records don't contain a handshake_complete record
+    explicit capture_replayer(const std::vector<capture_record>& records)
+    {
+        auto it = std::find_if(records.begin(), records.end(), [](const capture_record& r) {
+            return r.type == capture_record_type::handshake_complete;
+        });
+        if (it == records.end() || it->payload.size() != 6)
+            throw std::invalid_argument("capture_replayer: the capture doesn't contain a complete handshake");
+        detail::int4 caps;
+        detail::int2 coll;
+        detail::deserialization_context ctx (boost::asio::buffer(it->payload), detail::capabilities(0));
+        detail::deserialize(ctx, caps, coll);
+        caps_ = detail::capabilities(caps.value);
+        collation_ = static_cast<collation>(coll.value);
+
+        for (++it; it != records.end(); ++it)
+        {
+            if (it->type == capture_record_type::client_message)
+            {
+                if (it->payload.empty())
+                    throw std::invalid_argument("capture_replayer: empty client message");
+                commands_.push_back(*it);
+            }
+            else if (it->type == capture_record_type::server_message)
+            {
+                auto framed = fake_server::frame(it->sequence_number, it->payload);
+                server_bytes_size_ += framed.size();
+                conn_.next_layer().add_bytes_to_read(framed);
+            }
+        }
+    }
+
+    static std::vector<capture_record> read_file(const std::string& path)
+    {
+        std::ifstream input (path, std::ios::binary);
+        if (!input)
+            throw std::runtime_error("capture_replayer: cannot open " + path);
+        return capture_reader(input).read_all();
+    }
+
+    std::size_t num_commands() const noexcept { return commands_.size(); }
+    std::size_t server_bytes_size() const noexcept { return server_bytes_size_; }
+
+    // The connection used to replay. Can be used to set read-ahead or an observer
+    connection<test_stream>& get_connection() noexcept { return conn_; }
+
+    // Replays all the commands once. Throws on error, including
+    // server errors and any mismatch between commands and responses
+    stats run()
+    {
+        auto& chan = conn_.get_channel();
+        chan.set_current_capabilities(caps_);
+        chan.set_current_collation(collation_);
+        chan.reset_session(std::string_view(), 0, std::string_view());
+        conn_.next_layer().rewind();
+        conn_.next_layer().clear_bytes_written();
+
+        stats res;
+        error_code err;
+        error_info info;
+        resultset<test_stream> result;
+        prepared_statement<test_stream> stmt;
+        for (const auto& cmd: commands_)
+        {
+            auto payload = boost::asio::buffer(cmd.payload);
+            switch (cmd.payload[0])
+            {
+            case static_cast<std::uint8_t>(command_type::query):
+            case static_cast<std::uint8_t>(command_type::execute):
+                detail::execute_generic(
+                    cmd.payload[0] == static_cast<std::uint8_t>(command_type::query) ?
+                        &detail::deserialize_text_row : &detail::deserialize_binary_row,
+                    chan,
+                    detail::serialized_request{payload},
+                    result,
+                    err,
+                    info
+                );
+                detail::check_error_code(err, info);
+                while (result.fetch_one())
+                    ++res.num_rows;
+                break;
+            case static_cast<std::uint8_t>(command_type::prepare):
+                detail::prepare_statement(
+                    chan,
+                    std::string_view(reinterpret_cast<const char*>(cmd.payload.data()) + 1, cmd.payload.size() - 1),
+                    err,
+                    info,
+                    stmt
+                );
+                detail::check_error_code(err, info);
+                break;
+            case static_cast<std::uint8_t>(command_type::close_statement):
+            case static_cast<std::uint8_t>(command_type::quit):
+                // No response
+                chan.reset_sequence_number();
+                chan.write(payload, err);
+                detail::check_error_code(err, info);
+                break;
+            default:
+                // Anything else, with a single message as response
+                chan.reset_sequence_number();
+                chan.write(payload, err);
+                detail::check_error_code(err, info);
+                chan.read(chan.shared_buffer(), err);
+                detail::check_error_code(err, info);
+                break;
+            }
+            ++res.num_commands;
+        }
+        res.bytes_read = server_bytes_size_;
+        return res;
+    }
+};
+
+} // test
+} // mysql
+} // boost
+
+#endif
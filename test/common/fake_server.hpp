@@ -0,0 +1,769 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_TEST_COMMON_FAKE_SERVER_HPP
+#define BOOST_MYSQL_TEST_COMMON_FAKE_SERVER_HPP
+
+#include "boost/mysql/value.hpp"
+#include "boost/mysql/errc.hpp"
+#include "boost/mysql/collation.hpp"
+#include "boost/mysql/detail/protocol/serialization.hpp"
+#include "boost/mysql/detail/protocol/binary_serialization.hpp"
+#include "boost/mysql/detail/protocol/null_bitmap_traits.hpp"
+#include "boost/mysql/detail/protocol/capabilities.hpp"
+#include "boost/mysql/detail/protocol/constants.hpp"
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/asio/post.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <future>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace boost {
+namespace mysql {
+namespace test {
+
+// A scriptable stand-in for a MySQL server, to run the client end to end
+// without a live server. It answers queries and statements with canned
+// responses, registered beforehand by SQL text. Responses are serialized
+// when registered, so serving them is just writing bytes.
+//
+// The server advertises mysql_native_password (or caching_sha2_password,
+// see require_full_auth), accepts any credentials and does not support TLS
+// (use ssl_mode::disable or ssl_mode::enable).
+// Statement parameters are ignored, and the number of parameters of a
+// statement is the number of '?' characters in its text.
+//
+// It can be used:
+//   - Over an in-memory stream (e.g. test_stream), loading the bytes
+//     returned by handshake_bytes(), query_response() and friends.
+//   - Over loopback TCP or a UNIX socket, with fake_tcp_server and
+//     fake_unix_server, which run the protocol in a background thread.
+//
+// The fake_server must not be modified while it is being served.
+class fake_server
+{
+public:
+    using bytes = std::vector<std::uint8_t>;
+    using row_type = std::vector<value>;
+
+    fake_server()
+    {
+        make_handshake();
+        unknown_query_ = frame(1, make_error(errc::parse_error, "fake_server: unknown query"));
+        unknown_statement_ = frame(1, make_error(errc::unknown_stmt_handler, "fake_server: unknown statement"));
+        unknown_command_ = frame(1, make_error(errc::unknown_com_error, "fake_server: unknown command"));
+    }
+
+    // Registers a query returning rows. Column types are deduced from
+    // the first non-NULL value in each column. The rows are served using
+    // the text protocol for queries and the binary one for statements.
+    // rows must be rectangular, with field_names.size() columns
+    fake_server& add_resultset(
+        std::string_view sql,
+        const std::vector<std::string>& field_names,
+        const std::vector<row_type>& rows
+    )
+    {
+        auto meta = make_metadata(field_names, rows);
+        queries_[std::string(sql)] = make_resultset(meta, rows, false);
+        add_statement(sql, meta.size(), make_resultset(meta, rows, true));
+        return *this;
+    }
+
+    // Registers a query that does not return rows
+    fake_server& add_ok(
+        std::string_view sql,
+        std::uint64_t affected_rows = 0,
+        std::uint64_t last_insert_id = 0
+    )
+    {
+        auto response = frame(1, make_ok(affected_rows, last_insert_id));
+        queries_[std::string(sql)] = response;
+        add_statement(sql, 0, std::move(response));
+        return *this;
+    }
+
+    // Makes the server announce session tracking (CLIENT_SESSION_TRACK),
+    // so clients read the session state changes in OK packets
+    fake_server& enable_session_tracking()
+    {
+        extra_caps_ |= detail::CLIENT_SESSION_TRACK;
+        make_handshake();
+        return *this;
+    }
+
+    // Makes the server authenticate clients using caching_sha2_password,
+    // requesting full authentication, as a server with an empty cache does.
+    // Clients send the password in clear text, which they only do over
+    // secure transports (e.g. UNIX sockets)
+    fake_server& require_full_auth()
+    {
+        full_auth_ = true;
+        make_handshake();
+        return *this;
+    }
+
+    // Registers a query that does not return rows and reports the GTIDs
+    // of the transaction it committed. Requires enable_session_tracking
+    fake_server& add_ok_with_gtids(
+        std::string_view sql,
+        std::string_view gtids,
+        std::uint64_t affected_rows = 0
+    )
+    {
+        auto as_string = [](const bytes& b) {
+            return std::string_view(reinterpret_cast<const char*>(b.data()), b.size());
+        };
+        bytes gtid_data;
+        append(gtid_data, detail::int1(0), detail::string_lenenc(gtids)); // encoding, GTIDs
+        bytes state_change;
+        append(
+            state_change,
+            detail::int1(detail::session_track::gtids),
+            detail::string_lenenc(as_string(gtid_data))
+        );
+        bytes ok;
+        append(
+            ok,
+            detail::int1(0x00),
+            detail::int_lenenc(affected_rows),
+            detail::int_lenenc(0), // last insert ID
+            detail::int2(static_cast<std::uint16_t>(status_flags | detail::SERVER_SESSION_STATE_CHANGED)),
+            detail::int2(0), // warnings
+            detail::string_lenenc(""), // info
+            detail::string_lenenc(as_string(state_change))
+        );
+        auto response = frame(1, ok);
+        queries_[std::string(sql)] = response;
+        add_statement(sql, 0, std::move(response));
+        return *this;
+    }
+
+    // Registers a query that fails with the given error
+    fake_server& add_error(
+        std::string_view sql,
+        errc code,
+        std::string_view message
+    )
+    {
+        auto response = frame(1, make_error(code, message));
+        queries_[std::string(sql)] = response;
+        add_statement(sql, 0, std::move(response));
+        return *this;
+    }
+
+    // The server greeting followed by the authentication responses,
+    // i.e. everything the client reads during handshake
+    bytes handshake_bytes() const
+    {
+        bytes res (greeting_);
+        for (const auto& response: auth_responses_)
+            res.insert(res.end(), response.begin(), response.end());
+        return res;
+    }
+
+    // Responses to query, prepare and execute requests for sql,
+    // or an error response if it was not registered
+    const bytes& query_response(std::string_view sql) const
+    {
+        auto it = queries_.find(sql);
+        return it == queries_.end() ? unknown_query_ : it->second;
+    }
+    const bytes& prepare_response(std::string_view sql) const
+    {
+        auto it = statement_ids_.find(sql);
+        return it == statement_ids_.end() ? unknown_query_ : statements_[it->second - 1].prepare;
+    }
+    const bytes& execute_response(std::string_view sql) const
+    {
+        auto it = statement_ids_.find(sql);
+        return it == statement_ids_.end() ? unknown_statement_ : statements_[it->second - 1].execute;
+    }
+
+    // Response to a command packet (without frame header). Sets quit if
+    // the connection should be closed. An empty response means that the
+    // server does not reply to the command
+    const bytes& command_response(std::string_view payload, bool& quit) const
+    {
+        static const bytes no_response;
+        quit = false;
+        if (payload.empty())
+            return unknown_command_;
+        auto command = static_cast<std::uint8_t>(payload[0]);
+        auto body = payload.substr(1);
+        switch (command)
+        {
+        case 0x01: // COM_QUIT
+            quit = true;
+            return no_response;
+        case 0x03: // COM_QUERY
+            return query_response(body);
+        case 0x16: // COM_STMT_PREPARE
+            return prepare_response(body);
+        case 0x17: // COM_STMT_EXECUTE
+        {
+            auto id = read_int4(body);
+            return id >= 1 && id <= statements_.size() ? statements_[id - 1].execute : unknown_statement_;
+        }
+        case 0x19: // COM_STMT_CLOSE
+            return no_response;
+        default:
+            return unknown_command_;
+        }
+    }
+
+    // Greeting and responses to each message sent by the client during
+    // authentication (the last one is an OK packet), for servers
+    const bytes& greeting() const noexcept { return greeting_; }
+    const std::vector<bytes>& auth_responses() const noexcept { return auth_responses_; }
+
+    // Frames payload into one or more packets, starting with sequence number seqnum
+    static bytes frame(std::uint8_t seqnum, const bytes& payload)
+    {
+        constexpr std::size_t max_size = detail::MAX_PACKET_SIZE;
+        bytes res;
+        std::size_t offset = 0;
+        while (true)
+        {
+            auto size = std::min(max_size, payload.size() - offset);
+            res.push_back(static_cast<std::uint8_t>(size));
+            res.push_back(static_cast<std::uint8_t>(size >> 8));
+            res.push_back(static_cast<std::uint8_t>(size >> 16));
+            res.push_back(seqnum++);
+            res.insert(res.end(), payload.begin() + offset, payload.begin() + offset + size);
+            offset += size;
+            if (size != max_size)
+                break;
+        }
+        return res;
+    }
+
+    // Row message payloads, using the text and binary protocols.
+    // Integers are served as BIGINT, and datetimes and times with 6 decimals
+    static bytes make_text_row(const row_type& r)
+    {
+        bytes res;
+        for (const auto& v: r)
+        {
+            if (v.is_null())
+                res.push_back(0xfb);
+            else
+                append(res, detail::string_lenenc(to_text(v)));
+        }
+        return res;
+    }
+
+    static bytes make_binary_row(const row_type& r)
+    {
+        detail::null_bitmap_traits traits (detail::binary_row_null_bitmap_offset, r.size());
+        bytes res (1 + traits.byte_count(), 0); // header + NULL bitmap
+        for (std::size_t i = 0; i < r.size(); ++i)
+        {
+            if (r[i].is_null())
+            {
+                traits.set_null(res.data() + 1, i);
+            }
+            else
+            {
+                detail::serialization_context ctx (detail::capabilities(0));
+                auto offset = res.size();
+                res.resize(offset + detail::get_binary_value_size(ctx, r[i]));
+                ctx.set_first(res.data() + offset);
+                detail::serialize_binary_value(ctx, r[i]);
+            }
+        }
+        return res;
+    }
+
+private:
+    struct statement
+    {
+        bytes prepare;
+        bytes execute;
+    };
+
+    struct field
+    {
+        std::string name;
+        detail::protocol_field_type type;
+        std::uint16_t flags;
+        std::uint8_t decimals;
+    };
+
+    std::uint32_t extra_caps_ {0};
+    bool full_auth_ {false};
+    bytes greeting_;
+    std::vector<bytes> auth_responses_;
+    bytes unknown_query_;
+    bytes unknown_statement_;
+    bytes unknown_command_;
+    std::map<std::string, bytes, std::less<>> queries_;
+    std::map<std::string, std::uint32_t, std::less<>> statement_ids_;
+    std::vector<statement> statements_; // statement ID - 1 => statement
+
+    static constexpr std::uint16_t status_flags = detail::SERVER_STATUS_AUTOCOMMIT;
+
+    void make_handshake()
+    {
+        if (full_auth_)
+        {
+            greeting_ = frame(0, make_greeting(extra_caps_, "caching_sha2_password"));
+            auth_responses_ = {
+                frame(2, bytes{0x01, 0x04}), // auth more data: perform full authentication
+                frame(4, make_ok(0, 0))
+            };
+        }
+        else
+        {
+            greeting_ = frame(0, make_greeting(extra_caps_));
+            auth_responses_ = { frame(2, make_ok(0, 0)) };
+        }
+    }
+
+    static std::uint32_t read_int4(std::string_view from)
+    {
+        std::uint8_t buff [4] {};
+        std::copy_n(from.begin(), std::min<std::size_t>(4, from.size()), buff);
+        return buff[0] | (buff[1] << 8) | (buff[2] << 16) | (static_cast<std::uint32_t>(buff[3]) << 24);
+    }
+
+    template <typename... Types>
+    static void append(bytes& to, const Types&... fields)
+    {
+        detail::serialization_context ctx (detail::capabilities(0));
+        auto offset = to.size();
+        to.resize(offset + detail::get_size(ctx, fields...));
+        ctx.set_first(to.data() + offset);
+        detail::serialize(ctx, fields...);
+    }
+
+    static void append_packet(bytes& to, std::uint8_t& seqnum, const bytes& payload)
+    {
+        auto framed = frame(seqnum, payload);
+        seqnum += static_cast<std::uint8_t>(payload.size() / detail::MAX_PACKET_SIZE + 1);
+        to.insert(to.end(), framed.begin(), framed.end());
+    }
+
+    static bytes make_greeting(
+        std::uint32_t extra_caps = 0,
+        std::string_view auth_plugin = "mysql_native_password"
+    )
+    {
+        const std::uint32_t caps = extra_caps |
+            detail::CLIENT_PROTOCOL_41 |
+            detail::CLIENT_PLUGIN_AUTH |
+            detail::CLIENT_PLUGIN_AUTH_LENENC_CLIENT_DATA |
+            detail::CLIENT_DEPRECATE_EOF |
+            detail::CLIENT_SECURE_CONNECTION |
+            detail::CLIENT_CONNECT_WITH_DB;
+        detail::string_fixed<8> scramble1 {'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h'};
+        detail::string_fixed<13> scramble2 {'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p', 'q', 'r', 's', 't', '\0'};
+        bytes res;
+        append(
+            res,
+            detail::int1(detail::handshake_protocol_version_10),
+            detail::string_null("8.0.0-fake"),
+            detail::int4(1), // connection ID
+            scramble1,
+            detail::int1(0), // filler
+            detail::int2(static_cast<std::uint16_t>(caps)),
+            detail::int1(static_cast<std::uint8_t>(collation::utf8mb4_general_ci)),
+            detail::int2(status_flags),
+            detail::int2(static_cast<std::uint16_t>(caps >> 16)),
+            detail::int1(21), // auth plugin data length
+            detail::string_fixed<10>{}, // reserved
+            scramble2,
+            detail::string_null(auth_plugin)
+        );
+        return res;
+    }
+
+    static bytes make_ok(std::uint64_t affected_rows, std::uint64_t last_insert_id, std::uint8_t header = 0x00)
+    {
+        bytes res;
+        append(
+            res,
+            detail::int1(header),
+            detail::int_lenenc(affected_rows),
+            detail::int_lenenc(last_insert_id),
+            detail::int2(status_flags),
+            detail::int2(0) // warnings
+        );
+        return res;
+    }
+
+    static bytes make_error(errc code, std::string_view message)
+    {
+        bytes res;
+        append(
+            res,
+            detail::int1(detail::error_packet_header),
+            detail::int2(static_cast<std::uint16_t>(code)),
+            detail::string_fixed<1>{'#'},
+            detail::string_fixed<5>{'H', 'Y', '0', '0', '0'},
+            detail::string_eof(message)
+        );
+        return res;
+    }
+
+    static std::vector<field> make_metadata(
+        const std::vector<std::string>& field_names,
+        const std::vector<row_type>& rows
+    )
+    {
+        using detail::protocol_field_type;
+        std::vector<field> res;
+        for (std::size_t i = 0; i < field_names.size(); ++i)
+        {
+            field f {field_names[i], protocol_field_type::var_string, 0, 0};
+            auto it = std::find_if(rows.begin(), rows.end(), [i](const row_type& r) { return !r.at(i).is_null(); });
+            if (it != rows.end())
+            {
+                const auto& v = (*it)[i];
+                if (v.is<std::int64_t>()) f.type = protocol_field_type::longlong;
+                else if (v.is<std::uint64_t>())
+                {
+                    f.type = protocol_field_type::longlong;
+                    f.flags = detail::column_flags::unsigned_;
+                }
+                else if (v.is<float>()) { f.type = protocol_field_type::float_; f.decimals = 31; }
+                else if (v.is<double>()) { f.type = protocol_field_type::double_; f.decimals = 31; }
+                else if (v.is<date>()) f.type = protocol_field_type::date;
+                else if (v.is<datetime>()) { f.type = protocol_field_type::datetime; f.decimals = 6; }
+                else if (v.is<time>()) { f.type = protocol_field_type::time; f.decimals = 6; }
+            }
+            res.push_back(std::move(f));
+        }
+        return res;
+    }
+
+    static bytes make_column_definition(const field& f)
+    {
+        bytes res;
+        append(
+            res,
+            detail::string_lenenc("def"), // catalog
+            detail::string_lenenc("fake"), // schema
+            detail::string_lenenc("fake"), // table
+            detail::string_lenenc("fake"), // org_table
+            detail::string_lenenc(f.name),
+            detail::string_lenenc(f.name), // org_name
+            detail::int_lenenc(0x0c), // length of fixed fields
+            detail::int2(static_cast<std::uint16_t>(collation::utf8mb4_general_ci)),
+            detail::int4(1024), // column length
+            detail::int1(static_cast<std::uint8_t>(f.type)),
+            detail::int2(f.flags),
+            detail::int1(f.decimals),
+            detail::int2(0) // filler
+        );
+        return res;
+    }
+
+    // Text protocol representation of a non-NULL value
+    static std::string to_text(const value& v)
+    {
+        char buff [64] {};
+        if (v.is<std::int64_t>())
+            return std::to_string(v.get<std::int64_t>());
+        else if (v.is<std::uint64_t>())
+            return std::to_string(v.get<std::uint64_t>());
+        else if (v.is<std::string_view>())
+            return std::string(v.get<std::string_view>());
+        else if (v.is<float>())
+            snprintf(buff, sizeof(buff), "%.9g", static_cast<double>(v.get<float>()));
+        else if (v.is<double>())
+            snprintf(buff, sizeof(buff), "%.17g", v.get<double>());
+        else
+        {
+            // Dates, datetimes (with 6 decimals) and times are printed in the same format MySQL uses
+            std::ostringstream oss;
+            oss << v;
+            return oss.str();
+        }
+        return buff;
+    }
+
+    static bytes make_resultset(
+        const std::vector<field>& meta,
+        const std::vector<row_type>& rows,
+        bool binary
+    )
+    {
+        bytes res;
+        std::uint8_t seqnum = 1;
+        bytes field_count;
+        append(field_count, detail::int_lenenc(meta.size()));
+        append_packet(res, seqnum, field_count);
+        for (const auto& f: meta)
+            append_packet(res, seqnum, make_column_definition(f));
+        for (const auto& r: rows)
+            append_packet(res, seqnum, binary ? make_binary_row(r) : make_text_row(r));
+        append_packet(res, seqnum, make_ok(0, 0, detail::eof_packet_header));
+        return res;
+    }
+
+    void add_statement(std::string_view sql, std::size_t num_columns, bytes execute)
+    {
+        auto num_params = std::count(sql.begin(), sql.end(), '?');
+        auto id = static_cast<std::uint32_t>(statements_.size() + 1);
+        auto it = statement_ids_.find(sql);
+        if (it != statement_ids_.end())
+            id = it->second;
+
+        // Prepare response: prepare OK packet, parameter definitions and
+        // the column definitions of the execution response
+        bytes prepare;
+        std::uint8_t seqnum = 1;
+        bytes prepare_ok;
+        append(
+            prepare_ok,
+            detail::int1(0), // status
+            detail::int4(id),
+            detail::int2(static_cast<std::uint16_t>(num_columns)),
+            detail::int2(static_cast<std::uint16_t>(num_params)),
+            detail::int1(0), // reserved
+            detail::int2(0) // warnings
+        );
+        append_packet(prepare, seqnum, prepare_ok);
+        for (decltype(num_params) i = 0; i < num_params; ++i)
+            append_packet(prepare, seqnum, make_column_definition(field{"?", detail::protocol_field_type::var_string, 0, 0}));
+        if (num_columns)
+        {
+            std::size_t offset = skip_packet(execute, 0); // field count
+            for (std::size_t i = 0; i < num_columns; ++i)
+            {
+                auto next = skip_packet(execute, offset);
+                bytes payload (execute.begin() + offset + 4, execute.begin() + next);
+                append_packet(prepare, seqnum, payload);
+                offset = next;
+            }
+        }
+
+        statement st {std::move(prepare), std::move(execute)};
+        if (it != statement_ids_.end())
+        {
+            statements_[id - 1] = std::move(st);
+        }
+        else
+        {
+            statement_ids_.emplace(std::string(sql), id);
+            statements_.push_back(std::move(st));
+        }
+    }
+
+    // Returns the offset of the packet following the one at offset.
+    // Column definitions are always shorter than MAX_PACKET_SIZE
+    static std::size_t skip_packet(const bytes& from, std::size_t offset)
+    {
+        std::size_t size = from[offset] | (from[offset + 1] << 8) | (from[offset + 2] << 16);
+        return offset + 4 + size;
+    }
+};
+
+// Serves a fake_server over sockets of a given protocol (e.g. TCP or UNIX sockets).
+// Connections are accepted and served in a background thread, each one running
+// the handshake and then answering commands until the client quits or
+// closes the connection.
+template <typename Protocol>
+class fake_socket_server
+{
+public:
+    using endpoint_type = typename Protocol::endpoint;
+    using socket_type = typename Protocol::socket;
+
+    // Listens at ep. For TCP, use port 0 to get any free port,
+    // and endpoint() to retrieve it
+    fake_socket_server(const fake_server& server, const endpoint_type& ep) :
+        server_(server),
+        acceptor_(ctx_)
+    {
+        if constexpr (std::is_same_v<Protocol, boost::asio::local::stream_protocol>)
+        {
+            std::remove(ep.path().c_str()); // stale socket files prevent bind
+        }
+        acceptor_.open(ep.protocol());
+        if constexpr (std::is_same_v<Protocol, boost::asio::ip::tcp>)
+        {
+            acceptor_.set_option(boost::asio::socket_base::reuse_address(true)); // allow restarts
+        }
+        acceptor_.bind(ep);
+        acceptor_.listen();
+        endpoint_ = acceptor_.local_endpoint();
+        accept();
+        thread_ = std::thread([this] { ctx_.run(); });
+    }
+    fake_socket_server(const fake_socket_server&) = delete;
+    fake_socket_server& operator=(const fake_socket_server&) = delete;
+
+    ~fake_socket_server()
+    {
+        // Closing the acceptor and sockets makes all pending operations fail,
+        // so run() returns once they have been cleaned up
+        boost::asio::post(ctx_, [this] {
+            acceptor_.close();
+            close_sessions();
+        });
+        thread_.join();
+        if constexpr (std::is_same_v<Protocol, boost::asio::local::stream_protocol>)
+        {
+            std::remove(endpoint_.path().c_str());
+        }
+    }
+
+    const endpoint_type& endpoint() const noexcept { return endpoint_; }
+
+    // Closes the connections being served, as a server restart would,
+    // and keeps accepting new ones
+    void close_connections()
+    {
+        std::promise<void> done;
+        boost::asio::post(ctx_, [this, &done] {
+            close_sessions();
+            done.set_value();
+        });
+        done.get_future().wait();
+    }
+
+private:
+    struct session : std::enable_shared_from_this<session>
+    {
+        const fake_server& server;
+        socket_type sock;
+        std::uint8_t header [4] {};
+        std::string payload;
+        std::size_t auth_step {0}; // number of authentication messages answered
+
+        session(const fake_server& server, socket_type&& sock) :
+            server(server), sock(std::move(sock)) {}
+
+        void start()
+        {
+            write(server.greeting());
+        }
+
+        void write(const fake_server::bytes& response)
+        {
+            boost::asio::async_write(sock, boost::asio::buffer(response),
+                [self = this->shared_from_this()](error_code err, std::size_t) {
+                    if (!err)
+                    {
+                        self->payload.clear();
+                        self->read_header();
+                    }
+                });
+        }
+
+        void read_header()
+        {
+            boost::asio::async_read(sock, boost::asio::buffer(header),
+                [self = this->shared_from_this()](error_code err, std::size_t) {
+                    if (!err)
+                        self->read_payload();
+                });
+        }
+
+        void read_payload()
+        {
+            std::size_t size = header[0] | (header[1] << 8) | (header[2] << 16);
+            auto offset = payload.size();
+            payload.resize(offset + size);
+            boost::asio::async_read(sock, boost::asio::buffer(payload.data() + offset, size),
+                [self = this->shared_from_this(), size](error_code err, std::size_t) {
+                    if (err)
+                        return;
+                    if (size == detail::MAX_PACKET_SIZE)
+                        self->read_header(); // message continues in the next frame
+                    else
+                        self->process();
+                });
+        }
+
+        void process()
+        {
+            const auto& auth_responses = server.auth_responses();
+            if (auth_step < auth_responses.size())
+            {
+                // Any handshake response is accepted
+                write(auth_responses[auth_step++]);
+                return;
+            }
+            bool quit = false;
+            const auto& response = server.command_response(payload, quit);
+            if (quit)
+            {
+                error_code ignored;
+                sock.close(ignored);
+            }
+            else if (response.empty())
+            {
+                payload.clear();
+                read_header();
+            }
+            else
+            {
+                write(response);
+            }
+        }
+    };
+
+    const fake_server& server_;
+    boost::asio::io_context ctx_;
+    typename Protocol::acceptor acceptor_;
+    endpoint_type endpoint_;
+    std::vector<std::weak_ptr<session>> sessions_;
+    std::thread thread_;
+
+    void close_sessions()
+    {
+        for (auto& weak_sess: sessions_)
+        {
+            if (auto sess = weak_sess.lock())
+            {
+                error_code ignored;
+                sess->sock.close(ignored);
+            }
+        }
+    }
+
+    void accept()
+    {
+        acceptor_.async_accept([this](error_code err, socket_type sock) {
+            if (err)
+                return;
+            auto sess = std::make_shared<session>(server_, std::move(sock));
+            sessions_.erase(
+                std::remove_if(sessions_.begin(), sessions_.end(), [](const auto& s) { return s.expired(); }),
+                sessions_.end()
+            );
+            sessions_.push_back(sess);
+            sess->start();
+            accept();
+        });
+    }
+};
+
+using fake_tcp_server = fake_socket_server<boost::asio::ip::tcp>;
+using fake_unix_server = fake_socket_server<boost::asio::local::stream_protocol>;
+
+} // test
+} // mysql
+} // boost
+
+#endif
@@ -0,0 +1,61 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_TEST_COMMON_FAKE_SERVER_FIXTURE_HPP
+#define BOOST_MYSQL_TEST_COMMON_FAKE_SERVER_FIXTURE_HPP
+
+#include <gtest/gtest.h>
+#include "boost/mysql/connection.hpp"
+#include "fake_server.hpp"
+#include "test_common.hpp"
+#include "test_stream.hpp"
+
+namespace boost {
+namespace mysql {
+namespace test {
+
+// Base fixture for tests talking to a fake_server. The server knows
+// the following statements, to which tests may add their own:
+//   - "SELECT * FROM t": rows (1, "abc"), (2, "def") and (3, NULL), in columns id and name.
+//   - "DELETE FROM t": 2 affected rows.
+//   - "DROP TABLE t": fails with errc::no_such_table.
+struct fake_server_fixture : public testing::Test
+{
+    fake_server server;
+    connection_params params {"user", "password", "db", collation::utf8mb4_general_ci,
+        ssl_options(ssl_mode::disable)};
+    boost::asio::io_context ctx;
+
+    fake_server_fixture()
+    {
+        server.add_resultset("SELECT * FROM t", {"id", "name"}, {
+            makevalues(1, "abc"),
+            makevalues(2, "def"),
+            makevalues(3, nullptr)
+        });
+        server.add_ok("DELETE FROM t", 2);
+        server.add_error("DROP TABLE t", errc::no_such_table, "Table 't' doesn't exist");
+    }
+};
+
+// Same as fake_server_fixture, plus a connection over a test_stream. The
+// server's handshake response is already loaded: tests load the responses
+// for the commands they run, in order, before running them.
+struct fake_connection_fixture : fake_server_fixture
+{
+    connection<test_stream> conn {ctx};
+
+    fake_connection_fixture() { load(server.handshake_bytes()); }
+
+    void load(const fake_server::bytes& bytes) { conn.next_layer().add_bytes_to_read(bytes); }
+};
+
+} // test
+} // mysql
+} // boost
+
+#endif
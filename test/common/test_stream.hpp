@@ -0,0 +1,166 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_TEST_COMMON_TEST_STREAM_HPP
+#define BOOST_MYSQL_TEST_COMMON_TEST_STREAM_HPP
+
+#include "boost/mysql/error.hpp"
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/system/system_error.hpp>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace boost {
+namespace mysql {
+namespace test {
+
+// An in-memory stream, to run network algorithms without a server.
+// Reads are served from a buffer set up by the test. Writes are
+// recorded so the test can inspect them. Async operations complete
+// by posting to the io_context passed in the constructor.
+class test_stream
+{
+    boost::asio::io_context* ctx_;
+    std::vector<std::uint8_t> bytes_to_read_;
+    std::size_t read_pos_ {0};
+    std::vector<std::uint8_t> bytes_written_;
+    std::size_t num_writes_ {0};
+public:
+    using executor_type = boost::asio::io_context::executor_type;
+    using lowest_layer_type = test_stream;
+
+    explicit test_stream(boost::asio::io_context& ctx): ctx_(&ctx) {}
+
+    void add_bytes_to_read(const std::vector<std::uint8_t>& bytes)
+    {
+        bytes_to_read_.insert(bytes_to_read_.end(), bytes.begin(), bytes.end());
+    }
+    void rewind() noexcept { read_pos_ = 0; } // serve the bytes to read again
+    const std::vector<std::uint8_t>& bytes_written() const noexcept { return bytes_written_; }
+    std::size_t num_writes() const noexcept { return num_writes_; }
+    void clear_bytes_written() { bytes_written_.clear(); num_writes_ = 0; }
+
+    template <typename MutableBufferSequence>
+    std::size_t read_some(const MutableBufferSequence& buffers, error_code& ec)
+    {
+        if (boost::asio::buffer_size(buffers) == 0)
+        {
+            ec.clear();
+            return 0;
+        }
+        if (read_pos_ == bytes_to_read_.size())
+        {
+            ec = boost::asio::error::eof;
+            return 0;
+        }
+        auto res = boost::asio::buffer_copy(
+            buffers,
+            boost::asio::buffer(bytes_to_read_) + read_pos_
+        );
+        read_pos_ += res;
+        ec.clear();
+        return res;
+    }
+
+    template <typename MutableBufferSequence>
+    std::size_t read_some(const MutableBufferSequence& buffers)
+    {
+        error_code ec;
+        auto res = read_some(buffers, ec);
+        if (ec)
+            throw boost::system::system_error(ec);
+        return res;
+    }
+
+    template <typename ConstBufferSequence>
+    std::size_t write_some(const ConstBufferSequence& buffers, error_code& ec)
+    {
+        std::size_t res = 0;
+        for (auto it = boost::asio::buffer_sequence_begin(buffers);
+             it != boost::asio::buffer_sequence_end(buffers); ++it)
+        {
+            boost::asio::const_buffer buff (*it);
+            const auto* first = static_cast<const std::uint8_t*>(buff.data());
+            bytes_written_.insert(bytes_written_.end(), first, first + buff.size());
+            res += buff.size();
+        }
+        ++num_writes_;
+        ec.clear();
+        return res;
+    }
+
+    template <typename ConstBufferSequence>
+    std::size_t write_some(const ConstBufferSequence& buffers)
+    {
+        error_code ec;
+        return write_some(buffers, ec);
+    }
+
+    template <typename MutableBufferSequence, typename CompletionToken>
+    BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(error_code, std::size_t))
+    async_read_some(const MutableBufferSequence& buffers, CompletionToken&& token)
+    {
+        return boost::asio::async_initiate<CompletionToken, void(error_code, std::size_t)>(
+            [this](auto handler, const MutableBufferSequence& buffers) {
+                error_code ec;
+                auto res = read_some(buffers, ec);
+                boost::asio::post(get_executor(), [handler = std::move(handler), ec, res] () mutable {
+                    handler(ec, res);
+                });
+            },
+            token,
+            buffers
+        );
+    }
+
+    template <typename ConstBufferSequence, typename CompletionToken>
+    BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(error_code, std::size_t))
+    async_write_some(const ConstBufferSequence& buffers, CompletionToken&& token)
+    {
+        return boost::asio::async_initiate<CompletionToken, void(error_code, std::size_t)>(
+            [this](auto handler, const ConstBufferSequence& buffers) {
+                error_code ec;
+                auto res = write_some(buffers, ec);
+                boost::asio::post(get_executor(), [handler = std::move(handler), ec, res] () mutable {
+                    handler(ec, res);
+                });
+            },
+            token,
+            buffers
+        );
+    }
+
+    executor_type get_executor() { return ctx_->get_executor(); }
+    test_stream& lowest_layer() { return *this; }
+    void close(error_code& ec) { ec.clear(); }
+    void shutdown(int, error_code& ec) { ec.clear(); }
+};
+
+// Composes a protocol packet (header + payload), to be read from or compared
+// against the bytes written to a test_stream
+inline std::vector<std::uint8_t> make_packet(std::uint8_t seqnum, std::string_view payload)
+{
+    auto size = payload.size();
+    std::vector<std::uint8_t> res {
+        static_cast<std::uint8_t>(size),
+        static_cast<std::uint8_t>(size >> 8),
+        static_cast<std::uint8_t>(size >> 16),
+        seqnum
+    };
+    res.insert(res.end(), payload.begin(), payload.end());
+    return res;
+}
+
+} // test
+} // mysql
+} // boost
+
+#endif
@@ -0,0 +1,68 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "boost/mysql/connection.hpp"
+#include "integration_test_common.hpp"
+#include "test_common.hpp"
+#include <boost/asio/use_future.hpp>
+
+using namespace boost::mysql::test;
+using boost::mysql::value;
+
+namespace
+{
+
+struct BatchInserterTest : IntegTest<boost::asio::ip::tcp::socket>
+{
+    BatchInserterTest()
+    {
+        connect(boost::mysql::ssl_mode::disable);
+        conn.query("START TRANSACTION");
+    }
+
+    std::uint64_t count_rows()
+    {
+        auto rows = conn.query("SELECT COUNT(*) FROM inserts_table WHERE field_varchar LIKE 'batch%'").fetch_all();
+        return rows.at(0).values().at(0).get<std::int64_t>();
+    }
+};
+
+TEST_F(BatchInserterTest, ManyRows_SeveralStatements_AllRowsInserted)
+{
+    // A small size forces several statements to be sent
+    auto inserter = conn.make_batch_inserter(
+        "INSERT INTO inserts_table (field_varchar, field_date) VALUES", 256);
+    constexpr int num_rows = 100;
+    for (int i = 0; i < num_rows; ++i)
+    {
+        inserter.add_row(boost::mysql::make_values(
+            "batch'" + std::to_string(i),
+            makedate(2020, 1, 1 + i % 28)
+        ));
+    }
+    EXPECT_LT(inserter.pending_rows(), num_rows);
+    inserter.flush();
+    EXPECT_EQ(inserter.pending_rows(), 0);
+    EXPECT_EQ(inserter.affected_rows(), num_rows);
+    EXPECT_EQ(count_rows(), num_rows);
+}
+
+TEST_F(BatchInserterTest, Async_AllRowsInserted)
+{
+    using boost::asio::use_future;
+    auto inserter = conn.make_batch_inserter(
+        "INSERT INTO inserts_table (field_varchar) VALUES", 128);
+    for (int i = 0; i < 20; ++i)
+    {
+        inserter.async_add_row(boost::mysql::make_values("batch" + std::to_string(i)), use_future).get();
+    }
+    inserter.async_flush(use_future).get();
+    EXPECT_EQ(inserter.affected_rows(), 20);
+    EXPECT_EQ(count_rows(), 20);
+}
+
+}
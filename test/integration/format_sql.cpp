@@ -0,0 +1,86 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "boost/mysql/connection.hpp"
+#include "integration_test_common.hpp"
+#include "test_common.hpp"
+
+using namespace boost::mysql::test;
+using boost::mysql::value;
+using boost::mysql::format_sql;
+
+namespace
+{
+
+struct FormatSqlTest : IntegTest<boost::asio::ip::tcp::socket>
+{
+    std::string query_buffer;
+
+    FormatSqlTest()
+    {
+        connect(boost::mysql::ssl_mode::disable);
+    }
+
+    // Formats a SELECT with the given value and checks it is retrieved unmodified
+    void validate_roundtrip(value v)
+    {
+        format_sql("SELECT {}", boost::mysql::make_values(v), conn.format_opts(), query_buffer);
+        auto rows = conn.query(query_buffer).fetch_all();
+        ASSERT_EQ(rows.size(), 1);
+        ASSERT_EQ(rows[0].values().size(), 1);
+        EXPECT_EQ(rows[0].values()[0], v);
+    }
+};
+
+TEST_F(FormatSqlTest, Roundtrip_StringWithSpecialCharacters)
+{
+    EXPECT_TRUE(conn.format_opts().backslash_escapes());
+    const char str [] = "it's \"a\" \\ test\n\r\0\x1a";
+    validate_roundtrip(value(std::string_view(str, sizeof(str) - 1)));
+}
+
+TEST_F(FormatSqlTest, Roundtrip_NoBackslashEscapes)
+{
+    conn.query("SET SESSION sql_mode = 'NO_BACKSLASH_ESCAPES'");
+    EXPECT_FALSE(conn.format_opts().backslash_escapes());
+    validate_roundtrip(value("it's a \\ test\\"));
+
+    conn.query("SET SESSION sql_mode = ''");
+    EXPECT_TRUE(conn.format_opts().backslash_escapes());
+}
+
+TEST_F(FormatSqlTest, Roundtrip_Numbers)
+{
+    validate_roundtrip(value(-42));
+    validate_roundtrip(value(std::uint64_t(0xffffffffffffffff)));
+    validate_roundtrip(value(1.0e300));
+}
+
+TEST_F(FormatSqlTest, InsertAndSelect_ReusedBuffer)
+{
+    auto v = value("O'Brien");
+    format_sql(
+        "INSERT INTO inserts_table (field_varchar, field_date) VALUES ({}, {})",
+        boost::mysql::make_values(v, makedate(2020, 3, 4)),
+        conn.format_opts(),
+        query_buffer
+    );
+    auto insert_result = conn.query(query_buffer);
+    EXPECT_EQ(insert_result.affected_rows(), 1);
+
+    format_sql(
+        "SELECT field_varchar FROM inserts_table WHERE id = {}",
+        boost::mysql::make_values(insert_result.last_insert_id()),
+        conn.format_opts(),
+        query_buffer
+    );
+    auto rows = conn.query(query_buffer).fetch_all();
+    ASSERT_EQ(rows.size(), 1);
+    EXPECT_EQ(rows[0].values()[0], v);
+}
+
+}
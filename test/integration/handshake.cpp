@@ -190,12 +190,20 @@ struct CachingSha2HandshakeTest : SslSensitiveHandshakeTest<Stream>
     void SslOffCacheMiss_FailedLogin_RequiresSha256()
     {
         // A cache miss would force us send a plaintext password over
-        // a non-TLS connection, so we fail
-        this->set_ssl(ssl_mode::disable);
+        // a non-TLS connection, so we fail. UNIX sockets are secure
+        // transports, so we send the password and succeed
         this->set_credentials("csha2p_user", "csha2p_password");
         clear_sha256_cache();
-        auto result = this->do_handshake();
-        result.validate_error(errc::auth_plugin_requires_ssl, {});
+        if (boost::mysql::detail::is_secure_transport<Stream>::value)
+        {
+            this->do_handshake_ok(ssl_mode::disable);
+        }
+        else
+        {
+            this->set_ssl(ssl_mode::disable);
+            auto result = this->do_handshake();
+            result.validate_error(errc::auth_plugin_requires_ssl, {});
+        }
     }
 
     void EmptyPasswordSslOnCacheHit_SuccessfulLogin_RequiresSha256()
@@ -277,7 +285,8 @@ struct MiscSslSensitiveHandshakeTest : SslSensitiveHandshakeTest<Stream>
     void SslEnable_SuccessfulLogin()
     {
         // In all our CI systems, our servers support SSL, so
-        // ssl_mode::enable will do the same as ssl_mode::require.
+        // ssl_mode::enable will do the same as ssl_mode::require,
+        // except over UNIX sockets, where SSL is not used.
         // We test for this fact.
         this->do_handshake_ok(ssl_mode::enable);
     }
@@ -288,4 +297,53 @@ BOOST_MYSQL_NETWORK_TEST_SUITE(MiscSslSensitiveHandshakeTest)
 BOOST_MYSQL_NETWORK_TEST(MiscSslSensitiveHandshakeTest, BadUser_FailedLogin)
 BOOST_MYSQL_NETWORK_TEST(MiscSslSensitiveHandshakeTest, SslEnable_SuccessfulLogin)
 
+#ifdef BOOST_ASIO_HAS_LOCAL_SOCKETS
+// caching_sha2_password full authentication over UNIX sockets, which are
+// secure transports: the password is sent in plain text, without TLS
+struct UnixSocketHandshakeTest : IntegTest<boost::asio::local::stream_protocol::socket>
+{
+    UnixSocketHandshakeTest()
+    {
+        set_credentials("csha2p_user", "csha2p_password");
+        check_call("mysql -u root -e \"FLUSH PRIVILEGES\""); // clear the SHA256 cache
+        physical_connect();
+    }
+};
+
+TEST_F(UnixSocketHandshakeTest, CachingSha2SslEnableCacheMiss_SuccessfulLoginWithoutSsl_RequiresSha256)
+{
+    connection_params.set_ssl(boost::mysql::ssl_options(ssl_mode::enable));
+    conn.handshake(connection_params);
+    EXPECT_FALSE(conn.uses_ssl());
+    auto rows = conn.query("SELECT CURRENT_USER()").fetch_all();
+    ASSERT_EQ(rows.size(), 1);
+    EXPECT_EQ(rows[0].values().at(0), boost::mysql::value("csha2p_user@localhost"));
+}
+#endif
+
+// Shared TLS context and session resumption
+struct SharedSslContextHandshakeTest : IntegTest<boost::asio::ip::tcp::socket>
+{
+    boost::asio::ssl::context ssl_ctx {boost::asio::ssl::context::tls_client};
+    boost::mysql::ssl_session_cache session_cache;
+};
+
+TEST_F(SharedSslContextHandshakeTest, SeveralConnections_SuccessfulLoginAndSessionStored)
+{
+    connection_params.set_ssl(boost::mysql::ssl_options(ssl_mode::require, &ssl_ctx, &session_cache));
+    physical_connect();
+    conn.handshake(connection_params);
+    EXPECT_TRUE(conn.uses_ssl());
+    EXPECT_TRUE(session_cache.has_session());
+
+    // A second connection attempts to resume the session
+    boost::mysql::tcp_connection other_conn (ctx);
+    other_conn.next_layer().connect(get_endpoint<boost::asio::ip::tcp::socket>(endpoint_kind::localhost));
+    other_conn.handshake(connection_params);
+    EXPECT_TRUE(other_conn.uses_ssl());
+    EXPECT_TRUE(session_cache.has_session());
+    other_conn.query("SELECT 1").fetch_all();
+    other_conn.close();
+}
+
 } // anon namespace
@@ -86,12 +86,15 @@ struct IntegTest : testing::Test
         handshake(m);
     }
 
+    // Over secure transports (UNIX sockets), ssl_mode::enable doesn't use SSL
     static bool should_use_ssl(ssl_mode m)
     {
-        return m == ssl_mode::enable || m == ssl_mode::require;
+        return m == ssl_mode::require ||
+            (m == ssl_mode::enable && !detail::is_secure_transport<Stream>::value);
     }
 
-    // Verifies that we are or are not using SSL, depending on what mode was requested.
+    // Verifies that we are or are not using SSL, depending on what mode was requested
+    // and the stream type.
     void validate_ssl(ssl_mode m)
     {
         if (should_use_ssl(m))
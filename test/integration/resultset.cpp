@@ -18,6 +18,7 @@ using boost::mysql::ssl_mode;
 using boost::mysql::connection;
 using boost::mysql::resultset;
 using boost::mysql::prepared_statement;
+using boost::mysql::value;
 namespace net = boost::asio;
 
 namespace
@@ -133,6 +134,9 @@ struct ResultsetTest : public NetworkTest<Stream, true, resultset_testcase<Strea
         ASSERT_NE(row_result.value, nullptr);
         this->validate_2fields_meta(result, "one_row_table");
         EXPECT_EQ(row_result.value->values(), makevalues(1, "f0"));
+        EXPECT_EQ(result.at(*row_result.value, "id"), value(1));
+        EXPECT_EQ(result.at(*row_result.value, "field_varchar"), value("f0"));
+        EXPECT_EQ(result.field_index("field_varchar"), 1);
         EXPECT_FALSE(result.complete());
 
         // Fetch next: end of resultset
@@ -203,6 +207,7 @@ struct ResultsetTest : public NetworkTest<Stream, true, resultset_testcase<Strea
         rows_result.validate_no_error();
         EXPECT_FALSE(result.complete());
         EXPECT_EQ(rows_result.value, (makerows(2, 1, "f0", 2, "f1")));
+        EXPECT_EQ(result.at(rows_result.value.at(1), "field_varchar"), value("f1"));
 
         // Fetch another two (completes the resultset)
         rows_result = do_fetch_many(result, 2);
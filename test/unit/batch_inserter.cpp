@@ -0,0 +1,190 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include "boost/mysql/connection.hpp"
+#include "test_common.hpp"
+#include "test_stream.hpp"
+#include <limits>
+
+using namespace boost::mysql::test;
+using boost::mysql::batch_inserter;
+using boost::mysql::errc;
+using boost::mysql::error_code;
+using boost::mysql::error_info;
+using boost::mysql::value;
+
+namespace
+{
+
+using test_connection = boost::mysql::connection<test_stream>;
+
+// A COM_QUERY packet, as sent by the client
+std::vector<std::uint8_t> make_query_packet(std::string_view query)
+{
+    std::string payload ("\x03");
+    payload += query;
+    return make_packet(0, payload);
+}
+
+// An OK packet, as sent by the server. affected_rows must be < 251
+std::vector<std::uint8_t> make_ok_packet(std::uint8_t affected_rows)
+{
+    const char payload [] = { 0x00, static_cast<char>(affected_rows), 0x00, 0x02, 0x00, 0x00, 0x00 };
+    return make_packet(1, std::string_view(payload, sizeof(payload)));
+}
+
+struct BatchInserterTest : public testing::Test
+{
+    boost::asio::io_context ctx;
+    test_connection conn {ctx};
+    error_code err;
+    error_info info;
+
+    test_stream& stream() { return conn.next_layer(); }
+};
+
+TEST_F(BatchInserterTest, DefaultConstructor_Invalid)
+{
+    batch_inserter<test_stream> inserter;
+    EXPECT_FALSE(inserter.valid());
+}
+
+TEST_F(BatchInserterTest, MakeBatchInserter_Valid)
+{
+    auto inserter = conn.make_batch_inserter("INSERT INTO t VALUES", 1024);
+    EXPECT_TRUE(inserter.valid());
+    EXPECT_EQ(inserter.max_size(), 1024);
+    EXPECT_EQ(inserter.pending_rows(), 0);
+    EXPECT_EQ(inserter.affected_rows(), 0);
+}
+
+TEST_F(BatchInserterTest, AddRow_RowsFit_NotSentUntilFlush)
+{
+    auto inserter = conn.make_batch_inserter("INSERT INTO t VALUES");
+    inserter.add_row(makevalues(1, "a'b"), err, info);
+    inserter.add_row(makevalues(2, nullptr), err, info);
+    EXPECT_EQ(err, error_code());
+    EXPECT_EQ(inserter.pending_rows(), 2);
+    EXPECT_EQ(stream().bytes_written().size(), 0);
+
+    stream().add_bytes_to_read(make_ok_packet(2));
+    inserter.flush(err, info);
+    EXPECT_EQ(err, error_code());
+    EXPECT_EQ(info, error_info());
+    EXPECT_EQ(stream().bytes_written(), make_query_packet("INSERT INTO t VALUES (1,'a\\'b'),(2,NULL)"));
+    EXPECT_EQ(inserter.pending_rows(), 0);
+    EXPECT_EQ(inserter.affected_rows(), 2);
+}
+
+TEST_F(BatchInserterTest, AddRow_RowDoesNotFit_PreviousRowsSent)
+{
+    // The COM_QUERY payload with two rows takes exactly 29 bytes
+    auto inserter = conn.make_batch_inserter("INSERT INTO t VALUES", 29);
+    stream().add_bytes_to_read(make_ok_packet(2));
+    stream().add_bytes_to_read(make_ok_packet(1));
+    inserter.add_row(makevalues(1));
+    inserter.add_row(makevalues(2));
+    EXPECT_EQ(stream().bytes_written().size(), 0);
+
+    inserter.add_row(makevalues(3));
+    EXPECT_EQ(stream().bytes_written(), make_query_packet("INSERT INTO t VALUES (1),(2)"));
+    EXPECT_EQ(inserter.pending_rows(), 1);
+    EXPECT_EQ(inserter.affected_rows(), 2);
+
+    // The row that didn't fit is the first one in the next statement
+    stream().clear_bytes_written();
+    inserter.flush();
+    EXPECT_EQ(stream().bytes_written(), make_query_packet("INSERT INTO t VALUES (3)"));
+    EXPECT_EQ(inserter.pending_rows(), 0);
+    EXPECT_EQ(inserter.affected_rows(), 3);
+}
+
+TEST_F(BatchInserterTest, AddRow_SingleRowBiggerThanMaxSize_SentAlone)
+{
+    auto inserter = conn.make_batch_inserter("INSERT INTO t VALUES", 4);
+    stream().add_bytes_to_read(make_ok_packet(1));
+    inserter.add_row(makevalues("long string"));
+    EXPECT_EQ(stream().bytes_written().size(), 0);
+    inserter.flush();
+    EXPECT_EQ(stream().bytes_written(), make_query_packet("INSERT INTO t VALUES ('long string')"));
+}
+
+TEST_F(BatchInserterTest, AddRow_UnformattableValue_ReturnsErrorAndRowDiscarded)
+{
+    auto inserter = conn.make_batch_inserter("INSERT INTO t VALUES");
+    inserter.add_row(makevalues(1));
+    inserter.add_row(makevalues(2, std::numeric_limits<double>::infinity()), err, info);
+    EXPECT_EQ(err, boost::mysql::detail::make_error_code(errc::unformattable_value));
+    validate_error_info(info, {"add_row", "1"});
+    EXPECT_EQ(inserter.pending_rows(), 1);
+    EXPECT_THROW(inserter.add_row(makevalues(std::numeric_limits<double>::quiet_NaN())),
+        boost::system::system_error);
+
+    stream().add_bytes_to_read(make_ok_packet(1));
+    inserter.flush();
+    EXPECT_EQ(stream().bytes_written(), make_query_packet("INSERT INTO t VALUES (1)"));
+}
+
+TEST_F(BatchInserterTest, Flush_NoPendingRows_NothingSent)
+{
+    auto inserter = conn.make_batch_inserter("INSERT INTO t VALUES");
+    inserter.flush(err, info);
+    EXPECT_EQ(err, error_code());
+    EXPECT_EQ(stream().bytes_written().size(), 0);
+}
+
+TEST_F(BatchInserterTest, Flush_ErrorReadingResponse_ReturnsError)
+{
+    auto inserter = conn.make_batch_inserter("INSERT INTO t VALUES");
+    inserter.add_row(makevalues(1));
+    inserter.flush(err, info);
+    EXPECT_EQ(err, error_code(boost::asio::error::eof));
+    EXPECT_EQ(inserter.pending_rows(), 1);
+}
+
+TEST_F(BatchInserterTest, AsyncAddRowAndFlush_Ok)
+{
+    auto inserter = conn.make_batch_inserter("INSERT INTO t VALUES", 29);
+    stream().add_bytes_to_read(make_ok_packet(2));
+    stream().add_bytes_to_read(make_ok_packet(1));
+    std::vector<error_code> results;
+    auto handler = [&results](error_code ec) { results.push_back(ec); };
+
+    inserter.async_add_row(makevalues(1), handler, &info);
+    ctx.run();
+    ctx.restart();
+    inserter.async_add_row(makevalues(2), handler, &info);
+    ctx.run();
+    ctx.restart();
+    inserter.async_add_row(makevalues(3), handler, &info);
+    ctx.run();
+    ctx.restart();
+    EXPECT_EQ(stream().bytes_written(), make_query_packet("INSERT INTO t VALUES (1),(2)"));
+
+    stream().clear_bytes_written();
+    inserter.async_flush(handler, &info);
+    ctx.run();
+    EXPECT_EQ(stream().bytes_written(), make_query_packet("INSERT INTO t VALUES (3)"));
+    EXPECT_EQ(results, std::vector<error_code>(4));
+    EXPECT_EQ(inserter.affected_rows(), 3);
+    EXPECT_EQ(inserter.pending_rows(), 0);
+}
+
+TEST_F(BatchInserterTest, AsyncAddRow_UnformattableValue_ReturnsError)
+{
+    auto inserter = conn.make_batch_inserter("INSERT INTO t VALUES");
+    error_code result;
+    inserter.async_add_row(makevalues(std::numeric_limits<float>::infinity()),
+        [&result](error_code ec) { result = ec; }, &info);
+    ctx.run();
+    EXPECT_EQ(result, boost::mysql::detail::make_error_code(errc::unformattable_value));
+    validate_error_info(info, {"add_row"});
+    EXPECT_EQ(inserter.pending_rows(), 0);
+}
+
+}
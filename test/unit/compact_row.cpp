@@ -0,0 +1,166 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include "boost/mysql/compact_row.hpp"
+#include "test_common.hpp"
+#include <limits>
+
+using namespace boost::mysql::test;
+using namespace testing;
+using boost::mysql::value;
+using boost::mysql::compact_value;
+using boost::mysql::compact_row;
+using boost::mysql::owning_row;
+using boost::mysql::detail::resource_bytestring;
+
+namespace
+{
+
+// compact_value
+struct compact_value_testcase : named_param
+{
+    std::string name;
+    value v;
+    compact_value::kind expected_kind;
+
+    compact_value_testcase(std::string name, value v, compact_value::kind expected_kind) :
+        name(std::move(name)), v(v), expected_kind(expected_kind) {}
+};
+
+struct CompactValueTest : TestWithParam<compact_value_testcase>
+{
+};
+
+TEST_P(CompactValueTest, FromValueToValue_Trivial_SameValue)
+{
+    auto cv = compact_value::from_value(GetParam().v, nullptr);
+    EXPECT_EQ(cv.type(), GetParam().expected_kind);
+    EXPECT_EQ(cv.is_null(), GetParam().v.is_null());
+    EXPECT_EQ(cv.to_value(nullptr), GetParam().v);
+}
+
+using kind = compact_value::kind;
+
+INSTANTIATE_TEST_SUITE_P(Default, CompactValueTest, Values(
+    compact_value_testcase("null", value(), kind::null),
+    compact_value_testcase("int64_positive", value(42), kind::int64),
+    compact_value_testcase("int64_min", value(std::numeric_limits<std::int64_t>::min()), kind::int64),
+    compact_value_testcase("uint64_max", value(std::numeric_limits<std::uint64_t>::max()), kind::uint64),
+    compact_value_testcase("empty_string", value(""), kind::string),
+    compact_value_testcase("float", value(-4.2f), kind::float_),
+    compact_value_testcase("double", value(-4.2e100), kind::double_),
+    compact_value_testcase("date", value(makedate(2020, 2, 29)), kind::date),
+    compact_value_testcase("date_negative", value(makedate(1900, 1, 1)), kind::date),
+    compact_value_testcase("datetime", value(makedt(2020, 2, 29, 23, 1, 2, 999999)), kind::datetime),
+    compact_value_testcase("time_negative", value(-maket(838, 59, 58, 1)), kind::time)
+), test_name_generator);
+
+TEST(CompactValueTest, FromValueToValue_String_UsesOffsetFromBase)
+{
+    std::string buffer ("0123456789");
+    const auto* base = reinterpret_cast<const std::uint8_t*>(buffer.data());
+    auto cv = compact_value::from_value(value(std::string_view(buffer.data() + 2, 3)), base);
+    EXPECT_EQ(cv.type(), kind::string);
+
+    // The same offset gets applied to a copy of the buffer
+    std::string copy (buffer);
+    auto res = cv.to_value(reinterpret_cast<const std::uint8_t*>(copy.data()));
+    EXPECT_EQ(res, value("234"));
+    EXPECT_EQ(res.get<std::string_view>().data(), copy.data() + 2);
+}
+
+TEST(CompactValueTest, Size_Is16Bytes)
+{
+    EXPECT_EQ(sizeof(compact_value), 16);
+    EXPECT_LT(sizeof(compact_value), sizeof(value));
+}
+
+// compact_row
+owning_row make_owning_row(std::string_view strings, std::vector<value>&& values)
+{
+    return owning_row(std::move(values), resource_bytestring(strings.begin(), strings.end()));
+}
+
+TEST(CompactRowTest, DefaultConstructor_Empty)
+{
+    compact_row r;
+    EXPECT_TRUE(r.empty());
+    EXPECT_EQ(r.size(), 0);
+    EXPECT_EQ(r.to_row(), makerow());
+}
+
+TEST(CompactRowTest, FromOwningRow_StringsInBuffer_TakesOwnershipWithoutCopying)
+{
+    resource_bytestring buffer {'a', 'b', 'c', 'd', 'e'};
+    const char* data = reinterpret_cast<const char*>(buffer.data());
+    std::vector<value> values {
+        value(std::string_view(data + 3, 2)),
+        value(10),
+        value(std::string_view(data, 3)),
+        value()
+    };
+    compact_row r (owning_row(std::move(values), std::move(buffer)));
+    ASSERT_EQ(r.size(), 4);
+    EXPECT_EQ(r, makerow("de", 10, "abc", nullptr));
+    EXPECT_EQ(r[0].get<std::string_view>().data(), data + 3);
+    EXPECT_EQ(r[2].get<std::string_view>().data(), data);
+}
+
+TEST(CompactRowTest, FromOwningRow_ExternalStrings_Copied)
+{
+    resource_bytestring buffer {'i', 'n'};
+    std::string external ("external");
+    std::vector<value> values {
+        value(std::string_view(reinterpret_cast<const char*>(buffer.data()), 2)),
+        value(std::string_view(external)),
+        value(4.2)
+    };
+    compact_row r (owning_row(std::move(values), std::move(buffer)));
+    external = "modified";
+    EXPECT_EQ(r, makerow("in", "external", 4.2));
+}
+
+TEST(CompactRowTest, At_OutOfRange_Throws)
+{
+    compact_row r (make_owning_row("", std::vector<value>{value(1)}));
+    EXPECT_EQ(r.at(0), value(1));
+    EXPECT_THROW(r.at(1), std::out_of_range);
+}
+
+TEST(CompactRowTest, MoveConstructor_StringsStillValid)
+{
+    auto input = make_owning_row("", std::vector<value>{});
+    compact_row r (std::move(input));
+    compact_row other (make_owning_row("", std::vector<value>{value("abc"), value(1)}));
+    compact_row moved (std::move(other));
+    r = std::move(moved);
+    EXPECT_EQ(r, makerow("abc", 1));
+}
+
+TEST(CompactRowTest, OperatorsEqNe)
+{
+    compact_row r1 (make_owning_row("", std::vector<value>{value("abc"), value(1)}));
+    compact_row r2 (make_owning_row("", std::vector<value>{value("abc"), value(1)}));
+    compact_row r3 (make_owning_row("", std::vector<value>{value("abc")}));
+    compact_row r4 (make_owning_row("", std::vector<value>{value("abd"), value(1)}));
+    EXPECT_TRUE(r1 == r2);
+    EXPECT_FALSE(r1 != r2);
+    EXPECT_FALSE(r1 == r3);
+    EXPECT_FALSE(r1 == r4);
+    EXPECT_TRUE(r1 != makerow("abc"));
+}
+
+TEST(CompactRowTest, OperatorStream)
+{
+    compact_row r (make_owning_row("", std::vector<value>{value("abc"), value(1)}));
+    std::ostringstream ss;
+    ss << r;
+    EXPECT_EQ(ss.str(), "{abc, 1}");
+}
+
+}
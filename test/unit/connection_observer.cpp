@@ -0,0 +1,374 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include "boost/mysql/connection.hpp"
+#include "boost/mysql/histogram_observer.hpp"
+#include "boost/mysql/span_observer.hpp"
+#include "fake_server_fixture.hpp"
+#include "test_common.hpp"
+#include "test_stream.hpp"
+#include <cstring>
+#include <sstream>
+#include <thread>
+
+using namespace boost::mysql::test;
+using boost::mysql::error_code;
+using boost::mysql::error_info;
+using boost::mysql::errc;
+using boost::mysql::connection_params;
+using boost::mysql::ssl_options;
+using boost::mysql::ssl_mode;
+using boost::mysql::command_type;
+using boost::mysql::command_stats;
+using boost::mysql::handshake_phase;
+using boost::mysql::latency_histogram;
+using boost::mysql::sql_digest;
+using boost::mysql::detail::make_error_code;
+using std::chrono::nanoseconds;
+
+namespace
+{
+
+// Records everything it gets notified of
+struct recording_observer : boost::mysql::connection_observer
+{
+    struct command
+    {
+        command_type type;
+        std::string digest;
+        std::size_t num_rows;
+        std::size_t bytes_written;
+        std::size_t bytes_read;
+        nanoseconds elapsed;
+        nanoseconds decode_time;
+        error_code err;
+    };
+
+    std::vector<handshake_phase> phases;
+    std::vector<std::string> started; // digests
+    std::vector<command> ended;
+    std::size_t bytes_read {0};
+    std::size_t bytes_written {0};
+    std::size_t rows_decoded {0};
+
+    void on_packet_read(std::size_t bytes) override { bytes_read += bytes; }
+    void on_packet_written(std::size_t bytes) override { bytes_written += bytes; }
+    void on_handshake_phase(handshake_phase phase) override { phases.push_back(phase); }
+    void on_command_start(command_type, std::string_view digest) override { started.emplace_back(digest); }
+    void on_row_decoded(nanoseconds) override { ++rows_decoded; }
+    void on_command_end(const command_stats& stats, error_code err) override
+    {
+        ended.push_back(command{stats.type, std::string(stats.sql_digest), stats.num_rows,
+            stats.bytes_written, stats.bytes_read, stats.elapsed, stats.decode_time, err});
+    }
+};
+
+struct ConnectionObserverTest : fake_connection_fixture
+{
+    recording_observer obs;
+
+    // Statements with literals, so digests differ from the SQL
+    ConnectionObserverTest()
+    {
+        server.add_resultset("SELECT * FROM t WHERE id > 0", {"id", "name"}, {
+            makevalues(1, "abc"),
+            makevalues(2, "def"),
+            makevalues(3, nullptr)
+        });
+        server.add_ok("UPDATE t SET name = 'x'", 2);
+        conn.set_observer(&obs);
+    }
+};
+
+TEST_F(ConnectionObserverTest, Handshake_ReportsPhases)
+{
+    conn.handshake(params);
+    EXPECT_EQ(obs.phases, (std::vector<handshake_phase>{
+        handshake_phase::greeting_received,
+        handshake_phase::authenticated
+    }));
+    EXPECT_TRUE(obs.started.empty());
+    EXPECT_TRUE(obs.ended.empty());
+}
+
+TEST_F(ConnectionObserverTest, QueryWithRows_EndsWhenLastRowIsRead)
+{
+    load(server.query_response("SELECT * FROM t WHERE id > 0"));
+    conn.handshake(params);
+    auto result = conn.query("SELECT * FROM t WHERE id > 0");
+    ASSERT_EQ(obs.started, std::vector<std::string>{"SELECT * FROM t WHERE id > ?"});
+    EXPECT_TRUE(obs.ended.empty());
+
+    result.fetch_one();
+    result.fetch_one();
+    result.fetch_one();
+    EXPECT_TRUE(obs.ended.empty());
+    EXPECT_EQ(obs.rows_decoded, 3);
+
+    result.fetch_one(); // EOF
+    ASSERT_EQ(obs.ended.size(), 1);
+    const auto& cmd = obs.ended[0];
+    EXPECT_EQ(cmd.type, command_type::query);
+    EXPECT_EQ(cmd.digest, "SELECT * FROM t WHERE id > ?");
+    EXPECT_EQ(cmd.num_rows, 3);
+    EXPECT_EQ(cmd.bytes_written, 4 + 1 + std::strlen("SELECT * FROM t WHERE id > 0"));
+    EXPECT_EQ(cmd.bytes_read, server.query_response("SELECT * FROM t WHERE id > 0").size());
+    EXPECT_GE(cmd.elapsed, cmd.decode_time);
+    EXPECT_EQ(cmd.err, error_code());
+}
+
+TEST_F(ConnectionObserverTest, QueryWithoutRows_EndsImmediately)
+{
+    load(server.query_response("UPDATE t SET name = 'x'"));
+    conn.handshake(params);
+    conn.query("UPDATE t SET name = 'x'");
+    ASSERT_EQ(obs.ended.size(), 1);
+    EXPECT_EQ(obs.ended[0].digest, "UPDATE t SET name = ?");
+    EXPECT_EQ(obs.ended[0].num_rows, 0);
+    EXPECT_EQ(obs.ended[0].err, error_code());
+}
+
+TEST_F(ConnectionObserverTest, QueryError_EndsWithError)
+{
+    load(server.query_response("DROP TABLE t"));
+    conn.handshake(params);
+    error_code err;
+    error_info info;
+    conn.query("DROP TABLE t", err, info);
+    ASSERT_EQ(obs.ended.size(), 1);
+    EXPECT_EQ(obs.ended[0].err, make_error_code(errc::no_such_table));
+}
+
+TEST_F(ConnectionObserverTest, NetworkError_EndsWithError)
+{
+    conn.handshake(params);
+    error_code err;
+    error_info info;
+    conn.query("SELECT * FROM t WHERE id > 0", err, info); // no response available
+    EXPECT_NE(err, error_code());
+    ASSERT_EQ(obs.ended.size(), 1);
+    EXPECT_EQ(obs.ended[0].err, err);
+}
+
+TEST_F(ConnectionObserverTest, Statements_ReportEachCommand)
+{
+    load(server.prepare_response("SELECT * FROM t WHERE id > 0"));
+    load(server.execute_response("SELECT * FROM t WHERE id > 0"));
+    conn.handshake(params);
+    auto stmt = conn.prepare_statement("SELECT * FROM t WHERE id > 0");
+    auto result = stmt.execute(boost::mysql::no_statement_params);
+    result.fetch_all();
+    stmt.close();
+    conn.quit();
+
+    ASSERT_EQ(obs.ended.size(), 4);
+    EXPECT_EQ(obs.ended[0].type, command_type::prepare);
+    EXPECT_EQ(obs.ended[0].digest, "SELECT * FROM t WHERE id > ?");
+    EXPECT_EQ(obs.ended[1].type, command_type::execute);
+    EXPECT_EQ(obs.ended[1].digest, "");
+    EXPECT_EQ(obs.ended[1].num_rows, 3);
+    EXPECT_EQ(obs.ended[2].type, command_type::close_statement);
+    EXPECT_EQ(obs.ended[2].bytes_read, 0);
+    EXPECT_EQ(obs.ended[3].type, command_type::quit);
+    for (const auto& cmd: obs.ended)
+        EXPECT_EQ(cmd.err, error_code());
+}
+
+TEST_F(ConnectionObserverTest, DiscardRemaining_EndsWithoutRows)
+{
+    load(server.query_response("SELECT * FROM t WHERE id > 0"));
+    conn.handshake(params);
+    auto result = conn.query("SELECT * FROM t WHERE id > 0");
+    result.fetch_one();
+    result.discard_remaining();
+    ASSERT_EQ(obs.ended.size(), 1);
+    EXPECT_EQ(obs.ended[0].num_rows, 1);
+    EXPECT_EQ(obs.ended[0].err, error_code());
+}
+
+TEST_F(ConnectionObserverTest, PacketBytes_MatchStream)
+{
+    load(server.query_response("SELECT * FROM t WHERE id > 0"));
+    conn.handshake(params);
+    conn.query("SELECT * FROM t WHERE id > 0").fetch_all();
+    std::size_t total_read = server.handshake_bytes().size() +
+        server.query_response("SELECT * FROM t WHERE id > 0").size();
+    EXPECT_EQ(obs.bytes_read, total_read);
+    EXPECT_EQ(obs.bytes_written, conn.next_layer().bytes_written().size());
+}
+
+TEST_F(ConnectionObserverTest, Async_ReportsSameEvents)
+{
+    load(server.query_response("SELECT * FROM t WHERE id > 0"));
+    bool called = false;
+    boost::mysql::resultset<test_stream> result;
+    conn.async_handshake(params, [&](error_code err) {
+        ASSERT_EQ(err, error_code());
+        conn.async_query("SELECT * FROM t WHERE id > 0", [&](error_code err, boost::mysql::resultset<test_stream> r) {
+            ASSERT_EQ(err, error_code());
+            result = std::move(r);
+            result.async_fetch_all([&](error_code err, std::vector<boost::mysql::owning_row>) {
+                EXPECT_EQ(err, error_code());
+                called = true;
+            });
+        });
+    });
+    ctx.run();
+    ASSERT_TRUE(called);
+    EXPECT_EQ(obs.phases.back(), handshake_phase::authenticated);
+    ASSERT_EQ(obs.ended.size(), 1);
+    EXPECT_EQ(obs.ended[0].num_rows, 3);
+    EXPECT_EQ(obs.ended[0].bytes_read, server.query_response("SELECT * FROM t WHERE id > 0").size());
+}
+
+TEST_F(ConnectionObserverTest, ObserverRemoved_NoMoreNotifications)
+{
+    load(server.query_response("UPDATE t SET name = 'x'"));
+    conn.handshake(params);
+    conn.set_observer(nullptr);
+    EXPECT_EQ(conn.observer(), nullptr);
+    conn.query("UPDATE t SET name = 'x'");
+    EXPECT_TRUE(obs.started.empty());
+}
+
+TEST_F(ConnectionObserverTest, HistogramObserver_RecordsCommands)
+{
+    boost::mysql::histogram_observer hist;
+    conn.set_observer(&hist);
+    load(server.query_response("SELECT * FROM t WHERE id > 0"));
+    load(server.query_response("DROP TABLE t"));
+    conn.handshake(params);
+    conn.query("SELECT * FROM t WHERE id > 0").fetch_all();
+    error_code err;
+    error_info info;
+    conn.query("DROP TABLE t", err, info);
+    EXPECT_EQ(hist.elapsed().count(), 2);
+    EXPECT_EQ(hist.network_time().count(), 2);
+    EXPECT_EQ(hist.decode_time().count(), 2);
+    EXPECT_EQ(hist.num_errors(), 1);
+    EXPECT_LE(hist.decode_time().sum(), hist.elapsed().sum());
+}
+
+TEST_F(ConnectionObserverTest, SpanObserver_ReportsSpans)
+{
+    std::vector<std::string> names;
+    std::vector<std::pair<std::string, std::string>> attrs;
+    boost::mysql::span_observer spans ([&](const boost::mysql::span_record& rec) {
+        names.emplace_back(rec.name);
+        EXPECT_LE(rec.start_time, rec.end_time);
+        rec.for_each_attribute([&](std::string_view key, auto value) {
+            std::ostringstream os;
+            os << value;
+            attrs.emplace_back(key, os.str());
+        });
+    });
+    conn.set_observer(&spans);
+    load(server.query_response("SELECT * FROM t WHERE id > 0"));
+    load(server.prepare_response("UPDATE t SET name = 'x'"));
+    conn.handshake(params);
+    conn.query("SELECT * FROM t WHERE id > 0").fetch_all();
+    conn.prepare_statement("UPDATE t SET name = 'x'");
+
+    EXPECT_EQ(names, (std::vector<std::string>{"SELECT", "prepare"}));
+    ASSERT_GE(attrs.size(), 4);
+    EXPECT_EQ(attrs[0], std::make_pair(std::string("db.system"), std::string("mysql")));
+    EXPECT_EQ(attrs[1], std::make_pair(std::string("db.operation"), std::string("SELECT")));
+    EXPECT_EQ(attrs[2], std::make_pair(std::string("db.statement"), std::string("SELECT * FROM t WHERE id > ?")));
+    EXPECT_EQ(attrs[3], std::make_pair(std::string("db.mysql.rows"), std::string("3")));
+}
+
+// sql_digest
+TEST(SqlDigest, Literals_Replaced)
+{
+    EXPECT_EQ(sql_digest("SELECT 1"), "SELECT ?");
+    EXPECT_EQ(sql_digest("SELECT -1.5e-3, .5, 0x1F, 0b101"), "SELECT -?, ?, ?, ?");
+    EXPECT_EQ(sql_digest("SELECT 'abc', \"def\""), "SELECT ?, ?");
+    EXPECT_EQ(sql_digest("SELECT 'it''s', 'a\\'b'"), "SELECT ?, ?");
+    EXPECT_EQ(sql_digest("SELECT X'1F', b'01', N'abc'"), "SELECT ?, ?, ?");
+    EXPECT_EQ(sql_digest("SELECT * FROM t WHERE a IN (1, 2, 3)"), "SELECT * FROM t WHERE a IN (?, ?, ?)");
+}
+
+TEST(SqlDigest, Identifiers_Kept)
+{
+    EXPECT_EQ(sql_digest("SELECT t1.col2 FROM t1"), "SELECT t1.col2 FROM t1");
+    EXPECT_EQ(sql_digest("SELECT `my col`, `a``b` FROM x"), "SELECT `my col`, `a``b` FROM x");
+    EXPECT_EQ(sql_digest("SELECT x FROM b"), "SELECT x FROM b");
+}
+
+TEST(SqlDigest, WhitespaceAndComments_Collapsed)
+{
+    EXPECT_EQ(sql_digest("  SELECT\n\t*   FROM t  "), "SELECT * FROM t");
+    EXPECT_EQ(sql_digest("SELECT /* hint */ a -- comment\nFROM t # another"), "SELECT a FROM t");
+    EXPECT_EQ(sql_digest("SELECT 5--3"), "SELECT ?--?"); // not a comment
+    EXPECT_EQ(sql_digest("SELECT 'abc"), "SELECT ?"); // unterminated
+    EXPECT_EQ(sql_digest(""), "");
+}
+
+// latency_histogram
+TEST(LatencyHistogram, Empty)
+{
+    latency_histogram hist;
+    EXPECT_EQ(hist.count(), 0);
+    EXPECT_EQ(hist.sum(), nanoseconds(0));
+    EXPECT_EQ(hist.percentile(0.5), nanoseconds(0));
+}
+
+TEST(LatencyHistogram, Record_UsesLogBuckets)
+{
+    latency_histogram hist;
+    hist.record(nanoseconds(0));
+    hist.record(nanoseconds(1));
+    hist.record(nanoseconds(1000)); // [512, 1024)
+    hist.record(nanoseconds(1024)); // [1024, 2048)
+    hist.record(nanoseconds(-5));   // as zero
+    EXPECT_EQ(hist.count(), 5);
+    EXPECT_EQ(hist.sum(), nanoseconds(2025));
+    EXPECT_EQ(hist.bucket_count(0), 2);
+    EXPECT_EQ(hist.bucket_count(1), 1);
+    EXPECT_EQ(hist.bucket_count(10), 1);
+    EXPECT_EQ(hist.bucket_count(11), 1);
+    EXPECT_EQ(latency_histogram::bucket_upper_bound(10), nanoseconds(1024));
+    EXPECT_EQ(latency_histogram::bucket_upper_bound(latency_histogram::num_buckets - 1), nanoseconds::max());
+}
+
+TEST(LatencyHistogram, Percentile)
+{
+    latency_histogram hist;
+    for (int i = 0; i < 90; ++i)
+        hist.record(nanoseconds(100)); // [64, 128)
+    for (int i = 0; i < 10; ++i)
+        hist.record(std::chrono::milliseconds(10)); // [2^23, 2^24)
+    EXPECT_EQ(hist.percentile(0.0), nanoseconds(128));
+    EXPECT_EQ(hist.percentile(0.5), nanoseconds(128));
+    EXPECT_EQ(hist.percentile(0.9), nanoseconds(128));
+    EXPECT_EQ(hist.percentile(0.95), nanoseconds(1 << 24));
+    EXPECT_EQ(hist.percentile(1.0), nanoseconds(1 << 24));
+
+    hist.reset();
+    EXPECT_EQ(hist.count(), 0);
+    EXPECT_EQ(hist.sum(), nanoseconds(0));
+}
+
+TEST(LatencyHistogram, ConcurrentRecording)
+{
+    latency_histogram hist;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i)
+    {
+        threads.emplace_back([&hist] {
+            for (int j = 0; j < 10000; ++j)
+                hist.record(nanoseconds(j));
+        });
+    }
+    for (auto& t: threads)
+        t.join();
+    EXPECT_EQ(hist.count(), 40000);
+    EXPECT_EQ(hist.sum(), nanoseconds(4 * (9999 * 10000 / 2)));
+}
+
+} // anon namespace
@@ -0,0 +1,188 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include "boost/mysql/connection_pool.hpp"
+#include "fake_server_fixture.hpp"
+#include "test_common.hpp"
+#include <optional>
+
+using namespace boost::mysql::test;
+using boost::mysql::error_code;
+using boost::mysql::error_info;
+using boost::mysql::connection_params;
+using boost::mysql::ssl_options;
+using boost::mysql::ssl_mode;
+using boost::mysql::pool_options;
+using boost::mysql::pooled_connection;
+using boost::mysql::resilient_connection;
+using std::chrono::milliseconds;
+
+namespace
+{
+
+using pool_type = boost::mysql::connection_pool<boost::asio::ip::tcp::socket>;
+using pooled_type = pooled_connection<boost::asio::ip::tcp::socket>;
+
+const boost::asio::ip::tcp::endpoint any_port {boost::asio::ip::address_v4::loopback(), 0};
+
+struct ConnectionPoolTest : fake_server_fixture
+{
+    ConnectionPoolTest()
+    {
+        server.add_resultset("SELECT 1", {"1"}, {makevalues(1)});
+    }
+
+    static pool_options make_options(std::size_t max_size)
+    {
+        pool_options res;
+        res.max_size = max_size;
+        res.retry.max_retries = 0;
+        return res;
+    }
+};
+
+TEST_F(ConnectionPoolTest, Constructor_NoConnections)
+{
+    pool_type pool (ctx.get_executor(), any_port, params);
+    EXPECT_EQ(pool.size(), 0);
+    EXPECT_EQ(pool.num_idle(), 0);
+    EXPECT_EQ(pool.num_in_use(), 0);
+}
+
+TEST_F(ConnectionPoolTest, Acquire_Released_ReusesConnection)
+{
+    fake_tcp_server tcp_server (server, any_port);
+    pool_type pool (ctx.get_executor(), tcp_server.endpoint(), params);
+
+    auto conn = pool.acquire();
+    ASSERT_TRUE(conn.valid());
+    EXPECT_EQ(conn->query("SELECT 1").size(), 1);
+    auto* first = &conn.get();
+    EXPECT_EQ(&conn.pool(), &pool);
+    EXPECT_EQ(pool.num_in_use(), 1);
+
+    conn.release();
+    EXPECT_FALSE(conn.valid());
+    EXPECT_EQ(pool.num_idle(), 1);
+
+    conn = pool.acquire();
+    EXPECT_EQ(&conn.get(), first);
+    EXPECT_EQ(pool.size(), 1);
+}
+
+TEST_F(ConnectionPoolTest, Acquire_SeveralInUse_OpensNewConnections)
+{
+    fake_tcp_server tcp_server (server, any_port);
+    pool_type pool (ctx.get_executor(), tcp_server.endpoint(), params);
+
+    auto conn1 = pool.acquire();
+    auto conn2 = pool.acquire();
+    EXPECT_NE(&conn1.get(), &conn2.get());
+    EXPECT_EQ(pool.size(), 2);
+    EXPECT_EQ(pool.num_in_use(), 2);
+}
+
+TEST_F(ConnectionPoolTest, Acquire_Full_WouldBlock)
+{
+    fake_tcp_server tcp_server (server, any_port);
+    pool_type pool (ctx.get_executor(), tcp_server.endpoint(), params, make_options(1));
+
+    auto conn1 = pool.acquire();
+    error_code err;
+    error_info info;
+    auto conn2 = pool.acquire(err, info);
+    EXPECT_EQ(err, boost::asio::error::would_block);
+    EXPECT_EQ(info.message(), "All the connections in the pool are in use");
+    EXPECT_FALSE(conn2.valid());
+}
+
+TEST_F(ConnectionPoolTest, Acquire_ConnectFails_ConnectionDiscarded)
+{
+    boost::asio::ip::tcp::endpoint unused;
+    {
+        fake_tcp_server tcp_server (server, any_port);
+        unused = tcp_server.endpoint();
+    }
+    pool_type pool (ctx.get_executor(), unused, params, make_options(4));
+
+    error_code err;
+    error_info info;
+    auto conn = pool.acquire(err, info);
+    EXPECT_NE(err, error_code());
+    EXPECT_FALSE(conn.valid());
+    EXPECT_EQ(pool.size(), 0);
+}
+
+TEST_F(ConnectionPoolTest, PooledConnection_MovedAndDestroyed_ReleasesOnce)
+{
+    fake_tcp_server tcp_server (server, any_port);
+    pool_type pool (ctx.get_executor(), tcp_server.endpoint(), params);
+    {
+        auto conn1 = pool.acquire();
+        pooled_type conn2 (std::move(conn1));
+        EXPECT_FALSE(conn1.valid());
+        EXPECT_TRUE(conn2.valid());
+    }
+    EXPECT_EQ(pool.num_idle(), 1);
+    EXPECT_EQ(pool.size(), 1);
+}
+
+TEST_F(ConnectionPoolTest, AsyncAcquire_Idle_ReturnsIt)
+{
+    fake_tcp_server tcp_server (server, any_port);
+    pool_type pool (ctx.get_executor(), tcp_server.endpoint(), params);
+    pool.acquire().release();
+
+    std::optional<error_code> err;
+    pooled_type conn;
+    pool.async_acquire([&](error_code ec, pooled_type c) { err = ec; conn = std::move(c); });
+    EXPECT_FALSE(err); // never completes inline
+    ctx.run();
+    ASSERT_TRUE(err);
+    EXPECT_EQ(*err, error_code());
+    EXPECT_TRUE(conn.valid());
+    EXPECT_EQ(pool.size(), 1);
+}
+
+TEST_F(ConnectionPoolTest, AsyncAcquire_Empty_Connects)
+{
+    fake_tcp_server tcp_server (server, any_port);
+    pool_type pool (ctx.get_executor(), tcp_server.endpoint(), params);
+
+    std::optional<error_code> err;
+    pooled_type conn;
+    pool.async_acquire([&](error_code ec, pooled_type c) { err = ec; conn = std::move(c); });
+    ctx.run();
+    ASSERT_TRUE(err);
+    EXPECT_EQ(*err, error_code());
+    ASSERT_TRUE(conn.valid());
+    EXPECT_TRUE(conn->is_connected());
+}
+
+TEST_F(ConnectionPoolTest, AsyncAcquire_Full_WaitsForRelease)
+{
+    fake_tcp_server tcp_server (server, any_port);
+    pool_type pool (ctx.get_executor(), tcp_server.endpoint(), params, make_options(1));
+    auto conn1 = pool.acquire();
+    auto* first = &conn1.get();
+
+    std::optional<error_code> err;
+    pooled_type conn2;
+    pool.async_acquire([&](error_code ec, pooled_type c) { err = ec; conn2 = std::move(c); });
+    ctx.poll();
+    EXPECT_FALSE(err);
+
+    conn1.release();
+    ctx.run();
+    ASSERT_TRUE(err);
+    EXPECT_EQ(*err, error_code());
+    EXPECT_EQ(&conn2.get(), first);
+    EXPECT_EQ(pool.size(), 1);
+}
+
+} // anon namespace
@@ -0,0 +1,254 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include "boost/mysql/connection.hpp"
+#include "fake_server_fixture.hpp"
+#include "test_common.hpp"
+#include "test_stream.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+using namespace boost::mysql::test;
+using boost::mysql::error_code;
+using boost::mysql::error_info;
+using boost::mysql::errc;
+using boost::mysql::connection_params;
+using boost::mysql::connection_stats;
+using boost::mysql::ssl_options;
+using boost::mysql::ssl_mode;
+using boost::mysql::detail::make_error_code;
+using std::chrono::nanoseconds;
+
+namespace
+{
+
+struct ConnectionStatsTest : fake_connection_fixture
+{
+};
+
+TEST_F(ConnectionStatsTest, NewConnection_AllZero)
+{
+    auto stats = conn.stats();
+    EXPECT_EQ(stats.bytes_read, 0);
+    EXPECT_EQ(stats.bytes_written, 0);
+    EXPECT_EQ(stats.packets_read, 0);
+    EXPECT_EQ(stats.packets_written, 0);
+    EXPECT_EQ(stats.queries, 0);
+    EXPECT_EQ(stats.rows_decoded, 0);
+    EXPECT_EQ(stats.read_time, nanoseconds(0));
+    EXPECT_EQ(stats.write_time, nanoseconds(0));
+}
+
+TEST_F(ConnectionStatsTest, Handshake_CountsPackets)
+{
+    conn.handshake(params);
+    auto stats = conn.stats();
+    EXPECT_EQ(stats.packets_read, 2); // greeting, OK
+    EXPECT_EQ(stats.packets_written, 1); // handshake response
+    EXPECT_EQ(stats.bytes_read, server.handshake_bytes().size());
+    EXPECT_EQ(stats.bytes_written, conn.next_layer().bytes_written().size());
+    EXPECT_EQ(stats.queries, 0);
+}
+
+TEST_F(ConnectionStatsTest, Query_CountsQueryAndRows)
+{
+    load(server.query_response("SELECT * FROM t"));
+    conn.handshake(params);
+    auto before = conn.stats();
+    conn.next_layer().clear_bytes_written();
+    conn.query("SELECT * FROM t").fetch_all();
+    auto stats = conn.stats() - before;
+
+    EXPECT_EQ(stats.queries, 1);
+    EXPECT_EQ(stats.rows_decoded, 3);
+    EXPECT_EQ(stats.decode_errors, 0);
+    EXPECT_EQ(stats.packets_written, 1);
+    EXPECT_EQ(stats.bytes_written, 4 + 1 + std::strlen("SELECT * FROM t"));
+    EXPECT_EQ(stats.bytes_written, conn.next_layer().bytes_written().size());
+    EXPECT_EQ(stats.bytes_read, server.query_response("SELECT * FROM t").size());
+    EXPECT_EQ(stats.packets_read, 1 + 2 + 3 + 1); // field count, fields, rows, EOF
+}
+
+TEST_F(ConnectionStatsTest, Statements_CountsEachCommand)
+{
+    load(server.prepare_response("SELECT * FROM t"));
+    load(server.execute_response("SELECT * FROM t"));
+    load(server.execute_response("SELECT * FROM t"));
+    conn.handshake(params);
+    auto stmt = conn.prepare_statement("SELECT * FROM t");
+    stmt.execute(boost::mysql::no_statement_params).fetch_all();
+    stmt.execute(boost::mysql::no_statement_params).fetch_all();
+    stmt.close();
+    conn.quit();
+
+    auto stats = conn.stats();
+    EXPECT_EQ(stats.queries, 0);
+    EXPECT_EQ(stats.statements_prepared, 1);
+    EXPECT_EQ(stats.statements_executed, 2);
+    EXPECT_EQ(stats.statements_closed, 1);
+    EXPECT_EQ(stats.rows_decoded, 6);
+}
+
+TEST_F(ConnectionStatsTest, DiscardRemaining_RowsNotCounted)
+{
+    load(server.query_response("SELECT * FROM t"));
+    conn.handshake(params);
+    auto result = conn.query("SELECT * FROM t");
+    result.fetch_one();
+    result.discard_remaining();
+    auto stats = conn.stats();
+    EXPECT_EQ(stats.rows_decoded, 1);
+    EXPECT_EQ(stats.bytes_read, server.handshake_bytes().size() + server.query_response("SELECT * FROM t").size());
+}
+
+TEST_F(ConnectionStatsTest, ServerError_NotADecodeError)
+{
+    load(server.query_response("DROP TABLE t"));
+    conn.handshake(params);
+    error_code err;
+    error_info info;
+    conn.query("DROP TABLE t", err, info);
+    EXPECT_EQ(err, make_error_code(errc::no_such_table));
+    EXPECT_EQ(conn.stats().queries, 1);
+    EXPECT_EQ(conn.stats().decode_errors, 0);
+}
+
+TEST_F(ConnectionStatsTest, MalformedRow_CountsDecodeError)
+{
+    // Make the string in the first row longer than its message
+    auto response = server.query_response("SELECT * FROM t");
+    const std::uint8_t abc [] = {3, 'a', 'b', 'c'};
+    auto it = std::search(response.begin(), response.end(), std::begin(abc), std::end(abc));
+    ASSERT_NE(it, response.end());
+    *it = 5;
+    load(response);
+    conn.handshake(params);
+
+    error_code err;
+    error_info info;
+    auto result = conn.query("SELECT * FROM t");
+    result.fetch_one(err, info);
+    EXPECT_EQ(err, make_error_code(errc::incomplete_message));
+    auto stats = conn.stats();
+    EXPECT_EQ(stats.rows_decoded, 0);
+    EXPECT_EQ(stats.decode_errors, 1);
+}
+
+TEST_F(ConnectionStatsTest, IoError_NotCounted)
+{
+    conn.handshake(params);
+    auto before = conn.stats();
+    error_code err;
+    error_info info;
+    conn.query("SELECT * FROM t", err, info); // no response available
+    EXPECT_NE(err, error_code());
+    auto stats = conn.stats() - before;
+    EXPECT_EQ(stats.queries, 1);
+    EXPECT_EQ(stats.packets_written, 1);
+    EXPECT_EQ(stats.packets_read, 0);
+    EXPECT_EQ(stats.bytes_read, 0);
+    EXPECT_EQ(stats.decode_errors, 0);
+}
+
+TEST_F(ConnectionStatsTest, Async_CountsSameAsSync)
+{
+    load(server.query_response("SELECT * FROM t"));
+    bool called = false;
+    boost::mysql::resultset<test_stream> result;
+    conn.async_handshake(params, [&](error_code err) {
+        ASSERT_EQ(err, error_code());
+        conn.async_query("SELECT * FROM t", [&](error_code err, boost::mysql::resultset<test_stream> r) {
+            ASSERT_EQ(err, error_code());
+            result = std::move(r);
+            result.async_fetch_all([&](error_code err, std::vector<boost::mysql::owning_row>) {
+                EXPECT_EQ(err, error_code());
+                called = true;
+            });
+        });
+    });
+    ctx.run();
+    ASSERT_TRUE(called);
+
+    auto stats = conn.stats();
+    EXPECT_EQ(stats.queries, 1);
+    EXPECT_EQ(stats.rows_decoded, 3);
+    EXPECT_EQ(stats.packets_written, 2);
+    EXPECT_EQ(stats.bytes_written, conn.next_layer().bytes_written().size());
+    EXPECT_EQ(stats.bytes_read, server.handshake_bytes().size() + server.query_response("SELECT * FROM t").size());
+    EXPECT_GE(stats.read_time, nanoseconds(0));
+    EXPECT_GE(stats.write_time, nanoseconds(0));
+}
+
+TEST_F(ConnectionStatsTest, ReadAhead_SameCounts)
+{
+    load(server.query_response("SELECT * FROM t"));
+    conn.set_read_ahead_size(16384);
+    conn.handshake(params);
+    conn.query("SELECT * FROM t").fetch_all();
+    auto stats = conn.stats();
+    EXPECT_EQ(stats.rows_decoded, 3);
+    EXPECT_EQ(stats.bytes_read, server.handshake_bytes().size() + server.query_response("SELECT * FROM t").size());
+}
+
+TEST_F(ConnectionStatsTest, ConcurrentSnapshots_Monotonic)
+{
+    constexpr int num_queries = 200;
+    for (int i = 0; i < num_queries; ++i)
+        load(server.query_response("SELECT * FROM t"));
+    conn.handshake(params);
+
+    std::atomic<bool> done {false};
+    bool monotonic = true;
+    std::thread reader ([&] {
+        connection_stats prev;
+        while (!done.load())
+        {
+            auto current = conn.stats();
+            if (current.rows_decoded < prev.rows_decoded || current.bytes_read < prev.bytes_read)
+                monotonic = false;
+            prev = current;
+        }
+    });
+    for (int i = 0; i < num_queries; ++i)
+        conn.query("SELECT * FROM t").fetch_all();
+    done = true;
+    reader.join();
+
+    EXPECT_TRUE(monotonic);
+    EXPECT_EQ(conn.stats().queries, num_queries);
+    EXPECT_EQ(conn.stats().rows_decoded, 3 * num_queries);
+}
+
+TEST(ConnectionStats, Arithmetic)
+{
+    connection_stats a;
+    a.bytes_read = 10;
+    a.queries = 2;
+    a.read_time = nanoseconds(100);
+    connection_stats b;
+    b.bytes_read = 5;
+    b.queries = 1;
+    b.decode_errors = 1;
+    b.read_time = nanoseconds(50);
+
+    auto sum = a + b;
+    EXPECT_EQ(sum.bytes_read, 15);
+    EXPECT_EQ(sum.queries, 3);
+    EXPECT_EQ(sum.decode_errors, 1);
+    EXPECT_EQ(sum.read_time, nanoseconds(150));
+
+    auto diff = sum - b;
+    EXPECT_EQ(diff.bytes_read, 10);
+    EXPECT_EQ(diff.queries, 2);
+    EXPECT_EQ(diff.decode_errors, 0);
+    EXPECT_EQ(diff.read_time, nanoseconds(100));
+}
+
+} // anon namespace
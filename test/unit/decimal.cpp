@@ -0,0 +1,291 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include "boost/mysql/decimal.hpp"
+#include "boost/mysql/value.hpp"
+#include "boost/mysql/detail/protocol/text_deserialization.hpp"
+#include "boost/mysql/detail/protocol/binary_deserialization.hpp"
+#include "test_common.hpp"
+#include <limits>
+#include <sstream>
+
+using namespace boost::mysql::test;
+using namespace testing;
+using boost::mysql::decimal;
+using boost::mysql::value;
+using boost::mysql::field_metadata;
+using boost::mysql::error_code;
+using namespace boost::mysql::detail;
+
+namespace
+{
+
+const std::string max_digits (38, '9');
+
+// parse and to_string
+struct decimal_parse_testcase : named_param
+{
+    std::string name;
+    std::string input;
+    std::string expected; // output of to_string
+    unsigned expected_scale;
+
+    decimal_parse_testcase(std::string name, std::string input, std::string expected, unsigned expected_scale) :
+        name(std::move(name)), input(std::move(input)), expected(std::move(expected)), expected_scale(expected_scale) {}
+};
+
+struct DecimalParseTest : TestWithParam<decimal_parse_testcase>
+{
+};
+
+TEST_P(DecimalParseTest, ParseToString_ValidInput_ReturnsExpected)
+{
+    auto res = decimal::parse(GetParam().input);
+    ASSERT_TRUE(res.has_value());
+    EXPECT_EQ(res->scale(), GetParam().expected_scale);
+    EXPECT_EQ(res->to_string(), GetParam().expected);
+}
+
+INSTANTIATE_TEST_SUITE_P(Default, DecimalParseTest, Values(
+    decimal_parse_testcase("zero", "0", "0", 0),
+    decimal_parse_testcase("zero_scale", "0.00", "0.00", 2),
+    decimal_parse_testcase("negative_zero", "-0.0", "0.0", 1),
+    decimal_parse_testcase("integer", "1234", "1234", 0),
+    decimal_parse_testcase("positive_sign", "+1234", "1234", 0),
+    decimal_parse_testcase("negative_integer", "-1234", "-1234", 0),
+    decimal_parse_testcase("fractional", "20.52", "20.52", 2),
+    decimal_parse_testcase("trailing_zeros", "-20.5200", "-20.5200", 4),
+    decimal_parse_testcase("leading_zeros", "000020.5", "20.5", 1),
+    decimal_parse_testcase("less_than_one", "0.001", "0.001", 3),
+    decimal_parse_testcase("no_integer_part", "-.25", "-0.25", 2),
+    decimal_parse_testcase("no_fractional_part", "25.", "25", 0),
+    decimal_parse_testcase("max_digits", max_digits, max_digits, 0),
+    decimal_parse_testcase("max_digits_negative_scale", "-0." + max_digits, "-0." + max_digits, 38),
+    decimal_parse_testcase("max_digits_leading_zeros", "00" + max_digits, max_digits, 0),
+    decimal_parse_testcase("above_64_bits", "123456789012345678901234567890",
+        "123456789012345678901234567890", 0)
+), test_name_generator);
+
+struct decimal_parse_error_testcase : named_param
+{
+    std::string name;
+    std::string input;
+
+    decimal_parse_error_testcase(std::string name, std::string input) :
+        name(std::move(name)), input(std::move(input)) {}
+};
+
+struct DecimalParseErrorTest : TestWithParam<decimal_parse_error_testcase>
+{
+};
+
+TEST_P(DecimalParseErrorTest, Parse_InvalidInput_ReturnsEmpty)
+{
+    EXPECT_FALSE(decimal::parse(GetParam().input).has_value());
+}
+
+INSTANTIATE_TEST_SUITE_P(Default, DecimalParseErrorTest, Values(
+    decimal_parse_error_testcase("empty", ""),
+    decimal_parse_error_testcase("only_sign", "-"),
+    decimal_parse_error_testcase("only_dot", "."),
+    decimal_parse_error_testcase("two_dots", "1.2.3"),
+    decimal_parse_error_testcase("two_signs", "--1"),
+    decimal_parse_error_testcase("letters", "12a"),
+    decimal_parse_error_testcase("exponent", "1e10"),
+    decimal_parse_error_testcase("spaces", " 1"),
+    decimal_parse_error_testcase("too_many_digits", max_digits + "9"),
+    decimal_parse_error_testcase("too_many_fractional_digits", "0." + std::string(39, '0'))
+), test_name_generator);
+
+// Construction and conversions
+TEST(DecimalTest, DefaultConstructor_Zero)
+{
+    decimal d;
+    EXPECT_EQ(d.scale(), 0);
+    EXPECT_FALSE(d.is_negative());
+    EXPECT_EQ(d.to_string(), "0");
+}
+
+TEST(DecimalTest, IntegerConstructor)
+{
+    EXPECT_EQ(decimal(-12345, 2).to_string(), "-123.45");
+    EXPECT_EQ(decimal(5, 3).to_string(), "0.005");
+    EXPECT_EQ(decimal(std::numeric_limits<std::int64_t>::min()).to_string(), "-9223372036854775808");
+}
+
+TEST(DecimalTest, ToChars_MatchesToString)
+{
+    char buffer [decimal::max_string_size];
+    std::string smallest = "-0." + std::string(38, '9');
+    auto d = *decimal::parse(smallest);
+    EXPECT_EQ(std::string(buffer, d.to_chars(buffer)), smallest);
+    EXPECT_EQ(std::string(buffer, decimal(-12345, 2).to_chars(buffer)), "-123.45");
+    EXPECT_EQ(std::string(buffer, decimal().to_chars(buffer)), "0");
+}
+
+TEST(DecimalTest, ToDouble)
+{
+    EXPECT_DOUBLE_EQ(decimal(-12345, 2).to_double(), -123.45);
+    EXPECT_DOUBLE_EQ(decimal::parse("123456789012345678901234567890.5")->to_double(), 1.234567890123456789e29);
+}
+
+TEST(DecimalTest, Rescale_Increase_Exact)
+{
+    EXPECT_EQ(decimal(-125, 2).rescale(5)->to_string(), "-1.25000");
+}
+
+TEST(DecimalTest, Rescale_Decrease_RoundsHalfAwayFromZero)
+{
+    EXPECT_EQ(decimal(1234, 3).rescale(2)->to_string(), "1.23");
+    EXPECT_EQ(decimal(1235, 3).rescale(2)->to_string(), "1.24");
+    EXPECT_EQ(decimal(-1235, 3).rescale(2)->to_string(), "-1.24");
+    EXPECT_EQ(decimal(-4, 1).rescale(0)->to_string(), "0");
+    EXPECT_EQ(decimal(-5, 1).rescale(0)->to_string(), "-1");
+}
+
+TEST(DecimalTest, Rescale_Overflow_ReturnsEmpty)
+{
+    EXPECT_FALSE(decimal::parse(max_digits)->rescale(1).has_value());
+    EXPECT_FALSE(decimal(1).rescale(39).has_value());
+    EXPECT_EQ(decimal(1).rescale(37)->to_string(), "1." + std::string(37, '0'));
+}
+
+// Arithmetic
+TEST(DecimalTest, Addition_DifferentScales)
+{
+    auto res = decimal(1050, 2) + decimal(-3, 0);
+    EXPECT_EQ(res.scale(), 2);
+    EXPECT_EQ(res.to_string(), "7.50");
+}
+
+TEST(DecimalTest, Addition_Carry64Bits)
+{
+    auto res = decimal(std::numeric_limits<std::int64_t>::max()) + decimal(std::numeric_limits<std::int64_t>::max());
+    EXPECT_EQ(res.to_string(), "18446744073709551614");
+}
+
+TEST(DecimalTest, Subtraction_ChangesSign)
+{
+    EXPECT_EQ((decimal(1) - decimal(25, 1)).to_string(), "-1.5");
+    EXPECT_EQ((decimal(-1) - decimal(-25, 1)).to_string(), "1.5");
+    EXPECT_EQ((decimal(15, 1) - decimal(15, 1)).to_string(), "0.0");
+    EXPECT_FALSE((decimal(15, 1) - decimal(15, 1)).is_negative());
+}
+
+TEST(DecimalTest, Subtraction_Borrow64Bits)
+{
+    auto lhs = *decimal::parse("18446744073709551616"); // 2^64
+    EXPECT_EQ((lhs - decimal(1)).to_string(), "18446744073709551615");
+}
+
+TEST(DecimalTest, UnaryMinus)
+{
+    EXPECT_EQ((-decimal(15, 1)).to_string(), "-1.5");
+    EXPECT_EQ((-decimal(-15, 1)).to_string(), "1.5");
+    EXPECT_FALSE((-decimal()).is_negative());
+}
+
+TEST(DecimalTest, Addition_Overflow_Throws)
+{
+    auto max = *decimal::parse(max_digits);
+    EXPECT_THROW(max + decimal(1), std::overflow_error);
+    EXPECT_THROW(-max - decimal(1), std::overflow_error);
+    EXPECT_THROW(max + decimal(1, 1), std::overflow_error); // rescaling overflows
+    EXPECT_EQ((max - decimal(1)).to_string(), std::string(37, '9') + "8");
+}
+
+TEST(DecimalTest, Accumulate_ManyValues_Exact)
+{
+    decimal sum;
+    for (int i = 0; i < 1000; ++i)
+        sum += decimal(1, 2); // 0.01 can't be exactly represented as a double
+    EXPECT_EQ(sum, decimal(10));
+    EXPECT_EQ(sum.to_string(), "10.00");
+}
+
+// Comparisons
+TEST(DecimalTest, Comparisons)
+{
+    EXPECT_TRUE(decimal(10, 1) == decimal(100, 2));
+    EXPECT_TRUE(decimal(10, 1) != decimal(101, 2));
+    EXPECT_TRUE(decimal(-1) < decimal(0));
+    EXPECT_TRUE(decimal(-2) < decimal(-15, 1));
+    EXPECT_TRUE(decimal(15, 1) > decimal(149, 2));
+    EXPECT_TRUE(decimal(15, 1) >= decimal(150, 2));
+    EXPECT_TRUE(decimal(15, 1) <= decimal(150, 2));
+    EXPECT_TRUE(decimal() == -decimal());
+
+    // Rescaling overflows
+    auto max = *decimal::parse(max_digits);
+    EXPECT_TRUE(max > decimal(1, 2));
+    EXPECT_TRUE(decimal(1, 2) < max);
+    EXPECT_TRUE(-max < decimal(-1, 2));
+}
+
+TEST(DecimalTest, OperatorStream)
+{
+    std::ostringstream ss;
+    ss << decimal(-2052, 2);
+    EXPECT_EQ(ss.str(), "-20.52");
+}
+
+// value::get_optional<decimal>
+TEST(DecimalTest, ValueGetOptional_String_Parsed)
+{
+    EXPECT_EQ(value("20.52").get_optional<decimal>(), decimal(2052, 2));
+    EXPECT_EQ(value("20.52").get<decimal>().scale(), 2);
+    EXPECT_FALSE(value("abc").get_optional<decimal>().has_value());
+    EXPECT_FALSE(value("abc").is_convertible_to<decimal>());
+    EXPECT_THROW(value("abc").get<decimal>(), std::bad_variant_access);
+}
+
+TEST(DecimalTest, ValueGetOptional_Integers_Converted)
+{
+    EXPECT_EQ(value(-42).get<decimal>(), decimal(-42));
+    EXPECT_EQ(value(std::numeric_limits<std::uint64_t>::max()).get<decimal>().to_string(),
+        "18446744073709551615");
+}
+
+TEST(DecimalTest, ValueGetOptional_OtherTypes_Empty)
+{
+    EXPECT_FALSE(value().get_optional<decimal>().has_value());
+    EXPECT_FALSE(value(4.2).get_optional<decimal>().has_value());
+    EXPECT_FALSE(value(makedate(2020, 1, 1)).get_optional<decimal>().has_value());
+}
+
+// The MySQL protocol sends DECIMALs as strings in both the text and binary protocols
+std::vector<field_metadata> make_decimal_meta()
+{
+    column_definition_packet coldef;
+    coldef.type = protocol_field_type::newdecimal;
+    coldef.decimals = int1(3);
+    return std::vector<field_metadata>{field_metadata(coldef)};
+}
+
+TEST(DecimalTest, DeserializeTextRow_Decimal)
+{
+    std::vector<std::uint8_t> buffer {0x07, '-', '1', '2', '.', '3', '4', '0'};
+    deserialization_context ctx (buffer.data(), buffer.data() + buffer.size(), capabilities());
+    std::vector<value> output;
+    auto err = deserialize_text_row(ctx, make_decimal_meta(), output);
+    ASSERT_EQ(err, error_code());
+    EXPECT_EQ(output.at(0).get<decimal>(), decimal(-1234, 2));
+    EXPECT_EQ(output.at(0).get<decimal>().scale(), 3);
+}
+
+TEST(DecimalTest, DeserializeBinaryRow_Decimal)
+{
+    std::vector<std::uint8_t> buffer {0x00, 0x00, 0x07, '-', '1', '2', '.', '3', '4', '0'};
+    deserialization_context ctx (buffer.data(), buffer.data() + buffer.size(), capabilities());
+    std::vector<value> output;
+    auto err = deserialize_binary_row(ctx, make_decimal_meta(), output);
+    ASSERT_EQ(err, error_code());
+    EXPECT_EQ(output.at(0).get<decimal>(), decimal(-1234, 2));
+}
+
+}
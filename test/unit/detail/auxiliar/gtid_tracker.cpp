@@ -0,0 +1,79 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include "boost/mysql/detail/auxiliar/gtid_tracker.hpp"
+
+using boost::mysql::detail::gtid_tracker;
+
+namespace
+{
+
+constexpr const char* uuid1 = "3e11fa47-71ca-11e1-9e33-c80aa9429562";
+constexpr const char* uuid2 = "9f3c2b10-0a5e-11eb-8f2a-0242ac110002";
+
+std::string with_uuid(const char* uuid, const char* rest) { return std::string(uuid) + rest; }
+
+TEST(GtidTrackerTest, DefaultConstructor_Empty)
+{
+    gtid_tracker tracker;
+    EXPECT_TRUE(tracker.empty());
+    EXPECT_EQ(tracker.to_string(), "");
+}
+
+TEST(GtidTrackerTest, Add_SingleTransaction_TracksUpToIt)
+{
+    gtid_tracker tracker;
+    EXPECT_TRUE(tracker.add(with_uuid(uuid1, ":23")));
+    EXPECT_FALSE(tracker.empty());
+    EXPECT_EQ(tracker.to_string(), with_uuid(uuid1, ":1-23"));
+}
+
+TEST(GtidTrackerTest, Add_SeveralCalls_KeepsTheHighest)
+{
+    gtid_tracker tracker;
+    EXPECT_TRUE(tracker.add(with_uuid(uuid1, ":23")));
+    EXPECT_TRUE(tracker.add(with_uuid(uuid1, ":10")));
+    EXPECT_TRUE(tracker.add(with_uuid(uuid1, ":24")));
+    EXPECT_EQ(tracker.to_string(), with_uuid(uuid1, ":1-24"));
+}
+
+TEST(GtidTrackerTest, Add_IntervalsAndSeveralSources_TracksEachSource)
+{
+    gtid_tracker tracker;
+    EXPECT_TRUE(tracker.add(with_uuid(uuid2, ":1-5:7-9,\n") + with_uuid(uuid1, ":3")));
+    EXPECT_EQ(tracker.to_string(), with_uuid(uuid1, ":1-3,") + with_uuid(uuid2, ":1-9"));
+}
+
+TEST(GtidTrackerTest, Add_Tags_TrackedAsSeparateSources)
+{
+    gtid_tracker tracker;
+    EXPECT_TRUE(tracker.add(with_uuid(uuid1, ":4:my_tag:1-2")));
+    EXPECT_EQ(tracker.to_string(), with_uuid(uuid1, ":1-4,") + with_uuid(uuid1, ":my_tag:1-2"));
+}
+
+TEST(GtidTrackerTest, Add_Malformed_ReturnsFalseAndLeavesUnchanged)
+{
+    for (const char* input: {"abc", "not-a-uuid!:1", ":1", "3e11fa47-71ca:x-y", "3e11fa47-71ca:5-2",
+        "3e11fa47-71ca:1,zz:1", "3e11fa47-71ca::1", "3e11fa47-71ca:bad'tag"})
+    {
+        gtid_tracker tracker;
+        EXPECT_TRUE(tracker.add(with_uuid(uuid1, ":2")));
+        EXPECT_FALSE(tracker.add(input)) << input;
+        EXPECT_EQ(tracker.to_string(), with_uuid(uuid1, ":1-2")) << input;
+    }
+}
+
+TEST(GtidTrackerTest, Clear_Empty)
+{
+    gtid_tracker tracker;
+    tracker.add(with_uuid(uuid1, ":2"));
+    tracker.clear();
+    EXPECT_TRUE(tracker.empty());
+}
+
+} // anon namespace
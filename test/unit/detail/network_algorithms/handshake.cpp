@@ -0,0 +1,108 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "boost/mysql/detail/network_algorithms/handshake.hpp"
+#include <boost/asio/ip/tcp.hpp>
+#include <gtest/gtest.h>
+
+using namespace boost::mysql::detail;
+using namespace testing;
+using boost::mysql::connection_params;
+using boost::mysql::ssl_options;
+using boost::mysql::ssl_mode;
+using boost::mysql::collation;
+using boost::mysql::error_code;
+using boost::mysql::error_info;
+using boost::mysql::errc;
+
+namespace
+{
+
+connection_params make_params(ssl_mode mode)
+{
+    return connection_params("user", "pass", "", collation::utf8_general_ci, ssl_options(mode));
+}
+
+handshake_packet make_greeting(std::uint32_t caps)
+{
+    handshake_packet res;
+    res.capability_falgs = int4(caps);
+    return res;
+}
+
+constexpr std::uint32_t server_caps = mandatory_capabilities.get() | CLIENT_SSL;
+
+// An auth switch to caching_sha2_password requesting full authentication
+resource_bytestring full_auth_request()
+{
+    std::string_view plugin = "caching_sha2_password";
+    resource_bytestring res { auth_switch_request_header };
+    res.insert(res.end(), plugin.begin(), plugin.end());
+    res.insert(res.end(), { 0, 4, 0 });
+    return res;
+}
+
+TEST(HandshakeProcessor, ProcessCapabilities_SslEnableNonSecureTransport_UsesSsl)
+{
+    handshake_processor processor (make_params(ssl_mode::enable), false);
+    EXPECT_EQ(processor.process_capabilities(make_greeting(server_caps)), error_code());
+    EXPECT_TRUE(processor.use_ssl());
+    EXPECT_TRUE(processor.secure_channel());
+}
+
+TEST(HandshakeProcessor, ProcessCapabilities_SslEnableSecureTransport_DoesNotUseSsl)
+{
+    handshake_processor processor (make_params(ssl_mode::enable), true);
+    EXPECT_EQ(processor.process_capabilities(make_greeting(server_caps)), error_code());
+    EXPECT_FALSE(processor.use_ssl());
+    EXPECT_TRUE(processor.secure_channel());
+}
+
+TEST(HandshakeProcessor, ProcessCapabilities_SslRequireSecureTransport_UsesSsl)
+{
+    handshake_processor processor (make_params(ssl_mode::require), true);
+    EXPECT_EQ(processor.process_capabilities(make_greeting(server_caps)), error_code());
+    EXPECT_TRUE(processor.use_ssl());
+}
+
+TEST(HandshakeProcessor, FullAuth_NonSecureChannel_ReturnsError)
+{
+    handshake_processor processor (make_params(ssl_mode::disable), false);
+    processor.process_capabilities(make_greeting(server_caps));
+    auto buffer = full_auth_request();
+    auth_result result = auth_result::invalid;
+    error_info info;
+    auto err = processor.process_handshake_server_response(buffer, result, info);
+    EXPECT_EQ(err, make_error_code(errc::auth_plugin_requires_ssl));
+}
+
+TEST(HandshakeProcessor, FullAuth_SecureTransport_SendsPassword)
+{
+    handshake_processor processor (make_params(ssl_mode::enable), true);
+    processor.process_capabilities(make_greeting(server_caps));
+    auto buffer = full_auth_request();
+    auth_result result = auth_result::invalid;
+    error_info info;
+    auto err = processor.process_handshake_server_response(buffer, result, info);
+    EXPECT_EQ(err, error_code());
+    EXPECT_EQ(result, auth_result::send_more_data);
+    EXPECT_EQ(buffer, (resource_bytestring{'p', 'a', 's', 's', 0}));
+}
+
+TEST(IsSecureTransport, TcpSocket_IsFalse)
+{
+    EXPECT_FALSE(is_secure_transport<boost::asio::ip::tcp::socket>::value);
+}
+
+#ifdef BOOST_ASIO_HAS_LOCAL_SOCKETS
+TEST(IsSecureTransport, UnixSocket_IsTrue)
+{
+    EXPECT_TRUE(is_secure_transport<boost::asio::local::stream_protocol::socket>::value);
+}
+#endif
+
+} // anon namespace
@@ -14,6 +14,8 @@ using namespace boost::mysql::detail;
 using namespace boost::mysql::test;
 using namespace testing;
 using boost::mysql::value;
+using boost::mysql::statement_param;
+using boost::mysql::decimal;
 using boost::mysql::error_code;
 using boost::mysql::errc;
 
@@ -112,4 +114,57 @@ INSTANTIATE_TEST_SUITE_P(Null, SerializeBinaryValueTest, Values(
     serialize_binary_value_testcase("regular", nullptr, {})
 ), test_name_generator);
 
+// statement_param: decimals are sent as length-encoded strings,
+// anything else as the value it holds
+struct serialize_statement_param_testcase : named_param
+{
+    std::string name;
+    statement_param from;
+    bytestring buffer;
+
+    serialize_statement_param_testcase(
+        std::string&& name,
+        statement_param from,
+        bytestring&& buffer
+    ) :
+        name(std::move(name)),
+        from(from),
+        buffer(std::move(buffer))
+    {
+    }
+};
+
+struct SerializeStatementParamTest : TestWithParam<serialize_statement_param_testcase>
+{
+};
+
+TEST_P(SerializeStatementParamTest, GetBinaryValueSize_Trivial_ReturnsExpectedSize)
+{
+    serialization_context ctx (capabilities{});
+    std::size_t size = get_binary_value_size(ctx, GetParam().from);
+    EXPECT_EQ(size, GetParam().buffer.size());
+}
+
+TEST_P(SerializeStatementParamTest, SerializeBinaryValue_Trivial_WritesToBuffer)
+{
+    do_serialize_test(GetParam().buffer, [](serialization_context& ctx) {
+        serialize_binary_value(ctx, GetParam().from);
+    });
+}
+
+INSTANTIATE_TEST_SUITE_P(DECIMAL, SerializeStatementParamTest, Values(
+    serialize_statement_param_testcase("positive", decimal(12345, 2),
+        {0x06, 0x31, 0x32, 0x33, 0x2e, 0x34, 0x35}),
+    serialize_statement_param_testcase("negative", decimal(-5, 3),
+        {0x06, 0x2d, 0x30, 0x2e, 0x30, 0x30, 0x35}),
+    serialize_statement_param_testcase("zero", decimal(), {0x01, 0x30})
+), test_name_generator);
+
+INSTANTIATE_TEST_SUITE_P(Value, SerializeStatementParamTest, Values(
+    serialize_statement_param_testcase("int64", value(std::int64_t(-0x0706050403020101)),
+            {0xff, 0xfe, 0xfd, 0xfc, 0xfb, 0xfa, 0xf9, 0xf8}),
+    serialize_statement_param_testcase("string", value("abc"), {0x03, 0x61, 0x62, 0x63}),
+    serialize_statement_param_testcase("null", value(), {})
+), test_name_generator);
+
 } // anon namespace
@@ -10,8 +10,10 @@
 #include <boost/system/system_error.hpp>
 #include <boost/asio/buffer.hpp>
 #include <algorithm>
+#include <numeric>
 #include "boost/mysql/detail/protocol/channel.hpp"
 #include "test_common.hpp"
+#include "test_stream.hpp"
 
 using namespace testing;
 using namespace boost::mysql::detail;
@@ -268,6 +270,93 @@ TEST_F(MysqlChannelReadTest, SyncRead_SequenceNumberFF_SequenceNumberWraps)
     EXPECT_EQ(chan.sequence_number(), 0);
 }
 
+TEST_F(MysqlChannelReadTest, SyncRead_ReadAhead_ServesSeveralMessagesFromSingleRead)
+{
+    bytes_to_read = {
+        0x03, 0x00, 0x00, 0x00,
+        0xfe, 0x03, 0x02,
+        0x02, 0x00, 0x00, 0x01,
+        0x05, 0x06
+    };
+    EXPECT_CALL(stream, read_buffer)
+        .WillOnce(Invoke(make_read_handler()));
+    chan.set_read_ahead_size(64);
+    chan.read(buffer, code);
+    EXPECT_EQ(code, error_code());
+    verify_buffer({0xfe, 0x03, 0x02});
+    chan.read(buffer, code);
+    EXPECT_EQ(code, error_code());
+    verify_buffer({0x05, 0x06});
+}
+
+TEST_F(MysqlChannelReadTest, SyncRead_ReadAheadShortReads_InvokesReadAgain)
+{
+    EXPECT_CALL(stream, read_buffer)
+        .WillOnce(Invoke(buffer_copier({0x04})))
+        .WillOnce(Invoke(buffer_copier({     0x00, 0x00, 0x00, 0x01})))
+        .WillOnce(Invoke(buffer_copier({0x02, 0x03, 0x04})));
+    chan.set_read_ahead_size(64);
+    chan.read(buffer, code);
+    EXPECT_EQ(code, error_code());
+    verify_buffer({0x01, 0x02, 0x03, 0x04});
+}
+
+TEST_F(MysqlChannelReadTest, SyncRead_MessageBiggerThanReadAhead_ReadsBodyDirectly)
+{
+    EXPECT_CALL(stream, read_buffer)
+        .WillOnce(Invoke([](boost::asio::mutable_buffer b, error_code& ec) {
+            EXPECT_EQ(b.size(), 8);
+            const std::uint8_t bytes [] = { 0x14, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03 };
+            memcpy(b.data(), bytes, sizeof(bytes));
+            ec.clear();
+            return sizeof(bytes);
+        }))
+        .WillOnce(Invoke([](boost::asio::mutable_buffer b, error_code& ec) {
+            EXPECT_EQ(b.size(), 16); // the rest of the body, not the read-ahead buffer
+            for (std::size_t i = 0; i < b.size(); ++i)
+                static_cast<std::uint8_t*>(b.data())[i] = static_cast<std::uint8_t>(i + 4);
+            ec.clear();
+            return b.size();
+        }));
+    chan.set_read_ahead_size(8);
+    chan.read(buffer, code);
+    EXPECT_EQ(code, error_code());
+    std::vector<uint8_t> expected (20);
+    std::iota(expected.begin(), expected.end(), std::uint8_t(0));
+    verify_buffer(expected);
+}
+
+TEST(MysqlChannelAsyncReadTest, AsyncRead_ReadAhead_ServesSeveralMessagesFromSingleRead)
+{
+    boost::asio::io_context ctx;
+    boost::mysql::test::test_stream stream (ctx);
+    stream.add_bytes_to_read({
+        0x03, 0x00, 0x00, 0x00,
+        0xfe, 0x03, 0x02,
+        0x02, 0x00, 0x00, 0x01,
+        0x05, 0x06
+    });
+    channel<boost::mysql::test::test_stream> chan (stream);
+    chan.set_read_ahead_size(64);
+    bytestring buffer;
+    std::vector<std::vector<uint8_t>> messages;
+    auto handler = [&](error_code err) {
+        EXPECT_EQ(err, error_code());
+        messages.emplace_back(buffer.begin(), buffer.end());
+    };
+
+    // The second read is served from the read-ahead buffer, and still completes as if by post
+    chan.async_read(buffer, handler);
+    ctx.run();
+    ASSERT_EQ(messages.size(), 1);
+    chan.async_read(buffer, handler);
+    EXPECT_EQ(messages.size(), 1);
+    ctx.restart();
+    ctx.run();
+    ASSERT_EQ(messages.size(), 2);
+    EXPECT_EQ(messages[0], (std::vector<uint8_t>{0xfe, 0x03, 0x02}));
+    EXPECT_EQ(messages[1], (std::vector<uint8_t>{0x05, 0x06}));
+}
 
 struct MysqlChannelWriteTest : public MysqlChannelFixture
 {
@@ -324,6 +413,36 @@ TEST_F(MysqlChannelWriteTest, SyncWrite_MoreThan16M_SplitsInPackets)
     EXPECT_EQ(code, error_code());
 }
 
+TEST_F(MysqlChannelWriteTest, SyncWrite_BufferSequence_WritesConcatenation)
+{
+    ON_CALL(stream, write_buffer)
+        .WillByDefault(Invoke(make_write_handler()));
+    std::vector<uint8_t> first {0xaa, 0xab};
+    std::vector<uint8_t> second {0xac};
+    chan.write(std::array<const_buffer, 3> {buffer(first), const_buffer(), buffer(second)}, code);
+    verify_buffer({
+        0x03, 0x00, 0x00, 0x00, // header
+        0xaa, 0xab, 0xac // body
+    });
+    EXPECT_EQ(code, error_code());
+}
+
+TEST_F(MysqlChannelWriteTest, SyncWrite_BufferSequenceMoreThan16M_SplitsAcrossBuffers)
+{
+    ON_CALL(stream, write_buffer)
+        .WillByDefault(Invoke(make_write_handler()));
+    std::vector<uint8_t> first (0xfffff0, 0xab);
+    std::vector<uint8_t> second (0x14, 0xac);
+    chan.write(std::array<const_buffer, 2> {buffer(first), buffer(second)}, code);
+    std::vector<uint8_t> expected_buffer {0xff, 0xff, 0xff, 0x00};
+    concat(expected_buffer, first);
+    concat(expected_buffer, std::vector<std::uint8_t>(0x0f, 0xac));
+    concat(expected_buffer, {0x05, 0x00, 0x00, 0x01});
+    concat(expected_buffer, std::vector<std::uint8_t>(0x05, 0xac));
+    verify_buffer(expected_buffer);
+    EXPECT_EQ(code, error_code());
+}
+
 TEST_F(MysqlChannelWriteTest, SyncWrite_EmptyPacket_WritesHeader)
 {
     ON_CALL(stream, write_buffer)
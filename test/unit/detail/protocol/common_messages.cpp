@@ -28,7 +28,8 @@ INSTANTIATE_TEST_SUITE_P(OkPacket, DeserializeTest, ::testing::Values(
         int_lenenc(0), // last insert ID
         int2(static_cast<std::uint16_t>(SERVER_STATUS_AUTOCOMMIT | SERVER_QUERY_NO_INDEX_USED)), // server status
         int2(0), // warnings
-        string_lenenc("Rows matched: 5  Changed: 4  Warnings: 0")
+        string_lenenc("Rows matched: 5  Changed: 4  Warnings: 0"),
+        string_lenenc("") // no session state info
     }, {
         0x04, 0x00, 0x22, 0x00, 0x00, 0x00, 0x28, 0x52, 0x6f, 0x77, 0x73,
         0x20, 0x6d, 0x61, 0x74, 0x63, 0x68, 0x65, 0x64, 0x3a, 0x20, 0x35, 0x20, 0x20, 0x43, 0x68, 0x61,
@@ -41,7 +42,8 @@ INSTANTIATE_TEST_SUITE_P(OkPacket, DeserializeTest, ::testing::Values(
         int_lenenc(6), // last insert ID
         int2(static_cast<std::uint16_t>(SERVER_STATUS_AUTOCOMMIT)), // server status
         int2(0), // warnings
-        string_lenenc("")  // no message
+        string_lenenc(""),  // no message
+        string_lenenc("") // no session state info
     },{
         0x01, 0x06, 0x02, 0x00, 0x00, 0x00
     }, "successful_insert"),
@@ -51,10 +53,23 @@ INSTANTIATE_TEST_SUITE_P(OkPacket, DeserializeTest, ::testing::Values(
         int_lenenc(0), // last insert ID
         int2(static_cast<std::uint16_t>(SERVER_STATUS_AUTOCOMMIT)), // server status
         int2(0), // warnings
-        string_lenenc("")  // no message
+        string_lenenc(""),  // no message
+        string_lenenc("") // no session state info
     }, {
         0x00, 0x00, 0x02, 0x00, 0x00, 0x00
-    }, "successful_login")
+    }, "successful_login"),
+
+    serialization_testcase(ok_packet{
+        int_lenenc(0), // affected rows
+        int_lenenc(0), // last insert ID
+        int2(static_cast<std::uint16_t>(SERVER_STATUS_AUTOCOMMIT | SERVER_SESSION_STATE_CHANGED)), // server status
+        int2(0), // warnings
+        string_lenenc(""),  // no message
+        string_lenenc("\x01\x03\x02" "db") // schema changed to "db"
+    }, {
+        0x00, 0x00, 0x02, 0x40, 0x00, 0x00, 0x00,
+        0x05, 0x01, 0x03, 0x02, 0x64, 0x62
+    }, "session_state_changed", CLIENT_SESSION_TRACK)
 ), test_name_generator);
 
 INSTANTIATE_TEST_SUITE_P(ErrPacket, DeserializeTest, ::testing::Values(
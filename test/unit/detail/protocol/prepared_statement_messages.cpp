@@ -13,6 +13,7 @@
 using namespace boost::mysql::test;
 using namespace boost::mysql::detail;
 using boost::mysql::value;
+using boost::mysql::statement_param;
 
 namespace
 {
@@ -49,7 +50,7 @@ serialization_testcase make_stmt_execute_test(
     std::uint8_t flags,
     std::uint32_t itercount,
     std::uint8_t new_params_flag,
-    std::vector<value>&& params,
+    std::vector<typename Collection::value_type>&& params,
     std::vector<std::uint8_t>&& buffer,
     std::string&& test_name
 )
@@ -138,6 +139,23 @@ INSTANTIATE_TEST_SUITE_P(ComStmtExecute, SerializeTest, testing::Values(
         },
         "time"
     ),
+    make_stmt_execute_test<std::vector<statement_param>>(1, 0, 1, 1, // stmt ID, flags, itercount, new params
+        { boost::mysql::decimal(-12345, 2) }, {
+            0x17, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00,
+            0x00, 0x00, 0x00, 0x01, 0xf6, 0x00, 0x07, 0x2d,
+            0x31, 0x32, 0x33, 0x2e, 0x34, 0x35
+        },
+        "decimal"
+    ),
+    make_stmt_execute_test<std::vector<statement_param>>(1, 0, 1, 1, // stmt ID, flags, itercount, new params
+        { value(std::uint64_t(0xab)), boost::mysql::decimal(5, 1), value(nullptr) }, {
+            0x17, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00,
+            0x00, 0x00, 0x04, 0x01, 0x08, 0x80, 0xf6, 0x00,
+            0x06, 0x00, 0xab, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x03, 0x30, 0x2e, 0x35
+        },
+        "values_and_decimal"
+    ),
     make_stmt_execute_test(1, 0, 1, 1, // stmt ID, flags, itercount, new params
         { value(nullptr) }, {
             0x17, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00,
@@ -7,6 +7,8 @@
 
 #include "serialization_test_common.hpp"
 #include "test_common.hpp"
+#include "boost/mysql/detail/protocol/query_messages.hpp"
+#include "boost/mysql/detail/protocol/prepared_statement_messages.hpp"
 
 using namespace boost::mysql::detail;
 using namespace boost::mysql::test;
@@ -127,4 +129,77 @@ INSTANTIATE_TEST_SUITE_P(Enums, FullSerializationTest, ::testing::Values(
     serialization_testcase(EnumInt4::value2, {0xff, 0xfe, 0xfd, 0xfc}, "int4_high_value")
 ), test_name_generator);
 
+// serialize_message_gather
+struct SerializeMessageGatherTest : testing::Test
+{
+    bytestring buffer;
+    std::vector<boost::asio::const_buffer> output;
+
+    bytestring flatten() const
+    {
+        bytestring res;
+        for (const auto& buff: output)
+            concat(res, buff);
+        return res;
+    }
+
+    template <typename Serializable>
+    void validate_same_as_serialize_message(const Serializable& input)
+    {
+        bytestring expected;
+        serialize_message(input, capabilities(0), expected);
+        EXPECT_EQ(flatten(), expected);
+    }
+};
+
+TEST_F(SerializeMessageGatherTest, ShortStrings_SingleBuffer)
+{
+    com_query_packet packet { string_eof("SELECT 1") };
+    serialize_message_gather(packet, capabilities(0), buffer, output);
+    ASSERT_EQ(output.size(), 1);
+    EXPECT_EQ(output[0].data(), buffer.data());
+    validate_same_as_serialize_message(packet);
+}
+
+TEST_F(SerializeMessageGatherTest, LongEofString_Referenced)
+{
+    std::string query (min_referenced_string_size, 'a');
+    com_query_packet packet { string_eof(query) };
+    serialize_message_gather(packet, capabilities(0), buffer, output);
+    ASSERT_EQ(output.size(), 2);
+    EXPECT_EQ(output[0].size(), 1); // command byte
+    EXPECT_EQ(output[1].data(), query.data());
+    EXPECT_EQ(output[1].size(), query.size());
+    validate_same_as_serialize_message(packet);
+}
+
+TEST_F(SerializeMessageGatherTest, LongLenencStrings_ReferencedAndInterleaved)
+{
+    std::string long_string (min_referenced_string_size + 10, 'b');
+    auto params = makevalues(42, long_string, "abc", long_string);
+    com_stmt_execute_packet<std::vector<value>::const_iterator> packet {
+        int4(1), int1(0), int4(1), int1(1), params.begin(), params.end()
+    };
+    serialize_message_gather(packet, capabilities(0), buffer, output);
+
+    // header, string 1, string "abc" and lengths, string 2
+    ASSERT_EQ(output.size(), 4);
+    EXPECT_EQ(output[1].data(), long_string.data());
+    EXPECT_EQ(output[3].data(), long_string.data());
+    validate_same_as_serialize_message(packet);
+}
+
+TEST_F(SerializeMessageGatherTest, LongStringAtEnd_NoEmptyTrailingBuffer)
+{
+    std::string long_string (min_referenced_string_size, 'c');
+    auto params = makevalues(long_string);
+    com_stmt_execute_packet<std::vector<value>::const_iterator> packet {
+        int4(1), int1(0), int4(1), int1(1), params.begin(), params.end()
+    };
+    serialize_message_gather(packet, capabilities(0), buffer, output);
+    ASSERT_EQ(output.size(), 2);
+    EXPECT_EQ(output[1].data(), long_string.data());
+    validate_same_as_serialize_message(packet);
+}
+
 } // anon namespace
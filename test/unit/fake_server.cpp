@@ -0,0 +1,225 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include "boost/mysql/connection.hpp"
+#include "fake_server.hpp"
+#include "test_common.hpp"
+#include "test_stream.hpp"
+
+using namespace boost::mysql::test;
+using boost::mysql::error_code;
+using boost::mysql::error_info;
+using boost::mysql::errc;
+using boost::mysql::value;
+using boost::mysql::row;
+using boost::mysql::owning_row;
+using boost::mysql::connection_params;
+using boost::mysql::ssl_options;
+using boost::mysql::ssl_mode;
+using boost::mysql::detail::make_error_code;
+
+namespace
+{
+
+void expect_rows(const std::vector<owning_row>& actual, const std::vector<row>& expected)
+{
+    ASSERT_EQ(actual.size(), expected.size());
+    for (std::size_t i = 0; i < actual.size(); ++i)
+        EXPECT_EQ(static_cast<const row&>(actual[i]), expected[i]) << "i=" << i;
+}
+
+struct FakeServerTest : public testing::Test
+{
+    fake_server server;
+    connection_params params {"user", "password", "db", boost::mysql::collation::utf8mb4_general_ci,
+        ssl_options(ssl_mode::disable)};
+
+    FakeServerTest()
+    {
+        server.add_resultset("SELECT * FROM t", {"id", "name", "score", "born", "updated"}, {
+            makevalues(1, "abc", 4.2, makedate(2010, 2, 1), makedt(2020, 1, 2, 3, 4, 5, 6)),
+            makevalues(2, nullptr, -1.5, nullptr, makedt(2020, 3, 4)),
+            makevalues(3, "", 0.0, makedate(1999, 12, 31), nullptr)
+        });
+        server.add_ok("UPDATE t SET name = ? WHERE id = ?", 2);
+        server.add_error("DROP TABLE t", errc::no_such_table, "Table 't' doesn't exist");
+    }
+
+    std::vector<row> expected_rows() const
+    {
+        return {
+            makerow(1, "abc", 4.2, makedate(2010, 2, 1), makedt(2020, 1, 2, 3, 4, 5, 6)),
+            makerow(2, nullptr, -1.5, nullptr, makedt(2020, 3, 4)),
+            makerow(3, "", 0.0, makedate(1999, 12, 31), nullptr)
+        };
+    }
+};
+
+struct FakeServerInMemoryTest : FakeServerTest
+{
+    boost::asio::io_context ctx;
+    boost::mysql::connection<test_stream> conn {ctx};
+
+    void load(const fake_server::bytes& bytes) { conn.next_layer().add_bytes_to_read(bytes); }
+};
+
+TEST_F(FakeServerInMemoryTest, Query_ReturnsTextRows)
+{
+    load(server.handshake_bytes());
+    load(server.query_response("SELECT * FROM t"));
+    conn.handshake(params);
+    auto result = conn.query("SELECT * FROM t");
+    EXPECT_EQ(result.fields().size(), 5);
+    EXPECT_EQ(result.fields()[1].field_name(), "name");
+    expect_rows(result.fetch_all(), expected_rows());
+    EXPECT_TRUE(result.complete());
+}
+
+TEST_F(FakeServerInMemoryTest, Statement_ReturnsBinaryRows)
+{
+    load(server.handshake_bytes());
+    load(server.prepare_response("SELECT * FROM t"));
+    load(server.execute_response("SELECT * FROM t"));
+    conn.handshake(params);
+    auto stmt = conn.prepare_statement("SELECT * FROM t");
+    EXPECT_EQ(stmt.num_params(), 0);
+    auto result = stmt.execute(boost::mysql::no_statement_params);
+    expect_rows(result.fetch_all(), expected_rows());
+}
+
+TEST_F(FakeServerInMemoryTest, StatementWithoutRows_ReturnsOk)
+{
+    load(server.handshake_bytes());
+    load(server.prepare_response("UPDATE t SET name = ? WHERE id = ?"));
+    load(server.execute_response("UPDATE t SET name = ? WHERE id = ?"));
+    conn.handshake(params);
+    auto stmt = conn.prepare_statement("UPDATE t SET name = ? WHERE id = ?");
+    EXPECT_EQ(stmt.num_params(), 2);
+    auto result = stmt.execute(makevalues("abc", 1));
+    EXPECT_TRUE(result.complete());
+    EXPECT_EQ(result.affected_rows(), 2);
+}
+
+TEST_F(FakeServerInMemoryTest, Error_ReturnsServerError)
+{
+    load(server.handshake_bytes());
+    load(server.query_response("DROP TABLE t"));
+    load(server.query_response("unknown"));
+    conn.handshake(params);
+
+    error_code err;
+    error_info info;
+    conn.query("DROP TABLE t", err, info);
+    EXPECT_EQ(err, make_error_code(errc::no_such_table));
+    EXPECT_EQ(info.message(), "Table 't' doesn't exist");
+    conn.query("unknown", err, info);
+    EXPECT_EQ(err, make_error_code(errc::parse_error));
+}
+
+TEST_F(FakeServerInMemoryTest, BigRow_SplitIntoSeveralFrames)
+{
+    std::string big (boost::mysql::detail::MAX_PACKET_SIZE + 10, 'a');
+    server.add_resultset("SELECT big", {"f"}, {makevalues(std::string_view(big))});
+    load(server.handshake_bytes());
+    load(server.query_response("SELECT big"));
+    conn.handshake(params);
+    auto rows = conn.query("SELECT big").fetch_all();
+    ASSERT_EQ(rows.size(), 1);
+    EXPECT_EQ(rows[0].values()[0], value(big));
+}
+
+template <typename Connection, typename Server>
+void run_session(Connection& conn, const Server& server, const connection_params& params, const std::vector<row>& expected)
+{
+    conn.connect(server.endpoint(), params);
+    expect_rows(conn.query("SELECT * FROM t").fetch_all(), expected);
+    auto stmt = conn.prepare_statement("SELECT * FROM t");
+    expect_rows(stmt.execute(boost::mysql::no_statement_params).fetch_all(), expected);
+    stmt.close();
+    EXPECT_EQ(conn.query("UPDATE t SET name = ? WHERE id = ?").affected_rows(), 2);
+    conn.close();
+}
+
+TEST_F(FakeServerTest, Tcp_QueriesAndStatements)
+{
+    fake_tcp_server tcp_server (server, {boost::asio::ip::address_v4::loopback(), 0});
+    boost::asio::io_context ctx;
+    boost::mysql::tcp_connection conn1 (ctx);
+    boost::mysql::tcp_connection conn2 (ctx);
+    run_session(conn1, tcp_server, params, expected_rows());
+    run_session(conn2, tcp_server, params, expected_rows());
+}
+
+TEST_F(FakeServerTest, Tcp_AsyncQuery)
+{
+    fake_tcp_server tcp_server (server, {boost::asio::ip::address_v4::loopback(), 0});
+    boost::asio::io_context ctx;
+    boost::mysql::tcp_connection conn (ctx);
+    conn.connect(tcp_server.endpoint(), params);
+
+    bool called = false;
+    boost::mysql::tcp_resultset result;
+    conn.async_query("SELECT * FROM t", [&](error_code err, boost::mysql::tcp_resultset r) {
+        ASSERT_EQ(err, error_code());
+        result = std::move(r);
+        result.async_fetch_all([&](error_code err, std::vector<owning_row> rows) {
+            called = true;
+            EXPECT_EQ(err, error_code());
+            expect_rows(rows, expected_rows());
+        });
+    });
+    ctx.run();
+    EXPECT_TRUE(called);
+}
+
+TEST_F(FakeServerTest, Tcp_ClientDoesNotQuit_ServerStops)
+{
+    boost::asio::io_context ctx;
+    boost::mysql::tcp_connection conn (ctx);
+    {
+        fake_tcp_server tcp_server (server, {boost::asio::ip::address_v4::loopback(), 0});
+        conn.connect(tcp_server.endpoint(), params);
+    }
+    error_code err;
+    error_info info;
+    conn.query("SELECT * FROM t", err, info);
+    EXPECT_NE(err, error_code());
+}
+
+TEST_F(FakeServerTest, Tcp_FullAuth_RequiresSsl)
+{
+    server.require_full_auth();
+    fake_tcp_server tcp_server (server, {boost::asio::ip::address_v4::loopback(), 0});
+    boost::asio::io_context ctx;
+    boost::mysql::tcp_connection conn (ctx);
+    error_code err;
+    error_info info;
+    conn.connect(tcp_server.endpoint(), params, err, info);
+    EXPECT_EQ(err, make_error_code(errc::auth_plugin_requires_ssl));
+}
+
+#ifdef BOOST_ASIO_HAS_LOCAL_SOCKETS
+TEST_F(FakeServerTest, UnixSocket_QueriesAndStatements)
+{
+    fake_unix_server unix_server (server, {"/tmp/boost_mysql_fake_server.sock"});
+    boost::asio::io_context ctx;
+    boost::mysql::unix_connection conn (ctx);
+    run_session(conn, unix_server, params, expected_rows());
+}
+
+TEST_F(FakeServerTest, UnixSocket_FullAuth)
+{
+    server.require_full_auth();
+    fake_unix_server unix_server (server, {"/tmp/boost_mysql_fake_server.sock"});
+    boost::asio::io_context ctx;
+    boost::mysql::unix_connection conn (ctx);
+    run_session(conn, unix_server, params, expected_rows());
+}
+#endif
+
+} // anon namespace
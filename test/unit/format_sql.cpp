@@ -0,0 +1,213 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include "boost/mysql/format_sql.hpp"
+#include "test_common.hpp"
+#include <limits>
+
+using namespace boost::mysql::test;
+using namespace testing;
+using boost::mysql::format_sql;
+using boost::mysql::format_options;
+using boost::mysql::collation;
+using boost::mysql::errc;
+using boost::mysql::error_code;
+using boost::mysql::error_info;
+using boost::mysql::value;
+
+namespace
+{
+
+std::string format_ok(
+    std::string_view format_str,
+    const std::vector<value>& args,
+    format_options opts = format_options()
+)
+{
+    std::string output;
+    error_code err;
+    error_info info;
+    format_sql(format_str, args, opts, output, err, info);
+    EXPECT_EQ(err, error_code());
+    EXPECT_EQ(info, error_info());
+    return output;
+}
+
+void format_error(
+    std::string_view format_str,
+    const std::vector<value>& args,
+    errc expected,
+    format_options opts = format_options()
+)
+{
+    std::string output;
+    error_code err;
+    error_info info;
+    format_sql(format_str, args, opts, output, err, info);
+    EXPECT_EQ(err, boost::mysql::detail::make_error_code(expected));
+    validate_error_info(info, {"format_sql"});
+}
+
+// Placeholders
+TEST(FormatSqlTest, Placeholders_NoPlaceholders_CopiesFormatString)
+{
+    EXPECT_EQ(format_ok("SELECT 1", {}), "SELECT 1");
+    EXPECT_EQ(format_ok("", {}), "");
+}
+
+TEST(FormatSqlTest, Placeholders_SeveralPlaceholders_ReplacedInOrder)
+{
+    EXPECT_EQ(format_ok("SELECT {}, {} FROM t WHERE a = {}", makevalues(1, "abc", nullptr)),
+        "SELECT 1, 'abc' FROM t WHERE a = NULL");
+    EXPECT_EQ(format_ok("{}{}", makevalues(1, 2)), "12");
+}
+
+TEST(FormatSqlTest, Placeholders_EscapedBraces_WrittenOnce)
+{
+    EXPECT_EQ(format_ok("SELECT '{{}}', {}", makevalues(1)), "SELECT '{}', 1");
+    EXPECT_EQ(format_ok("{{{}}}", makevalues(1)), "{1}");
+}
+
+TEST(FormatSqlTest, Placeholders_UnmatchedBraces_ReturnsError)
+{
+    format_error("SELECT {", {}, errc::invalid_format_string);
+    format_error("SELECT }", {}, errc::invalid_format_string);
+    format_error("SELECT {abc}", makevalues(1), errc::invalid_format_string);
+    format_error("SELECT {0}", makevalues(1), errc::invalid_format_string);
+}
+
+TEST(FormatSqlTest, Placeholders_TooFewArgs_ReturnsError)
+{
+    format_error("SELECT {}, {}", makevalues(1), errc::wrong_num_format_args);
+}
+
+TEST(FormatSqlTest, Placeholders_TooManyArgs_ReturnsError)
+{
+    format_error("SELECT {}", makevalues(1, 2), errc::wrong_num_format_args);
+}
+
+// Value types
+TEST(FormatSqlTest, Values_Integers_WrittenAsNumbers)
+{
+    EXPECT_EQ(format_ok("{} {} {}", makevalues(42, -1, std::uint64_t(0xffffffffffffffff))),
+        "42 -1 18446744073709551615");
+    EXPECT_EQ(format_ok("{}", makevalues(std::numeric_limits<std::int64_t>::min())),
+        "-9223372036854775808");
+}
+
+TEST(FormatSqlTest, Values_FloatingPoint_WrittenAsDoubleLiterals)
+{
+    EXPECT_EQ(format_ok("{}", makevalues(4.2)), "4.2000000000000002e+00");
+    EXPECT_EQ(format_ok("{}", makevalues(-1.5f)), "-1.50000000e+00");
+    EXPECT_EQ(format_ok("{}", makevalues(0.0)), "0.0000000000000000e+00");
+}
+
+TEST(FormatSqlTest, Values_NonFiniteFloatingPoint_ReturnsError)
+{
+    format_error("{}", makevalues(std::numeric_limits<double>::infinity()), errc::unformattable_value);
+    format_error("{}", makevalues(std::numeric_limits<float>::quiet_NaN()), errc::unformattable_value);
+}
+
+TEST(FormatSqlTest, Values_Dates_WrittenAsQuotedStrings)
+{
+    EXPECT_EQ(format_ok("{}", makevalues(makedate(2020, 1, 5))), "'2020-01-05'");
+    EXPECT_EQ(format_ok("{}", makevalues(makedt(2020, 12, 31, 23, 59, 1, 123))),
+        "'2020-12-31 23:59:01.000123'");
+}
+
+TEST(FormatSqlTest, Values_Times_WrittenAsQuotedStrings)
+{
+    EXPECT_EQ(format_ok("{}", makevalues(maket(838, 59, 58, 999999))), "'838:59:58.999999'");
+    EXPECT_EQ(format_ok("{}", makevalues(-maket(1, 2, 3))), "'-01:02:03.000000'");
+}
+
+// String escaping
+TEST(FormatSqlTest, Strings_SpecialCharacters_BackslashEscaped)
+{
+    EXPECT_EQ(format_ok("{}", makevalues(makesv("a'b\"c\\d\ne\rf\x1a"))), "'a\\'b\\\"c\\\\d\\ne\\rf\\Z'");
+    EXPECT_EQ(format_ok("{}", makevalues(std::string_view("a\0b", 3))), "'a\\0b'");
+    EXPECT_EQ(format_ok("{}", makevalues("")), "''");
+}
+
+TEST(FormatSqlTest, Strings_NoBackslashEscapes_OnlyQuotesDoubled)
+{
+    format_options opts (collation::utf8mb4_general_ci, false);
+    EXPECT_EQ(format_ok("{}", makevalues("it's a \\ test\n"), opts), "'it''s a \\ test\n'");
+}
+
+TEST(FormatSqlTest, Strings_Utf8MultiByte_CopiedVerbatim)
+{
+    EXPECT_EQ(format_ok("{}", makevalues("\xc3\xb1'")), "'\xc3\xb1\\''");
+}
+
+TEST(FormatSqlTest, Strings_GbkValidCharacterWithBackslashTrail_NotEscaped)
+{
+    format_options opts (collation::gbk_chinese_ci);
+    EXPECT_EQ(format_ok("{}", makevalues("\xbf\x5c"), opts), "'\xbf\x5c'");
+}
+
+TEST(FormatSqlTest, Strings_GbkInvalidCharacterWithQuote_LeadByteEscaped)
+{
+    // Escaping only the quote would yield 0xbf5c27, where 0xbf5c is a valid character
+    format_options opts (collation::gbk_chinese_ci);
+    EXPECT_EQ(format_ok("{}", makevalues("\xbf'"), opts), "'\\\xbf\\''");
+}
+
+TEST(FormatSqlTest, Strings_SjisValidCharacterWithBackslashTrail_NotEscaped)
+{
+    format_options opts (collation::sjis_japanese_ci);
+    EXPECT_EQ(format_ok("{}", makevalues("\x95\x5c\\"), opts), "'\x95\x5c\\\\'");
+}
+
+TEST(FormatSqlTest, Strings_Gb18030FourByteCharacter_CopiedVerbatim)
+{
+    format_options opts (collation::gb18030_chinese_ci);
+    EXPECT_EQ(format_ok("{}", makevalues("\x81\x30\x81\x30'"), opts), "'\x81\x30\x81\x30\\''");
+}
+
+TEST(FormatSqlTest, Strings_UnsupportedCharacterSet_ReturnsError)
+{
+    format_error("{}", makevalues("abc"), errc::unsupported_character_set,
+        format_options(collation::utf16_general_ci));
+    format_error("{}", makevalues("abc"), errc::unsupported_character_set,
+        format_options(collation::ucs2_unicode_ci));
+}
+
+TEST(FormatSqlTest, Strings_UnsupportedCharacterSetNoStrings_Ok)
+{
+    EXPECT_EQ(format_ok("{}", makevalues(42), format_options(collation::utf32_bin)), "42");
+}
+
+// Buffer handling and error reporting
+TEST(FormatSqlTest, Output_NonEmptyBuffer_ContentsReplaced)
+{
+    std::string output = "previous contents, longer than the result";
+    auto previous_capacity = output.capacity();
+    format_sql("SELECT {}", makevalues(1), format_options(), output);
+    EXPECT_EQ(output, "SELECT 1");
+    EXPECT_EQ(output.capacity(), previous_capacity);
+}
+
+TEST(FormatSqlTest, Exceptions_Error_Throws)
+{
+    std::string output;
+    EXPECT_THROW(
+        format_sql("SELECT {}", makevalues(1, 2), format_options(), output),
+        boost::system::system_error
+    );
+}
+
+TEST(FormatSqlTest, IteratorRange_Ok_FormatsRange)
+{
+    auto values = makevalues(1, 2, 3);
+    std::string output;
+    format_sql("{}, {}", values.begin() + 1, values.end(), format_options(), output);
+    EXPECT_EQ(output, "2, 3");
+}
+
+}
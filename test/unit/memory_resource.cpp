@@ -0,0 +1,179 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include "boost/mysql/connection.hpp"
+#include "test_common.hpp"
+#include "test_stream.hpp"
+#include <memory_resource>
+
+using namespace boost::mysql::test;
+using boost::mysql::owning_row;
+using boost::mysql::value;
+using boost::mysql::error_code;
+using boost::mysql::error_info;
+
+namespace
+{
+
+using test_connection = boost::mysql::connection<test_stream>;
+
+// Forwards to new/delete, keeping track of the memory in use
+class counting_resource : public std::pmr::memory_resource
+{
+    std::size_t num_allocations_ {};
+    std::size_t bytes_in_use_ {};
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        ++num_allocations_;
+        bytes_in_use_ += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+    {
+        bytes_in_use_ -= bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+public:
+    std::size_t num_allocations() const noexcept { return num_allocations_; }
+    std::size_t bytes_in_use() const noexcept { return bytes_in_use_; }
+};
+
+// Server response to a query returning a single VARCHAR column, with rows "abc" and "def"
+void add_resultset_response(test_stream& stream)
+{
+    const char column_definition [] =
+        "\x03" "def" "\x00" "\x00" "\x00" "\x01" "f" "\x00" "\x0c" "\x21\x00"
+        "\x0a\x00\x00\x00" "\xfd" "\x00\x00" "\x00" "\x00\x00";
+    const char eof [] = { '\xfe', 0x00, 0x00, 0x02, 0x00, 0x00, 0x00 };
+    stream.add_bytes_to_read(make_packet(1, "\x01"));
+    stream.add_bytes_to_read(make_packet(2, std::string_view(column_definition, sizeof(column_definition) - 1)));
+    stream.add_bytes_to_read(make_packet(3, "\x03" "abc"));
+    stream.add_bytes_to_read(make_packet(4, "\x03" "def"));
+    stream.add_bytes_to_read(make_packet(5, std::string_view(eof, sizeof(eof))));
+}
+
+// Reads all rows with fetch_one, which doesn't allocate once the row has grown enough
+std::size_t fetch_one_all(boost::mysql::resultset<test_stream>& result)
+{
+    std::size_t res = 0;
+    while (result.fetch_one())
+        ++res;
+    return res;
+}
+
+TEST(MemoryResourceTest, DefaultConstructor_UsesDefaultResource)
+{
+    boost::asio::io_context ctx;
+    test_connection conn (ctx);
+    EXPECT_EQ(conn.get_allocator().resource(), std::pmr::get_default_resource());
+}
+
+TEST(MemoryResourceTest, QueryAndFetch_AllocatesFromConnectionResource)
+{
+    counting_resource resource;
+    {
+        boost::asio::io_context ctx;
+        test_connection conn (std::allocator_arg, &resource, ctx);
+        EXPECT_EQ(conn.get_allocator().resource(), &resource);
+        add_resultset_response(conn.next_layer());
+
+        auto result = conn.query("SELECT f FROM t");
+        ASSERT_EQ(result.fields().size(), 1);
+        EXPECT_EQ(result.fields()[0].field_name(), "f");
+        EXPECT_GT(resource.num_allocations(), 0);
+
+        const auto* row = result.fetch_one();
+        ASSERT_NE(row, nullptr);
+        EXPECT_EQ(*row, makerow("abc"));
+
+        auto rows = result.fetch_all();
+        ASSERT_EQ(rows.size(), 1);
+        EXPECT_EQ(rows[0], makerow("def"));
+        EXPECT_TRUE(result.complete());
+    }
+    EXPECT_EQ(resource.bytes_in_use(), 0);
+}
+
+TEST(MemoryResourceTest, OwningRowMoveAssignment_KeepsStringsValid)
+{
+    counting_resource resource;
+    boost::asio::io_context ctx;
+    test_connection conn (std::allocator_arg, &resource, ctx);
+    add_resultset_response(conn.next_layer());
+    auto rows = conn.query("SELECT f FROM t").fetch_all();
+    ASSERT_EQ(rows.size(), 2);
+
+    // The destination row uses the default resource. Moving must transfer
+    // the string buffer, rather than copying it, or the value would dangle
+    const void* string_data = rows[1].values()[0].get<std::string_view>().data();
+    owning_row row;
+    row = std::move(rows[1]);
+    EXPECT_EQ(row.values()[0].get<std::string_view>().data(), string_data);
+    EXPECT_EQ(row, makerow("def"));
+}
+
+TEST(MemoryResourceTest, QueryIntoResultset_SteadyState_NoAllocations)
+{
+    counting_resource resource;
+    boost::asio::io_context ctx;
+    test_connection conn (std::allocator_arg, &resource, ctx);
+    boost::mysql::resultset<test_stream> result;
+
+    // The first query allocates the buffers
+    add_resultset_response(conn.next_layer());
+    conn.query("SELECT f FROM t", result);
+    EXPECT_EQ(fetch_one_all(result), 2);
+    std::size_t num_allocations = resource.num_allocations();
+
+    // The following ones reuse them
+    for (int i = 0; i < 10; ++i)
+    {
+        add_resultset_response(conn.next_layer());
+        conn.query("SELECT f FROM t", result);
+        ASSERT_EQ(result.fields().size(), 1);
+        EXPECT_EQ(result.fields()[0].field_name(), "f");
+        const auto* row = result.fetch_one();
+        ASSERT_NE(row, nullptr);
+        EXPECT_EQ(*row, makerow("abc"));
+        EXPECT_EQ(result.at(*row, "f"), value("abc"));
+        EXPECT_EQ(fetch_one_all(result), 1);
+        EXPECT_TRUE(result.complete());
+    }
+    EXPECT_EQ(resource.num_allocations(), num_allocations);
+}
+
+TEST(MemoryResourceTest, DiscardRemaining_SteadyState_NoAllocations)
+{
+    counting_resource resource;
+    boost::asio::io_context ctx;
+    test_connection conn (std::allocator_arg, &resource, ctx);
+    boost::mysql::resultset<test_stream> result;
+
+    add_resultset_response(conn.next_layer());
+    conn.query("SELECT f FROM t", result);
+    result.discard_remaining();
+    std::size_t num_allocations = resource.num_allocations();
+
+    for (int i = 0; i < 10; ++i)
+    {
+        add_resultset_response(conn.next_layer());
+        conn.query("SELECT f FROM t", result);
+        result.discard_remaining();
+        EXPECT_TRUE(result.complete());
+    }
+    EXPECT_EQ(resource.num_allocations(), num_allocations);
+}
+
+}
@@ -8,12 +8,15 @@
 #include "boost/mysql/metadata.hpp"
 #include <gtest/gtest.h>
 #include "boost/mysql/detail/protocol/serialization.hpp"
+#include <memory>
 
 using namespace testing;
 using namespace boost::mysql::detail;
 using boost::mysql::collation;
 using boost::mysql::field_metadata;
 using boost::mysql::field_type;
+using boost::mysql::field_name_index;
+using boost::mysql::field_name_key;
 
 namespace
 {
@@ -130,4 +133,139 @@ TEST(FieldMetadata, FloatField)
 
 }
 
+// field_name_index
+std::vector<field_metadata> make_fields(const std::vector<std::string>& names)
+{
+    // Strings must outlive the metadata, so we keep them in static storage
+    static std::vector<std::unique_ptr<std::string>> storage;
+    std::vector<field_metadata> res;
+    for (const auto& name: names)
+    {
+        storage.push_back(std::make_unique<std::string>(name));
+        column_definition_packet msg {};
+        msg.name = string_lenenc(*storage.back());
+        res.emplace_back(msg);
+    }
+    return res;
+}
+
+TEST(FieldNameIndex, Empty_FindReturnsNpos)
+{
+    field_name_index index;
+    EXPECT_EQ(index.find("id"), field_name_index::npos);
+    EXPECT_EQ(field_name_index(make_fields({})).find("id"), field_name_index::npos);
+}
+
+TEST(FieldNameIndex, SeveralFields_FindReturnsPosition)
+{
+    field_name_index index (make_fields({"id", "name", "", "created_at"}));
+    EXPECT_EQ(index.find("id"), 0);
+    EXPECT_EQ(index.find("name"), 1);
+    EXPECT_EQ(index.find(""), 2);
+    EXPECT_EQ(index.find("created_at"), 3);
+    EXPECT_EQ(index.find("ID"), field_name_index::npos); // case sensitive
+    EXPECT_EQ(index.find("nam"), field_name_index::npos);
+    EXPECT_EQ(index.find("other"), field_name_index::npos);
+}
+
+TEST(FieldNameIndex, DuplicateNames_FindReturnsFirst)
+{
+    field_name_index index (make_fields({"a", "b", "a", "b"}));
+    EXPECT_EQ(index.find("a"), 0);
+    EXPECT_EQ(index.find("b"), 1);
+}
+
+TEST(FieldNameIndex, ManyFields_AllFound)
+{
+    std::vector<std::string> names;
+    for (int i = 0; i < 500; ++i)
+        names.push_back("field_" + std::to_string(i));
+    field_name_index index (make_fields(names));
+    for (std::size_t i = 0; i < names.size(); ++i)
+        EXPECT_EQ(index.find(names[i]), i);
+    EXPECT_EQ(index.find("field_500"), field_name_index::npos);
+}
+
+TEST(FieldNameIndex, FieldNameKey_HashComputedAtCompileTime)
+{
+    constexpr field_name_key key ("name");
+    static_assert(key.hash() == hash_field_name("name"));
+    static_assert(key.name() == "name");
+    field_name_index index (make_fields({"id", "name"}));
+    EXPECT_EQ(index.find(key), 1);
+}
+
+TEST(FieldNameIndex, NamesModifiedAfterBuildingIndex_LookupsWork)
+{
+    // The index copies the names, so it doesn't depend on the memory fields point to
+    std::string name ("id");
+    column_definition_packet msg {};
+    msg.name = string_lenenc(name);
+    field_name_index index (std::vector<field_metadata>{field_metadata(msg)});
+    name = "xx";
+    EXPECT_EQ(index.find("id"), 0);
+    EXPECT_EQ(index.find("xx"), field_name_index::npos);
+}
+
+// resultset_metadata
+void append_column_definition(resource_bytestring& buffer, std::string_view name)
+{
+    for (std::string_view str: {std::string_view("def"), std::string_view("awesome"),
+            std::string_view("test_table"), std::string_view("test_table"), name, name})
+    {
+        buffer.push_back(static_cast<std::uint8_t>(str.size()));
+        buffer.insert(buffer.end(), str.begin(), str.end());
+    }
+    buffer.insert(buffer.end(), {
+        0x0c, // length of fixed fields
+        0x3f, 0x00, // collation
+        0x0b, 0x00, 0x00, 0x00, // column length
+        0x03, // type (long)
+        0x00, 0x00, // flags
+        0x00, // decimals
+        0x00, 0x00 // padding
+    });
+}
+
+TEST(ResultsetMetadata, ConcatenatedPackets_FieldsPointIntoBuffer)
+{
+    resource_bytestring buffer;
+    append_column_definition(buffer, "id");
+    append_column_definition(buffer, "field_varchar");
+    const auto* data = reinterpret_cast<const char*>(buffer.data());
+    std::size_t size = buffer.size();
+
+    resultset_metadata meta (std::move(buffer), 2);
+    const auto& fields = meta.fields();
+    ASSERT_EQ(fields.size(), 2);
+    EXPECT_EQ(fields[0].field_name(), "id");
+    EXPECT_EQ(fields[0].database(), "awesome");
+    EXPECT_EQ(fields[1].field_name(), "field_varchar");
+    EXPECT_EQ(fields[1].type(), field_type::int_);
+    EXPECT_GE(fields[1].field_name().data(), data);
+    EXPECT_LE(fields[1].field_name().data(), data + size);
+    EXPECT_EQ(meta.name_index().find("field_varchar"), 1);
+}
+
+TEST(ResultsetMetadata, Assign_OtherFields_RebuildsNameIndex)
+{
+    resource_bytestring buffer;
+    append_column_definition(buffer, "a");
+    append_column_definition(buffer, "b");
+    resultset_metadata meta (std::move(buffer), 2);
+
+    resource_bytestring other;
+    append_column_definition(other, "b");
+    append_column_definition(other, "c");
+    meta.assign(std::move(other), 2);
+    EXPECT_EQ(meta.name_index().find("a"), field_name_index::npos);
+    EXPECT_EQ(meta.name_index().find("b"), 0);
+    EXPECT_EQ(meta.name_index().find("c"), 1);
+}
+
+TEST(ResultsetMetadata, FieldMetadata_SmallerThanColumnDefinition)
+{
+    EXPECT_LT(sizeof(field_metadata), sizeof(column_definition_packet));
+}
+
 } // anon namespace
@@ -0,0 +1,301 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include "boost/mysql/connection.hpp"
+#include "boost/mysql/protocol_capture.hpp"
+#include "capture_replay.hpp"
+#include "fake_server_fixture.hpp"
+#include "test_common.hpp"
+#include "test_stream.hpp"
+#include <sstream>
+
+using namespace boost::mysql::test;
+using boost::mysql::error_code;
+using boost::mysql::errc;
+using boost::mysql::connection_params;
+using boost::mysql::ssl_options;
+using boost::mysql::ssl_mode;
+using boost::mysql::capture_record;
+using boost::mysql::capture_record_type;
+using boost::mysql::capture_writer;
+using boost::mysql::capture_reader;
+using boost::mysql::detail::make_error_code;
+using bytes = std::vector<std::uint8_t>;
+
+namespace
+{
+
+bytes to_bytes(std::string_view s) { return bytes(s.begin(), s.end()); }
+
+// Reader and writer
+TEST(ProtocolCapture, WriteRead_RoundTrip)
+{
+    std::stringstream stream;
+    capture_writer writer (stream);
+    std::array<boost::asio::const_buffer, 2> bufs {
+        boost::asio::buffer("abc", 3),
+        boost::asio::buffer("de", 2)
+    };
+    writer.write(capture_record_type::client_message, 3, bufs);
+    writer.write(capture_record{capture_record_type::server_message, 255, {}, {}});
+    writer.write(capture_record{capture_record_type::handshake_complete, 0, {}, {1, 2, 3, 4, 5, 6}});
+
+    capture_reader reader (stream);
+    auto records = reader.read_all();
+    ASSERT_EQ(records.size(), 3);
+    EXPECT_EQ(records[0].type, capture_record_type::client_message);
+    EXPECT_EQ(records[0].sequence_number, 3);
+    EXPECT_EQ(records[0].payload, to_bytes("abcde"));
+    EXPECT_EQ(records[1].type, capture_record_type::server_message);
+    EXPECT_EQ(records[1].sequence_number, 255);
+    EXPECT_EQ(records[1].payload, bytes());
+    EXPECT_EQ(records[2].type, capture_record_type::handshake_complete);
+    EXPECT_EQ(records[2].payload, (bytes{1, 2, 3, 4, 5, 6}));
+    EXPECT_LE(records[0].timestamp, records[1].timestamp);
+    EXPECT_LE(records[1].timestamp, records[2].timestamp);
+}
+
+TEST(ProtocolCapture, Write_IsCompact)
+{
+    std::stringstream stream;
+    capture_writer writer (stream);
+    writer.write(capture_record{capture_record_type::client_message, 0, {}, to_bytes("abc")});
+    EXPECT_EQ(stream.str().size(), 12 + 14 + 3); // header, record header, payload
+}
+
+TEST(ProtocolCapture, Read_EmptyCapture_ReturnsFalse)
+{
+    std::stringstream stream;
+    capture_writer writer (stream);
+    capture_reader reader (stream);
+    capture_record record;
+    error_code err;
+    EXPECT_FALSE(reader.read(record, err));
+    EXPECT_EQ(err, error_code());
+}
+
+TEST(ProtocolCapture, Read_InvalidHeader_ReturnsError)
+{
+    std::stringstream stream ("NOTACAPTURE!");
+    capture_reader reader (stream);
+    capture_record record;
+    error_code err;
+    EXPECT_FALSE(reader.read(record, err));
+    EXPECT_EQ(err, make_error_code(errc::protocol_value_error));
+}
+
+TEST(ProtocolCapture, Read_TruncatedRecord_ReturnsError)
+{
+    std::stringstream stream;
+    capture_writer writer (stream);
+    writer.write(capture_record{capture_record_type::client_message, 0, {}, to_bytes("abc")});
+    auto contents = stream.str();
+    for (std::size_t size: {contents.size() - 1, contents.size() - 4})
+    {
+        std::stringstream truncated (contents.substr(0, size));
+        capture_reader reader (truncated);
+        capture_record record;
+        error_code err;
+        EXPECT_FALSE(reader.read(record, err));
+        EXPECT_EQ(err, make_error_code(errc::incomplete_message)) << "size=" << size;
+    }
+    std::stringstream truncated (contents.substr(0, contents.size() - 1));
+    capture_reader reader (truncated);
+    EXPECT_THROW(reader.read_all(), boost::system::system_error);
+}
+
+// Capturing a connection's traffic, and replaying it
+struct ConnectionCaptureTest : fake_connection_fixture
+{
+    std::stringstream stream;
+    capture_writer writer {stream};
+
+    ConnectionCaptureTest()
+    {
+        // Same as the fixture's, with a long value
+        server.add_resultset("SELECT * FROM t", {"id", "name"}, {
+            makevalues(1, "abc"),
+            makevalues(2, std::string(1000, 'a')),
+            makevalues(3, nullptr)
+        });
+        load(server.query_response("SELECT * FROM t"));
+        load(server.prepare_response("SELECT * FROM t"));
+        load(server.execute_response("SELECT * FROM t"));
+        conn.set_capture(&writer);
+    }
+
+    void run_sync()
+    {
+        conn.handshake(params);
+        conn.query("SELECT * FROM t").fetch_all();
+        auto stmt = conn.prepare_statement("SELECT * FROM t");
+        stmt.execute(boost::mysql::no_statement_params).fetch_all();
+        stmt.close();
+        conn.quit();
+    }
+
+    std::vector<capture_record> records()
+    {
+        capture_reader reader (stream);
+        return reader.read_all();
+    }
+};
+
+TEST_F(ConnectionCaptureTest, Sync_CapturesAllMessages)
+{
+    run_sync();
+    auto recs = records();
+
+    // Handshake: greeting, response, OK, handshake_complete
+    ASSERT_GE(recs.size(), 4);
+    EXPECT_EQ(recs[0].type, capture_record_type::server_message);
+    EXPECT_EQ(recs[0].sequence_number, 0);
+    EXPECT_EQ(recs[1].type, capture_record_type::client_message);
+    EXPECT_EQ(recs[1].sequence_number, 1);
+    EXPECT_EQ(recs[1].payload, bytes()); // authentication data is not captured
+    EXPECT_EQ(recs[2].type, capture_record_type::server_message);
+    EXPECT_EQ(recs[2].sequence_number, 2);
+    EXPECT_EQ(recs[3].type, capture_record_type::handshake_complete);
+
+    // Query
+    ASSERT_GE(recs.size(), 5);
+    EXPECT_EQ(recs[4].type, capture_record_type::client_message);
+    EXPECT_EQ(recs[4].sequence_number, 0);
+    EXPECT_EQ(recs[4].payload, to_bytes("\x03SELECT * FROM t"));
+
+    // All server bytes were captured, in order
+    bytes server_bytes;
+    for (const auto& rec: recs)
+    {
+        if (rec.type == capture_record_type::server_message)
+        {
+            auto framed = fake_server::frame(rec.sequence_number, rec.payload);
+            server_bytes.insert(server_bytes.end(), framed.begin(), framed.end());
+        }
+    }
+    bytes expected = server.handshake_bytes();
+    for (const auto& part: {server.query_response("SELECT * FROM t"),
+            server.prepare_response("SELECT * FROM t"), server.execute_response("SELECT * FROM t")})
+        expected.insert(expected.end(), part.begin(), part.end());
+    EXPECT_EQ(server_bytes, expected);
+
+    // Last messages are close statement and quit
+    EXPECT_EQ(recs[recs.size() - 2].payload.at(0), 0x19);
+    EXPECT_EQ(recs.back().payload, bytes{0x01});
+    for (std::size_t i = 1; i < recs.size(); ++i)
+        EXPECT_LE(recs[i - 1].timestamp, recs[i].timestamp);
+}
+
+TEST_F(ConnectionCaptureTest, Async_CapturesSameMessages)
+{
+    bool called = false;
+    boost::mysql::resultset<test_stream> result;
+    conn.async_handshake(params, [&](error_code err) {
+        ASSERT_EQ(err, error_code());
+        conn.async_query("SELECT * FROM t", [&](error_code err, boost::mysql::resultset<test_stream> r) {
+            ASSERT_EQ(err, error_code());
+            result = std::move(r);
+            result.async_fetch_all([&](error_code err, std::vector<boost::mysql::owning_row>) {
+                EXPECT_EQ(err, error_code());
+                called = true;
+            });
+        });
+    });
+    ctx.run();
+    ASSERT_TRUE(called);
+    auto async_recs = records();
+
+    // Same exchange, synchronously
+    boost::asio::io_context sync_ctx;
+    boost::mysql::connection<test_stream> sync_conn (sync_ctx);
+    std::stringstream sync_stream;
+    capture_writer sync_writer (sync_stream);
+    sync_conn.set_capture(&sync_writer);
+    sync_conn.next_layer().add_bytes_to_read(server.handshake_bytes());
+    sync_conn.next_layer().add_bytes_to_read(server.query_response("SELECT * FROM t"));
+    sync_conn.handshake(params);
+    sync_conn.query("SELECT * FROM t").fetch_all();
+    auto sync_recs = capture_reader(sync_stream).read_all();
+
+    ASSERT_EQ(async_recs.size(), sync_recs.size());
+    for (std::size_t i = 0; i < async_recs.size(); ++i)
+    {
+        EXPECT_EQ(async_recs[i].type, sync_recs[i].type) << "i=" << i;
+        EXPECT_EQ(async_recs[i].sequence_number, sync_recs[i].sequence_number) << "i=" << i;
+        EXPECT_EQ(async_recs[i].payload, sync_recs[i].payload) << "i=" << i;
+    }
+}
+
+#ifdef BOOST_ASIO_HAS_LOCAL_SOCKETS
+// Over UNIX sockets, caching_sha2_password full authentication
+// sends the password in clear text
+TEST_F(ConnectionCaptureTest, FullAuth_PasswordNotCaptured)
+{
+    server.require_full_auth();
+    fake_unix_server unix_server (server, {"/tmp/boost_mysql_capture.sock"});
+    connection_params full_auth_params ("user", "s3cr3t", "db", params.connection_collation(),
+        ssl_options(ssl_mode::disable));
+    boost::mysql::unix_connection unix_conn (ctx);
+    unix_conn.set_capture(&writer);
+    unix_conn.connect(unix_server.endpoint(), full_auth_params);
+    unix_conn.query("SELECT * FROM t").fetch_all();
+    unix_conn.close();
+    auto recs = records();
+
+    // Handshake: greeting, response, more data, password, OK, handshake_complete
+    ASSERT_GE(recs.size(), 7);
+    EXPECT_EQ(recs[3].type, capture_record_type::client_message);
+    EXPECT_EQ(recs[3].sequence_number, 3);
+    EXPECT_EQ(recs[3].payload, bytes());
+    EXPECT_EQ(recs[5].type, capture_record_type::handshake_complete);
+    EXPECT_EQ(recs[6].payload, to_bytes("\x03SELECT * FROM t"));
+    for (const auto& rec: recs)
+    {
+        std::string_view payload (reinterpret_cast<const char*>(rec.payload.data()), rec.payload.size());
+        EXPECT_EQ(payload.find("s3cr3t"), std::string_view::npos);
+    }
+}
+#endif
+
+TEST_F(ConnectionCaptureTest, Replay_RepeatsTraffic)
+{
+    run_sync();
+    capture_replayer replayer (records());
+    EXPECT_EQ(replayer.num_commands(), 5); // query, prepare, execute, close, quit
+
+    for (std::size_t read_ahead: {0, 16384})
+    {
+        replayer.get_connection().set_read_ahead_size(read_ahead);
+        for (int i = 0; i < 2; ++i)
+        {
+            auto stats = replayer.run();
+            EXPECT_EQ(stats.num_commands, 5);
+            EXPECT_EQ(stats.num_rows, 6);
+            EXPECT_EQ(stats.bytes_read, replayer.server_bytes_size());
+        }
+    }
+}
+
+TEST_F(ConnectionCaptureTest, Replay_NoHandshake_Throws)
+{
+    std::vector<capture_record> recs {
+        capture_record{capture_record_type::client_message, 0, {}, to_bytes("\x03SELECT 1")}
+    };
+    EXPECT_THROW(capture_replayer{recs}, std::invalid_argument);
+}
+
+TEST_F(ConnectionCaptureTest, Replay_TruncatedCapture_Throws)
+{
+    run_sync();
+    auto recs = records();
+    recs.erase(recs.end() - 3); // the last row or EOF of the statement execution
+    capture_replayer replayer (recs);
+    EXPECT_THROW(replayer.run(), boost::system::system_error);
+}
+
+} // anon namespace
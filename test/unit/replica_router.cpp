@@ -0,0 +1,481 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include "boost/mysql/replica_router.hpp"
+#include "fake_server.hpp"
+#include "test_common.hpp"
+#include <optional>
+
+using namespace boost::mysql::test;
+using boost::mysql::error_code;
+using boost::mysql::error_info;
+using boost::mysql::errc;
+using boost::mysql::connection_params;
+using boost::mysql::ssl_options;
+using boost::mysql::ssl_mode;
+using boost::mysql::owning_row;
+using boost::mysql::router_options;
+using boost::mysql::balancing_strategy;
+using boost::mysql::access_mode;
+using boost::mysql::tcp_replica_router;
+using boost::mysql::detail::make_error_code;
+using std::chrono::seconds;
+
+namespace
+{
+
+using endpoint_type = boost::asio::ip::tcp::endpoint;
+using pooled_type = boost::mysql::pooled_connection<boost::asio::ip::tcp::socket>;
+
+const endpoint_type any_port {boost::asio::ip::address_v4::loopback(), 0};
+const std::string gtid = "3e11fa47-71ca-11e1-9e33-c80aa9429562:5";
+const std::string wait_sql = "SELECT WAIT_FOR_EXECUTED_GTID_SET('3e11fa47-71ca-11e1-9e33-c80aa9429562:1-5', 1)";
+
+// Each server answers SELECT @@hostname with its own name,
+// so tests can tell which one served a query
+fake_server make_server(const char* name)
+{
+    fake_server res;
+    res.add_resultset("SELECT @@hostname", {"@@hostname"}, {makevalues(name)});
+    return res;
+}
+
+struct ReplicaRouterTest : public testing::Test
+{
+    fake_server primary_server = make_server("primary");
+    fake_server replica1_server = make_server("replica1");
+    fake_server replica2_server = make_server("replica2");
+    connection_params params {"user", "password", "db", boost::mysql::collation::utf8mb4_general_ci,
+        ssl_options(ssl_mode::disable)};
+    router_options opts;
+    boost::asio::io_context ctx;
+
+    ReplicaRouterTest()
+    {
+        primary_server.add_ok("INSERT INTO t VALUES (1)", 1);
+        opts.pool.retry.max_retries = 0;
+    }
+
+    static std::string hostname(tcp_replica_router& router)
+    {
+        auto rows = router.query("SELECT @@hostname");
+        return rows.empty() ? std::string() : std::string(rows[0].values().at(0).get<std::string_view>());
+    }
+
+    static void add_status(fake_server& server, const char* sql, const char* column, boost::mysql::value lag)
+    {
+        server.add_resultset(sql, {"Replica_IO_Running", column}, {makevalues("Yes", lag)});
+    }
+
+    // An endpoint where nothing is listening
+    endpoint_type unused_endpoint()
+    {
+        fake_tcp_server tcp_server (primary_server, any_port);
+        return tcp_server.endpoint();
+    }
+};
+
+TEST_F(ReplicaRouterTest, Query_Write_GoesToPrimary)
+{
+    fake_tcp_server primary (primary_server, any_port);
+    fake_tcp_server replica (replica1_server, any_port);
+    tcp_replica_router router (ctx.get_executor(), primary.endpoint(), {replica.endpoint()}, params, opts);
+
+    router.query("INSERT INTO t VALUES (1)");
+    EXPECT_EQ(router.primary().size(), 1);
+    EXPECT_EQ(router.replica(0).size(), 0);
+}
+
+TEST_F(ReplicaRouterTest, Query_RoundRobin_AlternatesReplicas)
+{
+    fake_tcp_server primary (primary_server, any_port);
+    fake_tcp_server replica1 (replica1_server, any_port);
+    fake_tcp_server replica2 (replica2_server, any_port);
+    tcp_replica_router router (ctx.get_executor(), primary.endpoint(),
+        {replica1.endpoint(), replica2.endpoint()}, params, opts);
+
+    EXPECT_EQ(router.num_replicas(), 2);
+    EXPECT_EQ(hostname(router), "replica1");
+    EXPECT_EQ(hostname(router), "replica2");
+    EXPECT_EQ(hostname(router), "replica1");
+    EXPECT_EQ(router.primary().size(), 0);
+}
+
+TEST_F(ReplicaRouterTest, Query_LeastOutstanding_AvoidsBusyReplica)
+{
+    fake_tcp_server primary (primary_server, any_port);
+    fake_tcp_server replica1 (replica1_server, any_port);
+    fake_tcp_server replica2 (replica2_server, any_port);
+    opts.balancing = balancing_strategy::least_outstanding;
+    tcp_replica_router router (ctx.get_executor(), primary.endpoint(),
+        {replica1.endpoint(), replica2.endpoint()}, params, opts);
+
+    auto busy = router.acquire(access_mode::read);
+    EXPECT_EQ(&busy.pool(), &router.replica(0));
+    EXPECT_EQ(hostname(router), "replica2");
+    EXPECT_EQ(hostname(router), "replica2");
+    busy.release();
+    EXPECT_EQ(hostname(router), "replica1");
+}
+
+TEST_F(ReplicaRouterTest, Acquire_ReplicaPoolFull_ReplicaStaysAvailable)
+{
+    fake_tcp_server primary (primary_server, any_port);
+    fake_tcp_server replica (replica1_server, any_port);
+    opts.pool.max_size = 1;
+    tcp_replica_router router (ctx.get_executor(), primary.endpoint(), {replica.endpoint()}, params, opts);
+
+    auto busy = router.acquire(access_mode::read);
+    EXPECT_EQ(&busy.pool(), &router.replica(0));
+
+    error_code err;
+    error_info info;
+    router.acquire(access_mode::read, err, info);
+    EXPECT_EQ(err, boost::asio::error::would_block);
+    router.query("SELECT @@hostname", err, info);
+    EXPECT_EQ(err, boost::asio::error::would_block);
+
+    EXPECT_TRUE(router.replica_available(0));
+    EXPECT_EQ(router.primary().size(), 0);
+
+    // The async version waits for the replica connection to be released
+    pooled_type waited;
+    router.async_acquire(access_mode::read, [&](error_code err, pooled_type conn) {
+        EXPECT_EQ(err, error_code());
+        waited = std::move(conn);
+    });
+    ctx.poll();
+    EXPECT_FALSE(waited.valid());
+    busy.release();
+    ctx.run();
+    ASSERT_TRUE(waited.valid());
+    EXPECT_EQ(&waited.pool(), &router.replica(0));
+    EXPECT_TRUE(router.replica_available(0));
+}
+
+TEST_F(ReplicaRouterTest, Query_NoReplicas_ReadsGoToPrimary)
+{
+    fake_tcp_server primary (primary_server, any_port);
+    tcp_replica_router router (ctx.get_executor(), primary.endpoint(), {}, params, opts);
+    EXPECT_EQ(hostname(router), "primary");
+}
+
+TEST_F(ReplicaRouterTest, Query_ReplicaDown_MarkedUnavailableAndReadServedByPrimary)
+{
+    fake_tcp_server primary (primary_server, any_port);
+    tcp_replica_router router (ctx.get_executor(), primary.endpoint(), {unused_endpoint()}, params, opts);
+
+    EXPECT_TRUE(router.replica_available(0));
+    EXPECT_EQ(hostname(router), "primary");
+    EXPECT_FALSE(router.replica_available(0));
+}
+
+TEST_F(ReplicaRouterTest, Query_ReplicaFailsWithServerError_NotRetried)
+{
+    fake_tcp_server primary (primary_server, any_port);
+    fake_tcp_server replica (replica1_server, any_port);
+    tcp_replica_router router (ctx.get_executor(), primary.endpoint(), {replica.endpoint()}, params, opts);
+
+    error_code err;
+    error_info info;
+    router.query("SELECT * FROM unknown", err, info);
+    EXPECT_EQ(err, make_error_code(errc::parse_error));
+    EXPECT_TRUE(router.replica_available(0));
+    EXPECT_EQ(router.primary().size(), 0);
+}
+
+TEST_F(ReplicaRouterTest, Acquire_Write_GoesToPrimary)
+{
+    fake_tcp_server primary (primary_server, any_port);
+    fake_tcp_server replica (replica1_server, any_port);
+    tcp_replica_router router (ctx.get_executor(), primary.endpoint(), {replica.endpoint()}, params, opts);
+
+    auto conn = router.acquire(access_mode::write);
+    EXPECT_EQ(&conn.pool(), &router.primary());
+    EXPECT_EQ(conn->query("SELECT @@hostname").at(0).values().at(0), boost::mysql::value("primary"));
+}
+
+TEST_F(ReplicaRouterTest, CheckReplicas_LagWithinLimit_Available)
+{
+    add_status(replica1_server, "SHOW REPLICA STATUS", "Seconds_Behind_Source", boost::mysql::value(std::uint64_t(5)));
+    add_status(replica2_server, "SHOW REPLICA STATUS", "Seconds_Behind_Source", boost::mysql::value(std::uint64_t(100)));
+    fake_tcp_server primary (primary_server, any_port);
+    fake_tcp_server replica1 (replica1_server, any_port);
+    fake_tcp_server replica2 (replica2_server, any_port);
+    tcp_replica_router router (ctx.get_executor(), primary.endpoint(),
+        {replica1.endpoint(), replica2.endpoint()}, params, opts);
+
+    router.check_replicas();
+    EXPECT_EQ(router.replica_lag(0), seconds(5));
+    EXPECT_TRUE(router.replica_available(0));
+    EXPECT_EQ(router.replica_lag(1), seconds(100));
+    EXPECT_FALSE(router.replica_available(1));
+    EXPECT_EQ(hostname(router), "replica1");
+    EXPECT_EQ(hostname(router), "replica1");
+}
+
+TEST_F(ReplicaRouterTest, CheckReplicas_OldServer_FallsBackToLegacySyntax)
+{
+    add_status(replica1_server, "SHOW SLAVE STATUS", "Seconds_Behind_Master", boost::mysql::value(std::uint64_t(2)));
+    fake_tcp_server primary (primary_server, any_port);
+    fake_tcp_server replica (replica1_server, any_port);
+    tcp_replica_router router (ctx.get_executor(), primary.endpoint(), {replica.endpoint()}, params, opts);
+
+    router.check_replicas();
+    EXPECT_EQ(router.replica_lag(0), seconds(2));
+    EXPECT_TRUE(router.replica_available(0));
+    router.check_replicas(); // remembers the syntax
+    EXPECT_TRUE(router.replica_available(0));
+}
+
+TEST_F(ReplicaRouterTest, CheckReplicas_ReplicationStopped_Unavailable)
+{
+    add_status(replica1_server, "SHOW REPLICA STATUS", "Seconds_Behind_Source", boost::mysql::value(nullptr));
+    replica2_server.add_resultset("SHOW REPLICA STATUS", {"Seconds_Behind_Source"}, {}); // not a replica
+    fake_tcp_server primary (primary_server, any_port);
+    fake_tcp_server replica1 (replica1_server, any_port);
+    fake_tcp_server replica2 (replica2_server, any_port);
+    tcp_replica_router router (ctx.get_executor(), primary.endpoint(),
+        {replica1.endpoint(), replica2.endpoint()}, params, opts);
+
+    router.check_replicas();
+    EXPECT_FALSE(router.replica_lag(0));
+    EXPECT_FALSE(router.replica_available(0));
+    EXPECT_FALSE(router.replica_lag(1));
+    EXPECT_FALSE(router.replica_available(1));
+    EXPECT_EQ(hostname(router), "primary");
+}
+
+TEST_F(ReplicaRouterTest, CheckReplicas_Error_ReturnsFirstAndChecksTheRest)
+{
+    replica1_server.add_error("SHOW REPLICA STATUS", errc::specific_access_denied_error, "Access denied");
+    add_status(replica2_server, "SHOW REPLICA STATUS", "Seconds_Behind_Source", boost::mysql::value(std::uint64_t(0)));
+    fake_tcp_server primary (primary_server, any_port);
+    fake_tcp_server replica1 (replica1_server, any_port);
+    fake_tcp_server replica2 (replica2_server, any_port);
+    tcp_replica_router router (ctx.get_executor(), primary.endpoint(),
+        {replica1.endpoint(), replica2.endpoint()}, params, opts);
+
+    error_code err;
+    error_info info;
+    router.check_replicas(err, info);
+    EXPECT_EQ(err, make_error_code(errc::specific_access_denied_error));
+    EXPECT_EQ(info.message(), "Access denied");
+    EXPECT_FALSE(router.replica_available(0));
+    EXPECT_TRUE(router.replica_available(1));
+}
+
+TEST_F(ReplicaRouterTest, ReadYourWrites_ReplicaCaughtUp_ReadServedByReplica)
+{
+    primary_server.enable_session_tracking().add_ok_with_gtids("UPDATE t SET a = 1", gtid, 1);
+    replica1_server.add_resultset(wait_sql, {"res"}, {makevalues(0)});
+    fake_tcp_server primary (primary_server, any_port);
+    fake_tcp_server replica (replica1_server, any_port);
+    opts.read_your_writes = true;
+    tcp_replica_router router (ctx.get_executor(), primary.endpoint(), {replica.endpoint()}, params, opts);
+
+    router.query("UPDATE t SET a = 1");
+    EXPECT_EQ(router.written_gtids(), "3e11fa47-71ca-11e1-9e33-c80aa9429562:1-5");
+    EXPECT_EQ(hostname(router), "replica1");
+}
+
+TEST_F(ReplicaRouterTest, ReadYourWrites_ReplicaBehind_ReadServedByPrimary)
+{
+    primary_server.enable_session_tracking().add_ok_with_gtids("UPDATE t SET a = 1", gtid, 1);
+    replica1_server.add_resultset(wait_sql, {"res"}, {makevalues(1)}); // timeout
+    fake_tcp_server primary (primary_server, any_port);
+    fake_tcp_server replica (replica1_server, any_port);
+    opts.read_your_writes = true;
+    tcp_replica_router router (ctx.get_executor(), primary.endpoint(), {replica.endpoint()}, params, opts);
+
+    router.query("UPDATE t SET a = 1");
+    EXPECT_EQ(hostname(router), "primary");
+    EXPECT_TRUE(router.replica_available(0));
+}
+
+TEST_F(ReplicaRouterTest, ReadYourWrites_NoGtidsReported_ReadsServedByPrimary)
+{
+    fake_tcp_server primary (primary_server, any_port);
+    fake_tcp_server replica (replica1_server, any_port);
+    opts.read_your_writes = true;
+    tcp_replica_router router (ctx.get_executor(), primary.endpoint(), {replica.endpoint()}, params, opts);
+
+    EXPECT_EQ(hostname(router), "replica1"); // nothing written yet
+    router.query("INSERT INTO t VALUES (1)");
+    EXPECT_EQ(router.written_gtids(), "");
+    EXPECT_EQ(hostname(router), "primary");
+}
+
+TEST_F(ReplicaRouterTest, ReadYourWrites_SetAfterWrite_ReadsServedByReplica)
+{
+    primary_server.enable_session_tracking().add_ok_with_gtids("UPDATE t SET a = 1", gtid, 1);
+    primary_server.add_ok("SET time_zone = '+00:00'");
+    replica1_server.add_resultset(wait_sql, {"res"}, {makevalues(0)});
+    fake_tcp_server primary (primary_server, any_port);
+    fake_tcp_server replica (replica1_server, any_port);
+    opts.read_your_writes = true;
+    tcp_replica_router router (ctx.get_executor(), primary.endpoint(), {replica.endpoint()}, params, opts);
+
+    router.query("UPDATE t SET a = 1");
+    router.query("SET time_zone = '+00:00'");
+    EXPECT_EQ(hostname(router), "replica1");
+    EXPECT_EQ(hostname(router), "replica1");
+}
+
+TEST_F(ReplicaRouterTest, ReadYourWrites_SetBeforeWrites_ReadsServedByReplicaOnceGtidsReported)
+{
+    primary_server.enable_session_tracking().add_ok_with_gtids("UPDATE t SET a = 1", gtid, 1);
+    primary_server.add_ok("SET time_zone = '+00:00'");
+    replica1_server.add_resultset(wait_sql, {"res"}, {makevalues(0)});
+    fake_tcp_server primary (primary_server, any_port);
+    fake_tcp_server replica (replica1_server, any_port);
+    opts.read_your_writes = true;
+    tcp_replica_router router (ctx.get_executor(), primary.endpoint(), {replica.endpoint()}, params, opts);
+
+    router.query("SET time_zone = '+00:00'");
+    EXPECT_EQ(hostname(router), "primary"); // the server may not report GTIDs
+    router.query("UPDATE t SET a = 1");
+    EXPECT_EQ(hostname(router), "replica1");
+    router.query("SET time_zone = '+00:00'");
+    EXPECT_EQ(hostname(router), "replica1");
+}
+
+TEST_F(ReplicaRouterTest, ReadYourWrites_Disabled_GtidsIgnored)
+{
+    primary_server.enable_session_tracking().add_ok_with_gtids("UPDATE t SET a = 1", gtid, 1);
+    fake_tcp_server primary (primary_server, any_port);
+    fake_tcp_server replica (replica1_server, any_port);
+    tcp_replica_router router (ctx.get_executor(), primary.endpoint(), {replica.endpoint()}, params, opts);
+
+    router.query("UPDATE t SET a = 1");
+    EXPECT_EQ(router.written_gtids(), "");
+    EXPECT_EQ(hostname(router), "replica1");
+}
+
+TEST_F(ReplicaRouterTest, TrackWrites_AcquiredConnection_Recorded)
+{
+    primary_server.enable_session_tracking().add_ok_with_gtids("COMMIT", gtid);
+    replica1_server.add_resultset(wait_sql, {"res"}, {makevalues(0)});
+    fake_tcp_server primary (primary_server, any_port);
+    fake_tcp_server replica (replica1_server, any_port);
+    opts.read_your_writes = true;
+    tcp_replica_router router (ctx.get_executor(), primary.endpoint(), {replica.endpoint()}, params, opts);
+
+    {
+        auto conn = router.acquire(access_mode::write);
+        conn->query("COMMIT");
+        router.track_writes(*conn);
+    }
+    EXPECT_EQ(router.written_gtids(), "3e11fa47-71ca-11e1-9e33-c80aa9429562:1-5");
+    EXPECT_EQ(hostname(router), "replica1");
+}
+
+TEST_F(ReplicaRouterTest, AsyncQuery_ReadAndWrite_Routed)
+{
+    fake_tcp_server primary (primary_server, any_port);
+    fake_tcp_server replica (replica1_server, any_port);
+    tcp_replica_router router (ctx.get_executor(), primary.endpoint(), {replica.endpoint()}, params, opts);
+
+    std::optional<error_code> read_err, write_err;
+    std::vector<owning_row> rows;
+    router.async_query("SELECT @@hostname", [&](error_code err, std::vector<owning_row> res) {
+        read_err = err;
+        rows = std::move(res);
+    });
+    router.async_query("INSERT INTO t VALUES (1)", [&](error_code err, std::vector<owning_row>) {
+        write_err = err;
+    });
+    ctx.run();
+    ASSERT_TRUE(read_err);
+    EXPECT_EQ(*read_err, error_code());
+    ASSERT_EQ(rows.size(), 1);
+    EXPECT_EQ(rows[0].values().at(0), boost::mysql::value("replica1"));
+    ASSERT_TRUE(write_err);
+    EXPECT_EQ(*write_err, error_code());
+    EXPECT_EQ(router.primary().num_idle(), 1);
+    EXPECT_EQ(router.replica(0).num_idle(), 1);
+}
+
+TEST_F(ReplicaRouterTest, AsyncQuery_ReplicaDown_ReadServedByPrimary)
+{
+    fake_tcp_server primary (primary_server, any_port);
+    tcp_replica_router router (ctx.get_executor(), primary.endpoint(), {unused_endpoint()}, params, opts);
+
+    std::optional<error_code> err;
+    std::vector<owning_row> rows;
+    router.async_query("SELECT @@hostname", [&](error_code ec, std::vector<owning_row> res) {
+        err = ec;
+        rows = std::move(res);
+    });
+    ctx.run();
+    ASSERT_TRUE(err);
+    EXPECT_EQ(*err, error_code());
+    ASSERT_EQ(rows.size(), 1);
+    EXPECT_EQ(rows[0].values().at(0), boost::mysql::value("primary"));
+    EXPECT_FALSE(router.replica_available(0));
+}
+
+TEST_F(ReplicaRouterTest, AsyncAcquire_ReadYourWritesBehind_ReturnsPrimary)
+{
+    primary_server.enable_session_tracking().add_ok_with_gtids("UPDATE t SET a = 1", gtid, 1);
+    replica1_server.add_resultset(wait_sql, {"res"}, {makevalues(1)});
+    fake_tcp_server primary (primary_server, any_port);
+    fake_tcp_server replica (replica1_server, any_port);
+    opts.read_your_writes = true;
+    tcp_replica_router router (ctx.get_executor(), primary.endpoint(), {replica.endpoint()}, params, opts);
+    router.query("UPDATE t SET a = 1");
+
+    std::optional<error_code> err;
+    pooled_type conn;
+    router.async_acquire(access_mode::read, [&](error_code ec, pooled_type c) {
+        err = ec;
+        conn = std::move(c);
+    });
+    ctx.run();
+    ASSERT_TRUE(err);
+    EXPECT_EQ(*err, error_code());
+    ASSERT_TRUE(conn.valid());
+    EXPECT_EQ(&conn.pool(), &router.primary());
+    EXPECT_EQ(router.replica(0).num_idle(), 1);
+}
+
+TEST_F(ReplicaRouterTest, AsyncCheckReplicas_UpdatesStatus)
+{
+    add_status(replica1_server, "SHOW SLAVE STATUS", "Seconds_Behind_Master", boost::mysql::value(std::uint64_t(40)));
+    add_status(replica2_server, "SHOW REPLICA STATUS", "Seconds_Behind_Source", boost::mysql::value(std::uint64_t(1)));
+    fake_tcp_server primary (primary_server, any_port);
+    fake_tcp_server replica1 (replica1_server, any_port);
+    fake_tcp_server replica2 (replica2_server, any_port);
+    tcp_replica_router router (ctx.get_executor(), primary.endpoint(),
+        {replica1.endpoint(), replica2.endpoint()}, params, opts);
+
+    std::optional<error_code> err;
+    router.async_check_replicas([&](error_code ec) { err = ec; });
+    ctx.run();
+    ASSERT_TRUE(err);
+    EXPECT_EQ(*err, error_code());
+    EXPECT_EQ(router.replica_lag(0), seconds(40));
+    EXPECT_FALSE(router.replica_available(0));
+    EXPECT_EQ(router.replica_lag(1), seconds(1));
+    EXPECT_TRUE(router.replica_available(1));
+}
+
+TEST_F(ReplicaRouterTest, AsyncCheckReplicas_NoReplicas_Completes)
+{
+    fake_tcp_server primary (primary_server, any_port);
+    tcp_replica_router router (ctx.get_executor(), primary.endpoint(), {}, params, opts);
+
+    std::optional<error_code> err;
+    router.async_check_replicas([&](error_code ec) { err = ec; });
+    EXPECT_FALSE(err);
+    ctx.run();
+    ASSERT_TRUE(err);
+    EXPECT_EQ(*err, error_code());
+}
+
+} // anon namespace
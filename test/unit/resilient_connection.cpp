@@ -0,0 +1,406 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include "boost/mysql/resilient_connection.hpp"
+#include "fake_server_fixture.hpp"
+#include "test_common.hpp"
+#include "test_stream.hpp"
+#include <optional>
+#include <thread>
+
+using namespace boost::mysql::test;
+using boost::mysql::error_code;
+using boost::mysql::error_info;
+using boost::mysql::errc;
+using boost::mysql::connection_params;
+using boost::mysql::owning_row;
+using boost::mysql::retry_policy;
+using boost::mysql::resilient_tcp_connection;
+using boost::mysql::ssl_options;
+using boost::mysql::ssl_mode;
+using boost::mysql::is_read_only_query;
+using boost::mysql::is_connection_error;
+using boost::mysql::detail::make_error_code;
+using boost::mysql::detail::compute_backoff;
+using std::chrono::milliseconds;
+
+namespace
+{
+
+const boost::asio::ip::tcp::endpoint any_port {boost::asio::ip::address_v4::loopback(), 0};
+
+struct ResilientConnectionTest : fake_server_fixture
+{
+    resilient_tcp_connection conn {ctx};
+
+    ResilientConnectionTest()
+    {
+        retry_policy policy;
+        policy.initial_backoff = milliseconds(5);
+        conn.set_retry_policy(policy);
+    }
+
+    // An endpoint where nothing is listening
+    static boost::asio::ip::tcp::endpoint unused_endpoint(const fake_server& server)
+    {
+        fake_tcp_server tcp_server (server, any_port);
+        return tcp_server.endpoint();
+    }
+};
+
+TEST_F(ResilientConnectionTest, Connect_Success)
+{
+    fake_tcp_server tcp_server (server, any_port);
+    conn.connect(tcp_server.endpoint(), params);
+    EXPECT_TRUE(conn.is_connected());
+    EXPECT_EQ(conn.num_reconnects(), 0);
+    EXPECT_EQ(conn.query("SELECT * FROM t").size(), 3);
+}
+
+TEST_F(ResilientConnectionTest, Connect_NoServer_RetriesWithBackoffThenFails)
+{
+    retry_policy policy;
+    policy.max_retries = 2;
+    policy.initial_backoff = milliseconds(20);
+    policy.jitter = 0.0;
+    conn.set_retry_policy(policy);
+
+    auto start = std::chrono::steady_clock::now();
+    error_code err;
+    error_info info;
+    conn.connect(unused_endpoint(server), params, err, info);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(err, boost::asio::error::connection_refused);
+    EXPECT_FALSE(conn.is_connected());
+    EXPECT_GE(elapsed, milliseconds(20 + 40));
+}
+
+TEST_F(ResilientConnectionTest, Connect_ServerStartsLater_Succeeds)
+{
+    auto ep = unused_endpoint(server);
+    retry_policy policy;
+    policy.max_retries = 50;
+    policy.initial_backoff = milliseconds(10);
+    policy.backoff_multiplier = 1.0;
+    conn.set_retry_policy(policy);
+
+    std::optional<fake_tcp_server> tcp_server;
+    std::thread starter ([&] {
+        std::this_thread::sleep_for(milliseconds(50));
+        tcp_server.emplace(server, ep);
+    });
+    error_code err;
+    error_info info;
+    conn.connect(ep, params, err, info);
+    starter.join();
+
+    EXPECT_EQ(err, error_code());
+    EXPECT_TRUE(conn.is_connected());
+}
+
+TEST_F(ResilientConnectionTest, Query_ConnectionLost_ReconnectsAndRetries)
+{
+    fake_tcp_server tcp_server (server, any_port);
+    conn.connect(tcp_server.endpoint(), params);
+    EXPECT_EQ(conn.query("SELECT * FROM t").size(), 3);
+
+    tcp_server.close_connections();
+    auto rows = conn.query("SELECT * FROM t");
+    EXPECT_EQ(rows.size(), 3);
+    EXPECT_EQ(rows[0].values()[0], boost::mysql::value(1));
+    EXPECT_TRUE(conn.is_connected());
+    EXPECT_EQ(conn.num_reconnects(), 1);
+}
+
+TEST_F(ResilientConnectionTest, Query_NotIdempotent_ReportsErrorAndReconnectsLater)
+{
+    fake_tcp_server tcp_server (server, any_port);
+    conn.connect(tcp_server.endpoint(), params);
+    tcp_server.close_connections();
+
+    error_code err;
+    error_info info;
+    conn.query("DELETE FROM t", err, info);
+    EXPECT_TRUE(is_connection_error(err));
+    EXPECT_FALSE(conn.is_connected());
+
+    conn.query("DELETE FROM t", err, info);
+    EXPECT_EQ(err, error_code());
+    EXPECT_EQ(conn.last_result().affected_rows(), 2);
+    EXPECT_EQ(conn.num_reconnects(), 1);
+}
+
+TEST_F(ResilientConnectionTest, Query_RetriesDisabled_ReportsError)
+{
+    fake_tcp_server tcp_server (server, any_port);
+    retry_policy policy;
+    policy.max_retries = 0;
+    conn.set_retry_policy(policy);
+    conn.connect(tcp_server.endpoint(), params);
+    tcp_server.close_connections();
+
+    error_code err;
+    error_info info;
+    conn.query("SELECT * FROM t", err, info);
+    EXPECT_TRUE(is_connection_error(err));
+    EXPECT_EQ(conn.query("SELECT * FROM t").size(), 3);
+}
+
+TEST_F(ResilientConnectionTest, Query_ServerError_NotRetried)
+{
+    fake_tcp_server tcp_server (server, any_port);
+    conn.connect(tcp_server.endpoint(), params);
+
+    error_code err;
+    error_info info;
+    conn.query("DROP TABLE t", err, info);
+    EXPECT_EQ(err, make_error_code(errc::no_such_table));
+    EXPECT_TRUE(conn.is_connected());
+    EXPECT_EQ(conn.num_reconnects(), 0);
+}
+
+TEST_F(ResilientConnectionTest, PrepareStatement_SameSql_SameStatement)
+{
+    fake_tcp_server tcp_server (server, any_port);
+    conn.connect(tcp_server.endpoint(), params);
+    auto stmt1 = conn.prepare_statement("SELECT * FROM t");
+    auto stmt2 = conn.prepare_statement("SELECT * FROM t");
+    EXPECT_TRUE(stmt1.valid());
+    EXPECT_EQ(conn.execute(stmt2, boost::mysql::no_statement_params).size(), 3);
+    EXPECT_EQ(conn.connection().stats().statements_prepared, 1);
+}
+
+TEST_F(ResilientConnectionTest, Execute_ConnectionLost_ReprepareAndRetry)
+{
+    fake_tcp_server tcp_server (server, any_port);
+    conn.connect(tcp_server.endpoint(), params);
+    auto stmt = conn.prepare_statement("SELECT * FROM t");
+    EXPECT_EQ(conn.execute(stmt, boost::mysql::no_statement_params).size(), 3);
+
+    tcp_server.close_connections();
+    EXPECT_EQ(conn.execute(stmt, boost::mysql::no_statement_params).size(), 3);
+    EXPECT_EQ(conn.execute(stmt, boost::mysql::no_statement_params).size(), 3);
+    auto stats = conn.connection().stats();
+    EXPECT_EQ(stats.statements_prepared, 2);
+    EXPECT_EQ(stats.statements_executed, 4); // including the one that found the connection closed
+    EXPECT_EQ(conn.num_reconnects(), 1);
+}
+
+TEST_F(ResilientConnectionTest, Async_ConnectionLost_ReconnectsAndRetries)
+{
+    fake_tcp_server tcp_server (server, any_port);
+    bool called = false;
+    conn.async_connect(tcp_server.endpoint(), params, [&](error_code err) {
+        ASSERT_EQ(err, error_code());
+        called = true;
+    });
+    ctx.run();
+    ASSERT_TRUE(called);
+
+    tcp_server.close_connections();
+    called = false;
+    ctx.restart();
+    conn.async_prepare_statement("SELECT * FROM t", [&](error_code err, resilient_tcp_connection::statement_handle stmt) {
+        ASSERT_EQ(err, error_code());
+        conn.async_execute(stmt, boost::mysql::no_statement_params, [&](error_code err, std::vector<owning_row> rows) {
+            ASSERT_EQ(err, error_code());
+            EXPECT_EQ(rows.size(), 3);
+            tcp_server.close_connections();
+            conn.async_query("SELECT * FROM t", [&](error_code err, std::vector<owning_row> rows) {
+                EXPECT_EQ(err, error_code());
+                EXPECT_EQ(rows.size(), 3);
+                called = true;
+            });
+        });
+    });
+    ctx.run();
+    EXPECT_TRUE(called);
+    EXPECT_EQ(conn.num_reconnects(), 2);
+}
+
+// Rows are returned by value, so they must remain usable
+// after the connection runs other queries
+struct ResilientConnectionRowsTest : ResilientConnectionTest
+{
+    ResilientConnectionRowsTest()
+    {
+        server.add_resultset("SELECT * FROM u", {"a", "b", "c", "d"}, {
+            makevalues(10, 20, 30, 40)
+        });
+    }
+
+    static void expect_first_rows(const std::vector<owning_row>& rows)
+    {
+        ASSERT_EQ(rows.size(), 3);
+        EXPECT_EQ(rows[1], makerow(2, "def"));
+    }
+};
+
+TEST_F(ResilientConnectionRowsTest, Query_RowsFromPreviousQuery_KeepTheirValues)
+{
+    fake_tcp_server tcp_server (server, any_port);
+    conn.connect(tcp_server.endpoint(), params);
+    auto rows = conn.query("SELECT * FROM t");
+    auto other_rows = conn.query("SELECT * FROM u");
+    expect_first_rows(rows);
+    ASSERT_EQ(other_rows.size(), 1);
+    EXPECT_EQ(conn.last_result().at(other_rows[0], "c"), boost::mysql::value(30));
+}
+
+TEST_F(ResilientConnectionRowsTest, Execute_RowsFromPreviousExecution_KeepTheirValues)
+{
+    fake_tcp_server tcp_server (server, any_port);
+    conn.connect(tcp_server.endpoint(), params);
+    auto stmt = conn.prepare_statement("SELECT * FROM t");
+    auto other_stmt = conn.prepare_statement("SELECT * FROM u");
+    auto rows = conn.execute(stmt, boost::mysql::no_statement_params);
+    auto other_rows = conn.execute(other_stmt, boost::mysql::no_statement_params);
+    expect_first_rows(rows);
+    ASSERT_EQ(other_rows.size(), 1);
+    EXPECT_EQ(conn.last_result().at(other_rows[0], "c"), boost::mysql::value(30));
+}
+
+TEST_F(ResilientConnectionRowsTest, Async_RowsFromPreviousQuery_KeepTheirValues)
+{
+    fake_tcp_server tcp_server (server, any_port);
+    conn.connect(tcp_server.endpoint(), params);
+    auto stmt = conn.prepare_statement("SELECT * FROM t");
+    std::vector<owning_row> query_rows, execute_rows, other_rows;
+    bool called = false;
+    conn.async_query("SELECT * FROM t", [&](error_code err, std::vector<owning_row> rows) {
+        ASSERT_EQ(err, error_code());
+        query_rows = std::move(rows);
+        conn.async_execute(stmt, boost::mysql::no_statement_params, [&](error_code err, std::vector<owning_row> rows) {
+            ASSERT_EQ(err, error_code());
+            execute_rows = std::move(rows);
+            conn.async_query("SELECT * FROM u", [&](error_code err, std::vector<owning_row> rows) {
+                EXPECT_EQ(err, error_code());
+                other_rows = std::move(rows);
+                called = true;
+            });
+        });
+    });
+    ctx.run();
+    ASSERT_TRUE(called);
+    expect_first_rows(query_rows);
+    expect_first_rows(execute_rows);
+    ASSERT_EQ(other_rows.size(), 1);
+    EXPECT_EQ(conn.last_result().at(other_rows[0], "c"), boost::mysql::value(30));
+}
+
+TEST_F(ResilientConnectionTest, Async_NoServer_Fails)
+{
+    retry_policy policy;
+    policy.max_retries = 1;
+    policy.initial_backoff = milliseconds(1);
+    conn.set_retry_policy(policy);
+    error_code result;
+    conn.async_connect(unused_endpoint(server), params, [&](error_code err) { result = err; });
+    ctx.run();
+    EXPECT_EQ(result, boost::asio::error::connection_refused);
+}
+
+// A test_stream usable as a socket: connecting always succeeds,
+// and reads are served from the bytes loaded by the test
+class connectable_stream : public test_stream
+{
+public:
+    struct endpoint_type {};
+    static constexpr int shutdown_both = 2;
+
+    using test_stream::test_stream;
+
+    bool is_open() const noexcept { return true; }
+    connectable_stream& lowest_layer() { return *this; }
+    void connect(const endpoint_type&, error_code& ec) { ec.clear(); }
+
+    template <typename CompletionToken>
+    BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(error_code))
+    async_connect(const endpoint_type&, CompletionToken&& token)
+    {
+        return boost::asio::async_initiate<CompletionToken, void(error_code)>(
+            [this](auto handler) {
+                boost::asio::post(get_executor(), [handler = std::move(handler)] () mutable {
+                    handler(error_code());
+                });
+            },
+            token
+        );
+    }
+};
+
+TEST_F(ResilientConnectionTest, Execute_UnknownStatement_Reprepared)
+{
+    boost::mysql::resilient_connection<connectable_stream> stream_conn (ctx);
+    auto& stream = stream_conn.connection().next_layer();
+    stream.add_bytes_to_read(server.handshake_bytes());
+    stream.add_bytes_to_read(server.prepare_response("SELECT * FROM t"));
+    stream.add_bytes_to_read(server.execute_response("SELECT * FROM unknown")); // the server forgot the statement
+    stream.add_bytes_to_read(server.prepare_response("SELECT * FROM t"));
+    stream.add_bytes_to_read(server.execute_response("SELECT * FROM t"));
+
+    stream_conn.connect({}, params);
+    auto stmt = stream_conn.prepare_statement("SELECT * FROM t");
+    EXPECT_EQ(stream_conn.execute(stmt, boost::mysql::no_statement_params).size(), 3);
+    EXPECT_EQ(stream_conn.connection().stats().statements_prepared, 2);
+    EXPECT_EQ(stream_conn.num_reconnects(), 0);
+}
+
+TEST(ResilientConnection, IsReadOnlyQuery)
+{
+    EXPECT_TRUE(is_read_only_query("SELECT 1"));
+    EXPECT_TRUE(is_read_only_query("select * from t"));
+    EXPECT_TRUE(is_read_only_query("  \n\t(SELECT 1) UNION (SELECT 2)"));
+    EXPECT_TRUE(is_read_only_query("/* comment */ SHOW TABLES"));
+    EXPECT_TRUE(is_read_only_query("-- comment\nDESCRIBE t"));
+    EXPECT_TRUE(is_read_only_query("# comment\ndesc t"));
+    EXPECT_TRUE(is_read_only_query("EXPLAIN SELECT 1"));
+    EXPECT_FALSE(is_read_only_query(""));
+    EXPECT_FALSE(is_read_only_query("INSERT INTO t VALUES (1)"));
+    EXPECT_FALSE(is_read_only_query("DELETE FROM t"));
+    EXPECT_FALSE(is_read_only_query("SELECTED"));
+    EXPECT_FALSE(is_read_only_query("DESCRIPTION"));
+    EXPECT_FALSE(is_read_only_query("/*! DELETE FROM t */ SELECT 1"));
+    EXPECT_FALSE(is_read_only_query("/* unterminated SELECT 1"));
+    EXPECT_FALSE(is_read_only_query("-- SELECT 1"));
+}
+
+TEST(ResilientConnection, IsConnectionError)
+{
+    EXPECT_FALSE(is_connection_error(error_code()));
+    EXPECT_TRUE(is_connection_error(boost::asio::error::eof));
+    EXPECT_TRUE(is_connection_error(boost::asio::error::connection_reset));
+    EXPECT_TRUE(is_connection_error(make_error_code(errc::server_shutdown)));
+    EXPECT_TRUE(is_connection_error(make_error_code(errc::session_was_killed)));
+    EXPECT_TRUE(is_connection_error(make_error_code(errc::con_count_error)));
+    EXPECT_TRUE(is_connection_error(make_error_code(errc::sequence_number_mismatch)));
+    EXPECT_FALSE(is_connection_error(make_error_code(errc::no_such_table)));
+    EXPECT_FALSE(is_connection_error(make_error_code(errc::dup_entry)));
+    EXPECT_FALSE(is_connection_error(make_error_code(errc::access_denied_error)));
+    EXPECT_FALSE(is_connection_error(make_error_code(errc::wrong_num_params)));
+}
+
+TEST(ResilientConnection, ComputeBackoff)
+{
+    retry_policy policy;
+    policy.initial_backoff = milliseconds(100);
+    policy.max_backoff = milliseconds(1000);
+    policy.backoff_multiplier = 2.0;
+    policy.jitter = 0.5;
+
+    EXPECT_EQ(compute_backoff(policy, 1, 0.0), milliseconds(100));
+    EXPECT_EQ(compute_backoff(policy, 2, 0.0), milliseconds(200));
+    EXPECT_EQ(compute_backoff(policy, 4, 0.0), milliseconds(800));
+    EXPECT_EQ(compute_backoff(policy, 5, 0.0), milliseconds(1000));
+    EXPECT_EQ(compute_backoff(policy, 1000, 0.0), milliseconds(1000));
+    EXPECT_EQ(compute_backoff(policy, 1, 0.5), milliseconds(75));
+    EXPECT_EQ(compute_backoff(policy, 2, 0.999), milliseconds(100));
+}
+
+} // anon namespace
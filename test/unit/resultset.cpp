@@ -0,0 +1,329 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include "boost/mysql/connection.hpp"
+#include "test_common.hpp"
+#include "test_stream.hpp"
+
+using namespace boost::mysql::test;
+using boost::mysql::error_code;
+using boost::mysql::error_info;
+using boost::mysql::errc;
+using boost::mysql::detail::make_error_code;
+
+namespace
+{
+
+using test_connection = boost::mysql::connection<test_stream>;
+using test_resultset = boost::mysql::resultset<test_stream>;
+
+// Column definition for a VARCHAR column called name
+std::string make_column_definition(std::string_view name)
+{
+    std::string res ("\x03" "def" "\x00" "\x00" "\x00", 7);
+    res.push_back(static_cast<char>(name.size()));
+    res += name;
+    res.append("\x00" "\x0c" "\x21\x00" "\x0a\x00\x00\x00" "\xfd" "\x00\x00" "\x00" "\x00\x00", 14);
+    return res;
+}
+
+// EOF packet with 3 warnings
+const char eof [] = { '\xfe', 0x00, 0x00, 0x02, 0x00, 0x03, 0x00 };
+
+// Error packet with code 1317 (query interrupted)
+const char error_packet [] = "\xff\x25\x05\x23\x37\x30\x31\x30\x30" "Query execution was interrupted";
+
+struct ResultsetTest : public testing::Test
+{
+    boost::asio::io_context ctx;
+    test_connection conn {ctx};
+    std::uint8_t seqnum {1};
+
+    void add_packet(std::string_view payload)
+    {
+        conn.next_layer().add_bytes_to_read(make_packet(seqnum++, payload));
+    }
+
+    // Server response to a query returning VARCHAR columns with the given names
+    void add_header(std::initializer_list<std::string_view> names = {"f"})
+    {
+        seqnum = 1;
+        add_packet(std::string(1, static_cast<char>(names.size())));
+        for (auto name: names)
+            add_packet(make_column_definition(name));
+    }
+
+    void add_row(std::initializer_list<std::string_view> values)
+    {
+        std::string payload;
+        for (auto value: values)
+        {
+            payload.push_back(static_cast<char>(value.size()));
+            payload += value;
+        }
+        add_packet(payload);
+    }
+
+    void add_row(std::string_view value) { add_row({value}); }
+
+    void add_eof() { add_packet(std::string_view(eof, sizeof(eof))); }
+
+    // Server response to a statement that doesn't return rows, with 1 affected row
+    void add_ok()
+    {
+        const char ok [] = { 0x00, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00 };
+        seqnum = 1;
+        add_packet(std::string_view(ok, sizeof(ok)));
+    }
+};
+
+// discard_remaining
+struct ResultsetDiscardRemainingTest : ResultsetTest
+{
+};
+
+TEST_F(ResultsetDiscardRemainingTest, SyncErrc_SeveralRows_CompletesResultset)
+{
+    add_header();
+    add_row("abc");
+    add_row("def");
+    add_row("ghi");
+    add_eof();
+    test_resultset result = conn.query("SELECT f FROM t");
+
+    const auto* row = result.fetch_one();
+    ASSERT_NE(row, nullptr);
+    EXPECT_EQ(*row, makerow("abc"));
+
+    error_code err;
+    error_info info ("previous error");
+    result.discard_remaining(err, info);
+    EXPECT_EQ(err, error_code());
+    EXPECT_EQ(info, error_info());
+    EXPECT_TRUE(result.complete());
+    EXPECT_EQ(result.warning_count(), 3);
+    EXPECT_EQ(result.fetch_one(), nullptr);
+}
+
+TEST_F(ResultsetDiscardRemainingTest, SyncExc_AlreadyComplete_DoesNothing)
+{
+    add_header();
+    add_eof();
+    test_resultset result = conn.query("SELECT f FROM t");
+    EXPECT_EQ(result.fetch_one(), nullptr);
+    ASSERT_TRUE(result.complete());
+
+    EXPECT_NO_THROW(result.discard_remaining());
+    EXPECT_TRUE(result.complete());
+}
+
+TEST_F(ResultsetDiscardRemainingTest, SyncErrc_ErrorPacket_ReturnsServerError)
+{
+    add_header();
+    add_row("abc");
+    add_packet(std::string_view(error_packet, sizeof(error_packet) - 1));
+    test_resultset result = conn.query("SELECT f FROM t");
+
+    error_code err;
+    error_info info;
+    result.discard_remaining(err, info);
+    EXPECT_EQ(err, make_error_code(errc::query_interrupted));
+    EXPECT_EQ(info.message(), "Query execution was interrupted");
+    EXPECT_FALSE(result.complete());
+}
+
+TEST_F(ResultsetDiscardRemainingTest, SyncExc_NetworkError_Throws)
+{
+    add_header();
+    add_row("abc"); // no EOF packet
+    test_resultset result = conn.query("SELECT f FROM t");
+    EXPECT_THROW(result.discard_remaining(), boost::system::system_error);
+    EXPECT_FALSE(result.complete());
+}
+
+TEST_F(ResultsetDiscardRemainingTest, Async_SeveralRows_CompletesResultset)
+{
+    add_header();
+    add_row("abc");
+    add_row("def");
+    add_eof();
+    test_resultset result = conn.query("SELECT f FROM t");
+
+    bool called = false;
+    error_info info ("previous error");
+    result.async_discard_remaining([&](error_code err) {
+        called = true;
+        EXPECT_EQ(err, error_code());
+    }, &info);
+    ctx.run();
+    EXPECT_TRUE(called);
+    EXPECT_EQ(info, error_info());
+    EXPECT_TRUE(result.complete());
+    EXPECT_EQ(result.warning_count(), 3);
+}
+
+TEST_F(ResultsetDiscardRemainingTest, Async_AlreadyComplete_CompletesAsIfByPost)
+{
+    add_header();
+    add_eof();
+    test_resultset result = conn.query("SELECT f FROM t");
+    result.fetch_one();
+    ASSERT_TRUE(result.complete());
+
+    bool called = false;
+    result.async_discard_remaining([&](error_code err) {
+        called = true;
+        EXPECT_EQ(err, error_code());
+    });
+    EXPECT_FALSE(called);
+    ctx.run();
+    EXPECT_TRUE(called);
+}
+
+TEST_F(ResultsetDiscardRemainingTest, Async_ErrorPacket_ReturnsServerError)
+{
+    add_header();
+    add_packet(std::string_view(error_packet, sizeof(error_packet) - 1));
+    test_resultset result = conn.query("SELECT f FROM t");
+
+    bool called = false;
+    error_info info;
+    result.async_discard_remaining([&](error_code err) {
+        called = true;
+        EXPECT_EQ(err, make_error_code(errc::query_interrupted));
+    }, &info);
+    ctx.run();
+    EXPECT_TRUE(called);
+    EXPECT_EQ(info.message(), "Query execution was interrupted");
+    EXPECT_FALSE(result.complete());
+}
+
+// Lookups by field name
+struct ResultsetFieldNamesTest : ResultsetTest
+{
+};
+
+TEST_F(ResultsetFieldNamesTest, At_ExistingField_ReturnsValue)
+{
+    add_header({"a", "b"});
+    add_row({"1", "2"});
+    add_eof();
+
+    test_resultset result = conn.query("SELECT a, b FROM t");
+    auto rows = result.fetch_all();
+    ASSERT_EQ(rows.size(), 1);
+    EXPECT_EQ(result.field_index("b"), 1);
+    EXPECT_EQ(result.at(rows[0], "a"), boost::mysql::value("1"));
+    EXPECT_EQ(result.at(rows[0], "b"), boost::mysql::value("2"));
+    constexpr boost::mysql::field_name_key key ("b");
+    EXPECT_EQ(result.field_index(key), 1);
+    EXPECT_EQ(result.at(rows[0], key), boost::mysql::value("2"));
+}
+
+TEST_F(ResultsetFieldNamesTest, At_NonExistingField_Throws)
+{
+    add_header({"a"});
+    add_row("1");
+    add_eof();
+
+    test_resultset result = conn.query("SELECT a FROM t");
+    auto row = result.fetch_one();
+    ASSERT_NE(row, nullptr);
+    EXPECT_EQ(result.field_index("x"), boost::mysql::field_name_index::npos);
+    EXPECT_THROW(result.at(*row, "x"), std::out_of_range);
+}
+
+// Queries into an existing resultset
+struct ResultsetQueryIntoTest : ResultsetTest
+{
+    test_resultset result;
+
+    void add_two_rows()
+    {
+        add_header();
+        add_row("abc");
+        add_row("def");
+        add_eof();
+    }
+};
+
+TEST_F(ResultsetQueryIntoTest, AlternatingEmptyAndRows)
+{
+    add_ok();
+    conn.query("UPDATE t SET f = 'abc'", result);
+    EXPECT_TRUE(result.valid());
+    EXPECT_TRUE(result.complete());
+    EXPECT_TRUE(result.fields().empty());
+    EXPECT_EQ(result.affected_rows(), 1);
+    EXPECT_EQ(result.fetch_one(), nullptr);
+
+    add_two_rows();
+    conn.query("SELECT f FROM t", result);
+    EXPECT_FALSE(result.complete());
+    EXPECT_EQ(result.fetch_all(), (makerows(1, "abc", "def")));
+
+    add_ok();
+    conn.query("UPDATE t SET f = 'abc'", result);
+    EXPECT_TRUE(result.complete());
+    EXPECT_TRUE(result.fields().empty());
+    EXPECT_EQ(result.field_index("f"), boost::mysql::field_name_index::npos);
+}
+
+TEST_F(ResultsetQueryIntoTest, Async_Success)
+{
+    for (int i = 0; i < 2; ++i)
+    {
+        add_two_rows();
+        error_code err = make_error_code(errc::protocol_value_error);
+        conn.async_query("SELECT f FROM t", result, [&err](error_code code) { err = code; });
+        ctx.restart();
+        ctx.run();
+        EXPECT_EQ(err, error_code());
+        ASSERT_TRUE(result.valid());
+        EXPECT_EQ(result.fetch_all(), (makerows(1, "abc", "def")));
+    }
+}
+
+TEST_F(ResultsetQueryIntoTest, Error_LeavesResultsetInvalid)
+{
+    add_ok();
+    conn.query("UPDATE t SET f = 'abc'", result);
+    ASSERT_TRUE(result.valid());
+
+    // No response available: the read fails
+    error_code err;
+    error_info info;
+    conn.query("SELECT f FROM t", result, err, info);
+    EXPECT_NE(err, error_code());
+    EXPECT_FALSE(result.valid());
+}
+
+TEST_F(ResultsetQueryIntoTest, OtherFields_LookupsUseNewFields)
+{
+    add_header({"a", "b"});
+    add_row({"1", "2"});
+    add_eof();
+    conn.query("SELECT a, b FROM t", result);
+    auto rows1 = result.fetch_all();
+
+    // Same names in a different order, and an extra one
+    add_header({"x", "b", "a"});
+    add_row({"3", "4", "5"});
+    add_eof();
+    conn.query("SELECT x, b, a FROM t", result);
+    auto rows2 = result.fetch_all();
+
+    EXPECT_EQ(result.field_index("x"), 0);
+    EXPECT_EQ(result.field_index("a"), 2);
+    ASSERT_EQ(rows2.size(), 1);
+    EXPECT_EQ(result.at(rows2[0], "a"), boost::mysql::value("5"));
+    EXPECT_EQ(result.at(rows2[0], "b"), boost::mysql::value("4"));
+    EXPECT_EQ(rows1, (makerows(2, "1", "2")));
+}
+
+} // anon namespace
@@ -0,0 +1,195 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include "boost/mysql/connection.hpp"
+#include "boost/mysql/row_batch_reader.hpp"
+#include "test_common.hpp"
+#include "test_stream.hpp"
+
+using namespace boost::mysql::test;
+using boost::mysql::owning_row;
+using boost::mysql::error_code;
+using boost::mysql::error_info;
+using boost::mysql::errc;
+
+namespace
+{
+
+using test_connection = boost::mysql::connection<test_stream>;
+using test_resultset = boost::mysql::resultset<test_stream>;
+using test_reader = boost::mysql::row_batch_reader<test_stream>;
+
+// Server response to a query returning a single VARCHAR column, with the given rows.
+// If terminate is false, the final EOF packet is not sent
+void add_resultset_response(
+    test_stream& stream,
+    const std::vector<std::string>& rows,
+    bool terminate = true
+)
+{
+    const char column_definition [] =
+        "\x03" "def" "\x00" "\x00" "\x00" "\x01" "f" "\x00" "\x0c" "\x21\x00"
+        "\x0a\x00\x00\x00" "\xfd" "\x00\x00" "\x00" "\x00\x00";
+    const char eof [] = { '\xfe', 0x00, 0x00, 0x02, 0x00, 0x00, 0x00 };
+    std::uint8_t seqnum = 1;
+    stream.add_bytes_to_read(make_packet(seqnum++, "\x01"));
+    stream.add_bytes_to_read(make_packet(seqnum++, std::string_view(column_definition, sizeof(column_definition) - 1)));
+    for (const auto& r: rows)
+        stream.add_bytes_to_read(make_packet(seqnum++, static_cast<char>(r.size()) + r));
+    if (terminate)
+        stream.add_bytes_to_read(make_packet(seqnum++, std::string_view(eof, sizeof(eof))));
+}
+
+struct RowBatchReaderTest : public testing::Test
+{
+    boost::asio::io_context ctx;
+    test_connection conn {ctx};
+
+    struct batch_result
+    {
+        bool called {false};
+        error_code err;
+        std::vector<owning_row> rows;
+    };
+
+    // Launches async_read_batch and runs until it completes.
+    // Background fetches that are still running are completed, too
+    batch_result read_batch(test_reader& reader, error_info* info=nullptr)
+    {
+        batch_result res;
+        reader.async_read_batch([&res](error_code err, std::vector<owning_row> rows) {
+            res.called = true;
+            res.err = err;
+            res.rows = std::move(rows);
+        }, info);
+        ctx.restart();
+        ctx.run();
+        EXPECT_TRUE(res.called);
+        return res;
+    }
+};
+
+TEST_F(RowBatchReaderTest, SeveralBatches_ReturnsRowsInOrderThenEmptyBatch)
+{
+    add_resultset_response(conn.next_layer(), {"a", "b", "c", "d", "e"});
+    test_resultset result = conn.query("SELECT f FROM t");
+    test_reader reader (result, 2);
+    EXPECT_EQ(reader.batch_size(), 2);
+    EXPECT_FALSE(reader.complete());
+
+    auto batch = read_batch(reader);
+    EXPECT_EQ(batch.err, error_code());
+    ASSERT_EQ(batch.rows.size(), 2);
+    EXPECT_EQ(batch.rows[0], makerow("a"));
+    EXPECT_EQ(batch.rows[1], makerow("b"));
+
+    batch = read_batch(reader);
+    EXPECT_EQ(batch.err, error_code());
+    ASSERT_EQ(batch.rows.size(), 2);
+    EXPECT_EQ(batch.rows[0], makerow("c"));
+    EXPECT_EQ(batch.rows[1], makerow("d"));
+
+    batch = read_batch(reader);
+    EXPECT_EQ(batch.err, error_code());
+    ASSERT_EQ(batch.rows.size(), 1);
+    EXPECT_EQ(batch.rows[0], makerow("e"));
+    EXPECT_TRUE(reader.complete());
+    EXPECT_TRUE(result.complete());
+
+    batch = read_batch(reader);
+    EXPECT_EQ(batch.err, error_code());
+    EXPECT_TRUE(batch.rows.empty());
+    EXPECT_TRUE(reader.complete());
+}
+
+TEST_F(RowBatchReaderTest, BatchReturned_NextBatchFetchedInBackground)
+{
+    add_resultset_response(conn.next_layer(), {"a", "b", "c"});
+    test_resultset result = conn.query("SELECT f FROM t");
+    test_reader reader (result, 2);
+
+    // Running the io_context to completion after the first batch
+    // lets the background fetch read the remaining rows
+    auto batch = read_batch(reader);
+    ASSERT_EQ(batch.rows.size(), 2);
+    EXPECT_TRUE(result.complete());
+    EXPECT_FALSE(reader.complete());
+
+    batch = read_batch(reader);
+    ASSERT_EQ(batch.rows.size(), 1);
+    EXPECT_EQ(batch.rows[0], makerow("c"));
+    EXPECT_TRUE(reader.complete());
+}
+
+TEST_F(RowBatchReaderTest, RowsMultipleOfBatchSize_LastBatchEmpty)
+{
+    add_resultset_response(conn.next_layer(), {"a", "b"});
+    test_resultset result = conn.query("SELECT f FROM t");
+    test_reader reader (result, 2);
+
+    auto batch = read_batch(reader);
+    ASSERT_EQ(batch.rows.size(), 2);
+
+    batch = read_batch(reader);
+    EXPECT_EQ(batch.err, error_code());
+    EXPECT_TRUE(batch.rows.empty());
+    EXPECT_TRUE(reader.complete());
+}
+
+TEST_F(RowBatchReaderTest, EmptyResultset_ReturnsEmptyBatch)
+{
+    add_resultset_response(conn.next_layer(), {});
+    test_resultset result = conn.query("SELECT f FROM t");
+    test_reader reader (result, 10);
+
+    auto batch = read_batch(reader);
+    EXPECT_EQ(batch.err, error_code());
+    EXPECT_TRUE(batch.rows.empty());
+    EXPECT_TRUE(reader.complete());
+}
+
+TEST_F(RowBatchReaderTest, BackgroundFetchFails_ErrorReportedByNextRead)
+{
+    // The stream runs out of bytes while fetching the second batch
+    add_resultset_response(conn.next_layer(), {"a", "b", "c"}, false);
+    test_resultset result = conn.query("SELECT f FROM t");
+    test_reader reader (result, 2);
+
+    auto batch = read_batch(reader);
+    EXPECT_EQ(batch.err, error_code());
+    ASSERT_EQ(batch.rows.size(), 2);
+
+    error_info info ("previous error");
+    batch = read_batch(reader, &info);
+    EXPECT_EQ(batch.err, boost::asio::error::eof);
+    EXPECT_EQ(info, error_info());
+    EXPECT_FALSE(reader.complete());
+}
+
+TEST_F(RowBatchReaderTest, ReaderDestroyedDuringBackgroundFetch_FetchCompletes)
+{
+    add_resultset_response(conn.next_layer(), {"a", "b", "c"});
+    test_resultset result = conn.query("SELECT f FROM t");
+    {
+        test_reader reader (result, 2);
+        bool called = false;
+        reader.async_read_batch([&called](error_code err, std::vector<owning_row> rows) {
+            called = true;
+            EXPECT_EQ(err, error_code());
+            EXPECT_EQ(rows.size(), 2);
+        });
+        ctx.run_one(); // start reading the first batch
+        while (!called)
+            ctx.run_one();
+    }
+    ctx.restart();
+    ctx.run();
+    EXPECT_TRUE(result.complete());
+}
+
+} // anon namespace
@@ -0,0 +1,189 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include "boost/mysql/session_state.hpp"
+#include "boost/mysql/detail/protocol/channel.hpp"
+#include "boost/mysql/detail/protocol/common_messages.hpp"
+#include "test_stream.hpp"
+
+using boost::mysql::session_state;
+using boost::mysql::detail::channel;
+using boost::mysql::detail::ok_packet;
+using boost::mysql::detail::capabilities;
+using boost::mysql::detail::CLIENT_SESSION_TRACK;
+using boost::mysql::detail::SERVER_STATUS_AUTOCOMMIT;
+using boost::mysql::detail::SERVER_STATUS_IN_TRANS;
+using boost::mysql::test::test_stream;
+using namespace std::literals::string_view_literals;
+
+namespace
+{
+
+// Session state information fields, as (type, string_lenenc data) entries
+constexpr auto schema_change = "\x01\x03\x02" "db"sv;
+constexpr auto autocommit_change = "\x00\x0f\x0a" "autocommit" "\x03" "OFF"sv;
+constexpr auto time_zone_change = "\x00\x0f\x09" "time_zone" "\x04" "UTC0"sv;
+constexpr auto state_change = "\x02\x02\x01" "1"sv;
+constexpr auto gtids_change = "\x03\x09\x00\x07" "abc:1-2"sv;
+constexpr auto transaction_state_change = "\x05\x09\x08" "T_______"sv;
+constexpr auto transaction_characteristics_change = "\x04\x0b\x0a" "READ ONLY;"sv;
+
+std::string concat(std::initializer_list<std::string_view> parts)
+{
+    std::string res;
+    for (auto part: parts)
+        res += part;
+    return res;
+}
+
+TEST(SessionState, DefaultConstructor_Empty)
+{
+    session_state st;
+    EXPECT_FALSE(st.tracking());
+    EXPECT_EQ(st.schema(), "");
+    EXPECT_EQ(st.system_variable("autocommit"), std::nullopt);
+    EXPECT_EQ(st.transaction_state(), "");
+    EXPECT_EQ(st.transaction_characteristics(), "");
+    EXPECT_EQ(st.gtids(), "");
+    EXPECT_FALSE(st.autocommit());
+    EXPECT_FALSE(st.in_transaction());
+}
+
+TEST(SessionState, Reset_ClearsPreviousChanges)
+{
+    session_state st;
+    ASSERT_TRUE(st.apply_changes(concat({ autocommit_change, gtids_change, transaction_state_change })));
+    st.reset(true, "mydb", SERVER_STATUS_AUTOCOMMIT);
+    EXPECT_TRUE(st.tracking());
+    EXPECT_EQ(st.schema(), "mydb");
+    EXPECT_EQ(st.system_variable("autocommit"), std::nullopt);
+    EXPECT_EQ(st.transaction_state(), "");
+    EXPECT_EQ(st.gtids(), "");
+    EXPECT_TRUE(st.autocommit());
+    EXPECT_FALSE(st.in_transaction());
+}
+
+TEST(SessionState, ApplyChanges_Empty_NoChanges)
+{
+    session_state st;
+    st.reset(true, "mydb", 0);
+    EXPECT_TRUE(st.apply_changes(""));
+    EXPECT_EQ(st.schema(), "mydb");
+}
+
+TEST(SessionState, ApplyChanges_AllTypes_Updated)
+{
+    session_state st;
+    EXPECT_TRUE(st.apply_changes(concat({
+        schema_change,
+        autocommit_change,
+        time_zone_change,
+        state_change,
+        gtids_change,
+        transaction_state_change,
+        transaction_characteristics_change
+    })));
+    EXPECT_EQ(st.schema(), "db");
+    EXPECT_EQ(st.system_variable("autocommit"), "OFF");
+    EXPECT_EQ(st.system_variable("time_zone"), "UTC0");
+    EXPECT_EQ(st.system_variable("sql_mode"), std::nullopt);
+    EXPECT_EQ(st.gtids(), "abc:1-2");
+    EXPECT_EQ(st.transaction_state(), "T_______");
+    EXPECT_EQ(st.transaction_characteristics(), "READ ONLY;");
+}
+
+TEST(SessionState, ApplyChanges_VariableChangedTwice_KeepsLastValue)
+{
+    session_state st;
+    EXPECT_TRUE(st.apply_changes(autocommit_change));
+    EXPECT_TRUE(st.apply_changes("\x00\x0e\x0a" "autocommit" "\x02" "ON"sv));
+    EXPECT_EQ(st.system_variable("autocommit"), "ON");
+}
+
+TEST(SessionState, ApplyChanges_UnknownType_Skipped)
+{
+    session_state st;
+    EXPECT_TRUE(st.apply_changes(concat({ "\x7f\x03" "abc"sv, schema_change })));
+    EXPECT_EQ(st.schema(), "db");
+}
+
+TEST(SessionState, ApplyChanges_Malformed_ReturnsFalseKeepsPreviousChanges)
+{
+    session_state st;
+    EXPECT_FALSE(st.apply_changes(concat({ schema_change, "\x05\x09\x08" "T_"sv })));
+    EXPECT_EQ(st.schema(), "db");
+    EXPECT_EQ(st.transaction_state(), "");
+}
+
+TEST(SessionState, ApplyChanges_MalformedData_ReturnsFalse)
+{
+    session_state st;
+    EXPECT_FALSE(st.apply_changes("\x01\x02\x05" "d"sv)); // schema shorter than its length
+    EXPECT_EQ(st.schema(), "");
+}
+
+// Integration with the channel
+struct SessionStateChannelTest : public testing::Test
+{
+    boost::asio::io_context ctx;
+    test_stream stream {ctx};
+    channel<test_stream> chan {stream};
+
+    ok_packet make_ok(std::uint16_t status_flags, std::string_view session_state_info)
+    {
+        ok_packet res {};
+        res.status_flags.value = status_flags;
+        res.session_state_info.value = session_state_info;
+        return res;
+    }
+};
+
+TEST_F(SessionStateChannelTest, ResetSession_TrackingNegotiated_AppliesHandshakeChanges)
+{
+    chan.set_current_capabilities(capabilities(CLIENT_SESSION_TRACK));
+    auto info = concat({ autocommit_change });
+    chan.reset_session("mydb", SERVER_STATUS_AUTOCOMMIT, info);
+    const auto& st = chan.current_session();
+    EXPECT_TRUE(st.tracking());
+    EXPECT_EQ(st.schema(), "mydb");
+    EXPECT_EQ(st.system_variable("autocommit"), "OFF");
+    EXPECT_TRUE(st.autocommit());
+    EXPECT_EQ(chan.status_flags(), SERVER_STATUS_AUTOCOMMIT);
+}
+
+TEST_F(SessionStateChannelTest, ResetSession_TrackingNotNegotiated_TrackingFalse)
+{
+    chan.set_current_capabilities(capabilities(0));
+    chan.reset_session("", 0, "");
+    EXPECT_FALSE(chan.current_session().tracking());
+}
+
+TEST_F(SessionStateChannelTest, ProcessOkPacket_WithChanges_UpdatesState)
+{
+    chan.set_current_capabilities(capabilities(CLIENT_SESSION_TRACK));
+    chan.reset_session("mydb", SERVER_STATUS_AUTOCOMMIT, "");
+    auto info = concat({ schema_change, transaction_state_change });
+    chan.process_ok_packet(make_ok(SERVER_STATUS_IN_TRANS, info));
+    const auto& st = chan.current_session();
+    EXPECT_EQ(st.schema(), "db");
+    EXPECT_EQ(st.transaction_state(), "T_______");
+    EXPECT_TRUE(st.in_transaction());
+    EXPECT_FALSE(st.autocommit());
+    EXPECT_EQ(chan.status_flags(), SERVER_STATUS_IN_TRANS);
+}
+
+TEST_F(SessionStateChannelTest, ProcessOkPacket_MalformedChanges_UpdatesStatusFlags)
+{
+    chan.set_current_capabilities(capabilities(CLIENT_SESSION_TRACK));
+    chan.reset_session("mydb", 0, "");
+    chan.process_ok_packet(make_ok(SERVER_STATUS_AUTOCOMMIT, "\x01\x09"sv));
+    EXPECT_EQ(chan.current_session().schema(), "mydb");
+    EXPECT_TRUE(chan.current_session().autocommit());
+}
+
+} // anon namespace
@@ -0,0 +1,276 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include "boost/mysql/sharded_pool.hpp"
+#include "fake_server_fixture.hpp"
+#include "test_common.hpp"
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/use_future.hpp>
+#include <future>
+#include <thread>
+
+using namespace boost::mysql::test;
+using boost::mysql::error_code;
+using boost::mysql::error_info;
+using boost::mysql::errc;
+using boost::mysql::connection_params;
+using boost::mysql::ssl_options;
+using boost::mysql::ssl_mode;
+using boost::mysql::owning_row;
+using boost::mysql::pool_options;
+using boost::mysql::tcp_sharded_pool;
+using boost::mysql::detail::make_error_code;
+
+namespace
+{
+
+const boost::asio::ip::tcp::endpoint any_port {boost::asio::ip::address_v4::loopback(), 0};
+
+// An io_context per shard, each one run by its own thread
+class shard_threads
+{
+    using guard_type = boost::asio::executor_work_guard<boost::asio::io_context::executor_type>;
+    std::vector<std::unique_ptr<boost::asio::io_context>> contexts_;
+    std::vector<guard_type> guards_;
+    std::vector<std::thread> threads_;
+public:
+    explicit shard_threads(std::size_t num_shards)
+    {
+        for (std::size_t i = 0; i < num_shards; ++i)
+        {
+            contexts_.push_back(std::make_unique<boost::asio::io_context>(1));
+            guards_.push_back(boost::asio::make_work_guard(*contexts_.back()));
+        }
+        for (auto& ctx: contexts_)
+            threads_.emplace_back([&ctx] { ctx->run(); });
+    }
+    ~shard_threads() { join(); }
+
+    boost::asio::io_context& context(std::size_t i) { return *contexts_.at(i); }
+
+    std::vector<tcp_sharded_pool::executor_type> executors() const
+    {
+        std::vector<tcp_sharded_pool::executor_type> res;
+        for (const auto& ctx: contexts_)
+            res.push_back(ctx->get_executor());
+        return res;
+    }
+
+    // Waits for all outstanding work to finish
+    void join()
+    {
+        guards_.clear();
+        for (auto& t: threads_)
+        {
+            if (t.joinable())
+                t.join();
+        }
+    }
+
+    // Runs fn in the i-th shard thread and waits for it
+    template <typename Fn>
+    auto run_in(std::size_t i, Fn&& fn)
+    {
+        std::packaged_task<decltype(fn())()> task (std::forward<Fn>(fn));
+        auto fut = task.get_future();
+        boost::asio::post(context(i), [&task] { task(); });
+        return fut.get();
+    }
+};
+
+struct ShardedPoolTest : fake_server_fixture
+{
+    ShardedPoolTest()
+    {
+        server.add_resultset("SELECT 1", {"1"}, {makevalues(1)});
+    }
+
+    static pool_options make_options(std::size_t max_size)
+    {
+        pool_options res;
+        res.max_size = max_size;
+        return res;
+    }
+};
+
+TEST_F(ShardedPoolTest, Constructor_OneShardPerExecutor)
+{
+    shard_threads threads (3);
+    tcp_sharded_pool pool (threads.executors(), any_port, params);
+    EXPECT_EQ(pool.num_shards(), 3);
+    for (std::size_t i = 0; i < 3; ++i)
+        EXPECT_EQ(pool.num_in_flight(i), 0);
+    EXPECT_EQ(pool.num_stolen(), 0);
+}
+
+TEST_F(ShardedPoolTest, LocalShard_ShardThread_ReturnsIt)
+{
+    shard_threads threads (2);
+    tcp_sharded_pool pool (threads.executors(), any_port, params);
+    EXPECT_EQ(pool.local_shard(), tcp_sharded_pool::npos);
+    EXPECT_EQ(threads.run_in(0, [&pool] { return pool.local_shard(); }), 0);
+    EXPECT_EQ(threads.run_in(1, [&pool] { return pool.local_shard(); }), 1);
+}
+
+TEST_F(ShardedPoolTest, LocalShard_StrandExecutor_ReturnsIt)
+{
+    shard_threads threads (2);
+    std::vector<tcp_sharded_pool::executor_type> executors {
+        boost::asio::make_strand(threads.context(0)),
+        boost::asio::make_strand(threads.context(1))
+    };
+    tcp_sharded_pool pool (executors, any_port, params);
+    auto res = threads.run_in(1, [&] {
+        std::promise<std::size_t> local;
+        boost::asio::dispatch(pool.shard_executor(1), [&] { local.set_value(pool.local_shard()); });
+        return local.get_future().get();
+    });
+    EXPECT_EQ(res, 1);
+}
+
+TEST_F(ShardedPoolTest, AsyncQuery_FromShardThread_RunsLocallyAndCompletesThere)
+{
+    fake_tcp_server tcp_server (server, any_port);
+    shard_threads threads (2);
+    tcp_sharded_pool pool (threads.executors(), tcp_server.endpoint(), params);
+
+    std::promise<std::pair<error_code, bool>> result;
+    threads.run_in(1, [&] {
+        pool.async_query("SELECT 1", [&](error_code err, std::vector<owning_row> rows) {
+            EXPECT_EQ(rows.size(), 1);
+            result.set_value({err, threads.context(1).get_executor().running_in_this_thread()});
+        });
+    });
+    auto [err, in_shard_thread] = result.get_future().get();
+    EXPECT_EQ(err, error_code());
+    EXPECT_TRUE(in_shard_thread);
+
+    threads.join();
+    EXPECT_EQ(pool.shard(0).size(), 0);
+    EXPECT_EQ(pool.shard(1).size(), 1);
+    EXPECT_EQ(pool.num_stolen(), 0);
+    EXPECT_EQ(pool.num_in_flight(1), 0);
+}
+
+TEST_F(ShardedPoolTest, AsyncQuery_RowsOutliveNextQueryOnConnection)
+{
+    fake_tcp_server tcp_server (server, any_port);
+    shard_threads threads (1);
+    tcp_sharded_pool pool (threads.executors(), tcp_server.endpoint(), params);
+
+    auto rows = pool.async_query("SELECT * FROM t", boost::asio::use_future).get();
+    auto other_rows = pool.async_query("SELECT 1", boost::asio::use_future).get();
+    ASSERT_EQ(rows.size(), 3);
+    EXPECT_EQ(rows[1], makerow(2, "def"));
+    EXPECT_EQ(other_rows, makerows(1, 1));
+    threads.join();
+    EXPECT_EQ(pool.shard(0).size(), 1);
+}
+
+TEST_F(ShardedPoolTest, AsyncQuery_LocalShardSaturated_StealsWork)
+{
+    fake_tcp_server tcp_server (server, any_port);
+    shard_threads threads (2);
+    tcp_sharded_pool pool (threads.executors(), tcp_server.endpoint(), params, make_options(1));
+
+    std::promise<void> done1, done2;
+    threads.run_in(0, [&] {
+        pool.async_query("SELECT 1", [&](error_code err, std::vector<owning_row>) {
+            EXPECT_EQ(err, error_code());
+            done1.set_value();
+        });
+        pool.async_query("SELECT 1", [&](error_code err, std::vector<owning_row>) {
+            EXPECT_EQ(err, error_code());
+            EXPECT_TRUE(threads.context(0).get_executor().running_in_this_thread());
+            done2.set_value();
+        });
+    });
+    done1.get_future().wait();
+    done2.get_future().wait();
+
+    threads.join();
+    EXPECT_EQ(pool.num_stolen(), 1);
+    EXPECT_EQ(pool.shard(0).size(), 1);
+    EXPECT_EQ(pool.shard(1).size(), 1);
+}
+
+TEST_F(ShardedPoolTest, AsyncQuery_ForeignThread_SpreadsLoad)
+{
+    fake_tcp_server tcp_server (server, any_port);
+    shard_threads threads (2);
+    tcp_sharded_pool pool (threads.executors(), tcp_server.endpoint(), params);
+
+    std::vector<std::future<std::vector<owning_row>>> futures;
+    for (int i = 0; i < 4; ++i)
+        futures.push_back(pool.async_query("SELECT 1", boost::asio::use_future));
+    for (auto& fut: futures)
+        EXPECT_EQ(fut.get().size(), 1);
+
+    threads.join();
+    EXPECT_GE(pool.shard(0).size(), 1);
+    EXPECT_GE(pool.shard(1).size(), 1);
+    EXPECT_EQ(pool.num_stolen(), 0);
+}
+
+TEST_F(ShardedPoolTest, AsyncQuery_Error_PropagatedWithInfo)
+{
+    fake_tcp_server tcp_server (server, any_port);
+    shard_threads threads (2);
+    tcp_sharded_pool pool (threads.executors(), tcp_server.endpoint(), params);
+
+    error_info info;
+    auto fut = pool.async_query("SELECT * FROM unknown", boost::asio::use_future, &info);
+    try
+    {
+        fut.get();
+        FAIL() << "Expected an error";
+    }
+    catch (const boost::system::system_error& err)
+    {
+        EXPECT_EQ(err.code(), make_error_code(errc::parse_error));
+    }
+    EXPECT_EQ(info.message(), "fake_server: unknown query");
+}
+
+TEST_F(ShardedPoolTest, AsyncQuery_ManyFromEveryShard_AllSucceed)
+{
+    constexpr std::size_t num_shards = 4;
+    constexpr int queries_per_shard = 50;
+    fake_tcp_server tcp_server (server, any_port);
+    shard_threads threads (num_shards);
+    tcp_sharded_pool pool (threads.executors(), tcp_server.endpoint(), params, make_options(2));
+
+    std::atomic<int> succeeded {0};
+    std::atomic<int> remaining {static_cast<int>(num_shards) * queries_per_shard};
+    std::promise<void> done;
+    for (std::size_t i = 0; i < num_shards; ++i)
+    {
+        boost::asio::post(threads.context(i), [&] {
+            for (int j = 0; j < queries_per_shard; ++j)
+            {
+                pool.async_query("SELECT 1", [&](error_code err, std::vector<owning_row> rows) {
+                    if (!err && rows.size() == 1)
+                        ++succeeded;
+                    if (--remaining == 0)
+                        done.set_value();
+                });
+            }
+        });
+    }
+    done.get_future().wait();
+
+    threads.join();
+    EXPECT_EQ(succeeded, static_cast<int>(num_shards) * queries_per_shard);
+    for (std::size_t i = 0; i < num_shards; ++i)
+    {
+        EXPECT_EQ(pool.num_in_flight(i), 0);
+        EXPECT_LE(pool.shard(i).size(), 2);
+    }
+}
+
+} // anon namespace
@@ -0,0 +1,80 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include "boost/mysql/connection_params.hpp"
+
+using boost::mysql::ssl_session_cache;
+using boost::mysql::ssl_options;
+using boost::mysql::ssl_mode;
+
+namespace
+{
+
+TEST(SslSessionCacheTest, DefaultConstructor_Empty)
+{
+    ssl_session_cache cache;
+    EXPECT_FALSE(cache.has_session());
+    EXPECT_EQ(cache.get_session(), nullptr);
+}
+
+TEST(SslSessionCacheTest, SetSession_GetReturnsSameSession)
+{
+    ssl_session_cache cache;
+    SSL_SESSION* session = SSL_SESSION_new();
+    cache.set_session(session);
+    EXPECT_TRUE(cache.has_session());
+
+    SSL_SESSION* got = cache.get_session();
+    EXPECT_EQ(got, session);
+    SSL_SESSION_free(got);
+
+    // The cache still owns its reference
+    got = cache.get_session();
+    EXPECT_EQ(got, session);
+    SSL_SESSION_free(got);
+}
+
+TEST(SslSessionCacheTest, SetSession_ReplacesPreviousSession)
+{
+    ssl_session_cache cache;
+    cache.set_session(SSL_SESSION_new());
+    SSL_SESSION* session = SSL_SESSION_new();
+    cache.set_session(session);
+    SSL_SESSION* got = cache.get_session();
+    EXPECT_EQ(got, session);
+    SSL_SESSION_free(got);
+}
+
+TEST(SslSessionCacheTest, Clear_RemovesSession)
+{
+    ssl_session_cache cache;
+    cache.set_session(SSL_SESSION_new());
+    cache.clear();
+    EXPECT_FALSE(cache.has_session());
+    EXPECT_EQ(cache.get_session(), nullptr);
+}
+
+TEST(SslOptionsTest, DefaultConstructor_NoContextNoCache)
+{
+    ssl_options opts;
+    EXPECT_EQ(opts.mode(), ssl_mode::enable);
+    EXPECT_EQ(opts.context(), nullptr);
+    EXPECT_EQ(opts.session_cache(), nullptr);
+}
+
+TEST(SslOptionsTest, InitializingConstructor_StoresPointers)
+{
+    boost::asio::ssl::context ctx (boost::asio::ssl::context::tls_client);
+    ssl_session_cache cache;
+    ssl_options opts (ssl_mode::require, &ctx, &cache);
+    EXPECT_EQ(opts.mode(), ssl_mode::require);
+    EXPECT_EQ(opts.context(), &ctx);
+    EXPECT_EQ(opts.session_cache(), &cache);
+}
+
+}
@@ -0,0 +1,106 @@
+//
+// Copyright (c) 2019-2020 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include "boost/mysql/connection.hpp"
+#include "fake_server.hpp"
+#include "test_common.hpp"
+#include <atomic>
+#include <future>
+#include <thread>
+
+using namespace boost::mysql::test;
+using boost::mysql::error_code;
+using boost::mysql::connection_params;
+using boost::mysql::ssl_options;
+using boost::mysql::ssl_mode;
+using boost::mysql::owning_row;
+using boost::mysql::tcp_strand_connection;
+using boost::mysql::tcp_strand_socket;
+
+namespace
+{
+
+const boost::asio::ip::tcp::endpoint any_port {boost::asio::ip::address_v4::loopback(), 0};
+
+// Runs a number of queries one after the other, checking
+// that every handler runs in the connection's strand
+class strand_client
+{
+    tcp_strand_connection& conn_;
+    int remaining_;
+    boost::mysql::resultset<tcp_strand_socket> result_;
+    std::promise<error_code> done_;
+public:
+    std::atomic<int> handlers_outside_strand {0};
+
+    strand_client(tcp_strand_connection& conn, int num_queries) : conn_(conn), remaining_(num_queries) {}
+
+    std::future<error_code> start(const boost::asio::ip::tcp::endpoint& ep, const connection_params& params)
+    {
+        boost::asio::dispatch(conn_.get_executor(), [this, ep, &params] {
+            conn_.async_connect(ep, params, [this](error_code err) {
+                check_strand();
+                if (err)
+                    done_.set_value(err);
+                else
+                    query();
+            });
+        });
+        return done_.get_future();
+    }
+private:
+    void check_strand()
+    {
+        if (!conn_.get_executor().running_in_this_thread())
+            ++handlers_outside_strand;
+    }
+
+    void query()
+    {
+        conn_.async_query("SELECT 1", [this](error_code err, boost::mysql::resultset<tcp_strand_socket> result) {
+            check_strand();
+            if (err)
+                return done_.set_value(err);
+            result_ = std::move(result);
+            result_.async_fetch_all([this](error_code err, std::vector<owning_row> rows) {
+                check_strand();
+                if (!err && rows.size() != 1)
+                    err = boost::asio::error::invalid_argument;
+                if (err || --remaining_ == 0)
+                    done_.set_value(err);
+                else
+                    query();
+            });
+        });
+    }
+};
+
+TEST(StrandConnectionTest, MultithreadedContext_HandlersRunInStrand)
+{
+    fake_server server;
+    server.add_resultset("SELECT 1", {"1"}, {makevalues(1)});
+    fake_tcp_server tcp_server (server, any_port);
+    connection_params params {"user", "password", "db", boost::mysql::collation::utf8mb4_general_ci,
+        ssl_options(ssl_mode::disable)};
+
+    boost::asio::io_context ctx (4);
+    tcp_strand_connection conn (boost::asio::make_strand(ctx));
+    strand_client client (conn, 50);
+    auto fut = client.start(tcp_server.endpoint(), params);
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i)
+        threads.emplace_back([&ctx] { ctx.run(); });
+    for (auto& t: threads)
+        t.join();
+
+    EXPECT_EQ(fut.get(), error_code());
+    EXPECT_EQ(client.handlers_outside_strand, 0);
+}
+
+} // anon namespace